@@ -0,0 +1,169 @@
+/**
+ * @file admission_control.cpp
+ * @brief Implementation of the sharded admission layer
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <functional>
+#include "admission_control.h"
+#include "course_registration.h"
+
+// Implementation of AdmissionController methods
+
+AdmissionController::AdmissionController() : shards(new Shard[kShardCount]) {}
+
+AdmissionController::Shard& AdmissionController::shardOf(const std::string& studentId) const {
+    return shards[std::hash<std::string>()(studentId) % kShardCount];
+}
+
+void AdmissionController::setPolicy(const AdmissionPolicy& newPolicy) {
+    policy = newPolicy;
+    // Without an explicit burst a quiet student may send one second's worth
+    if (policy.tokensPerSecond > 0 && policy.burst < 1) {
+        policy.burst = std::max(1.0, policy.tokensPerSecond);
+    }
+    for (size_t s = 0; s < kShardCount; ++s) {
+        shards[s].students.clear();
+        shards[s].stats = AdmissionStats();
+        shards[s].sweepBucket = 0;
+    }
+}
+
+bool AdmissionController::idle(const StudentState& state, time_t now) const {
+    for (const RecentRequest& r : state.recent) {
+        if (r.answeredAt + policy.idempotencyWindow > now) {
+            return false;
+        }
+    }
+    if (policy.tokensPerSecond > 0) {
+        double elapsed = now > state.refilledAt ? static_cast<double>(now - state.refilledAt) : 0.0;
+        return state.tokens + elapsed * policy.tokensPerSecond >= policy.burst;
+    }
+    return true;
+}
+
+void AdmissionController::sweep(Shard& shard, time_t now) {
+    const size_t buckets = shard.students.bucket_count();
+    for (size_t step = 0; step < kSweepBuckets && step < buckets; ++step) {
+        // A rehash moves students between buckets; the next pass catches any it skipped
+        const size_t bucket = shard.sweepBucket++ % buckets;
+        auto it = shard.students.begin(bucket);
+        while (it != shard.students.end(bucket)) {
+            if (!idle(it->second, now)) {
+                ++it;
+                continue;
+            }
+            // Bucket iterators cannot erase; rescan the bucket after erasing through the map
+            shard.students.erase(shard.students.find(it->first));
+            it = shard.students.begin(bucket);
+        }
+    }
+}
+
+AdmissionDecision AdmissionController::admit(const std::string& studentId,
+                                             const std::string& courseCode, time_t now) {
+    Shard& shard = shardOf(studentId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    sweep(shard, now);
+    auto inserted = shard.students.try_emplace(studentId);
+    StudentState& state = inserted.first->second;
+    if (inserted.second) {
+        state.tokens = policy.burst;
+        state.refilledAt = now;
+    }
+
+    if (policy.idempotencyWindow > 0) {
+        time_t window = policy.idempotencyWindow;
+        state.recent.erase(std::remove_if(state.recent.begin(), state.recent.end(),
+                                          [&](const RecentRequest& r) { return r.answeredAt + window <= now; }),
+                           state.recent.end());
+        for (const RecentRequest& r : state.recent) {
+            if (r.courseCode == courseCode) {
+                ++shard.stats.replayed;
+                return {AdmissionVerdict::REPLAY, r.status};
+            }
+        }
+    }
+
+    if (policy.tokensPerSecond > 0) {
+        if (now > state.refilledAt) {
+            state.tokens = std::min(policy.burst,
+                                    state.tokens + (now - state.refilledAt) * policy.tokensPerSecond);
+            state.refilledAt = now;
+        }
+        if (state.tokens < 1) {
+            ++shard.stats.rateLimited;
+            return {AdmissionVerdict::REJECT, RegistrationStatus::RATE_LIMITED};
+        }
+        state.tokens -= 1;
+    }
+
+    ++shard.stats.admitted;
+    return {AdmissionVerdict::ADMIT, RegistrationStatus::SUCCESS};
+}
+
+void AdmissionController::complete(const std::string& studentId, const std::string& courseCode,
+                                   RegistrationStatus status, time_t now) {
+    if (policy.idempotencyWindow <= 0) {
+        return;
+    }
+    // A refusal may not hold for long (a seat frees, the window opens), so retry it for real
+    if (status != RegistrationStatus::SUCCESS && status != RegistrationStatus::ALREADY_ENROLLED) {
+        return;
+    }
+    Shard& shard = shardOf(studentId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // A sweep may have dropped the student since admit(); start from a full bucket
+    auto inserted = shard.students.try_emplace(studentId);
+    StudentState& state = inserted.first->second;
+    if (inserted.second) {
+        state.tokens = policy.burst;
+        state.refilledAt = now;
+    }
+    for (RecentRequest& r : state.recent) {
+        if (r.courseCode == courseCode) {
+            r.status = status;
+            r.answeredAt = now;
+            return;
+        }
+    }
+    state.recent.push_back({courseCode, status, now});
+}
+
+void AdmissionController::forget(const std::string& studentId, const std::string& courseCode) {
+    if (policy.idempotencyWindow <= 0) {
+        return;
+    }
+    Shard& shard = shardOf(studentId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto studentIt = shard.students.find(studentId);
+    if (studentIt == shard.students.end()) {
+        return;
+    }
+    std::vector<RecentRequest>& recent = studentIt->second.recent;
+    recent.erase(std::remove_if(recent.begin(), recent.end(),
+                                [&](const RecentRequest& r) { return r.courseCode == courseCode; }),
+                 recent.end());
+}
+
+AdmissionStats AdmissionController::stats() const {
+    AdmissionStats total;
+    for (size_t s = 0; s < kShardCount; ++s) {
+        std::lock_guard<std::mutex> lock(shards[s].mutex);
+        total.admitted += shards[s].stats.admitted;
+        total.replayed += shards[s].stats.replayed;
+        total.rateLimited += shards[s].stats.rateLimited;
+    }
+    return total;
+}
+
+size_t AdmissionController::trackedStudents() const {
+    size_t total = 0;
+    for (size_t s = 0; s < kShardCount; ++s) {
+        std::lock_guard<std::mutex> lock(shards[s].mutex);
+        total += shards[s].students.size();
+    }
+    return total;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file admission_control.h
+ * @brief Per-student rate limiting and idempotent replay of registrations
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * The admission layer sits in front of registerStudent. For each student
+ * it keeps a token bucket and the outcomes of that student's recent
+ * enrollments. A request identical to one that enrolled the student
+ * within the idempotency window gets the earlier status back without
+ * touching the catalog; otherwise it spends a token, or is refused with
+ * RATE_LIMITED when the bucket is empty.
+ *
+ * State lives in kShardCount cache-line aligned shards selected by a hash
+ * of the student ID, each with its own mutex and hash map, so students on
+ * different shards never contend and a decision costs one short critical
+ * section. Buckets refill on the engine's RegistrationClock, so runs
+ * driven by a ManualClock are reproducible.
+ *
+ * A student whose bucket has refilled and whose cached outcomes have
+ * expired is indistinguishable from one never seen, so each shard drops
+ * such students as it goes: every admit() examines the next
+ * kSweepBuckets buckets of its shard's map, so no call ever walks a
+ * whole shard and every idle student is dropped once admissions have
+ * cycled through its shard.
+ */
+
+#ifndef ADMISSION_CONTROL_H
+#define ADMISSION_CONTROL_H
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class RegistrationStatus;
+
+/** @brief Limits applied by the admission layer; zero disables a limit */
+struct AdmissionPolicy {
+    double tokensPerSecond = 0; /**< Sustained requests per student per second */
+    double burst = 0;           /**< Bucket size: requests a quiet student may send at once */
+    int idempotencyWindow = 0;  /**< Seconds a request's outcome is replayed for retries */
+};
+
+/** @brief What the admission layer decided for one request */
+enum class AdmissionVerdict {
+    ADMIT,  /**< Run the request */
+    REPLAY, /**< Identical request answered recently; return its status */
+    REJECT  /**< Bucket empty; return RATE_LIMITED */
+};
+
+/** @brief Decision and, for REPLAY, the status to return */
+struct AdmissionDecision {
+    AdmissionVerdict verdict;   /**< Outcome of admission */
+    RegistrationStatus status;  /**< Status to return unless admitted */
+};
+
+/** @brief Totals of admission decisions */
+struct AdmissionStats {
+    uint64_t admitted = 0;    /**< Requests passed to the engine */
+    uint64_t replayed = 0;    /**< Retries answered from the idempotency cache */
+    uint64_t rateLimited = 0; /**< Requests refused with RATE_LIMITED */
+};
+
+/**
+ * @brief Sharded per-student token buckets and idempotency cache
+ *
+ * Example usage:
+ * @code
+ * AdmissionController admission;
+ * admission.setPolicy({5, 10, 2});
+ * AdmissionDecision d = admission.admit("S1", "CS201", now);
+ * if (d.verdict == AdmissionVerdict::ADMIT) {
+ *     admission.complete("S1", "CS201", runRegistration(), now);
+ * }
+ * @endcode
+ */
+class AdmissionController {
+private:
+    static const size_t kShardCount = 64;  /**< Shards students are spread over */
+    static const size_t kSweepBuckets = 4; /**< Map buckets each admit() examines for idle students */
+
+    /** @brief Outcome of one recent request */
+    struct RecentRequest {
+        std::string courseCode;    /**< Course requested */
+        RegistrationStatus status; /**< Status returned */
+        time_t answeredAt;         /**< Engine time of the answer */
+    };
+
+    /** @brief Admission state of one student */
+    struct StudentState {
+        double tokens = 0;                  /**< Tokens left in the bucket */
+        time_t refilledAt = 0;              /**< Engine time of the last refill */
+        std::vector<RecentRequest> recent;  /**< Answers still inside the window */
+    };
+
+    /** @brief Students mapped to one shard */
+    struct alignas(64) Shard {
+        std::mutex mutex;                                     /**< Guards every field below */
+        std::unordered_map<std::string, StudentState> students; /**< State by student ID */
+        AdmissionStats stats;                                 /**< Decisions made on this shard */
+        size_t sweepBucket = 0;                               /**< Next bucket of students to examine */
+    };
+
+    AdmissionPolicy policy;           /**< Limits in force */
+    std::unique_ptr<Shard[]> shards;  /**< kShardCount shards */
+
+    /** @brief Returns the shard holding @p studentId */
+    Shard& shardOf(const std::string& studentId) const;
+
+    /** @brief Returns true if @p state holds nothing a fresh state would not; shard locked */
+    bool idle(const StudentState& state, time_t now) const;
+
+    /** @brief Drops the idle students of the shard's next kSweepBuckets buckets; shard locked */
+    void sweep(Shard& shard, time_t now);
+
+public:
+    AdmissionController();
+
+    /**
+     * @brief Replaces the limits and forgets all per-student state
+     *
+     * @warning Must not be called concurrently with other methods
+     */
+    void setPolicy(const AdmissionPolicy& newPolicy);
+
+    /** @brief Returns true if any limit is configured */
+    bool enabled() const { return policy.tokensPerSecond > 0 || policy.idempotencyWindow > 0; }
+
+    /**
+     * @brief Decides whether a registration request may run
+     *
+     * @param studentId Student making the request
+     * @param courseCode Course requested
+     * @param now Engine time of the request
+     * @return ADMIT, REPLAY with the earlier status, or REJECT with RATE_LIMITED
+     */
+    AdmissionDecision admit(const std::string& studentId, const std::string& courseCode, time_t now);
+
+    /**
+     * @brief Records the outcome of an admitted request for later retries
+     *
+     * Only SUCCESS and ALREADY_ENROLLED are kept; any other status is
+     * ignored, so a retry after a refusal runs against the catalog again.
+     * Two identical requests admitted concurrently both run; the engine's
+     * own checks make the second return ALREADY_ENROLLED.
+     */
+    void complete(const std::string& studentId, const std::string& courseCode,
+                  RegistrationStatus status, time_t now);
+
+    /**
+     * @brief Drops a cached outcome after the student's enrollment changed
+     *
+     * Called when a withdrawal, cart or swap changes the student's roster
+     * for @p courseCode, so a retry is answered from the new state.
+     */
+    void forget(const std::string& studentId, const std::string& courseCode);
+
+    /** @brief Sums the decisions of every shard */
+    AdmissionStats stats() const;
+
+    /** @brief Returns how many students currently have admission state */
+    size_t trackedStudents() const;
+};
+
+#endif // ADMISSION_CONTROL_H
@@ -0,0 +1,98 @@
+/**
+ * @file availability_board.cpp
+ * @brief Implementation of the seqlock availability board
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "availability_board.h"
+
+// Implementation of AvailabilityBoard methods
+
+AvailabilityBoard::AvailabilityBoard() : chunks(new std::atomic<Entry*>[kMaxChunks]) {
+    for (uint32_t i = 0; i < kMaxChunks; ++i) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+void AvailabilityBoard::addCourse(CourseHandle handle, int capacity) {
+    uint32_t chunk = handle >> kChunkBits;
+    if (chunk >= kMaxChunks) {
+        throw std::length_error("Availability board is full");
+    }
+    if (!chunks[chunk].load(std::memory_order_relaxed)) {
+        owned.emplace_back(new Entry[kChunkSize]);
+        chunks[chunk].store(owned.back().get(), std::memory_order_release);
+    }
+    entry(handle).capacity.store(capacity, std::memory_order_relaxed);
+    // Count the course before its first version exists, so a poller whose
+    // cursor covers that version also scans the entry
+    courseCount.store(handle + 1, std::memory_order_release);
+    publish(handle, 0);
+}
+
+void AvailabilityBoard::publish(CourseHandle handle, int enrolled, int held) {
+    Entry& e = entry(handle);
+    uint32_t sequence = e.sequence.load(std::memory_order_relaxed);
+    e.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    e.enrolled.store(enrolled, std::memory_order_relaxed);
+    e.held.store(held, std::memory_order_relaxed);
+    e.version.store(boardVersion.fetch_add(1, std::memory_order_acq_rel) + 1,
+                    std::memory_order_relaxed);
+
+    e.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void AvailabilityBoard::setCapacity(CourseHandle handle, int capacity) {
+    Entry& e = entry(handle);
+    uint32_t sequence = e.sequence.load(std::memory_order_relaxed);
+    e.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    e.capacity.store(capacity, std::memory_order_relaxed);
+    e.version.store(boardVersion.fetch_add(1, std::memory_order_acq_rel) + 1,
+                    std::memory_order_relaxed);
+
+    e.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+SeatAvailability AvailabilityBoard::read(CourseHandle handle) const {
+    const Entry& e = entry(handle);
+    SeatAvailability result;
+    result.handle = handle;
+    uint32_t before;
+    uint32_t after;
+    do {
+        before = e.sequence.load(std::memory_order_acquire);
+        result.capacity = e.capacity.load(std::memory_order_relaxed);
+        result.enrolled = e.enrolled.load(std::memory_order_relaxed);
+        result.held = e.held.load(std::memory_order_relaxed);
+        result.version = e.version.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = e.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    result.seatsLeft = std::max(0, result.capacity - result.enrolled - result.held);
+    return result;
+}
+
+std::vector<SeatAvailability> AvailabilityBoard::changesSince(uint64_t sinceVersion,
+                                                              uint64_t& nextVersion) const {
+    // Any change numbered at or below this cursor is complete or in
+    // progress, and its course is counted by size() because addCourse
+    // counts a course before publishing it. read() waits out in-progress
+    // writes, so none is missed.
+    nextVersion = currentVersion();
+    std::vector<SeatAvailability> changes;
+    uint32_t count = size();
+    for (CourseHandle handle = 0; handle < count; ++handle) {
+        SeatAvailability availability = read(handle);
+        if (availability.version > sinceVersion) {
+            changes.push_back(availability);
+        }
+    }
+    return changes;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file availability_board.h
+ * @brief Lock-free published seat availability for every course
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * The board is an array of per-course entries indexed by CourseHandle,
+ * stored in fixed-size chunks so it can grow without moving existing
+ * entries. The engine publishes an entry every time a roster changes;
+ * readers load entries without taking any lock and without touching the
+ * rosters, so polling cost does not depend on registration load.
+ *
+ * Each entry is guarded by a sequence counter (seqlock): the writer makes
+ * the counter odd, updates the fields, and makes it even again; a reader
+ * retries if it saw an odd counter or the counter changed while reading.
+ * Writers to one entry are already serialized by the course's roster lock.
+ */
+
+#ifndef AVAILABILITY_BOARD_H
+#define AVAILABILITY_BOARD_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** @brief Dense index of a course, assigned in addCourse order */
+using CourseHandle = uint32_t;
+
+/** @brief Published availability of one course */
+struct SeatAvailability {
+    CourseHandle handle; /**< Course the entry describes */
+    int capacity;        /**< Maximum number of students */
+    int enrolled;        /**< Students currently enrolled */
+    int held;            /**< Seats on hold for students yet to register */
+    int seatsLeft;       /**< capacity - enrolled - held, never negative */
+    uint64_t version;    /**< Board version of the last change */
+};
+
+/**
+ * @brief Seqlock-published seat counts with a delta feed
+ *
+ * Example usage:
+ * @code
+ * const AvailabilityBoard& board = reg.getAvailabilityBoard();
+ * uint64_t cursor = 0;
+ * std::vector<SeatAvailability> changes = board.changesSince(cursor, cursor);
+ * @endcode
+ */
+class AvailabilityBoard {
+private:
+    static const int kChunkBits = 10;               /**< log2 of entries per chunk */
+    static const uint32_t kChunkSize = 1u << kChunkBits; /**< Entries per chunk */
+    static const uint32_t kMaxChunks = 4096;        /**< Limits the board to 4M courses */
+
+    /** @brief One seqlock-protected course entry, padded to a cache line */
+    struct alignas(64) Entry {
+        std::atomic<uint32_t> sequence{0}; /**< Odd while a write is in progress */
+        std::atomic<int> capacity{0};      /**< Course capacity */
+        std::atomic<int> enrolled{0};      /**< Enrolled students */
+        std::atomic<int> held{0};          /**< Held seats */
+        std::atomic<uint64_t> version{0};  /**< Board version of the last change */
+    };
+
+    std::unique_ptr<std::atomic<Entry*>[]> chunks; /**< kMaxChunks chunk pointers */
+    std::vector<std::unique_ptr<Entry[]>> owned;   /**< Allocated chunks, written by addCourse only */
+    std::atomic<uint32_t> courseCount{0};          /**< Number of published courses */
+    std::atomic<uint64_t> boardVersion{0};         /**< Version of the latest change */
+
+    Entry& entry(CourseHandle handle) const {
+        return chunks[handle >> kChunkBits].load(std::memory_order_acquire)[handle & (kChunkSize - 1)];
+    }
+
+public:
+    AvailabilityBoard();
+
+    /**
+     * @brief Adds an entry for a new course
+     *
+     * @param handle Handle of the course; must equal the current size()
+     * @param capacity Course capacity
+     * @throws std::length_error if the board is full
+     * @note Calls must be serialized (the engine holds its catalog lock).
+     */
+    void addCourse(CourseHandle handle, int capacity);
+
+    /**
+     * @brief Publishes a course's new enrollment and held seat counts
+     *
+     * @note Calls for the same handle must be serialized.
+     */
+    void publish(CourseHandle handle, int enrolled, int held = 0);
+
+    /**
+     * @brief Publishes a course's new capacity
+     *
+     * @note Must be serialized with publish() calls for the same handle.
+     */
+    void setCapacity(CourseHandle handle, int capacity);
+
+    /** @brief Returns the number of courses on the board */
+    uint32_t size() const { return courseCount.load(std::memory_order_acquire); }
+
+    /** @brief Returns the version of the latest published change */
+    uint64_t currentVersion() const { return boardVersion.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Reads one course's availability without locking
+     *
+     * @param handle Course handle; must be less than size()
+     */
+    SeatAvailability read(CourseHandle handle) const;
+
+    /**
+     * @brief Returns every entry changed after @p sinceVersion
+     *
+     * Delivery is at-least-once: an entry changed during the scan may be
+     * reported again by the next call.
+     *
+     * @param sinceVersion Cursor returned by the previous call (0 for all)
+     * @param[out] nextVersion Cursor to pass to the next call
+     * @return Changed entries in handle order
+     */
+    std::vector<SeatAvailability> changesSince(uint64_t sinceVersion, uint64_t& nextVersion) const;
+};
+
+#endif // AVAILABILITY_BOARD_H
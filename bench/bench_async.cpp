@@ -0,0 +1,208 @@
+/**
+ * @file bench_async.cpp
+ * @brief Thread-per-request blocking calls versus coroutines on the engine executor
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Keeps --clients requests in flight against a Zipf-skewed catalog, so a
+ * few hot courses see most of the traffic. Each client owns a disjoint
+ * slice of the students and loops: register for a course, and withdraw
+ * again if that succeeded, so hot courses stay contended for the whole
+ * run. Two ways of keeping the requests in flight are compared:
+ * - "blocking": one OS thread per client calling the synchronous API
+ *   (what the front end does today)
+ * - "coroutine": one coroutine per client awaiting registration_async.h,
+ *   run by an executor of --workers threads
+ * Latency is measured per engine call, from issue to result.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_async
+ * ./build/bench_async --clients 1024 --workers 4 --requests 400000
+ * @endcode
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <latch>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench/bench_util.h"
+#include "bench/workload.h"
+#include "registration_async.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Coroutine that starts at once and frees itself when it finishes */
+struct DetachedClient {
+    struct promise_type {
+        DetachedClient get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/** @brief What one client does and what it measured */
+struct ClientPlan {
+    std::vector<Student*> students;  /**< Students only this client registers */
+    std::vector<int> courses;        /**< Course index of each registration */
+    std::vector<uint64_t> latencies; /**< Nanoseconds per engine call */
+};
+
+/** @brief Returns nanoseconds since @p start */
+uint64_t elapsedNanos(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/** @brief Runs one client's plan with blocking calls */
+void runBlocking(CourseRegistration& reg, const std::vector<bench::CourseSpec>& catalog,
+                 ClientPlan& plan) {
+    for (size_t i = 0; i < plan.courses.size(); ++i) {
+        Student& student = *plan.students[i % plan.students.size()];
+        const std::string& code = catalog[plan.courses[i]].code;
+        Clock::time_point start = Clock::now();
+        RegistrationStatus status = reg.tryRegisterStudent(student, code);
+        plan.latencies.push_back(elapsedNanos(start));
+        if (status == RegistrationStatus::SUCCESS) {
+            start = Clock::now();
+            reg.withdrawStudent(student.getStudentId(), code);
+            plan.latencies.push_back(elapsedNanos(start));
+        }
+    }
+}
+
+/** @brief Runs one client's plan as a coroutine on the engine executor */
+DetachedClient runCoroutine(CourseRegistration& reg, const std::vector<bench::CourseSpec>& catalog,
+                            ClientPlan& plan, std::latch& finished) {
+    for (size_t i = 0; i < plan.courses.size(); ++i) {
+        Student& student = *plan.students[i % plan.students.size()];
+        const std::string& code = catalog[plan.courses[i]].code;
+        Clock::time_point start = Clock::now();
+        RegistrationStatus status = co_await registerStudentAsync(reg, student, code);
+        plan.latencies.push_back(elapsedNanos(start));
+        if (status == RegistrationStatus::SUCCESS) {
+            start = Clock::now();
+            co_await withdrawStudentAsync(reg, student.getStudentId(), code);
+            plan.latencies.push_back(elapsedNanos(start));
+        }
+    }
+    finished.count_down();
+}
+
+/** @brief Builds a fresh engine over the catalog */
+void addCatalog(CourseRegistration& reg, const std::vector<bench::CourseSpec>& catalog) {
+    const time_t deadline = std::time(nullptr) + 30 * 86400;
+    for (const auto& course : catalog) {
+        reg.addCourse(course.code, course.name, course.capacity, {}, deadline);
+    }
+}
+
+/** @brief Splits students and requests over the clients */
+std::vector<ClientPlan> makePlans(std::vector<Student>& students, size_t clients, uint64_t requests,
+                                  const bench::ZipfSampler& zipf, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<ClientPlan> plans(clients);
+    for (size_t s = 0; s < students.size(); ++s) {
+        plans[s % clients].students.push_back(&students[s]);
+    }
+    for (uint64_t r = 0; r < requests; ++r) {
+        plans[r % clients].courses.push_back(zipf(rng));
+    }
+    for (ClientPlan& plan : plans) {
+        plan.latencies.reserve(2 * plan.courses.size());
+    }
+    return plans;
+}
+
+/** @brief Summarizes the latencies of every client */
+bench::OperationStats summarize(const char* name, std::vector<ClientPlan>& plans, double seconds,
+                                uint64_t allocs) {
+    std::vector<uint64_t> samples;
+    for (ClientPlan& plan : plans) {
+        samples.insert(samples.end(), plan.latencies.begin(), plan.latencies.end());
+    }
+    std::sort(samples.begin(), samples.end());
+    bench::OperationStats stats;
+    stats.name = name;
+    stats.operations = samples.size();
+    stats.opsPerSecond = seconds > 0 ? samples.size() / seconds : 0.0;
+    stats.p50Nanos = bench::percentile(samples, 0.50);
+    stats.p99Nanos = bench::percentile(samples, 0.99);
+    stats.p999Nanos = bench::percentile(samples, 0.999);
+    stats.allocsPerOp = samples.empty() ? 0.0 : static_cast<double>(allocs) / samples.size();
+    return stats;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::WorkloadConfig config;
+    config.demandSkew = 1.1;
+    bench::parseWorkloadArgs(argc, argv, config);
+    size_t clients = 1024;
+    unsigned workers = 4;
+    uint64_t requests = 400000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--clients")) clients = std::atol(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--workers")) workers = std::atoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--requests")) requests = std::atoll(argv[i + 1]);
+    }
+    std::vector<bench::CourseSpec> catalog = bench::generateCatalog(config);
+    bench::ZipfSampler zipf(config.courseCount, config.demandSkew);
+    clients = std::min<size_t>(clients, config.studentCount);
+
+    std::printf("%zu clients in flight, %llu registrations, %d courses, demand skew %.2f\n\n",
+                clients, static_cast<unsigned long long>(requests), config.courseCount,
+                config.demandSkew);
+    bench::printHeader();
+
+    {
+        std::vector<Student> students = bench::generateStudents(config, catalog);
+        CourseRegistration reg;
+        addCatalog(reg, catalog);
+        std::vector<ClientPlan> plans = makePlans(students, clients, requests, zipf, config.seed);
+        uint64_t allocsBefore = bench::allocationCount.load(std::memory_order_relaxed);
+        Clock::time_point start = Clock::now();
+        std::vector<std::thread> threads;
+        threads.reserve(clients);
+        for (ClientPlan& plan : plans) {
+            threads.emplace_back(runBlocking, std::ref(reg), std::cref(catalog), std::ref(plan));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        uint64_t allocs = bench::allocationCount.load(std::memory_order_relaxed) - allocsBefore;
+        bench::printStats(summarize("blocking", plans, seconds, allocs));
+    }
+    {
+        std::vector<Student> students = bench::generateStudents(config, catalog);
+        std::vector<ClientPlan> plans = makePlans(students, clients, requests, zipf, config.seed);
+        std::latch finished(static_cast<std::ptrdiff_t>(clients));
+        // Declared after what the coroutines touch, so its executor is joined first
+        CourseRegistration reg;
+        addCatalog(reg, catalog);
+        reg.enableExecutor(workers);
+        uint64_t allocsBefore = bench::allocationCount.load(std::memory_order_relaxed);
+        Clock::time_point start = Clock::now();
+        for (ClientPlan& plan : plans) {
+            runCoroutine(reg, catalog, plan, finished);
+        }
+        finished.wait();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        uint64_t allocs = bench::allocationCount.load(std::memory_order_relaxed) - allocsBefore;
+        bench::printStats(summarize("coroutine", plans, seconds, allocs));
+    }
+    std::printf("\nOS threads running engine calls: blocking %zu, coroutine %u\n", clients, workers);
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file bench_cart.cpp
+ * @brief Contended throughput of atomic cart registration
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Compares two ways of registering a student for a cart of courses from
+ * N threads hitting a Zipf-skewed catalog:
+ * - cart: one CourseRegistration::registerCart call (all-or-nothing)
+ * - sequential: registerStudent per course, withdrawing the already
+ *   registered courses when one fails (the front end's current approach)
+ *
+ * Reports carts/sec, latency percentiles, the share of carts committed and,
+ * for the sequential path, how many seats were taken and then given back.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_cart
+ * ./build/bench_cart --threads 8 --cart-size 5 --courses 200 --capacity 300
+ * @endcode
+ *
+ * Accepts the workload options of bench_registration plus --threads N
+ * and --cart-size K. Prerequisite depth defaults to 0 so that contention
+ * for seats is the only reason a cart fails.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include "bench/bench_util.h"
+#include "bench/workload.h"
+#include "course_registration.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Totals gathered by one benchmark thread */
+struct ThreadResult {
+    std::vector<uint64_t> latencies; /**< Per-cart latency in nanoseconds */
+    uint64_t committed = 0;          /**< Carts fully registered */
+    uint64_t rolledBack = 0;         /**< Seats taken and released again */
+};
+
+/** @brief Registers every cart and reports throughput for one mode */
+void runMode(const char* mode, bool atomicCart, unsigned threadCount,
+             const std::vector<bench::CourseSpec>& catalog,
+             const std::vector<std::vector<std::string>>& carts,
+             std::vector<Student> students) {
+    ManualClock clock(1700000000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    for (const auto& course : catalog) {
+        reg.addCourse(course.code, course.name, course.capacity, course.prerequisites,
+                      clock.now() + 86400);
+    }
+
+    std::vector<ThreadResult> results(threadCount);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    size_t perThread = carts.size() / threadCount;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            ThreadResult& result = results[t];
+            result.latencies.reserve(perThread);
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (size_t i = t * perThread; i < (t + 1) * perThread; ++i) {
+                Student& student = students[i];
+                const auto& cart = carts[i];
+                auto start = Clock::now();
+                if (atomicCart) {
+                    result.committed += reg.registerCart(student, cart).committed;
+                } else {
+                    size_t registered = 0;
+                    while (registered < cart.size() &&
+                           reg.tryRegisterStudent(student, cart[registered]) == RegistrationStatus::SUCCESS) {
+                        ++registered;
+                    }
+                    if (registered == cart.size()) {
+                        ++result.committed;
+                    } else {
+                        for (size_t j = 0; j < registered; ++j) {
+                            reg.withdrawStudent(student.getStudentId(), cart[j]);
+                        }
+                        result.rolledBack += registered;
+                    }
+                }
+                result.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                               Clock::now() - start).count());
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<uint64_t> latencies;
+    uint64_t committed = 0;
+    uint64_t rolledBack = 0;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        committed += result.committed;
+        rolledBack += result.rolledBack;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%-10s %8u %12.0f %9llu %9llu %9llu %9.1f%% %12llu\n",
+                mode, threadCount, latencies.size() / seconds,
+                static_cast<unsigned long long>(bench::percentile(latencies, 0.50)),
+                static_cast<unsigned long long>(bench::percentile(latencies, 0.99)),
+                static_cast<unsigned long long>(bench::percentile(latencies, 0.999)),
+                100.0 * committed / latencies.size(),
+                static_cast<unsigned long long>(rolledBack));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::WorkloadConfig config;
+    config.prereqDepth = 0;
+    config.courseCount = 200;
+    config.studentCount = 4000;
+    bench::parseWorkloadArgs(argc, argv, config);
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    size_t cartSize = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--threads")) threadCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--cart-size")) cartSize = std::atoi(argv[i + 1]);
+    }
+    cartSize = std::min<size_t>(cartSize, config.courseCount);
+
+    std::vector<bench::CourseSpec> catalog = bench::generateCatalog(config);
+    std::vector<Student> students = bench::generateStudents(config, catalog);
+
+    // One cart of distinct, demand-weighted courses per student
+    std::mt19937 rng(config.seed + 3);
+    bench::ZipfSampler demand(config.courseCount, config.demandSkew);
+    std::vector<std::vector<std::string>> carts(students.size());
+    for (auto& cart : carts) {
+        std::vector<int> picked;
+        while (picked.size() < cartSize) {
+            int course = demand(rng);
+            if (std::find(picked.begin(), picked.end(), course) == picked.end()) {
+                picked.push_back(course);
+                cart.push_back(catalog[course].code);
+            }
+        }
+    }
+
+    std::printf("courses=%d capacity=%d capacity-skew=%.2f demand-skew=%.2f carts=%zu cart-size=%zu\n",
+                config.courseCount, config.baseCapacity, config.capacitySkew,
+                config.demandSkew, carts.size(), cartSize);
+    std::printf("%-10s %8s %12s %9s %9s %9s %10s %12s\n",
+                "mode", "threads", "carts/sec", "p50(ns)", "p99(ns)", "p999(ns)",
+                "committed", "rolled-back");
+    runMode("cart", true, threadCount, catalog, carts, students);
+    runMode("sequential", false, threadCount, catalog, carts, students);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file bench_cgpa_ranking.cpp
+ * @brief CgpaRanking versus sorting and scanning Student objects
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Builds a population across several departments and compares:
+ * - a full ranking: std::sort of Student objects by getCGPA() versus
+ *   CgpaRanking::ranked() (radix sort, threaded from kParallelThreshold)
+ * - a percentile: counting lower CGPAs over every Student versus
+ *   CgpaRanking::percentile()
+ * - top N of a department: std::partial_sort of the department's
+ *   students versus CgpaRanking::topInDepartment()
+ * - the cost of Student::updateCGPA() on a tracked student, which
+ *   re-ranks it through CgpaRanking::onCgpaChange()
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_cgpa_ranking
+ * ./build/bench_cgpa_ranking --students 500000 --threads 4
+ * @endcode
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench/bench_util.h"
+#include "cgpa_ranking.h"
+
+int main(int argc, char** argv) {
+    int studentCount = 500000;
+    unsigned threads = 0;
+    int top = 20;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--students")) studentCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--threads")) threads = std::max(0, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--top")) top = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    const std::vector<std::string> departments = {"CSE", "ECE", "ME", "CE", "EEE", "CHE", "BT", "MME"};
+    std::mt19937 rng(42);
+    std::normal_distribution<float> cgpaDist(7.0f, 1.5f);
+    auto randomCgpa = [&] { return std::min(10.0f, std::max(0.0f, cgpaDist(rng))); };
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (int s = 0; s < studentCount; ++s) {
+        students.emplace_back("S" + std::to_string(1000000 + s), "Student " + std::to_string(s),
+                              departments[rng() % departments.size()]);
+        students.back().updateCGPA(randomCgpa());
+    }
+    CgpaRanking ranking(students, threads);
+    for (Student& student : students) {
+        ranking.track(student);
+    }
+
+    std::vector<bench::OperationStats> results;
+    uint64_t checksum = 0;
+    const uint64_t sorts = 5;
+    results.push_back(bench::measure("std::sort Students", sorts, [&](uint64_t) {
+        std::vector<Student> copy = students;
+        std::sort(copy.begin(), copy.end(),
+                  [](const Student& a, const Student& b) { return a.getCGPA() > b.getCGPA(); });
+        checksum += copy.front().getStudentId().size();
+    }));
+    results.push_back(bench::measure("ranking ranked", sorts, [&](uint64_t) {
+        checksum += ranking.ranked().front().size();
+    }));
+
+    const uint64_t lookups = 200;
+    std::vector<size_t> who(lookups);
+    for (auto& w : who) {
+        w = rng() % students.size();
+    }
+    results.push_back(bench::measure("scan percentile", lookups, [&](uint64_t i) {
+        const float mine = students[who[i]].getCGPA();
+        size_t below = 0;
+        for (const auto& student : students) {
+            below += student.getCGPA() < mine;
+        }
+        checksum += below;
+    }));
+    results.push_back(bench::measure("ranking percentile", lookups, [&](uint64_t i) {
+        checksum += static_cast<uint64_t>(ranking.percentile(students[who[i]].getStudentId()));
+    }));
+
+    results.push_back(bench::measure("partial_sort top N", lookups, [&](uint64_t i) {
+        const std::string& department = departments[i % departments.size()];
+        std::vector<const Student*> members;
+        for (const auto& student : students) {
+            if (student.getDepartment() == department) {
+                members.push_back(&student);
+            }
+        }
+        size_t n = std::min<size_t>(top, members.size());
+        std::partial_sort(members.begin(), members.begin() + n, members.end(),
+                          [](const Student* a, const Student* b) { return a->getCGPA() > b->getCGPA(); });
+        checksum += n;
+    }));
+    results.push_back(bench::measure("ranking top N", lookups, [&](uint64_t i) {
+        checksum += ranking.topInDepartment(departments[i % departments.size()], top).size();
+    }));
+
+    const uint64_t updates = 200000;
+    std::vector<size_t> movers(updates);
+    std::vector<float> newCgpas(updates);
+    for (uint64_t i = 0; i < updates; ++i) {
+        movers[i] = rng() % students.size();
+        newCgpas[i] = randomCgpa();
+    }
+    results.push_back(bench::measure("tracked updateCGPA", updates, [&](uint64_t i) {
+        students[movers[i]].updateCGPA(newCgpas[i]);
+    }));
+
+    std::printf("students=%d departments=%zu top=%d\n", studentCount, departments.size(), top);
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+    return checksum == 0;
+}
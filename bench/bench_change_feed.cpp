@@ -0,0 +1,138 @@
+/**
+ * @file bench_change_feed.cpp
+ * @brief Cost of the change feed to registration and its delivery latency
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * One thread registers every student for one course of a wide catalog
+ * while K consumer threads poll the change feed. Reports, for no feed
+ * and for 1..K consumers:
+ * - registrations/sec on the producer thread
+ * - latency from the start of registerStudent to the event reaching a
+ *   consumer, merged over consumers
+ * - events dropped, the largest lag seen and producer waits
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_change_feed
+ * ./build/bench_change_feed --students 200000 --consumers 4 --capacity 65536
+ * @endcode
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench/bench_util.h"
+#include "course_registration.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Nanoseconds since a fixed origin, comparable across threads */
+int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/** @brief Runs one registration pass with @p consumerCount consumers and prints a row */
+void runRow(size_t studentCount, int consumerCount, size_t capacity) {
+    const int courseCount = 1000;
+    ManualClock clock(1700000000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    for (int c = 0; c < courseCount; ++c) {
+        reg.addCourse("C" + std::to_string(c), "Course", static_cast<int>(studentCount), {},
+                      clock.now() + 86400);
+    }
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        students.emplace_back("S" + std::to_string(i), "Student", "CS");
+    }
+
+    // startedAt[i]: when registration i began; events carry sequence i
+    std::unique_ptr<std::atomic<int64_t>[]> startedAt(new std::atomic<int64_t>[studentCount]);
+    std::vector<ChangeFeedConsumer> consumers;
+    if (consumerCount > 0) {
+        reg.enableChangeFeed(capacity);
+        for (int k = 0; k < consumerCount; ++k) {
+            consumers.push_back(reg.subscribeChanges());
+        }
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::vector<uint64_t>> latencies(consumerCount);
+    std::vector<uint64_t> maxLag(consumerCount, 0);
+    std::vector<std::thread> threads;
+    for (int k = 0; k < consumerCount; ++k) {
+        threads.emplace_back([&, k] {
+            std::vector<EnrollmentEvent> events;
+            latencies[k].reserve(studentCount);
+            for (;;) {
+                bool finished = done.load(std::memory_order_acquire);
+                maxLag[k] = std::max(maxLag[k], consumers[k].stats().lag);
+                events.clear();
+                consumers[k].poll(events, 4096);
+                int64_t receivedAt = nowNanos();
+                for (const EnrollmentEvent& event : events) {
+                    latencies[k].push_back(receivedAt - startedAt[event.sequence].load(std::memory_order_relaxed));
+                }
+                if (finished && events.empty()) {
+                    break;
+                }
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < studentCount; ++i) {
+        startedAt[i].store(nowNanos(), std::memory_order_relaxed);
+        reg.registerStudent(students[i], "C" + std::to_string(i % courseCount));
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    done.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<uint64_t> all;
+    for (const auto& perConsumer : latencies) {
+        all.insert(all.end(), perConsumer.begin(), perConsumer.end());
+    }
+    std::sort(all.begin(), all.end());
+    ChangeFeedStats stats = reg.getChangeFeedStats();
+    uint64_t lag = consumerCount ? *std::max_element(maxLag.begin(), maxLag.end()) : 0;
+    std::printf("%9d %12.0f %10llu %10llu %10llu %10llu %10llu %8llu\n", consumerCount,
+                studentCount / seconds, static_cast<unsigned long long>(bench::percentile(all, 0.50)),
+                static_cast<unsigned long long>(bench::percentile(all, 0.99)),
+                static_cast<unsigned long long>(bench::percentile(all, 0.999)),
+                static_cast<unsigned long long>(stats.dropped), static_cast<unsigned long long>(lag),
+                static_cast<unsigned long long>(stats.producerWaits));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t studentCount = 200000;
+    int consumerCount = 4;
+    size_t capacity = 65536;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--students")) studentCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--consumers")) consumerCount = std::max(0, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--capacity")) capacity = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    std::printf("students=%zu capacity=%zu\n", studentCount, capacity);
+    std::printf("%9s %12s %10s %10s %10s %10s %10s %8s\n", "consumers", "regs/sec", "p50(ns)",
+                "p99(ns)", "p999(ns)", "dropped", "max lag", "waits");
+    for (int k = 0; k <= consumerCount; k = k ? k * 2 : 1) {
+        runRow(studentCount, k, capacity);
+    }
+    return 0;
+}
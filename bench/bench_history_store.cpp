@@ -0,0 +1,169 @@
+/**
+ * @file bench_history_store.cpp
+ * @brief Query cost of the columnar history store versus row-wise records
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Generates several years of synthetic terms, writes them to a history
+ * store and maps it back. Times three kinds of question on the store and
+ * on the same enrollments kept as a std::vector<HistoryRecord> per term:
+ * - one course in fall terms with CGPA under 6 (the audit example)
+ * - one course over all terms
+ * - CGPA under a threshold over all terms and courses (no zone map helps)
+ * and prints how many terms and blocks each store query skipped.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_history_store
+ * ./build/bench_history_store --years 10 --students 20000 --courses 400
+ * @endcode
+ *
+ * Options: --years N, --students N (per term), --courses N,
+ * --per-student N (courses per student per term), --queries N (queries
+ * per pass), --path FILE.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench/bench_util.h"
+#include "history_store.h"
+
+namespace {
+
+/** @brief One term kept row-wise, the baseline */
+struct RowTerm {
+    int year;                            /**< Year of the term */
+    TermSeason season;                   /**< Season of the term */
+    std::vector<HistoryRecord> records;  /**< Enrollments */
+};
+
+/** @brief Counts baseline matches of @p query by testing every record */
+uint64_t countRows(const std::vector<RowTerm>& terms, const HistoryQuery& query) {
+    uint64_t matched = 0;
+    for (const auto& term : terms) {
+        if (!(query.seasons & HistoryQuery::seasonBit(term.season)) || term.year < query.fromYear ||
+            term.year > query.toYear) {
+            continue;
+        }
+        for (const auto& record : term.records) {
+            matched += (query.courseCode.empty() || record.courseCode == query.courseCode) &&
+                       record.grade >= query.minGrade && record.grade < query.maxGrade &&
+                       record.cgpa >= query.minCgpa && record.cgpa < query.maxCgpa;
+        }
+    }
+    return matched;
+}
+
+/**
+ * @brief Times @p queries row-wise and on the store, printing the store's scan work
+ *
+ * @return false if the two disagree on the number of matches
+ */
+bool runCase(const std::vector<RowTerm>& rowTerms, const HistoryStore& store,
+             const std::vector<HistoryQuery>& queries, const char* rowName, const char* storeName,
+             std::vector<bench::OperationStats>& results) {
+    uint64_t rowMatches = 0;
+    uint64_t storeMatches = 0;
+    HistoryScanStats total;
+    results.push_back(bench::measure(rowName, queries.size(), [&](uint64_t i) {
+        rowMatches += countRows(rowTerms, queries[i]);
+    }));
+    results.push_back(bench::measure(storeName, queries.size(), [&](uint64_t i) {
+        HistoryScanStats scan;
+        storeMatches += store.count(queries[i], &scan);
+        total.termsSkipped += scan.termsSkipped;
+        total.blocksSkipped += scan.blocksSkipped;
+        total.blocksScanned += scan.blocksScanned;
+        total.rowsScanned += scan.rowsScanned;
+    }));
+    double n = static_cast<double>(queries.size());
+    std::printf("%-14s matches rows=%llu store=%llu; per query: terms skipped %.1f, blocks skipped %.1f, "
+                "blocks scanned %.1f, rows scanned %.0f\n",
+                storeName, static_cast<unsigned long long>(rowMatches),
+                static_cast<unsigned long long>(storeMatches), total.termsSkipped / n,
+                total.blocksSkipped / n, total.blocksScanned / n, total.rowsScanned / n);
+    if (rowMatches != storeMatches) {
+        std::printf("MISMATCH\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int years = 10;
+    int studentCount = 20000;
+    int courseCount = 400;
+    int perStudent = 5;
+    int queryCount = 20;
+    std::string path = "/tmp/bench_history_store.crh";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--years")) years = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--students")) studentCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--courses")) courseCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--per-student")) perStudent = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--queries")) queryCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--path")) path = argv[i + 1];
+    }
+
+    // Three terms a year; each term a new intake joins and CGPAs drift
+    const TermSeason seasons[] = {TermSeason::SPRING, TermSeason::SUMMER, TermSeason::FALL};
+    std::mt19937 rng(42);
+    std::normal_distribution<float> cgpaDist(7.0f, 1.2f);
+    std::normal_distribution<float> gradeDist(0.0f, 1.5f);
+    std::vector<RowTerm> rowTerms;
+    HistoryStoreWriter writer;
+    uint64_t rows = 0;
+    for (int year = 2016; year < 2016 + years; ++year) {
+        for (TermSeason season : seasons) {
+            RowTerm term{year, season, {}};
+            int intake = static_cast<int>(rowTerms.size()) * (studentCount / 8);
+            for (int s = 0; s < studentCount; ++s) {
+                std::string studentId = "S" + std::to_string(intake + s);
+                float cgpa = std::min(10.0f, std::max(0.0f, cgpaDist(rng)));
+                for (int k = 0; k < perStudent; ++k) {
+                    float grade = std::min(10.0f, std::max(0.0f, cgpa + gradeDist(rng)));
+                    term.records.push_back(
+                        {studentId, "C" + std::to_string(rng() % courseCount), grade, cgpa});
+                }
+            }
+            writer.addTerm(year, season, term.records);
+            rows += term.records.size();
+            rowTerms.push_back(std::move(term));
+        }
+    }
+    writer.write(path);
+    HistoryStore store(path);
+    std::printf("terms=%zu rows=%llu blocks of %u rows\n", store.termCount(),
+                static_cast<unsigned long long>(store.rowCount()), HistoryStore::kBlockRows);
+
+    // Each pass asks the same question of several courses or thresholds
+    std::vector<HistoryQuery> audit(queryCount);
+    std::vector<HistoryQuery> course(queryCount);
+    std::vector<HistoryQuery> lowCgpa(queryCount);
+    for (int i = 0; i < queryCount; ++i) {
+        audit[i].courseCode = course[i].courseCode = "C" + std::to_string(i % courseCount);
+        audit[i].seasons = HistoryQuery::seasonBit(TermSeason::FALL);
+        audit[i].maxCgpa = 6.0f;
+        lowCgpa[i].maxCgpa = 5.0f + 0.1f * (i % 20);
+    }
+
+    std::vector<bench::OperationStats> results;
+    if (!runCase(rowTerms, store, audit, "rows audit", "store audit", results) ||
+        !runCase(rowTerms, store, course, "rows course", "store course", results) ||
+        !runCase(rowTerms, store, lowCgpa, "rows cgpa<x", "store cgpa<x", results)) {
+        return 1;
+    }
+
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+    std::remove(path.c_str());
+    return rows == 0;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file bench_journal.cpp
+ * @brief Durable registration acknowledgements: per-change fsync versus group commit
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Clients loop over register-and-withdraw against a Zipf-skewed catalog
+ * with a journal enabled, and a change counts as acknowledged only once
+ * it is on disk. Passes:
+ * - "sync fsync": SYNCHRONOUS journal, write and fdatasync inside every
+ *   change (the blocking path); --threads client threads
+ * - "writer thread": WRITER_THREAD journal, each client thread blocks in
+ *   waitDurable after its call
+ * - "io_uring": IO_URING journal, same blocking clients
+ * - "io_uring async": IO_URING journal with --clients coroutines on an
+ *   executor of --workers threads; each acknowledgement comes from the
+ *   journal's completion queue
+ * --in-flight sets how many batches io_uring may have in flight.
+ * Latency is per call, from issue to durable acknowledgement. Journals
+ * are created in --dir and removed after each pass.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_journal
+ * ./build/bench_journal --threads 64 --clients 1024 --workers 4 --requests 20000 --in-flight 4 --dir /tmp
+ * @endcode
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <latch>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "bench/bench_util.h"
+#include "bench/workload.h"
+#include "registration_async.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Coroutine that starts at once and frees itself when it finishes */
+struct DetachedClient {
+    struct promise_type {
+        DetachedClient get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/** @brief What one client does and what it measured */
+struct ClientPlan {
+    std::vector<Student*> students;  /**< Students only this client registers */
+    std::vector<int> courses;        /**< Course index of each registration */
+    std::vector<uint64_t> latencies; /**< Nanoseconds per acknowledged call */
+};
+
+/** @brief Returns nanoseconds since @p start */
+uint64_t elapsedNanos(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/** @brief Runs one client's plan, blocking until each call's changes are durable */
+void runBlocking(CourseRegistration& reg, const std::vector<bench::CourseSpec>& catalog,
+                 ClientPlan& plan) {
+    RegistrationJournal& journal = reg.getJournal();
+    for (size_t i = 0; i < plan.courses.size(); ++i) {
+        Student& student = *plan.students[i % plan.students.size()];
+        const std::string& code = catalog[plan.courses[i]].code;
+        Clock::time_point start = Clock::now();
+        RegistrationStatus status = reg.tryRegisterStudent(student, code);
+        journal.sync();
+        plan.latencies.push_back(elapsedNanos(start));
+        if (status == RegistrationStatus::SUCCESS) {
+            start = Clock::now();
+            reg.withdrawStudent(student.getStudentId(), code);
+            journal.sync();
+            plan.latencies.push_back(elapsedNanos(start));
+        }
+    }
+}
+
+/** @brief Runs one client's plan as a coroutine acknowledged by the journal */
+DetachedClient runCoroutine(CourseRegistration& reg, const std::vector<bench::CourseSpec>& catalog,
+                            ClientPlan& plan, std::latch& finished) {
+    for (size_t i = 0; i < plan.courses.size(); ++i) {
+        Student& student = *plan.students[i % plan.students.size()];
+        const std::string& code = catalog[plan.courses[i]].code;
+        Clock::time_point start = Clock::now();
+        RegistrationStatus status = co_await registerStudentAsync(reg, student, code);
+        plan.latencies.push_back(elapsedNanos(start));
+        if (status == RegistrationStatus::SUCCESS) {
+            start = Clock::now();
+            co_await withdrawStudentAsync(reg, student.getStudentId(), code);
+            plan.latencies.push_back(elapsedNanos(start));
+        }
+    }
+    finished.count_down();
+}
+
+/** @brief Adds the catalog to an engine */
+void addCatalog(CourseRegistration& reg, const std::vector<bench::CourseSpec>& catalog) {
+    const time_t deadline = std::time(nullptr) + 30 * 86400;
+    for (const auto& course : catalog) {
+        reg.addCourse(course.code, course.name, course.capacity, {}, deadline);
+    }
+}
+
+/** @brief Splits students and requests over the clients */
+std::vector<ClientPlan> makePlans(std::vector<Student>& students, size_t clients, uint64_t requests,
+                                  const bench::ZipfSampler& zipf, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<ClientPlan> plans(clients);
+    for (size_t s = 0; s < students.size(); ++s) {
+        plans[s % clients].students.push_back(&students[s]);
+    }
+    for (uint64_t r = 0; r < requests; ++r) {
+        plans[r % clients].courses.push_back(zipf(rng));
+    }
+    for (ClientPlan& plan : plans) {
+        plan.latencies.reserve(2 * plan.courses.size());
+    }
+    return plans;
+}
+
+/** @brief Summarizes the latencies of every client */
+bench::OperationStats summarize(const char* name, std::vector<ClientPlan>& plans, double seconds) {
+    std::vector<uint64_t> samples;
+    for (ClientPlan& plan : plans) {
+        samples.insert(samples.end(), plan.latencies.begin(), plan.latencies.end());
+    }
+    std::sort(samples.begin(), samples.end());
+    bench::OperationStats stats;
+    stats.name = name;
+    stats.operations = samples.size();
+    stats.opsPerSecond = seconds > 0 ? samples.size() / seconds : 0.0;
+    stats.p50Nanos = bench::percentile(samples, 0.50);
+    stats.p99Nanos = bench::percentile(samples, 0.99);
+    stats.p999Nanos = bench::percentile(samples, 0.999);
+    stats.allocsPerOp = 0.0;
+    return stats;
+}
+
+/** @brief Prints a pass's row and how many records each sync covered */
+void report(const char* name, std::vector<ClientPlan>& plans, double seconds,
+            const JournalStats& journal) {
+    bench::printStats(summarize(name, plans, seconds));
+    std::printf("    %llu records, %llu syncs, %.1f records per sync\n",
+                static_cast<unsigned long long>(journal.records),
+                static_cast<unsigned long long>(journal.syncs),
+                journal.syncs ? static_cast<double>(journal.records) / journal.syncs : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::WorkloadConfig config;
+    config.demandSkew = 1.1;
+    bench::parseWorkloadArgs(argc, argv, config);
+    size_t threads = 64;
+    size_t clients = 1024;
+    unsigned workers = 4;
+    uint64_t requests = 20000;
+    unsigned inFlight = JournalOptions().maxInFlight;
+    std::string dir = "/tmp";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--threads")) threads = std::atol(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--clients")) clients = std::atol(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--workers")) workers = std::atoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--requests")) requests = std::atoll(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--in-flight")) inFlight = std::atoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--dir")) dir = argv[i + 1];
+    }
+    std::vector<bench::CourseSpec> catalog = bench::generateCatalog(config);
+    bench::ZipfSampler zipf(config.courseCount, config.demandSkew);
+    threads = std::min<size_t>(threads, config.studentCount);
+    clients = std::min<size_t>(clients, config.studentCount);
+    const std::string path = dir + "/bench_journal." + std::to_string(::getpid());
+
+    std::printf("%llu registrations, %d courses, journal in %s\n\n",
+                static_cast<unsigned long long>(requests), config.courseCount, dir.c_str());
+    bench::printHeader();
+
+    struct BlockingPass {
+        const char* name;
+        JournalBackend backend;
+    };
+    const BlockingPass blockingPasses[] = {
+        {"sync fsync", JournalBackend::SYNCHRONOUS},
+        {"writer thread", JournalBackend::WRITER_THREAD},
+        {"io_uring", JournalBackend::IO_URING},
+    };
+    for (const BlockingPass& pass : blockingPasses) {
+        std::vector<Student> students = bench::generateStudents(config, catalog);
+        std::vector<ClientPlan> plans = makePlans(students, threads, requests, zipf, config.seed);
+        JournalStats journal;
+        double seconds;
+        {
+            CourseRegistration reg;
+            addCatalog(reg, catalog);
+            JournalOptions options;
+            options.backend = pass.backend;
+            options.maxInFlight = inFlight;
+            try {
+                reg.enableJournal(path, options);
+            } catch (const std::runtime_error& e) {
+                std::printf("%-24s skipped: %s\n", pass.name, e.what());
+                continue;
+            }
+            Clock::time_point start = Clock::now();
+            std::vector<std::thread> running;
+            running.reserve(threads);
+            for (ClientPlan& plan : plans) {
+                running.emplace_back(runBlocking, std::ref(reg), std::cref(catalog), std::ref(plan));
+            }
+            for (std::thread& thread : running) {
+                thread.join();
+            }
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            journal = reg.getJournal().stats();
+        }
+        ::unlink(path.c_str());
+        report(pass.name, plans, seconds, journal);
+    }
+
+    {
+        std::vector<Student> students = bench::generateStudents(config, catalog);
+        std::vector<ClientPlan> plans = makePlans(students, clients, requests, zipf, config.seed);
+        std::latch finished(static_cast<std::ptrdiff_t>(clients));
+        JournalStats journal;
+        double seconds = 0;
+        bool ran = false;
+        {
+            // Declared after what the coroutines touch, so its executor is joined first
+            CourseRegistration reg;
+            addCatalog(reg, catalog);
+            JournalOptions options;
+            options.backend = JournalBackend::IO_URING;
+            options.maxInFlight = inFlight;
+            try {
+                reg.enableJournal(path, options);
+                ran = true;
+            } catch (const std::runtime_error& e) {
+                std::printf("%-24s skipped: %s\n", "io_uring async", e.what());
+            }
+            if (ran) {
+                reg.enableExecutor(workers);
+                Clock::time_point start = Clock::now();
+                for (ClientPlan& plan : plans) {
+                    runCoroutine(reg, catalog, plan, finished);
+                }
+                finished.wait();
+                seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                journal = reg.getJournal().stats();
+            }
+        }
+        ::unlink(path.c_str());
+        if (ran) {
+            report("io_uring async", plans, seconds, journal);
+        }
+    }
+    std::printf("\nblocking passes: %zu client threads; async: %zu coroutines on %u workers\n",
+                threads, clients, workers);
+    return 0;
+}
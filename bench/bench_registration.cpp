@@ -0,0 +1,182 @@
+/**
+ * @file bench_registration.cpp
+ * @brief Benchmark suite for the public CourseRegistration operations
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Builds a synthetic catalog and student population (see workload.h) and
+ * reports ops/sec, p50/p99/p999 latency and heap allocations per call for
+ * addCourse, registerStudent, prerequisite validation, getEnrollmentCount,
+ * isCourseFull, availability board reads and withdrawStudent, then
+ * registerStudent behind the admission layer, retries it answers from
+ * its idempotency cache and requests refused before their registration
+ * window opens.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_registration
+ * ./build/bench_registration
+ * @endcode
+ *
+ * Workload options (all optional): --courses N --depth D --capacity C
+ * --capacity-skew S --demand-skew Z --students N --per-student K --seed X
+ *
+ * Configure with -DCOURSE_REGISTRATION_METRICS=OFF to measure the engine
+ * without its built-in metrics.
+ *
+ * `--record FILE` additionally writes every call to a registration trace
+ * for replay_trace; timings then include the cost of recording.
+ */
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench/bench_util.h"
+#include "bench/workload.h"
+#include "course_registration.h"
+#include "registration_checks.h"
+#include "registration_trace.h"
+
+int main(int argc, char** argv) {
+    bench::WorkloadConfig config;
+    bench::parseWorkloadArgs(argc, argv, config);
+
+    std::printf("courses=%d depth=%d capacity=%d capacity-skew=%.2f demand-skew=%.2f "
+                "students=%d per-student=%d seed=%u\n",
+                config.courseCount, config.prereqDepth, config.baseCapacity,
+                config.capacitySkew, config.demandSkew, config.studentCount,
+                config.coursesPerStudent, config.seed);
+
+    std::vector<bench::CourseSpec> catalog = bench::generateCatalog(config);
+    std::vector<Student> students = bench::generateStudents(config, catalog);
+
+    // Pre-draw every (student, course) request so sampling is not timed
+    std::mt19937 rng(config.seed + 2);
+    bench::ZipfSampler demand(config.courseCount, config.demandSkew);
+    uint64_t requestCount = static_cast<uint64_t>(config.studentCount) * config.coursesPerStudent;
+    std::vector<int> requestCourse(requestCount);
+    for (auto& course : requestCourse) {
+        course = demand(rng);
+    }
+    auto studentOf = [&](uint64_t i) -> Student& {
+        return students[i / config.coursesPerStudent];
+    };
+
+    // A fixed clock keeps every run independent of the wall time
+    ManualClock clock(1700000000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    std::ofstream traceFile;
+    std::unique_ptr<TraceRecorder> recorder;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (!std::strcmp(argv[i], "--record")) {
+            traceFile.open(argv[i + 1], std::ios::binary);
+            recorder.reset(new TraceRecorder(traceFile));
+            reg.setTraceRecorder(recorder.get());
+        }
+    }
+
+    time_t deadline = clock.now() + 86400;
+    std::vector<bench::OperationStats> results;
+
+    results.push_back(bench::measure("addCourse", catalog.size(), [&](uint64_t i) {
+        const bench::CourseSpec& course = catalog[i];
+        reg.addCourse(course.code, course.name, course.capacity, course.prerequisites, deadline);
+    }));
+
+    results.push_back(bench::measure("validatePrerequisites", requestCount, [&](uint64_t i) {
+        volatile bool met = hasPrerequisites(catalog[requestCourse[i]].prerequisites, studentOf(i));
+        (void)met;
+    }));
+
+    std::vector<uint64_t> statusCounts(kStatusCount);
+    results.push_back(bench::measure("registerStudent", requestCount, [&](uint64_t i) {
+        RegistrationStatus status = reg.registerStudent(studentOf(i), catalog[requestCourse[i]].code);
+        ++statusCounts[static_cast<size_t>(status)];
+    }));
+
+    results.push_back(bench::measure("getEnrollmentCount", requestCount, [&](uint64_t i) {
+        volatile int count = reg.getEnrollmentCount(catalog[requestCourse[i]].code);
+        (void)count;
+    }));
+
+    results.push_back(bench::measure("isCourseFull", requestCount, [&](uint64_t i) {
+        volatile bool full = reg.isCourseFull(catalog[requestCourse[i]].code);
+        (void)full;
+    }));
+
+    std::vector<CourseHandle> handles;
+    for (const auto& course : catalog) {
+        handles.push_back(reg.getCourseHandle(course.code).value);
+    }
+    const AvailabilityBoard& board = reg.getAvailabilityBoard();
+    results.push_back(bench::measure("board.read", requestCount, [&](uint64_t i) {
+        volatile int seatsLeft = board.read(handles[requestCourse[i]]).seatsLeft;
+        (void)seatsLeft;
+    }));
+
+    results.push_back(bench::measure("withdrawStudent", requestCount, [&](uint64_t i) {
+        reg.withdrawStudent(studentOf(i).getStudentId(), catalog[requestCourse[i]].code);
+    }));
+
+    // Same requests again through the admission layer, then retried
+    reg.setAdmissionPolicy({1000, 1000, 60});
+    results.push_back(bench::measure("registerStudent+admit", requestCount, [&](uint64_t i) {
+        reg.registerStudent(studentOf(i), catalog[requestCourse[i]].code);
+    }));
+    results.push_back(bench::measure("registerStudent retry", requestCount, [&](uint64_t i) {
+        reg.registerStudent(studentOf(i), catalog[requestCourse[i]].code);
+    }));
+    AdmissionStats admission = reg.getAdmissionStats();
+
+    // Every cohort's window opens tomorrow: the cost of refusing early requests
+    std::vector<RegistrationWindow> windows;
+    for (AcademicStanding standing : {AcademicStanding::EXCELLENT, AcademicStanding::GOOD,
+                                      AcademicStanding::SATISFACTORY, AcademicStanding::PROBATION}) {
+        windows.push_back({1, INT_MAX, standing, clock.now() + 86400});
+    }
+    reg.setRegistrationWindows(windows);
+    results.push_back(bench::measure("registerStudent early", requestCount, [&](uint64_t i) {
+        reg.registerStudent(studentOf(i), catalog[requestCourse[i]].code);
+    }));
+
+    std::printf("registerStudent outcomes: success=%llu full=%llu prereq=%llu enrolled=%llu\n",
+                static_cast<unsigned long long>(statusCounts[0]),
+                static_cast<unsigned long long>(statusCounts[1]),
+                static_cast<unsigned long long>(statusCounts[2]),
+                static_cast<unsigned long long>(statusCounts[4]));
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+
+    std::printf("admission: admitted=%llu replayed=%llu rate-limited=%llu\n",
+                static_cast<unsigned long long>(admission.admitted),
+                static_cast<unsigned long long>(admission.replayed),
+                static_cast<unsigned long long>(admission.rateLimited));
+    std::printf("most COURSE_FULL attempts (demand sketch estimates):\n");
+    for (const CourseDemand& demand : reg.getTopDemand(RegistrationStatus::COURSE_FULL, 5)) {
+        std::printf("  %-10s %llu\n", demand.courseCode.c_str(),
+                    static_cast<unsigned long long>(demand.attempts));
+    }
+
+    if (RegistrationMetrics::enabled) {
+        MetricsSnapshot metrics = reg.getMetrics();
+        std::printf("engine-side latency (metrics histograms):\n");
+        for (size_t op = 0; op < metrics.latency.size(); ++op) {
+            const LatencyHistogram& histogram = metrics.latency[op];
+            std::printf("  %-22s n=%-9llu mean=%7.0fns p50<=%llu p99<=%llu p999<=%llu\n",
+                        metricOperationName(static_cast<MetricOperation>(op)),
+                        static_cast<unsigned long long>(histogram.count), histogram.mean(),
+                        static_cast<unsigned long long>(histogram.percentile(0.50)),
+                        static_cast<unsigned long long>(histogram.percentile(0.99)),
+                        static_cast<unsigned long long>(histogram.percentile(0.999)));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file bench_roster_archive.cpp
+ * @brief Memory and query cost of archived rosters versus live rosters
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Runs several terms of synthetic registration (see workload.h), keeps a
+ * copy of every term's rosters as std::set<std::string> and archives every
+ * term into one shared StudentDirectory. Reports the heap used by each
+ * form, then times membership tests and full-roster iteration on both.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_roster_archive
+ * ./build/bench_roster_archive --terms 4 --students 50000
+ * @endcode
+ *
+ * Accepts the workload options of bench_registration plus --terms N.
+ * Heap use is read from glibc's mallinfo2().
+ */
+
+#include <malloc.h>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "bench/bench_util.h"
+#include "bench/workload.h"
+#include "course_registration.h"
+#include "roster_snapshot.h"
+
+namespace {
+
+/** @brief One archived-enrollment question */
+struct Lookup {
+    int term;               /**< Term asked about */
+    std::string studentId;  /**< Student asked about */
+    std::string courseCode; /**< Course asked about */
+};
+
+/** @brief Bytes currently allocated from the heap */
+size_t heapInUse() {
+    return mallinfo2().uordblks;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::WorkloadConfig config;
+    config.prereqDepth = 0;
+    config.baseCapacity = 2000;
+    bench::parseWorkloadArgs(argc, argv, config);
+    int termCount = 4;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--terms")) termCount = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    std::vector<bench::CourseSpec> catalog = bench::generateCatalog(config);
+    std::vector<Student> population = bench::generateStudents(config, catalog);
+    bench::ZipfSampler demand(config.courseCount, config.demandSkew);
+
+    using LiveTerm = std::map<std::string, std::set<std::string>>;
+    std::vector<LiveTerm> liveTerms(termCount);
+    std::vector<ArchivedTerm> archivedTerms;
+    StudentDirectory directory;
+    size_t liveBytes = 0;
+    size_t archivedBytes = 0;
+    uint64_t enrollments = 0;
+
+    for (int term = 0; term < termCount; ++term) {
+        ManualClock clock(1700000000);
+        CourseRegistration reg;
+        reg.setClock(&clock);
+        for (const auto& course : catalog) {
+            reg.addCourse(course.code, course.name, course.capacity, course.prerequisites,
+                          clock.now() + 86400);
+        }
+        std::vector<Student> students = population;
+        std::mt19937 rng(config.seed + 100 + term);
+        for (auto& student : students) {
+            for (int k = 0; k < config.coursesPerStudent; ++k) {
+                reg.registerStudent(student, catalog[demand(rng)].code);
+            }
+        }
+
+        size_t before = heapInUse();
+        reg.openSnapshot().forEachCourse([&](const std::string& code, const std::set<std::string>& roster) {
+            liveTerms[term].emplace(code, roster);
+            enrollments += roster.size();
+        });
+        liveBytes += heapInUse() - before;
+
+        before = heapInUse();
+        archivedTerms.push_back(reg.archiveTerm(directory));
+        archivedBytes += heapInUse() - before;
+    }
+
+    std::printf("terms=%d courses=%d students=%d enrollments=%llu\n", termCount, config.courseCount,
+                config.studentCount, static_cast<unsigned long long>(enrollments));
+    std::printf("live rosters:     %12zu bytes (%.1f per enrollment)\n", liveBytes,
+                static_cast<double>(liveBytes) / enrollments);
+    std::printf("archived rosters: %12zu bytes (%.1f per enrollment, directory included)\n",
+                archivedBytes, static_cast<double>(archivedBytes) / enrollments);
+    size_t rosterBytes = 0;
+    for (const auto& term : archivedTerms) {
+        rosterBytes += term.memoryBytes();
+    }
+    std::printf("  of which rosters: %10zu bytes (%.2f per enrollment)\n", rosterBytes,
+                static_cast<double>(rosterBytes) / enrollments);
+
+    // Random (term, student, course) lookups, about half of them hits
+    const uint64_t lookups = 1000000;
+    std::mt19937 rng(config.seed + 7);
+    std::vector<Lookup> questions(lookups);
+    for (auto& question : questions) {
+        question.term = static_cast<int>(rng() % termCount);
+        const LiveTerm& live = liveTerms[question.term];
+        auto courseIt = std::next(live.begin(), rng() % live.size());
+        question.courseCode = courseIt->first;
+        if (rng() % 2 && !courseIt->second.empty()) {
+            question.studentId = *std::next(courseIt->second.begin(), rng() % courseIt->second.size());
+        } else {
+            question.studentId = population[rng() % population.size()].getStudentId();
+        }
+    }
+
+    std::vector<bench::OperationStats> results;
+    uint64_t liveHits = 0;
+    uint64_t archivedHits = 0;
+    results.push_back(bench::measure("set contains", lookups, [&](uint64_t i) {
+        const Lookup& question = questions[i];
+        liveHits += liveTerms[question.term].at(question.courseCode).count(question.studentId);
+    }));
+    results.push_back(bench::measure("archive wasEnrolled", lookups, [&](uint64_t i) {
+        const Lookup& question = questions[i];
+        archivedHits += archivedTerms[question.term].wasEnrolled(question.studentId, question.courseCode);
+    }));
+
+    uint64_t visited = 0;
+    results.push_back(bench::measure("set iterate course", catalog.size(), [&](uint64_t i) {
+        for (const auto& studentId : liveTerms[0].at(catalog[i].code)) {
+            visited += studentId.size();
+        }
+    }));
+    results.push_back(bench::measure("archive iterate course", catalog.size(), [&](uint64_t i) {
+        archivedTerms[0].forEachStudent(catalog[i].code, [&](const std::string& studentId) {
+            visited += studentId.size();
+        });
+    }));
+    results.push_back(bench::measure("archive iterate handles", catalog.size(), [&](uint64_t i) {
+        archivedTerms[0].roster(catalog[i].code)->forEach([&](StudentHandle handle) { visited += handle; });
+    }));
+
+    std::printf("hits: set=%llu archive=%llu\n", static_cast<unsigned long long>(liveHits),
+                static_cast<unsigned long long>(archivedHits));
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+    return visited == 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file bench_seat_holds.cpp
+ * @brief Timed seat holds: register-withdraw with a cron scan versus holdSeat
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Simulates a registration rush one second at a time. Every second a
+ * number of students put a seat on hold for 5 to 15 minutes, and lapsed
+ * holds are released:
+ * - "cron": registerStudent stands in for the hold, and a job that runs
+ *   every second walks every course's pending holds and withdraws the
+ *   lapsed ones (the current front-end workaround)
+ * - "wheel": CourseRegistration::holdSeat, then expireHolds() after the
+ *   clock moves, which only touches holds whose timers fired
+ * One timed operation is one simulated second: its new holds plus the
+ * expiry pass.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_seat_holds
+ * ./build/bench_seat_holds --courses 2000 --students 100000 --holds 200 --seconds 3600
+ * @endcode
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bench/bench_util.h"
+#include "course_registration.h"
+
+namespace {
+
+/** @brief One hold request of the simulation */
+struct HoldRequest {
+    size_t student; /**< Index into the student pool */
+    size_t course;  /**< Index into the catalog */
+    time_t ttl;     /**< Seconds the hold lasts */
+};
+
+/** @brief Adds @p courseCount courses of @p capacity seats to a fresh engine */
+void addCatalog(CourseRegistration& reg, const ManualClock& clock, size_t courseCount, int capacity) {
+    for (size_t c = 0; c < courseCount; ++c) {
+        reg.addCourse("C" + std::to_string(c), "Course " + std::to_string(c), capacity, {},
+                      clock.now() + 30 * 86400);
+    }
+}
+
+/** @brief Returns the seats in use (enrolled and held) summed over the board */
+int seatsInUse(const CourseRegistration& reg) {
+    const AvailabilityBoard& board = reg.getAvailabilityBoard();
+    int total = 0;
+    for (CourseHandle handle = 0; handle < board.size(); ++handle) {
+        SeatAvailability seats = board.read(handle);
+        total += seats.enrolled + seats.held;
+    }
+    return total;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t courseCount = 2000;
+    size_t studentCount = 100000;
+    int holdsPerSecond = 200;
+    int seconds = 3600;
+    int capacity = 60;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--courses")) courseCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--students")) studentCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--holds")) holdsPerSecond = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--seconds")) seconds = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--capacity")) capacity = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    std::mt19937 rng(42);
+    std::vector<HoldRequest> requests(static_cast<size_t>(holdsPerSecond) * seconds);
+    for (auto& request : requests) {
+        request = {rng() % studentCount, rng() % courseCount, static_cast<time_t>(300 + rng() % 601)};
+    }
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (size_t s = 0; s < studentCount; ++s) {
+        students.emplace_back("S" + std::to_string(1000000 + s), "Student " + std::to_string(s), "CSE");
+    }
+    std::vector<std::string> codes(courseCount);
+    for (size_t c = 0; c < courseCount; ++c) {
+        codes[c] = "C" + std::to_string(c);
+    }
+
+    std::vector<bench::OperationStats> results;
+
+    ManualClock cronClock(1700000000);
+    CourseRegistration cronReg;
+    cronReg.setClock(&cronClock);
+    addCatalog(cronReg, cronClock, courseCount, capacity);
+    std::vector<std::vector<std::pair<std::string, time_t>>> pending(courseCount);
+    std::vector<Student> cronStudents = students;
+    results.push_back(bench::measure("cron second", seconds, [&](uint64_t second) {
+        for (size_t r = second * holdsPerSecond; r < (second + 1) * holdsPerSecond; ++r) {
+            const HoldRequest& request = requests[r];
+            Student& student = cronStudents[request.student];
+            auto& holds = pending[request.course];
+            const time_t expiresAt = cronClock.now() + request.ttl;
+            RegistrationStatus status = cronReg.registerStudent(student, codes[request.course]);
+            if (status == RegistrationStatus::SUCCESS) {
+                holds.emplace_back(student.getStudentId(), expiresAt);
+            } else if (status == RegistrationStatus::ALREADY_ENROLLED) {
+                // Holding again renews the hold, as holdSeat does
+                for (auto& hold : holds) {
+                    if (hold.first == student.getStudentId()) {
+                        hold.second = expiresAt;
+                    }
+                }
+            }
+        }
+        cronClock.advance(1);
+        const time_t now = cronClock.now();
+        for (size_t c = 0; c < courseCount; ++c) {
+            auto& holds = pending[c];
+            for (size_t h = 0; h < holds.size();) {
+                if (holds[h].second <= now) {
+                    cronReg.withdrawStudent(holds[h].first, codes[c]);
+                    holds[h] = std::move(holds.back());
+                    holds.pop_back();
+                } else {
+                    ++h;
+                }
+            }
+        }
+    }));
+
+    ManualClock wheelClock(1700000000);
+    CourseRegistration wheelReg;
+    wheelReg.setClock(&wheelClock);
+    addCatalog(wheelReg, wheelClock, courseCount, capacity);
+    results.push_back(bench::measure("wheel second", seconds, [&](uint64_t second) {
+        for (size_t r = second * holdsPerSecond; r < (second + 1) * holdsPerSecond; ++r) {
+            const HoldRequest& request = requests[r];
+            wheelReg.holdSeat(students[request.student], codes[request.course], request.ttl);
+        }
+        wheelClock.advance(1);
+        wheelReg.expireHolds();
+    }));
+
+    const int cronSeats = seatsInUse(cronReg);
+    const int wheelSeats = seatsInUse(wheelReg);
+    std::printf("courses=%zu students=%zu holds/s=%d seconds=%d seats in use: cron=%d wheel=%d\n",
+                courseCount, studentCount, holdsPerSecond, seconds, cronSeats, wheelSeats);
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+    return cronSeats != wheelSeats;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file bench_sections.cpp
+ * @brief Contended registration into one pool versus sections of a course
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * N threads register distinct students for the same intro course, set up
+ * two ways with the same total seats:
+ * - pool: one course of S x C seats, all behind one roster lock
+ * - sections: a parent course with S sections of C seats, registered by
+ *   the parent code so the engine picks the least-loaded section
+ *
+ * Reports registrations/sec, latency percentiles and, for sections, the
+ * spread between the fullest and emptiest section.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_sections
+ * ./build/bench_sections --threads 8 --sections 20 --capacity 500
+ * @endcode
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench/bench_util.h"
+#include "course_registration.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Registers every student for "INTRO" and prints one result row */
+void runMode(const char* mode, bool sectioned, int sections, int capacity, unsigned threadCount) {
+    ManualClock clock(1700000000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    if (sectioned) {
+        reg.addCourse("INTRO", "Intro", 0, {}, clock.now() + 86400);
+        for (int s = 0; s < sections; ++s) {
+            reg.addSection("INTRO", "INTRO-" + std::to_string(s), capacity);
+        }
+    } else {
+        reg.addCourse("INTRO", "Intro", sections * capacity, {}, clock.now() + 86400);
+    }
+
+    size_t studentCount = static_cast<size_t>(sections) * capacity;
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        students.emplace_back("S" + std::to_string(i), "Student", "CS");
+    }
+
+    std::vector<std::vector<uint64_t>> latencies(threadCount);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (size_t i = t; i < studentCount; i += threadCount) {
+                auto start = Clock::now();
+                reg.registerStudent(students[i], "INTRO");
+                latencies[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           Clock::now() - start).count());
+            }
+        });
+    }
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<uint64_t> all;
+    for (const auto& perThread : latencies) {
+        all.insert(all.end(), perThread.begin(), perThread.end());
+    }
+    std::sort(all.begin(), all.end());
+    int spread = 0;
+    if (sectioned) {
+        int least = capacity;
+        int most = 0;
+        for (int s = 0; s < sections; ++s) {
+            int enrolled = reg.getEnrollmentCount("INTRO-" + std::to_string(s));
+            least = std::min(least, enrolled);
+            most = std::max(most, enrolled);
+        }
+        spread = most - least;
+    }
+    std::printf("%-10s %8u %12.0f %9llu %9llu %9llu %9d %8d\n", mode, threadCount, all.size() / seconds,
+                static_cast<unsigned long long>(bench::percentile(all, 0.50)),
+                static_cast<unsigned long long>(bench::percentile(all, 0.99)),
+                static_cast<unsigned long long>(bench::percentile(all, 0.999)),
+                reg.getEnrollmentCount("INTRO"), spread);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    int sections = 20;
+    int capacity = 500;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--threads")) threadCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--sections")) sections = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--capacity")) capacity = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    std::printf("sections=%d capacity=%d (pool capacity %d)\n", sections, capacity, sections * capacity);
+    std::printf("%-10s %8s %12s %9s %9s %9s %9s %8s\n", "mode", "threads", "regs/sec",
+                "p50(ns)", "p99(ns)", "p999(ns)", "enrolled", "spread");
+    runMode("pool", false, sections, capacity, threadCount);
+    runMode("sections", true, sections, capacity, threadCount);
+    return 0;
+}
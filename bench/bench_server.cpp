@@ -0,0 +1,305 @@
+/**
+ * @file bench_server.cpp
+ * @brief Load generator for the binary-protocol registration server
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Opens N connections and drives each from its own thread with a mix of
+ * REGISTER, WITHDRAW and QUERY requests over the bench_registration
+ * workload, keeping up to D requests in flight per connection: every
+ * batch of responses read is answered with one send of as many new
+ * requests. Each pass is run with D = 1 (one round trip per request) and
+ * with the requested depth, and reports requests/sec and per-request
+ * latency, measured from the send of a request to the read that returned
+ * its response.
+ *
+ * By default the server runs in this process on both a Unix socket and
+ * 127.0.0.1; --transport picks which one the clients use. With --unix
+ * PATH or --tcp HOST:PORT the clients connect to a serve_registration
+ * started with the same workload options instead.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_server
+ * ./build/bench_server --connections 4 --depth 64 --requests 200000 --server-threads 2 --transport unix
+ * ./build/bench_server --tcp 127.0.0.1:7070 --connections 8 --depth 64
+ * @endcode
+ *
+ * Other options: --query-share P (percent of QUERY requests, default 50;
+ * the rest are 80% REGISTER, 20% WITHDRAW) and the workload options of
+ * bench_registration.
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "bench/bench_util.h"
+#include "bench/workload.h"
+#include "registration_server.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Where the clients connect */
+struct Target {
+    std::string unixPath; /**< Unix socket path, or empty for TCP */
+    std::string host;     /**< IPv4 address for TCP */
+    uint16_t port = 0;    /**< TCP port */
+};
+
+/** @brief Requests of one connection, encoded back to back */
+struct RequestStream {
+    std::string bytes;           /**< Encoded frames */
+    std::vector<size_t> offsets; /**< Start of frame i; offsets.back() is bytes.size() */
+};
+
+/** @brief Totals gathered by one client connection */
+struct ConnectionResult {
+    std::vector<uint64_t> latencies; /**< Per-request latency in nanoseconds */
+    uint64_t unexpected = 0;         /**< Out-of-order tags or protocol error statuses */
+    uint64_t sends = 0;              /**< send() calls */
+};
+
+/** @brief Opens a blocking connection to the target */
+int connectTo(const Target& target) {
+    int fd;
+    if (!target.unixPath.empty()) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, target.unixPath.c_str(), sizeof(address.sun_path) - 1);
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            throw std::runtime_error("Cannot connect to " + target.unixPath);
+        }
+    } else {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(target.port);
+        ::inet_pton(AF_INET, target.host.c_str(), &address.sin_addr);
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            throw std::runtime_error("Cannot connect to " + target.host + ":" + std::to_string(target.port));
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+/** @brief Sends every byte of a range, retrying short writes */
+void sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (written <= 0) {
+            throw std::runtime_error("Connection lost");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+/** @brief Runs one connection's requests with up to @p depth in flight */
+void drive(const Target& target, const RequestStream& stream, size_t depth, ConnectionResult& result) {
+    const size_t total = stream.offsets.size() - 1;
+    int fd = connectTo(target);
+    std::vector<Clock::time_point> sentAt(depth);
+    result.latencies.reserve(total);
+    size_t sent = 0;
+    size_t received = 0;
+    auto sendUpTo = [&](size_t limit) {
+        if (limit <= sent) {
+            return;
+        }
+        const size_t from = sent;
+        const Clock::time_point now = Clock::now();
+        for (; sent < limit; ++sent) {
+            sentAt[sent % depth] = now;
+        }
+        sendAll(fd, stream.bytes.data() + stream.offsets[from], stream.offsets[sent] - stream.offsets[from]);
+        ++result.sends;
+    };
+
+    sendUpTo(std::min(depth, total));
+    std::string buffer;
+    std::vector<char> chunk(64 * 1024);
+    while (received < total) {
+        ssize_t got = ::recv(fd, chunk.data(), chunk.size(), 0);
+        if (got <= 0) {
+            throw std::runtime_error("Connection lost");
+        }
+        const Clock::time_point now = Clock::now();
+        buffer.append(chunk.data(), static_cast<size_t>(got));
+        size_t offset = 0;
+        for (; buffer.size() - offset >= kResponseSize; offset += kResponseSize) {
+            WireResponse response = decodeResponse(buffer.data() + offset);
+            if (response.tag != received || response.status >= kStatusUnknownStudent) {
+                ++result.unexpected;
+            }
+            result.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           now - sentAt[received % depth]).count());
+            ++received;
+        }
+        buffer.erase(0, offset);
+        sendUpTo(std::min(received + depth, total));
+    }
+    ::close(fd);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::WorkloadConfig config;
+    bench::parseWorkloadArgs(argc, argv, config);
+    unsigned connections = 4;
+    size_t depth = 64;
+    size_t requestsPerConnection = 200000;
+    unsigned serverThreads = 2;
+    int queryShare = 50;
+    std::string transport = "unix";
+    Target external;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--connections")) connections = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--depth")) depth = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--requests")) requestsPerConnection = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--server-threads")) serverThreads = std::atoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--query-share")) queryShare = std::atoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--transport")) transport = argv[i + 1];
+        else if (!std::strcmp(argv[i], "--unix")) external.unixPath = argv[i + 1];
+        else if (!std::strcmp(argv[i], "--tcp")) {
+            std::string address = argv[i + 1];
+            size_t colon = address.rfind(':');
+            external.host = address.substr(0, colon);
+            external.port = static_cast<uint16_t>(std::atoi(address.c_str() + colon + 1));
+        }
+    }
+
+    std::vector<bench::CourseSpec> catalog = bench::generateCatalog(config);
+    std::vector<Student> students = bench::generateStudents(config, catalog);
+
+    // The same request mix for every pass and connection count
+    bench::ZipfSampler demand(config.courseCount, config.demandSkew);
+    std::vector<RequestStream> streams(connections);
+    for (unsigned c = 0; c < connections; ++c) {
+        std::mt19937 rng(config.seed + 100 + c);
+        RequestStream& stream = streams[c];
+        for (size_t i = 0; i < requestsPerConnection; ++i) {
+            WireRequest request;
+            const int roll = static_cast<int>(rng() % 100);
+            request.opcode = roll < queryShare ? WireOpcode::QUERY
+                           : roll < queryShare + (100 - queryShare) * 4 / 5 ? WireOpcode::REGISTER
+                                                                              : WireOpcode::WITHDRAW;
+            request.tag = static_cast<uint32_t>(i);
+            if (request.opcode != WireOpcode::QUERY) {
+                request.studentId = students[rng() % students.size()].getStudentId();
+            }
+            request.courseCode = catalog[demand(rng)].code;
+            stream.offsets.push_back(stream.bytes.size());
+            encodeRequest(request, stream.bytes);
+        }
+        stream.offsets.push_back(stream.bytes.size());
+    }
+
+    // In-process server unless an external one was named
+    ManualClock clock(1700000000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    std::unique_ptr<RegistrationServer> server;
+    Target target = external;
+    if (external.unixPath.empty() && external.host.empty()) {
+        for (const auto& course : catalog) {
+            reg.addCourse(course.code, course.name, course.capacity, course.prerequisites,
+                          clock.now() + 86400);
+        }
+        server.reset(new RegistrationServer(reg, students));
+        const std::string path = "/tmp/bench_server." + std::to_string(::getpid()) + ".sock";
+        server->listenUnix(path);
+        const uint16_t port = server->listenTcp("127.0.0.1", 0);
+        server->start(serverThreads);
+        if (transport == "tcp") {
+            target.host = "127.0.0.1";
+            target.port = port;
+        } else {
+            target.unixPath = path;
+        }
+    }
+
+    std::vector<bench::OperationStats> results;
+    std::deque<std::string> names;
+    uint64_t unexpected = 0;
+    std::vector<size_t> depths = {1};
+    if (depth > 1) {
+        depths.push_back(depth);
+    }
+    for (size_t passDepth : depths) {
+        ServerStats before = server ? server->stats() : ServerStats();
+        std::vector<ConnectionResult> connectionResults(connections);
+        std::vector<std::thread> threads;
+        uint64_t allocsBefore = bench::allocationCount.load(std::memory_order_relaxed);
+        auto start = Clock::now();
+        for (unsigned c = 0; c < connections; ++c) {
+            threads.emplace_back([&, c] { drive(target, streams[c], passDepth, connectionResults[c]); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        uint64_t allocs = bench::allocationCount.load(std::memory_order_relaxed) - allocsBefore;
+
+        std::vector<uint64_t> latencies;
+        uint64_t sends = 0;
+        for (auto& result : connectionResults) {
+            latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+            unexpected += result.unexpected;
+            sends += result.sends;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        names.push_back(std::string(target.unixPath.empty() ? "tcp" : "unix") + " depth " +
+                        std::to_string(passDepth));
+        bench::OperationStats stats;
+        stats.name = names.back().c_str();
+        stats.operations = latencies.size();
+        stats.opsPerSecond = seconds > 0 ? latencies.size() / seconds : 0.0;
+        stats.p50Nanos = bench::percentile(latencies, 0.50);
+        stats.p99Nanos = bench::percentile(latencies, 0.99);
+        stats.p999Nanos = bench::percentile(latencies, 0.999);
+        stats.allocsPerOp = latencies.empty() ? 0.0 : static_cast<double>(allocs) / latencies.size();
+        results.push_back(stats);
+
+        if (server) {
+            ServerStats after = server->stats();
+            const uint64_t requests = after.requests - before.requests;
+            std::printf("depth %zu: %.1f requests per server read, %.1f per server send, %.1f per client send\n",
+                        passDepth,
+                        static_cast<double>(requests) / std::max<uint64_t>(1, after.batches - before.batches),
+                        static_cast<double>(requests) / std::max<uint64_t>(1, after.writes - before.writes),
+                        static_cast<double>(requests) / std::max<uint64_t>(1, sends));
+        }
+    }
+    if (server) {
+        server->stop();
+    }
+
+    std::printf("connections=%u requests/connection=%zu query-share=%d%% server=%s\n",
+                connections, requestsPerConnection, queryShare,
+                server ? "in-process" : "external");
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+    return unexpected != 0;
+}
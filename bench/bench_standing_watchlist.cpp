@@ -0,0 +1,95 @@
+/**
+ * @file bench_standing_watchlist.cpp
+ * @brief Probation list after grade posting: rescan versus StandingWatchlist
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Simulates rounds of grade posting, each updating the CGPA of a share of
+ * the population, and after each round produces the probation list:
+ * - "rescan": Student::updateCGPA on untracked students, then walk every
+ *   Student
+ * - "watchlist": Student::updateCGPA on tracked students, then
+ *   members(PROBATION)
+ * Also reports the per-update cost of each path.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_standing_watchlist
+ * ./build/bench_standing_watchlist --students 200000 --posted 2000 --rounds 50
+ * @endcode
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench/bench_util.h"
+#include "standing_watchlist.h"
+
+int main(int argc, char** argv) {
+    int studentCount = 200000;
+    int posted = 2000;
+    int rounds = 50;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--students")) studentCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--posted")) posted = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--rounds")) rounds = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> cgpaDist(6.5f, 1.5f);
+    auto randomCgpa = [&] { return std::min(10.0f, std::max(0.0f, cgpaDist(rng))); };
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (int s = 0; s < studentCount; ++s) {
+        students.emplace_back("S" + std::to_string(1000000 + s), "Student " + std::to_string(s), "CSE");
+        students.back().updateCGPA(randomCgpa());
+    }
+    // Copied before tracking, so the rescan path updates untracked students
+    std::vector<Student> rescanned = students;
+    StandingWatchlist watchlist;
+    for (auto& student : students) {
+        watchlist.track(student);
+    }
+
+    // The same postings for both paths
+    const size_t updates = static_cast<size_t>(posted) * rounds;
+    std::vector<size_t> who(updates);
+    std::vector<float> cgpas(updates);
+    for (size_t i = 0; i < updates; ++i) {
+        who[i] = rng() % students.size();
+        cgpas[i] = randomCgpa();
+    }
+
+    std::vector<bench::OperationStats> results;
+    size_t rescanListed = 0;
+    size_t watchlistListed = 0;
+    results.push_back(bench::measure("rescan update", updates, [&](uint64_t i) {
+        rescanned[who[i]].updateCGPA(cgpas[i]);
+    }));
+    results.push_back(bench::measure("watchlist update", updates, [&](uint64_t i) {
+        students[who[i]].updateCGPA(cgpas[i]);
+    }));
+    results.push_back(bench::measure("rescan list", rounds, [&](uint64_t) {
+        std::vector<std::string> probation;
+        for (const auto& student : rescanned) {
+            if (student.getAcademicStanding() == AcademicStanding::PROBATION) {
+                probation.push_back(student.getStudentId());
+            }
+        }
+        rescanListed = probation.size();
+    }));
+    results.push_back(bench::measure("watchlist list", rounds, [&](uint64_t) {
+        watchlistListed = watchlist.members(AcademicStanding::PROBATION).size();
+    }));
+
+    std::printf("students=%d posted/round=%d rounds=%d probation: rescan=%zu watchlist=%zu\n",
+                studentCount, posted, rounds, rescanListed, watchlistListed);
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+    return rescanListed != watchlistListed;
+}
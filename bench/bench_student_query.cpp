@@ -0,0 +1,118 @@
+/**
+ * @file bench_student_query.cpp
+ * @brief Advising-list queries on StudentTable versus walking Student objects
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Builds a population across several departments with random CGPAs and
+ * semesters, then runs the same advising queries two ways:
+ * - "getters": loop over std::vector<Student>, calling the getters
+ * - "table": StudentTable::select plus count, list or histogram
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_student_query
+ * ./build/bench_student_query --students 200000 --queries 50
+ * @endcode
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench/bench_util.h"
+#include "student_query.h"
+
+namespace {
+
+/** @brief Returns true if @p student passes @p query, using the Student getters */
+bool matchesByGetters(const Student& student, const StudentQuery& query) {
+    return (query.department.empty() || student.getDepartment() == query.department) &&
+           student.getSemester() >= query.minSemester && student.getSemester() <= query.maxSemester &&
+           student.getCGPA() >= query.minCgpa && student.getCGPA() < query.maxCgpa &&
+           (query.standings & StudentQuery::standingBit(student.getAcademicStanding()));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int studentCount = 200000;
+    int queryCount = 50;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--students")) studentCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (!std::strcmp(argv[i], "--queries")) queryCount = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    const std::vector<std::string> departments = {"CSE", "ECE", "ME", "CE", "EEE", "CHE", "BT", "MME"};
+    std::mt19937 rng(42);
+    std::normal_distribution<float> cgpaDist(7.0f, 1.5f);
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (int s = 0; s < studentCount; ++s) {
+        students.emplace_back("S" + std::to_string(1000000 + s), "Student " + std::to_string(s),
+                              departments[rng() % departments.size()]);
+        students.back().updateCGPA(std::min(10.0f, std::max(0.0f, cgpaDist(rng))));
+        for (int k = static_cast<int>(rng() % 8); k > 0; --k) {
+            students.back().advanceToNextSemester();
+        }
+    }
+    StudentTable table(students);
+
+    // "Department X, semester >= 5, on probation" and similar lists
+    std::vector<StudentQuery> queries(queryCount);
+    for (int i = 0; i < queryCount; ++i) {
+        queries[i].department = departments[i % departments.size()];
+        queries[i].minSemester = 1 + i % 6;
+        queries[i].standings = StudentQuery::standingBit(AcademicStanding::PROBATION) |
+                               (i % 2 ? StudentQuery::standingBit(AcademicStanding::SATISFACTORY) : 0);
+    }
+
+    std::vector<bench::OperationStats> results;
+    uint64_t getterMatches = 0;
+    uint64_t tableMatches = 0;
+    results.push_back(bench::measure("getters count", queries.size(), [&](uint64_t i) {
+        for (const auto& student : students) {
+            getterMatches += matchesByGetters(student, queries[i]);
+        }
+    }));
+    results.push_back(bench::measure("table count", queries.size(), [&](uint64_t i) {
+        tableMatches += table.count(queries[i]);
+    }));
+    uint64_t listed = 0;
+    results.push_back(bench::measure("getters list", queries.size(), [&](uint64_t i) {
+        std::vector<std::string> ids;
+        for (const auto& student : students) {
+            if (matchesByGetters(student, queries[i])) {
+                ids.push_back(student.getStudentId());
+            }
+        }
+        listed += ids.size();
+    }));
+    results.push_back(bench::measure("table list", queries.size(), [&](uint64_t i) {
+        listed += table.list(table.select(queries[i])).size();
+    }));
+    uint64_t histogramTotal = 0;
+    results.push_back(bench::measure("getters histogram", queries.size(), [&](uint64_t i) {
+        std::vector<size_t> buckets(16, 0);
+        for (const auto& student : students) {
+            if (matchesByGetters(student, queries[i])) {
+                ++buckets[std::min(student.getSemester(), 15)];
+            }
+        }
+        histogramTotal += buckets[1];
+    }));
+    results.push_back(bench::measure("table histogram", queries.size(), [&](uint64_t i) {
+        std::vector<size_t> buckets = table.histogram(table.select(queries[i]), StudentField::SEMESTER);
+        histogramTotal += buckets.size() > 1 ? buckets[1] : 0;
+    }));
+
+    std::printf("students=%d queries=%d matches: getters=%llu table=%llu\n", studentCount, queryCount,
+                static_cast<unsigned long long>(getterMatches), static_cast<unsigned long long>(tableMatches));
+    bench::printHeader();
+    for (const auto& stats : results) {
+        bench::printStats(stats);
+    }
+    return getterMatches != tableMatches || listed == 0 || histogramTotal == 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file bench_unknown_course.cpp
+ * @brief Microbenchmark: throwing vs non-throwing registration API
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Drives registerStudent / getEnrollmentCount (which throw on an unknown
+ * course code) and tryRegisterStudent / tryGetEnrollmentCount (which
+ * return UNKNOWN_COURSE) with the same request stream, in which 30% of
+ * course codes do not exist, and reports nanoseconds per call for each.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target bench_unknown_course
+ * ./build/bench_unknown_course [requests]
+ * @endcode
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "course_registration.h"
+
+namespace {
+
+const int kCourseCount = 200;       /**< Courses in the catalog */
+const double kInvalidRatio = 0.30;  /**< Share of requests with a bogus course code */
+
+/** @brief Prints the time per call of one benchmark pass */
+void report(const char* label, std::chrono::nanoseconds elapsed, size_t calls, long failures) {
+    std::printf("%-28s %8.1f ns/op  (%ld unknown-course results)\n",
+                label, static_cast<double>(elapsed.count()) / calls, failures);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t requestCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    CourseRegistration reg;
+    std::vector<std::string> validCodes;
+    for (int i = 0; i < kCourseCount; ++i) {
+        validCodes.push_back("CS" + std::to_string(1000 + i));
+        reg.addCourse(validCodes.back(), "Course " + std::to_string(i),
+                      0, {}, time(nullptr) + 86400);
+    }
+
+    // Build the request stream once so both passes see identical input
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<int> pick(0, kCourseCount - 1);
+    std::vector<std::string> requests;
+    requests.reserve(requestCount);
+    for (size_t i = 0; i < requestCount; ++i) {
+        if (coin(rng) < kInvalidRatio) {
+            requests.push_back("BOT" + std::to_string(rng() % 100000));
+        } else {
+            requests.push_back(validCodes[pick(rng)]);
+        }
+    }
+
+    // Courses have zero capacity, so every valid request runs the lookup and
+    // checks and ends in COURSE_FULL without changing any state between passes.
+    Student student("se22ucse272", "Bench Student", "CSE");
+    using Clock = std::chrono::steady_clock;
+
+    long failures = 0;
+    auto start = Clock::now();
+    for (const auto& code : requests) {
+        try {
+            reg.registerStudent(student, code);
+        } catch (const std::invalid_argument&) {
+            ++failures;
+        }
+    }
+    report("registerStudent (throws)", Clock::now() - start, requests.size(), failures);
+
+    failures = 0;
+    start = Clock::now();
+    for (const auto& code : requests) {
+        if (reg.tryRegisterStudent(student, code) == RegistrationStatus::UNKNOWN_COURSE) {
+            ++failures;
+        }
+    }
+    report("tryRegisterStudent", Clock::now() - start, requests.size(), failures);
+
+    failures = 0;
+    start = Clock::now();
+    for (const auto& code : requests) {
+        try {
+            reg.getEnrollmentCount(code);
+        } catch (const std::out_of_range&) {
+            ++failures;
+        }
+    }
+    report("getEnrollmentCount (throws)", Clock::now() - start, requests.size(), failures);
+
+    failures = 0;
+    start = Clock::now();
+    for (const auto& code : requests) {
+        if (!reg.tryGetEnrollmentCount(code).ok()) {
+            ++failures;
+        }
+    }
+    report("tryGetEnrollmentCount", Clock::now() - start, requests.size(), failures);
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file replay_trace.cpp
+ * @brief Replays a recorded registration trace against a fresh engine
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Loads a trace written by TraceRecorder, recreates its catalog and
+ * students, and drives registerStudent / withdrawStudent from N threads.
+ * Events are partitioned by student so each student's calls keep their
+ * recorded order on one thread; events for different students may
+ * interleave differently than in the recording.
+ *
+ * With --speed 1 each event is issued at its recorded offset, --speed 10
+ * replays ten times faster, and --speed 0 (the default) issues events as
+ * fast as possible. Courses are all added before the clock starts, and
+ * deadlines are evaluated against a clock fixed at the recording's start.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target replay_trace
+ * ./build/replay_trace rush.trace --threads 8 --speed 1
+ * @endcode
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "bench/bench_util.h"
+#include "course_registration.h"
+#include "registration_trace.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int kMaxThreads = 1024; /**< Upper bound on --threads */
+
+/** @brief Results gathered by one replay thread */
+struct ThreadResult {
+    std::vector<uint64_t> latencies; /**< Per-call latency in nanoseconds */
+    uint64_t mismatches = 0;         /**< Calls whose result differs from the recording */
+    uint64_t maxLagNanos = 0;        /**< Worst delay behind the paced schedule */
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s TRACE [--threads N] [--speed X]\n", argv[0]);
+        return 2;
+    }
+    unsigned threadCount = std::thread::hardware_concurrency();
+    double speed = 0.0;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--threads")) threadCount = std::clamp(std::atoi(argv[i + 1]), 1, kMaxThreads);
+        else if (!std::strcmp(argv[i], "--speed")) speed = std::atof(argv[i + 1]);
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    Trace trace = readTrace(in);
+
+    ManualClock clock(trace.startTime);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    std::unordered_map<std::string, Student> students;
+    for (const auto& entry : trace.studentCourses) {
+        students.emplace(entry.first, replayStudent(trace, entry.first));
+    }
+
+    // Partition calls by student so one student is only touched by one thread
+    std::vector<std::vector<const TraceEvent*>> partitions(threadCount);
+    std::hash<std::string> hasher;
+    for (const auto& event : trace.events) {
+        if (event.type == TraceRecordType::ADD_COURSE) {
+            reg.addCourse(event.courseCode, event.courseName, event.capacity,
+                          event.prerequisites, event.deadline);
+        } else if (event.type == TraceRecordType::ADD_SECTION) {
+            reg.addSection(event.parentCode, event.courseCode, event.capacity, event.department);
+        } else {
+            partitions[hasher(event.studentId) % threadCount].push_back(&event);
+        }
+    }
+
+    std::vector<ThreadResult> results(threadCount);
+    std::atomic<bool> go{false};
+    Clock::time_point start;
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            ThreadResult& result = results[t];
+            result.latencies.reserve(partitions[t].size());
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (const TraceEvent* event : partitions[t]) {
+                if (speed > 0) {
+                    auto due = start + std::chrono::nanoseconds(
+                                           static_cast<uint64_t>(event->offsetNanos / speed));
+                    std::this_thread::sleep_until(due);
+                    auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   Clock::now() - due).count();
+                    result.maxLagNanos = std::max<uint64_t>(result.maxLagNanos, lag);
+                }
+
+                auto callStart = Clock::now();
+                uint8_t outcome;
+                if (event->type == TraceRecordType::REGISTER) {
+                    auto it = students.find(event->studentId);
+                    outcome = static_cast<uint8_t>(reg.tryRegisterStudent(it->second, event->courseCode));
+                } else {
+                    outcome = reg.withdrawStudent(event->studentId, event->courseCode) ? 1 : 0;
+                }
+                result.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                               Clock::now() - callStart).count());
+                result.mismatches += outcome != event->result;
+            }
+        });
+    }
+
+    start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<uint64_t> latencies;
+    uint64_t mismatches = 0;
+    uint64_t maxLag = 0;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        mismatches += result.mismatches;
+        maxLag = std::max(maxLag, result.maxLagNanos);
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("events=%zu threads=%u speed=%g elapsed=%.3fs ops/sec=%.0f\n",
+                latencies.size(), threadCount, speed, seconds,
+                seconds > 0 ? latencies.size() / seconds : 0.0);
+    std::printf("latency p50=%lluns p99=%lluns p999=%lluns max-lag=%lluus\n",
+                static_cast<unsigned long long>(bench::percentile(latencies, 0.50)),
+                static_cast<unsigned long long>(bench::percentile(latencies, 0.99)),
+                static_cast<unsigned long long>(bench::percentile(latencies, 0.999)),
+                static_cast<unsigned long long>(maxLag / 1000));
+    std::printf("results differing from recording: %llu\n",
+                static_cast<unsigned long long>(mismatches));
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file serve_registration.cpp
+ * @brief Standalone registration server over a synthetic catalog
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Builds the workload of bench_registration (same options, same seed, so
+ * the same course codes and student IDs) and serves it with
+ * RegistrationServer until SIGINT or SIGTERM, then prints the server's
+ * counters. Point bench_server at it with --unix or --tcp to benchmark
+ * the server in a separate process.
+ *
+ * Build and run from the repository root:
+ * @code
+ * cmake -S . -B build && cmake --build build --target serve_registration
+ * ./build/serve_registration --unix /tmp/registration.sock --port 7070 --threads 4
+ * @endcode
+ *
+ * Without --unix the server listens on 127.0.0.1:PORT only; with --unix
+ * and no --port, on the Unix socket only.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include "bench/workload.h"
+#include "registration_server.h"
+
+int main(int argc, char** argv) {
+    bench::WorkloadConfig config;
+    bench::parseWorkloadArgs(argc, argv, config);
+    std::string unixPath;
+    int port = -1;
+    unsigned threads = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--unix")) unixPath = argv[i + 1];
+        else if (!std::strcmp(argv[i], "--port")) port = std::atoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--threads")) threads = std::atoi(argv[i + 1]);
+    }
+    if (unixPath.empty() && port < 0) {
+        port = 7070;
+    }
+
+    // Block the stop signals before any thread starts, so only sigwait sees them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    std::vector<bench::CourseSpec> catalog = bench::generateCatalog(config);
+    std::vector<Student> students = bench::generateStudents(config, catalog);
+    CourseRegistration reg;
+    const time_t deadline = std::time(nullptr) + 30 * 86400;
+    for (const auto& course : catalog) {
+        reg.addCourse(course.code, course.name, course.capacity, course.prerequisites, deadline);
+    }
+
+    RegistrationServer server(reg, students);
+    if (!unixPath.empty()) {
+        server.listenUnix(unixPath);
+        std::printf("listening on %s\n", unixPath.c_str());
+    }
+    if (port >= 0) {
+        std::printf("listening on 127.0.0.1:%u\n",
+                    server.listenTcp("127.0.0.1", static_cast<uint16_t>(port)));
+    }
+    server.start(threads);
+    std::printf("serving %d courses and %d students with %u threads\n",
+                config.courseCount, config.studentCount, threads);
+    std::fflush(stdout);
+
+    int received;
+    sigwait(&stopSignals, &received);
+    ServerStats stats = server.stats();
+    server.stop();
+    std::printf("connections=%llu requests=%llu batches=%llu writes=%llu\n",
+                static_cast<unsigned long long>(stats.connections),
+                static_cast<unsigned long long>(stats.requests),
+                static_cast<unsigned long long>(stats.batches),
+                static_cast<unsigned long long>(stats.writes));
+    return 0;
+}
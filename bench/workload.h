@@ -0,0 +1,170 @@
+/**
+ * @file workload.h
+ * @brief Synthetic course catalog and student population generator
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Generates reproducible catalogs and students for the benchmarks:
+ * - Courses are arranged in prerequisite levels; a course at level L
+ *   requires one course from level L-1, up to the configured depth
+ * - Capacities follow a power law so a few courses are much larger
+ *   than the rest (capacitySkew = 0 gives uniform capacities)
+ * - Course demand follows a Zipf distribution (demandSkew = 0 is uniform)
+ * - Each student has completed one prerequisite chain of random length
+ */
+
+#ifndef BENCH_WORKLOAD_H
+#define BENCH_WORKLOAD_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "student.h"
+
+namespace bench {
+
+/** @brief Parameters of a synthetic workload */
+struct WorkloadConfig {
+    int courseCount = 1000;      /**< Courses in the catalog */
+    int prereqDepth = 3;         /**< Length of the longest prerequisite chain */
+    int baseCapacity = 200;      /**< Capacity of the largest course */
+    double capacitySkew = 0.5;   /**< Power-law exponent of course capacities */
+    double demandSkew = 0.8;     /**< Zipf exponent of course popularity */
+    int studentCount = 50000;    /**< Students in the population */
+    int coursesPerStudent = 4;   /**< Registration attempts per student */
+    uint32_t seed = 42;          /**< Random seed */
+};
+
+/** @brief One generated course, ready to pass to CourseRegistration::addCourse */
+struct CourseSpec {
+    std::string code;                    /**< Course code */
+    std::string name;                    /**< Course name */
+    int capacity;                        /**< Maximum number of students */
+    int level;                           /**< Prerequisite level (0 = none) */
+    std::set<std::string> prerequisites; /**< Prerequisite course codes */
+};
+
+/**
+ * @brief Parses `--name value` command line options into @p config
+ *
+ * Recognized options: --courses, --depth, --capacity, --capacity-skew,
+ * --demand-skew, --students, --per-student, --seed. Unknown options
+ * are ignored so benchmarks can add their own.
+ */
+inline void parseWorkloadArgs(int argc, char** argv, WorkloadConfig& config) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (!std::strcmp(key, "--courses")) config.courseCount = std::atoi(value);
+        else if (!std::strcmp(key, "--depth")) config.prereqDepth = std::atoi(value);
+        else if (!std::strcmp(key, "--capacity")) config.baseCapacity = std::atoi(value);
+        else if (!std::strcmp(key, "--capacity-skew")) config.capacitySkew = std::atof(value);
+        else if (!std::strcmp(key, "--demand-skew")) config.demandSkew = std::atof(value);
+        else if (!std::strcmp(key, "--students")) config.studentCount = std::atoi(value);
+        else if (!std::strcmp(key, "--per-student")) config.coursesPerStudent = std::atoi(value);
+        else if (!std::strcmp(key, "--seed")) config.seed = static_cast<uint32_t>(std::atol(value));
+    }
+}
+
+/**
+ * @brief Samples indices in [0, n) with Zipf-distributed probability
+ *
+ * Index 0 is the most popular. Sampling is a binary search over the
+ * precomputed cumulative distribution.
+ */
+class ZipfSampler {
+private:
+    std::vector<double> cumulative; /**< Cumulative probability per index */
+
+public:
+    /**
+     * @param n Number of distinct indices
+     * @param exponent Zipf exponent (0 gives a uniform distribution)
+     */
+    ZipfSampler(int n, double exponent) : cumulative(n) {
+        double total = 0.0;
+        for (int i = 0; i < n; ++i) {
+            total += 1.0 / std::pow(i + 1.0, exponent);
+            cumulative[i] = total;
+        }
+        for (double& c : cumulative) {
+            c /= total;
+        }
+    }
+
+    /** @brief Draws one index */
+    template <typename Rng>
+    int operator()(Rng& rng) const {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        auto it = std::lower_bound(cumulative.begin(), cumulative.end(), u);
+        return static_cast<int>(std::min<size_t>(it - cumulative.begin(), cumulative.size() - 1));
+    }
+};
+
+/**
+ * @brief Generates a course catalog
+ *
+ * Courses are returned in popularity order: index 0 is the course a
+ * ZipfSampler over the catalog returns most often.
+ */
+inline std::vector<CourseSpec> generateCatalog(const WorkloadConfig& config) {
+    std::mt19937 rng(config.seed);
+    int levels = config.prereqDepth + 1;
+    std::vector<CourseSpec> catalog(config.courseCount);
+    std::vector<std::vector<int>> byLevel(levels);
+
+    for (int i = 0; i < config.courseCount; ++i) {
+        CourseSpec& course = catalog[i];
+        course.code = std::string("C").append(std::to_string(100000 + i));
+        course.name = std::string("Synthetic course ").append(std::to_string(i));
+        course.level = i % levels;
+        double scale = 1.0 / std::pow(i + 1.0, config.capacitySkew);
+        course.capacity = std::max(1, static_cast<int>(config.baseCapacity * scale));
+        byLevel[course.level].push_back(i);
+    }
+    for (auto& course : catalog) {
+        if (course.level > 0) {
+            const auto& candidates = byLevel[course.level - 1];
+            course.prerequisites.insert(catalog[candidates[rng() % candidates.size()]].code);
+        }
+    }
+    return catalog;
+}
+
+/**
+ * @brief Generates students that have completed prerequisite chains
+ *
+ * Each student walks down the prerequisite chain of a random course and
+ * records every course on it except the course itself as completed, so
+ * students satisfy the prerequisites of some courses but not others.
+ */
+inline std::vector<Student> generateStudents(const WorkloadConfig& config,
+                                             const std::vector<CourseSpec>& catalog) {
+    std::mt19937 rng(config.seed + 1);
+    std::vector<Student> students;
+    students.reserve(config.studentCount);
+
+    for (int s = 0; s < config.studentCount; ++s) {
+        // Appending keeps GCC 12's -Wrestrict quiet about literal + to_string
+        students.emplace_back(std::string("S").append(std::to_string(1000000 + s)),
+                              std::string("Student ").append(std::to_string(s)), "CSE");
+        const CourseSpec* course = &catalog[rng() % catalog.size()];
+        while (!course->prerequisites.empty()) {
+            const std::string& prereq = *course->prerequisites.begin();
+            students.back().enrollInCourse(prereq);
+            // Course codes encode their catalog index
+            course = &catalog[std::atoi(prereq.c_str() + 1) - 100000];
+        }
+    }
+    return students;
+}
+
+} // namespace bench
+
+#endif // BENCH_WORKLOAD_H
@@ -0,0 +1,282 @@
+/**
+ * @file cgpa_ranking.cpp
+ * @brief Implementation of the CGPA ranking
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "cgpa_ranking.h"
+
+namespace {
+
+/** @brief Maps a CGPA to a key whose ascending order is descending CGPA */
+uint32_t descendingKey(float cgpa) {
+    uint32_t bits;
+    std::memcpy(&bits, &cgpa, sizeof(bits));
+    // IEEE order to unsigned order: flip negatives entirely, positives' sign bit only
+    bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    return ~bits;
+}
+
+/** @brief Runs fn(chunk) for every chunk in [0, chunkCount), one thread per chunk */
+template <typename Fn>
+void forEachChunk(size_t chunkCount, Fn fn) {
+    if (chunkCount <= 1) {
+        fn(size_t(0));
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        workers.emplace_back(fn, chunk);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Stable LSD radix sort of (key << 32 | row) items on their keys
+ *
+ * Each pass sorts one byte of the key. Every chunk counts its digits,
+ * the counts are turned into per-chunk output offsets, and every chunk
+ * scatters its items to those offsets, so chunks run in parallel and the
+ * result is still stable. Passes whose byte is the same in every item
+ * are skipped.
+ */
+void radixSortByKey(std::vector<uint64_t>& items, unsigned threads) {
+    const size_t n = items.size();
+    if (n < 2) {
+        return;
+    }
+    const size_t chunk = (n + threads - 1) / threads;
+    const size_t chunkCount = (n + chunk - 1) / chunk;
+    std::vector<uint64_t> scratch(n);
+    std::vector<std::array<size_t, 256>> offsets(chunkCount);
+
+    for (int shift = 32; shift < 64; shift += 8) {
+        forEachChunk(chunkCount, [&](size_t c) {
+            std::array<size_t, 256>& counts = offsets[c];
+            counts.fill(0);
+            for (size_t i = c * chunk, end = std::min(n, i + chunk); i < end; ++i) {
+                ++counts[(items[i] >> shift) & 0xff];
+            }
+        });
+        std::array<size_t, 256> totals{};
+        for (const auto& counts : offsets) {
+            for (int digit = 0; digit < 256; ++digit) {
+                totals[digit] += counts[digit];
+            }
+        }
+        if (std::find(totals.begin(), totals.end(), n) != totals.end()) {
+            continue;
+        }
+        // Digit-major, then chunk order: where each chunk writes each digit
+        size_t running = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            for (auto& counts : offsets) {
+                size_t count = counts[digit];
+                counts[digit] = running;
+                running += count;
+            }
+        }
+        forEachChunk(chunkCount, [&](size_t c) {
+            std::array<size_t, 256>& next = offsets[c];
+            for (size_t i = c * chunk, end = std::min(n, i + chunk); i < end; ++i) {
+                scratch[next[(items[i] >> shift) & 0xff]++] = items[i];
+            }
+        });
+        items.swap(scratch);
+    }
+}
+
+} // namespace
+
+// Implementation of CgpaRanking methods
+
+CgpaRanking::CgpaRanking(const std::vector<Student>& students, unsigned threads)
+    : threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+    entries.reserve(students.size());
+    rows.reserve(students.size());
+    for (const auto& student : students) {
+        place(student);
+    }
+}
+
+uint16_t CgpaRanking::bucketOf(float cgpa) {
+    if (!(cgpa > 0.0f)) {
+        return 0;
+    }
+    return static_cast<uint16_t>(std::min<float>(cgpa * kBucketsPerPoint, kBucketCount - 1));
+}
+
+void CgpaRanking::place(const Student& student) {
+    const std::string department = student.getDepartment();
+    auto departmentIt = departmentIds.find(department);
+    if (departmentIt == departmentIds.end()) {
+        departmentIt = departmentIds.emplace(department, static_cast<int32_t>(departments.size())).first;
+        departments.emplace_back();
+    }
+    const int32_t departmentId = departmentIt->second;
+    const float cgpa = student.getCGPA();
+    const uint16_t bucket = bucketOf(cgpa);
+
+    uint32_t row;
+    auto rowIt = rows.find(student.getStudentId());
+    if (rowIt == rows.end()) {
+        row = static_cast<uint32_t>(entries.size());
+        entries.push_back({student.getStudentId(), cgpa, departmentId, bucket, 0});
+        rows.emplace(entries.back().studentId, row);
+    } else {
+        row = rowIt->second;
+        Entry& entry = entries[row];
+        entry.cgpa = cgpa;
+        if (entry.department == departmentId && entry.bucket == bucket) {
+            return;
+        }
+        // Out of the old bucket: swap the last member into its slot
+        DepartmentIndex& old = departments[entry.department];
+        std::vector<uint32_t>& members = old.members[entry.bucket];
+        uint32_t moved = members.back();
+        members[entry.slot] = moved;
+        entries[moved].slot = entry.slot;
+        members.pop_back();
+        old.counts.add(entry.bucket, -1);
+        overall.add(entry.bucket, -1);
+        entry.department = departmentId;
+        entry.bucket = bucket;
+    }
+    DepartmentIndex& index = departments[departmentId];
+    entries[row].slot = static_cast<uint32_t>(index.members[bucket].size());
+    index.members[bucket].push_back(row);
+    index.counts.add(bucket, 1);
+    overall.add(bucket, 1);
+}
+
+bool CgpaRanking::remove(const std::string& studentId) {
+    auto rowIt = rows.find(studentId);
+    if (rowIt == rows.end()) {
+        return false;
+    }
+    const uint32_t row = rowIt->second;
+    rows.erase(rowIt);
+    const Entry& entry = entries[row];
+    DepartmentIndex& index = departments[entry.department];
+    std::vector<uint32_t>& members = index.members[entry.bucket];
+    uint32_t moved = members.back();
+    members[entry.slot] = moved;
+    entries[moved].slot = entry.slot;
+    members.pop_back();
+    index.counts.add(entry.bucket, -1);
+    overall.add(entry.bucket, -1);
+    // Shift later rows down rather than swapping in the last, so ties keep first-added order
+    entries.erase(entries.begin() + row);
+    for (uint32_t later = row; later < entries.size(); ++later) {
+        const Entry& shifted = entries[later];
+        rows.find(shifted.studentId)->second = later;
+        departments[shifted.department].members[shifted.bucket][shifted.slot] = later;
+    }
+    return true;
+}
+
+void CgpaRanking::update(const Student& student) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    place(student);
+}
+
+void CgpaRanking::track(Student& student) {
+    update(student);
+    student.addCgpaObserver(this);
+}
+
+bool CgpaRanking::untrack(Student& student) {
+    student.removeCgpaObserver(this);
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    return remove(student.getStudentId());
+}
+
+void CgpaRanking::onCgpaChange(const Student& student, float) {
+    update(student);
+}
+
+void CgpaRanking::onRecordReplaced(const Student& student, const std::string& previousId, float) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (previousId != student.getStudentId()) {
+        remove(previousId);
+    }
+    place(student);
+}
+
+size_t CgpaRanking::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return entries.size();
+}
+
+std::vector<std::string> CgpaRanking::ranked() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<uint64_t> items(entries.size());
+    for (size_t row = 0; row < entries.size(); ++row) {
+        items[row] = (uint64_t(descendingKey(entries[row].cgpa)) << 32) | row;
+    }
+    radixSortByKey(items, items.size() >= kParallelThreshold ? threads : 1);
+    std::vector<std::string> ids;
+    ids.reserve(items.size());
+    for (uint64_t item : items) {
+        ids.push_back(entries[static_cast<uint32_t>(item)].studentId);
+    }
+    return ids;
+}
+
+double CgpaRanking::percentile(const std::string& studentId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto rowIt = rows.find(studentId);
+    if (rowIt == rows.end()) {
+        throw std::out_of_range("Student not ranked");
+    }
+    int64_t below = overall.prefix(entries[rowIt->second].bucket);
+    return 100.0 * static_cast<double>(below) / static_cast<double>(entries.size());
+}
+
+size_t CgpaRanking::rankOf(const std::string& studentId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto rowIt = rows.find(studentId);
+    if (rowIt == rows.end()) {
+        throw std::out_of_range("Student not ranked");
+    }
+    int64_t notAbove = overall.prefix(entries[rowIt->second].bucket + 1);
+    return entries.size() - static_cast<size_t>(notAbove) + 1;
+}
+
+std::vector<std::string> CgpaRanking::topInDepartment(const std::string& department, size_t n) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto departmentIt = departmentIds.find(department);
+    if (departmentIt == departmentIds.end() || n == 0) {
+        return {};
+    }
+    const DepartmentIndex& index = departments[departmentIt->second];
+    const int64_t total = index.counts.prefix(kBucketCount);
+    // Lowest bucket holding one of the top n: the first where more than total - n sit at or below
+    size_t lowest = static_cast<int64_t>(n) >= total
+                        ? 0 : index.counts.upperBound(total - static_cast<int64_t>(n));
+
+    std::vector<uint32_t> candidates;
+    for (size_t bucket = kBucketCount; bucket-- > lowest;) {
+        const std::vector<uint32_t>& members = index.members[bucket];
+        candidates.insert(candidates.end(), members.begin(), members.end());
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b) {
+        return entries[a].cgpa != entries[b].cgpa ? entries[a].cgpa > entries[b].cgpa : a < b;
+    });
+    candidates.resize(std::min(candidates.size(), n));
+    std::vector<std::string> ids;
+    ids.reserve(candidates.size());
+    for (uint32_t row : candidates) {
+        ids.push_back(entries[row].studentId);
+    }
+    return ids;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file cgpa_ranking.h
+ * @brief CGPA ranking, percentiles and per-department top lists
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Priority registration and honors lists rank students by CGPA. Sorting
+ * Student objects with a comparator copies fields on every comparison; a
+ * CgpaRanking instead keeps each student's CGPA in a flat array and
+ * answers three kinds of question:
+ * - ranked(): every student, best CGPA first. The CGPAs are mapped to
+ *   unsigned keys that sort like the floats and ordered by an LSD radix
+ *   sort, one byte per pass, split across threads for large populations.
+ * - percentile() and rankOf(): how a student compares with everyone. A
+ *   FenwickTree counts students per CGPA bucket of width 1/kBucketsPerPoint,
+ *   so both are a prefix sum, O(log buckets), and stay current as
+ *   CGPAs change.
+ * - topInDepartment(): the best N of one department. A per-department
+ *   FenwickTree finds the lowest bucket that still holds one of the top
+ *   N in O(log buckets); only the buckets from there up are read.
+ *
+ * track() attaches the ranking as one of a Student's CgpaObservers, next
+ * to any StandingWatchlist, so every Student::updateCGPA of that object
+ * re-ranks the student, and assigning it another record replaces its
+ * old ID. Students ranked from copies, such as those given to the
+ * constructor, are re-ranked only by update().
+ */
+
+#ifndef CGPA_RANKING_H
+#define CGPA_RANKING_H
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "student.h"
+
+/**
+ * @brief Binary indexed tree of counts over a fixed number of buckets
+ *
+ * add() and prefix() are O(log size).
+ */
+class FenwickTree {
+private:
+    std::vector<int64_t> tree; /**< 1-based partial sums */
+
+public:
+    /** @brief Creates a tree of @p size zero counts */
+    explicit FenwickTree(size_t size = 0) : tree(size + 1, 0) {}
+
+    /** @brief Returns the number of buckets */
+    size_t size() const { return tree.size() - 1; }
+
+    /** @brief Adds @p delta to bucket @p bucket */
+    void add(size_t bucket, int64_t delta) {
+        for (size_t i = bucket + 1; i < tree.size(); i += i & (0 - i)) {
+            tree[i] += delta;
+        }
+    }
+
+    /** @brief Returns the sum of buckets [0, end) */
+    int64_t prefix(size_t end) const {
+        int64_t sum = 0;
+        for (size_t i = end; i > 0; i -= i & (0 - i)) {
+            sum += tree[i];
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Returns the first bucket at which the running sum exceeds @p target
+     *
+     * Counts must be non-negative. Returns size() if the total does not
+     * exceed @p target.
+     */
+    size_t upperBound(int64_t target) const {
+        size_t position = 0;
+        size_t step = 1;
+        while (step * 2 < tree.size()) {
+            step *= 2;
+        }
+        for (; step > 0; step /= 2) {
+            if (position + step < tree.size() && tree[position + step] <= target) {
+                position += step;
+                target -= tree[position];
+            }
+        }
+        return position;
+    }
+};
+
+/**
+ * @brief Students ranked by CGPA, kept current by tracking or update()
+ *
+ * The ranking must outlive the Student objects it tracks, or they must be
+ * detached with Student::removeCgpaObserver first.
+ *
+ * Ties in ranked() and topInDepartment() keep the order students were
+ * first added. Percentiles and ranks compare CGPA buckets, so CGPAs that
+ * differ by less than 1/kBucketsPerPoint may count as equal.
+ *
+ * All methods are thread-safe; queries run concurrently with each other.
+ *
+ * Example usage:
+ * @code
+ * CgpaRanking ranking;
+ * for (Student& student : students) {
+ *     ranking.track(student);
+ * }
+ * student.updateCGPA(8.7f);  // re-ranks the student
+ * double pct = ranking.percentile(student.getStudentId());
+ * std::vector<std::string> honors = ranking.topInDepartment("CSE", 20);
+ * @endcode
+ */
+class CgpaRanking : public CgpaObserver {
+public:
+    static constexpr int kBucketsPerPoint = 100;            /**< Buckets per CGPA point */
+    static constexpr int kBucketCount = 10 * kBucketsPerPoint + 1; /**< Buckets for CGPA 0..10 */
+    static constexpr size_t kParallelThreshold = 1 << 16;   /**< Students from which ranked() uses threads */
+
+private:
+    /** @brief One ranked student */
+    struct Entry {
+        std::string studentId; /**< Student ranked */
+        float cgpa;            /**< CGPA at the last update */
+        int32_t department;    /**< Department id */
+        uint16_t bucket;       /**< Bucket of cgpa */
+        uint32_t slot;         /**< Position in its department bucket's members */
+    };
+
+    /** @brief Counts and members of one department */
+    struct DepartmentIndex {
+        FenwickTree counts{kBucketCount};                  /**< Students per bucket */
+        std::vector<std::vector<uint32_t>> members{kBucketCount}; /**< Entry rows per bucket */
+    };
+
+    mutable std::shared_mutex mutex;                        /**< Guards everything below */
+    std::vector<Entry> entries;                             /**< One per student, in first-added order */
+    std::unordered_map<std::string, uint32_t> rows;         /**< Entry row of each student ID */
+    std::unordered_map<std::string, int32_t> departmentIds; /**< Id of each department name */
+    std::vector<DepartmentIndex> departments;               /**< Index of each department id */
+    FenwickTree overall{kBucketCount};                      /**< Students per bucket, every department */
+    unsigned threads;                                       /**< Threads ranked() may use */
+
+    /** @brief Returns the bucket of a CGPA, clamped to [0, kBucketCount) */
+    static uint16_t bucketOf(float cgpa);
+
+    /** @brief Adds or moves a student; caller holds the unique lock */
+    void place(const Student& student);
+
+    /** @brief Removes a student, shifting later rows down; caller holds the unique lock */
+    bool remove(const std::string& studentId);
+
+public:
+    /**
+     * @brief Ranks @p students
+     *
+     * @param students Students to rank
+     * @param threads Threads ranked() may use; 0 uses every hardware thread
+     */
+    explicit CgpaRanking(const std::vector<Student>& students = {}, unsigned threads = 0);
+
+    CgpaRanking(const CgpaRanking&) = delete;
+    CgpaRanking& operator=(const CgpaRanking&) = delete;
+
+    /**
+     * @brief Records a student's current CGPA and department
+     *
+     * Adds the student if new. Tracked students need no explicit call.
+     * O(log buckets) plus the department lookup.
+     */
+    void update(const Student& student);
+
+    /**
+     * @brief Ranks a student and re-ranks it on every later CGPA change
+     *
+     * Attaches the ranking as one of the student's CgpaObservers.
+     */
+    void track(Student& student);
+
+    /**
+     * @brief Stops ranking a student
+     *
+     * Detaches the ranking from the student and removes its ID. Later
+     * students keep their tie order; O(students).
+     *
+     * @return false if the student's ID was not ranked
+     */
+    bool untrack(Student& student);
+
+    /** @brief Re-ranks a tracked student; called by Student::updateCGPA */
+    void onCgpaChange(const Student& student, float previous) override;
+
+    /** @brief Drops a reassigned student's old ID and ranks the new record; called by Student */
+    void onRecordReplaced(const Student& student, const std::string& previousId, float previous) override;
+
+    /** @brief Returns the number of students ranked */
+    size_t size() const;
+
+    /**
+     * @brief Returns every student ID, highest CGPA first
+     *
+     * Radix sorts the current CGPAs; O(students).
+     */
+    std::vector<std::string> ranked() const;
+
+    /**
+     * @brief Returns the percentage of students with a lower CGPA bucket
+     *
+     * @return A value in [0, 100)
+     * @throws std::out_of_range if the student is not ranked
+     */
+    double percentile(const std::string& studentId) const;
+
+    /**
+     * @brief Returns 1 plus the number of students with a higher CGPA bucket
+     *
+     * @throws std::out_of_range if the student is not ranked
+     */
+    size_t rankOf(const std::string& studentId) const;
+
+    /**
+     * @brief Returns the @p n best students of a department, highest CGPA first
+     *
+     * @return Fewer than @p n IDs if the department is smaller; none if it
+     *         is unknown
+     */
+    std::vector<std::string> topInDepartment(const std::string& department, size_t n) const;
+};
+
+#endif // CGPA_RANKING_H
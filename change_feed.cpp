@@ -0,0 +1,215 @@
+/**
+ * @file change_feed.cpp
+ * @brief Implementation of the enrollment change feed
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include "change_feed.h"
+
+namespace {
+
+// Layout of Slot::header
+const int kKindShift = 32;
+const int kCodeLengthShift = 40;
+const int kIdLengthShift = 48;
+const uint64_t kTruncatedBit = uint64_t(1) << 56;
+
+static_assert(ChangeFeed::kMaxTextBytes < 256, "Text lengths are stored in 8 bits");
+
+} // namespace
+
+// Implementation of ChangeFeed methods
+
+ChangeFeed::ChangeFeed(size_t minCapacity)
+    : capacity([minCapacity] {
+          if (minCapacity == 0) {
+              throw std::invalid_argument("Change feed capacity must be positive");
+          }
+          uint64_t rounded = 1;
+          while (rounded < minCapacity) {
+              rounded <<= 1;
+          }
+          return rounded;
+      }()),
+      slots(new Slot[capacity]) {
+    for (uint64_t i = 0; i < capacity; ++i) {
+        for (auto& word : slots[i].text) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ChangeFeed::publish(CourseHandle handle, const std::string& courseCode,
+                         const std::string& studentId, uint64_t version, EnrollmentEventKind kind) {
+    if (consumerCount.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+
+    size_t codeLength = std::min(courseCode.size(), kMaxTextBytes);
+    size_t idLength = std::min(studentId.size(), kMaxTextBytes - codeLength);
+    bool truncated = codeLength < courseCode.size() || idLength < studentId.size();
+    uint64_t text[kTextWords] = {};
+    std::memcpy(text, courseCode.data(), codeLength);
+    std::memcpy(reinterpret_cast<char*>(text) + codeLength, studentId.data(), idLength);
+    size_t words = (codeLength + idLength + 7) / 8;
+    uint64_t header = uint64_t(handle) | (uint64_t(kind) << kKindShift) |
+                      (uint64_t(codeLength) << kCodeLengthShift) |
+                      (uint64_t(idLength) << kIdLengthShift) | (truncated ? kTruncatedBit : 0);
+
+    uint64_t position = head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[position & (capacity - 1)];
+
+    // The writer of this slot one lap earlier must have finished
+    uint64_t previous = position >= capacity ? 2 * (position - capacity) + 2 : 0;
+    if (slot.stamp.load(std::memory_order_acquire) != previous) {
+        producerWaits.fetch_add(1, std::memory_order_relaxed);
+        while (slot.stamp.load(std::memory_order_acquire) != previous) {
+            std::this_thread::yield();
+        }
+    }
+
+    slot.stamp.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.version.store(version, std::memory_order_relaxed);
+    slot.header.store(header, std::memory_order_relaxed);
+    for (size_t w = 0; w < words; ++w) {
+        slot.text[w].store(text[w], std::memory_order_relaxed);
+    }
+
+    slot.stamp.store(2 * position + 2, std::memory_order_release);
+}
+
+ChangeFeedConsumer ChangeFeed::subscribe() {
+    std::shared_ptr<ConsumerState> state = std::make_shared<ConsumerState>();
+    std::lock_guard<std::mutex> lock(consumersMutex);
+    consumers.push_back(state);
+    consumerCount.fetch_add(1, std::memory_order_acq_rel);
+    // Positions claimed from here on are published, since the count is now non-zero
+    state->cursor.store(head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    return ChangeFeedConsumer(this, std::move(state));
+}
+
+void ChangeFeed::unsubscribe(const std::shared_ptr<ConsumerState>& state) {
+    std::lock_guard<std::mutex> lock(consumersMutex);
+    auto stateIt = std::find(consumers.begin(), consumers.end(), state);
+    if (stateIt != consumers.end()) {
+        consumers.erase(stateIt);
+        consumerCount.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+ChangeFeedStats ChangeFeed::stats() const {
+    ChangeFeedStats result;
+    result.capacity = capacity;
+    result.published = head.load(std::memory_order_acquire);
+    result.producerWaits = producerWaits.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(consumersMutex);
+    result.consumers = consumers.size();
+    for (const auto& state : consumers) {
+        uint64_t cursor = state->cursor.load(std::memory_order_relaxed);
+        result.maxLag = std::max(result.maxLag, result.published - std::min(cursor, result.published));
+        result.dropped += state->dropped.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// Implementation of ChangeFeedConsumer methods
+
+ChangeFeedConsumer::ChangeFeedConsumer(ChangeFeed* feed, std::shared_ptr<ChangeFeed::ConsumerState> state)
+    : feed(feed), state(std::move(state)) {}
+
+ChangeFeedConsumer::ChangeFeedConsumer(ChangeFeedConsumer&& other) noexcept
+    : feed(other.feed), state(std::move(other.state)) {
+    other.feed = nullptr;
+}
+
+ChangeFeedConsumer& ChangeFeedConsumer::operator=(ChangeFeedConsumer&& other) noexcept {
+    if (this != &other) {
+        if (feed && state) {
+            feed->unsubscribe(state);
+        }
+        feed = other.feed;
+        state = std::move(other.state);
+        other.feed = nullptr;
+    }
+    return *this;
+}
+
+ChangeFeedConsumer::~ChangeFeedConsumer() {
+    if (feed && state) {
+        feed->unsubscribe(state);
+    }
+}
+
+size_t ChangeFeedConsumer::poll(std::vector<EnrollmentEvent>& events, size_t maxEvents) {
+    if (!feed) {
+        return 0;
+    }
+    const uint64_t capacity = feed->capacity;
+    uint64_t cursor = state->cursor.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (count < maxEvents) {
+        const ChangeFeed::Slot& slot = feed->slots[cursor & (capacity - 1)];
+        uint64_t expected = 2 * cursor + 2;
+        uint64_t before = slot.stamp.load(std::memory_order_acquire);
+        if (before < expected) {
+            break; // not written yet
+        }
+
+        uint64_t version = 0;
+        uint64_t header = 0;
+        uint64_t text[ChangeFeed::kTextWords];
+        if (before == expected) {
+            version = slot.version.load(std::memory_order_relaxed);
+            header = slot.header.load(std::memory_order_relaxed);
+            // Clamped because a header torn by an overwrite may hold any lengths
+            size_t length = std::min(((header >> kCodeLengthShift) & 0xff) + ((header >> kIdLengthShift) & 0xff),
+                                     ChangeFeed::kMaxTextBytes);
+            for (size_t w = 0; w < (length + 7) / 8; ++w) {
+                text[w] = slot.text[w].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        if (before != expected || slot.stamp.load(std::memory_order_relaxed) != before) {
+            // Lapped: skip to the oldest position a producer cannot be about to overwrite
+            uint64_t head = feed->head.load(std::memory_order_acquire);
+            uint64_t resume = std::max(cursor + 1, head > capacity ? head - capacity + 1 : 0);
+            state->dropped.fetch_add(resume - cursor, std::memory_order_relaxed);
+            cursor = resume;
+            continue;
+        }
+
+        size_t codeLength = (header >> kCodeLengthShift) & 0xff;
+        size_t idLength = (header >> kIdLengthShift) & 0xff;
+        const char* chars = reinterpret_cast<const char*>(text);
+        events.push_back(EnrollmentEvent{cursor, version, static_cast<CourseHandle>(header & 0xffffffff),
+                                         static_cast<EnrollmentEventKind>((header >> kKindShift) & 0xff),
+                                         (header & kTruncatedBit) != 0,
+                                         std::string(chars, codeLength),
+                                         std::string(chars + codeLength, idLength)});
+        ++cursor;
+        ++count;
+    }
+    state->cursor.store(cursor, std::memory_order_relaxed);
+    state->delivered.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+ChangeFeedConsumerStats ChangeFeedConsumer::stats() const {
+    ChangeFeedConsumerStats result;
+    if (!feed) {
+        return result;
+    }
+    uint64_t head = feed->head.load(std::memory_order_acquire);
+    uint64_t cursor = state->cursor.load(std::memory_order_relaxed);
+    result.delivered = state->delivered.load(std::memory_order_relaxed);
+    result.dropped = state->dropped.load(std::memory_order_relaxed);
+    result.lag = head - std::min(cursor, head);
+    return result;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file change_feed.h
+ * @brief Ordered broadcast stream of enrollment changes
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Every roster change the engine commits (registration, withdrawal, cart,
+ * swap, lottery) is appended to a fixed-size ring buffer as an
+ * EnrollmentEvent. Any number of consumers read the ring independently,
+ * each with its own cursor, so billing and LMS provisioning see the same
+ * ordered stream without querying rosters and without slowing each other.
+ *
+ * Producers claim a position with one fetch_add and write the slot under
+ * a per-slot stamp; consumers never lock and never write the ring. The
+ * producer side never waits for consumers: a consumer that falls a whole
+ * ring behind loses the oldest events, is moved forward to the oldest
+ * event still held and has the loss counted in its stats, so it knows to
+ * resynchronize from a roster snapshot. Lag and loss per consumer are the
+ * backpressure signal.
+ *
+ * Events of one course appear in the order their roster changes were
+ * committed, because each is appended with that course's roster locked.
+ * Changes made together (a cart, a swap, one lottery run) share a commit
+ * version.
+ */
+
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "availability_board.h"
+
+/** @brief Kind of roster change carried by an EnrollmentEvent */
+enum class EnrollmentEventKind : uint8_t {
+    ENROLLED,  /**< Student added to the course roster */
+    WITHDRAWN  /**< Student removed from the course roster */
+};
+
+/** @brief One roster change as delivered to a consumer */
+struct EnrollmentEvent {
+    uint64_t sequence;         /**< Position in the feed; consecutive unless events were lost */
+    uint64_t version;          /**< Commit version; shared by the changes of one cart, swap or lottery */
+    CourseHandle handle;       /**< Course changed */
+    EnrollmentEventKind kind;  /**< Enrollment or withdrawal */
+    bool truncated;            /**< Course code and student ID exceeded kMaxTextBytes and were cut */
+    std::string courseCode;    /**< Course changed (the section's code for a sectioned course) */
+    std::string studentId;     /**< Student added or removed */
+};
+
+/** @brief Progress of one consumer */
+struct ChangeFeedConsumerStats {
+    uint64_t delivered = 0; /**< Events returned by poll() */
+    uint64_t dropped = 0;   /**< Events overwritten before this consumer read them */
+    uint64_t lag = 0;       /**< Events published but not yet read */
+};
+
+/** @brief Totals of the feed and its consumers */
+struct ChangeFeedStats {
+    uint64_t capacity = 0;      /**< Events the ring holds */
+    uint64_t published = 0;     /**< Events appended since the feed was enabled */
+    uint64_t consumers = 0;     /**< Consumers subscribed now */
+    uint64_t maxLag = 0;        /**< Lag of the slowest consumer */
+    uint64_t dropped = 0;       /**< Events lost, summed over current consumers */
+    uint64_t producerWaits = 0; /**< Appends that waited for a slot still being written one lap earlier */
+};
+
+class ChangeFeedConsumer;
+
+/**
+ * @brief Lock-free multi-producer ring buffer with independent consumers
+ *
+ * Example usage:
+ * @code
+ * ChangeFeed feed(1 << 16);
+ * ChangeFeedConsumer billing = feed.subscribe();
+ * feed.publish(handle, "CS101", "S1", version, EnrollmentEventKind::ENROLLED);
+ * std::vector<EnrollmentEvent> events;
+ * billing.poll(events);
+ * @endcode
+ */
+class ChangeFeed {
+public:
+    static constexpr size_t kTextWords = 20;                 /**< Words of text per slot */
+    static constexpr size_t kMaxTextBytes = kTextWords * 8;  /**< Room for course code plus student ID */
+
+private:
+    friend class ChangeFeedConsumer;
+
+    /**
+     * @brief One event, stamped with the position it holds
+     *
+     * The stamp is 2p+1 while position p is being written and 2p+2 once it
+     * is complete; every field is atomic so a reader racing an overwrite
+     * sees a changed stamp rather than undefined behaviour.
+     */
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> stamp{0};               /**< Position held, see above */
+        std::atomic<uint64_t> version{0};             /**< Commit version */
+        std::atomic<uint64_t> header{0};              /**< Handle, kind, text lengths, truncated flag */
+        std::atomic<uint64_t> text[kTextWords];       /**< Course code followed by student ID */
+    };
+
+    /** @brief Cursor and counters of one consumer */
+    struct ConsumerState {
+        std::atomic<uint64_t> cursor{0};    /**< Next position to read */
+        std::atomic<uint64_t> delivered{0}; /**< Events returned by poll() */
+        std::atomic<uint64_t> dropped{0};   /**< Events lost to overwrites */
+    };
+
+    const uint64_t capacity;                  /**< Slots in the ring, a power of two */
+    std::unique_ptr<Slot[]> slots;            /**< The ring */
+    alignas(64) std::atomic<uint64_t> head{0}; /**< Next position to claim */
+    std::atomic<uint64_t> producerWaits{0};   /**< Appends that found their slot busy */
+    std::atomic<int> consumerCount{0};        /**< Subscribed consumers */
+
+    mutable std::mutex consumersMutex;                    /**< Guards consumers */
+    std::vector<std::shared_ptr<ConsumerState>> consumers; /**< Subscribed consumers */
+
+    /** @brief Removes a consumer from the stats; called by its destructor */
+    void unsubscribe(const std::shared_ptr<ConsumerState>& state);
+
+public:
+    /**
+     * @brief Creates an empty feed
+     *
+     * @param minCapacity Events the ring must hold; rounded up to a power of two
+     * @throws std::invalid_argument if @p minCapacity is 0
+     */
+    explicit ChangeFeed(size_t minCapacity);
+
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    /**
+     * @brief Appends one event; thread-safe and never blocked by consumers
+     *
+     * Does nothing while no consumer is subscribed.
+     */
+    void publish(CourseHandle handle, const std::string& courseCode, const std::string& studentId,
+                 uint64_t version, EnrollmentEventKind kind);
+
+    /**
+     * @brief Starts a consumer at the current end of the feed
+     *
+     * The consumer sees every event published after this call. It must not
+     * outlive the feed.
+     */
+    ChangeFeedConsumer subscribe();
+
+    /** @brief Returns capacity, throughput and the lag of the slowest consumer */
+    ChangeFeedStats stats() const;
+};
+
+/**
+ * @brief Independent reader of a ChangeFeed
+ *
+ * A consumer is used by one thread at a time; different consumers may be
+ * polled from different threads. Unsubscribes on destruction.
+ */
+class ChangeFeedConsumer {
+private:
+    friend class ChangeFeed;
+
+    ChangeFeed* feed = nullptr;                            /**< Feed read */
+    std::shared_ptr<ChangeFeed::ConsumerState> state;      /**< Cursor and counters */
+
+    ChangeFeedConsumer(ChangeFeed* feed, std::shared_ptr<ChangeFeed::ConsumerState> state);
+
+public:
+    ChangeFeedConsumer() = default;
+    ChangeFeedConsumer(ChangeFeedConsumer&& other) noexcept;
+    ChangeFeedConsumer& operator=(ChangeFeedConsumer&& other) noexcept;
+    ~ChangeFeedConsumer();
+
+    /**
+     * @brief Appends the events published since the last call, in order
+     *
+     * Stops at the first event still being written, so no event is ever
+     * skipped except by an overwrite, which is counted in stats().dropped
+     * and visible as a gap in EnrollmentEvent::sequence.
+     *
+     * @param[out] events Receives the new events
+     * @param maxEvents Most events to return
+     * @return Number of events appended
+     */
+    size_t poll(std::vector<EnrollmentEvent>& events, size_t maxEvents = SIZE_MAX);
+
+    /** @brief Returns this consumer's delivered, dropped and lag counts */
+    ChangeFeedConsumerStats stats() const;
+};
+
+#endif // CHANGE_FEED_H
@@ -14,233 +14,389 @@
  * and administrative requirements.
  */
 
-#include <map>
-#include <set>
+#include <algorithm>
 #include <stdexcept>
-#include <ctime>
-#include "student.h"
-
-/**
- * @brief Represents the registration status for a course
- * 
- * Used to track various states a course registration can be in,
- * from initial registration attempt to final confirmation.
- */
-enum class RegistrationStatus {
-    SUCCESS,            /**< Registration completed successfully */
-    COURSE_FULL,       /**< Course has reached maximum capacity */
-    PREREQ_NOT_MET,    /**< Prerequisites not satisfied */
-    TIME_CONFLICT,     /**< Schedule conflicts with another course */
-    ALREADY_ENROLLED,  /**< Student already enrolled in course */
-    REGISTRATION_CLOSED /**< Registration period has ended */
-};
-
-/**
- * @brief Class managing course registration operations
- * 
- * CourseRegistration handles all aspects of course enrollment including:
- * - Validating registration requirements
- * - Managing course capacities
- * - Handling registration periods
- * - Tracking enrolled students
- */
-class CourseRegistration {
-private:
-    /** @brief Structure to hold course information */
-    struct CourseInfo {
-        std::string courseName;        /**< Name of the course */
-        int maxCapacity;              /**< Maximum number of students allowed */
-        std::set<std::string> prerequisites; /**< List of prerequisite courses */
-        std::set<std::string> enrolledStudents; /**< Currently enrolled students */
-        time_t registrationDeadline;  /**< Deadline for course registration */
-    };
-
-    std::map<std::string, CourseInfo> courses; /**< Database of all courses */
-    
-    /**
-     * @brief Validates if a student meets course prerequisites
-     * 
-     * @param student Reference to the student object
-     * @param courseCode Code of the course to validate
-     * @return true if prerequisites are met
-     * @return false if any prerequisite is missing
-     */
-    bool validatePrerequisites(const Student& student, const std::string& courseCode) const;
-
-public:
-    /**
-     * @brief Adds a new course to the registration system
-     * 
-     * @param courseCode Unique identifier for the course
-     * @param courseName Name of the course
-     * @param capacity Maximum number of students allowed
-     * @param prerequisites List of prerequisite course codes
-     * @param deadline Registration deadline for the course
-     * 
-     * @throws std::invalid_argument if course code already exists
-     * @throws std::out_of_range if capacity is negative
-     * 
-     * Example usage:
-     * @code
-     * CourseRegistration reg;
-     * std::set<std::string> prereqs = {"CS101", "MATH201"};
-     * reg.addCourse("CS201", "Data Structures", 60, prereqs, time(nullptr) + 86400);
-     * @endcode
-     */
-    void addCourse(const std::string& courseCode, 
-                  const std::string& courseName,
-                  int capacity,
-                  const std::set<std::string>& prerequisites,
-                  time_t deadline);
-
-    /**
-     * @brief Registers a student for a course
-     * 
-     * @param student Student attempting to register
-     * @param courseCode Code of the course to register for
-     * @return RegistrationStatus indicating the result of registration attempt
-     * 
-     * @note This method performs several checks:
-     * - Verifies course exists
-     * - Checks course capacity
-     * - Validates prerequisites
-     * - Confirms registration deadline
-     * 
-     * @warning Registration after the deadline will be automatically rejected
-     */
-    RegistrationStatus registerStudent(Student& student, const std::string& courseCode);
-
-    /**
-     * @brief Withdraws a student from a course
-     * 
-     * @param studentId ID of the student to withdraw
-     * @param courseCode Code of the course to withdraw from
-     * @return true if withdrawal was successful
-     * @return false if student wasn't enrolled or course doesn't exist
-     */
-    bool withdrawStudent(const std::string& studentId, const std::string& courseCode);
-
-    /**
-     * @brief Gets current enrollment count for a course
-     * 
-     * @param courseCode Code of the course to check
-     * @return int Number of enrolled students
-     * @throws std::out_of_range if course doesn't exist
-     */
-    int getEnrollmentCount(const std::string& courseCode) const;
-
-    /**
-     * @brief Checks if a course is full
-     * 
-     * @param courseCode Code of the course to check
-     * @return true if course has reached maximum capacity
-     * @return false if there are still seats available
-     * @throws std::out_of_range if course doesn't exist
-     */
-    bool isCourseFull(const std::string& courseCode) const;
-};
+#include "course_registration.h"
+#include "registration_checks.h"
+#include "registration_trace.h"
+#include "roster_snapshot.h"
 
 // Implementation of CourseRegistration methods
 
+CourseRegistration::~CourseRegistration() {
+    if (!executor) {
+        return;
+    }
+    // An await in flight moves between executor tasks and journal callbacks,
+    // and each can hand it back to the other, so settle both until neither
+    // has work left; only then may the members be destroyed
+    for (;;) {
+        executor->drain();
+        if (!journal) {
+            break;
+        }
+        journal->waitIdle();
+        if (executor->idle()) {
+            break;
+        }
+    }
+}
+
 void CourseRegistration::addCourse(const std::string& courseCode,
                                  const std::string& courseName,
                                  int capacity,
                                  const std::set<std::string>& prerequisites,
                                  time_t deadline) {
-    if (courses.find(courseCode) != courses.end()) {
-        throw std::invalid_argument("Course already exists");
-    }
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::ADD_COURSE);
     if (capacity < 0) {
         throw std::out_of_range("Capacity must be non-negative");
     }
-    
-    CourseInfo info{
-        courseName,
-        capacity,
-        prerequisites,
-        std::set<std::string>(),
-        deadline
-    };
-    courses[courseCode] = info;
-}
-
-RegistrationStatus CourseRegistration::registerStudent(Student& student, 
-                                                     const std::string& courseCode) {
-    auto courseIt = courses.find(courseCode);
-    if (courseIt == courses.end()) {
-        throw std::invalid_argument("Course does not exist");
+    // Every roster change must fit in a journal record
+    if (courseCode.size() > RegistrationJournal::kMaxFieldSize) {
+        throw std::invalid_argument("Course code is too long");
     }
 
-    CourseInfo& course = courseIt->second;
+    {
+        std::unique_lock<std::shared_mutex> catalogLock(catalogMutex);
+        auto inserted = courses.try_emplace(courseCode);
+        if (!inserted.second) {
+            throw std::invalid_argument("Course already exists");
+        }
 
-    // Check registration deadline
-    if (time(nullptr) > course.registrationDeadline) {
-        return RegistrationStatus::REGISTRATION_CLOSED;
+        CourseInfo& info = inserted.first->second;
+        info.code = &inserted.first->first;
+        info.handle = board.size();
+        try {
+            board.addCourse(info.handle, capacity);
+        } catch (...) {
+            courses.erase(inserted.first);
+            throw;
+        }
+        info.courseName = courseName;
+        info.maxCapacity = capacity;
+        info.prerequisites = prerequisites;
+        info.registrationDeadline = deadline;
+        info.createdVersion = nextCommitVersion();
+        deadlines.add(deadline, &info.registrationClosed);
     }
 
-    // Check if already enrolled
-    if (course.enrolledStudents.find(student.getStudentId()) != 
-        course.enrolledStudents.end()) {
-        return RegistrationStatus::ALREADY_ENROLLED;
+    if (traceRecorder) {
+        traceRecorder->recordAddCourse(courseCode, courseName, capacity, prerequisites, deadline);
     }
+}
 
-    // Check course capacity
-    if (course.enrolledStudents.size() >= course.maxCapacity) {
-        return RegistrationStatus::COURSE_FULL;
-    }
+RegistrationStatus CourseRegistration::registerStudent(Student& student, 
+                                                     const std::string& courseCode) {
+    return registerStudentWith<DefaultRegistrationChecks>(student, courseCode);
+}
 
-    // Check prerequisites
-    if (!validatePrerequisites(student, courseCode)) {
-        return RegistrationStatus::PREREQ_NOT_MET;
-    }
+RegistrationStatus CourseRegistration::tryRegisterStudent(Student& student,
+                                                        const std::string& courseCode) {
+    return tryRegisterStudentWith<DefaultRegistrationChecks>(student, courseCode);
+}
+
+CartRegistrationResult CourseRegistration::registerCart(Student& student,
+                                                      const std::vector<std::string>& courseCodes) {
+    return registerCartWith<DefaultRegistrationChecks>(student, courseCodes);
+}
 
-    // Register student
-    course.enrolledStudents.insert(student.getStudentId());
-    student.enrollInCourse(courseCode);
-    return RegistrationStatus::SUCCESS;
+RegistrationStatus CourseRegistration::swapCourse(Student& student, const std::string& dropCode,
+                                                const std::string& addCode) {
+    return swapCourseWith<DefaultRegistrationChecks>(student, dropCode, addCode);
 }
 
 bool CourseRegistration::validatePrerequisites(const Student& student, 
                                              const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
     const auto& courseIt = courses.find(courseCode);
     if (courseIt == courses.end()) {
         return false;
     }
 
-    const auto& prereqs = courseIt->second.prerequisites;
-    const auto& completedCourses = student.getEnrolledCourses();
+    // Prerequisites never change after addCourse, so no roster lock is needed
+    return hasPrerequisites(courseIt->second.prerequisites, student);
+}
 
-    for (const auto& prereq : prereqs) {
-        if (std::find(completedCourses.begin(), completedCourses.end(), prereq) 
-            == completedCourses.end()) {
-            return false;
+bool CourseRegistration::withdrawStudent(const std::string& studentId, 
+                                       const std::string& courseCode) {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::WITHDRAW);
+    bool withdrawn = false;
+    {
+        std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+        auto courseIt = courses.find(courseCode);
+        CourseInfo* course = courseIt == courses.end() ? nullptr : &courseIt->second;
+        if (course && course->sections) {
+            course = course->sections->sectionOf(studentId);
+        }
+        if (course) {
+            {
+                std::lock_guard<std::mutex> rosterLock(course->rosterMutex);
+                withdrawn = course->enrolledStudents.erase(studentId) > 0;
+                if (withdrawn) {
+                    publishRosterChange(*course, nextCommitVersion(), studentId, false);
+                }
+            }
+            if (withdrawn) {
+                forgetAdmission(studentId, *course);
+            }
         }
     }
-    return true;
+
+    if (traceRecorder) {
+        traceRecorder->recordWithdraw(studentId, courseCode, withdrawn);
+    }
+    return withdrawn;
 }
 
-bool CourseRegistration::withdrawStudent(const std::string& studentId, 
-                                       const std::string& courseCode) {
+int CourseRegistration::getEnrollmentCount(const std::string& courseCode) const {
+    CourseQueryResult<int> result = tryGetEnrollmentCount(courseCode);
+    if (!result.ok()) {
+        throw std::out_of_range("Course does not exist");
+    }
+    return result.value;
+}
+
+CourseQueryResult<int> CourseRegistration::tryGetEnrollmentCount(const std::string& courseCode) const {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::ENROLLMENT_COUNT);
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
     auto courseIt = courses.find(courseCode);
     if (courseIt == courses.end()) {
-        return false;
+        return {RegistrationStatus::UNKNOWN_COURSE, 0};
+    }
+    const CourseInfo& course = courseIt->second;
+    if (course.sections) {
+        int enrolled = 0;
+        for (size_t s = 0; s < course.sections->sections.size(); ++s) {
+            enrolled += course.sections->enrolled[s].load(std::memory_order_relaxed);
+        }
+        return {RegistrationStatus::SUCCESS, enrolled};
     }
+    return {RegistrationStatus::SUCCESS, board.read(course.handle).enrolled};
+}
 
-    return courseIt->second.enrolledStudents.erase(studentId) > 0;
+bool CourseRegistration::isCourseFull(const std::string& courseCode) const {
+    CourseQueryResult<bool> result = tryIsCourseFull(courseCode);
+    if (!result.ok()) {
+        throw std::out_of_range("Course does not exist");
+    }
+    return result.value;
 }
 
-int CourseRegistration::getEnrollmentCount(const std::string& courseCode) const {
+CourseQueryResult<bool> CourseRegistration::tryIsCourseFull(const std::string& courseCode) const {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::IS_COURSE_FULL);
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
     auto courseIt = courses.find(courseCode);
     if (courseIt == courses.end()) {
-        throw std::out_of_range("Course does not exist");
+        return {RegistrationStatus::UNKNOWN_COURSE, false};
+    }
+    const CourseInfo& course = courseIt->second;
+    if (course.sections) {
+        const SectionGroup& group = *course.sections;
+        for (size_t s = 0; s < group.sections.size(); ++s) {
+            // Held seats are taken, as on the board
+            if (group.enrolled[s].load(std::memory_order_relaxed) +
+                    group.held[s].load(std::memory_order_relaxed) < group.capacities[s]) {
+                return {RegistrationStatus::SUCCESS, false};
+            }
+        }
+        return {RegistrationStatus::SUCCESS, true};
     }
-    return courseIt->second.enrolledStudents.size();
+    return {RegistrationStatus::SUCCESS, board.read(course.handle).seatsLeft == 0};
 }
 
-bool CourseRegistration::isCourseFull(const std::string& courseCode) const {
+CourseQueryResult<CourseHandle> CourseRegistration::getCourseHandle(const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
     auto courseIt = courses.find(courseCode);
     if (courseIt == courses.end()) {
-        throw std::out_of_range("Course does not exist");
+        return {RegistrationStatus::UNKNOWN_COURSE, 0};
+    }
+    return {RegistrationStatus::SUCCESS, courseIt->second.handle};
+}
+
+CourseQueryResult<SeatAvailability>
+CourseRegistration::tryGetSeatAvailability(const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+    auto courseIt = courses.find(courseCode);
+    if (courseIt == courses.end()) {
+        return {RegistrationStatus::UNKNOWN_COURSE, SeatAvailability{}};
     }
-    return courseIt->second.enrolledStudents.size() >= courseIt->second.maxCapacity;
+    const CourseInfo& course = courseIt->second;
+    SeatAvailability seats = board.read(course.handle);
+    if (course.sections) {
+        for (const CourseInfo* section : course.sections->sections) {
+            SeatAvailability sectionSeats = board.read(section->handle);
+            seats.capacity += sectionSeats.capacity;
+            seats.enrolled += sectionSeats.enrolled;
+            seats.held += sectionSeats.held;
+            seats.seatsLeft += sectionSeats.seatsLeft;
+            seats.version = std::max(seats.version, sectionSeats.version);
+        }
+    }
+    return {RegistrationStatus::SUCCESS, seats};
+}
+
+void CourseRegistration::setTraceRecorder(TraceRecorder* recorder) {
+    traceRecorder = recorder;
+    if (traceRecorder) {
+        traceRecorder->recordClock(clock->now());
+    }
+}
+
+std::vector<CourseDemand> CourseRegistration::getTopDemand(RegistrationStatus status, size_t k) const {
+    return demand.topK(status, k);
+}
+
+uint64_t CourseRegistration::estimateDemand(const std::string& courseCode,
+                                            RegistrationStatus status) const {
+    return demand.estimate(courseCode, status);
+}
+
+void CourseRegistration::setAdmissionPolicy(const AdmissionPolicy& policy) {
+    admission.setPolicy(policy);
+}
+
+AdmissionStats CourseRegistration::getAdmissionStats() const {
+    return admission.stats();
+}
+
+void CourseRegistration::setRegistrationWindows(const std::vector<RegistrationWindow>& newWindows) {
+    windows.set(newWindows);
+}
+
+time_t CourseRegistration::getRegistrationOpening(const Student& student) const {
+    return windows.opensAt(student);
+}
+
+void CourseRegistration::enableChangeFeed(size_t capacity) {
+    if (changeFeed) {
+        throw std::logic_error("Change feed is already enabled");
+    }
+    changeFeed.reset(new ChangeFeed(capacity));
+}
+
+ChangeFeedConsumer CourseRegistration::subscribeChanges() {
+    if (!changeFeed) {
+        throw std::logic_error("Change feed is not enabled");
+    }
+    return changeFeed->subscribe();
+}
+
+ChangeFeedStats CourseRegistration::getChangeFeedStats() const {
+    return changeFeed ? changeFeed->stats() : ChangeFeedStats();
+}
+
+void CourseRegistration::enableExecutor(unsigned threads) {
+    if (executor) {
+        throw std::logic_error("Executor is already enabled");
+    }
+    executor.reset(new RegistrationExecutor(threads));
+}
+
+RegistrationExecutor& CourseRegistration::getExecutor() {
+    if (!executor) {
+        throw std::logic_error("Executor is not enabled");
+    }
+    return *executor;
+}
+
+void CourseRegistration::enableJournal(const std::string& path, const JournalOptions& options) {
+    if (journal) {
+        throw std::logic_error("Journal is already enabled");
+    }
+    journal.reset(new RegistrationJournal(path, options));
+}
+
+RegistrationJournal& CourseRegistration::getJournal() {
+    if (!journal) {
+        throw std::logic_error("Journal is not enabled");
+    }
+    return *journal;
+}
+
+MetricsSnapshot CourseRegistration::getMetrics() const {
+    return metrics.snapshot();
+}
+
+void CourseRegistration::setClock(const RegistrationClock* newClock) {
+    clock = newClock;
+}
+
+void CourseRegistration::closeExpiredCourses() {
+    deadlines.advance(clock->now());
+}
+
+RosterSnapshot CourseRegistration::openSnapshot() const {
+    return RosterSnapshot(this, acquireSnapshotVersion());
+}
+
+void CourseRegistration::publishSeats(CourseInfo& course) {
+    const int enrolled = static_cast<int>(course.enrolledStudents.size());
+    const int held = static_cast<int>(course.seatHolds.size());
+    board.publish(course.handle, enrolled, held);
+    if (course.group) {
+        course.group->enrolled[course.sectionIndex].store(enrolled, std::memory_order_relaxed);
+        course.group->held[course.sectionIndex].store(held, std::memory_order_relaxed);
+    }
+}
+
+void CourseRegistration::publishRosterChange(CourseInfo& course, uint64_t version,
+                                            const std::string& studentId, bool added) {
+    if (added && !course.seatHolds.empty()) {
+        dropHold(course, studentId);
+    }
+    publishSeats(course);
+    if (changeFeed) {
+        changeFeed->publish(course.handle, *course.code, studentId, version,
+                            added ? EnrollmentEventKind::ENROLLED : EnrollmentEventKind::WITHDRAWN);
+    }
+    if (journal) {
+        journal->append(version, added ? EnrollmentEventKind::ENROLLED : EnrollmentEventKind::WITHDRAWN,
+                        *course.code, studentId);
+    }
+    if (course.group) {
+        SectionGroup& group = *course.group;
+        SectionGroup::MemberShard& shard = group.shardOf(studentId);
+        std::unique_lock<std::shared_mutex> memberLock(shard.mutex);
+        if (added) {
+            shard.sectionOf[studentId] = course.sectionIndex;
+        } else {
+            // A swap between two sections adds the new one before it removes this one
+            auto memberIt = shard.sectionOf.find(studentId);
+            if (memberIt != shard.sectionOf.end() && memberIt->second == course.sectionIndex) {
+                shard.sectionOf.erase(memberIt);
+            }
+        }
+    }
+
+    // With no snapshot open, any snapshot opened later is at or after this version
+    if (openSnapshotCount.load() == 0) {
+        course.history.clear();
+        return;
+    }
+    uint64_t oldest = oldestSnapshot.load();
+    while (!course.history.empty() && course.history.front().version <= oldest) {
+        course.history.pop_front();
+    }
+    course.history.push_back(RosterChange{version, studentId, added});
+}
+
+uint64_t CourseRegistration::acquireSnapshotVersion() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    // Publish a lower bound before the count so writers never trim past it
+    uint64_t lowerBound = commitVersion.load();
+    if (lowerBound < oldestSnapshot.load()) {
+        oldestSnapshot.store(lowerBound);
+    }
+    openSnapshotCount.fetch_add(1);
+    uint64_t version = commitVersion.load();
+    openSnapshots.insert(version);
+    oldestSnapshot.store(*openSnapshots.begin());
+    return version;
+}
+
+void CourseRegistration::releaseSnapshotVersion(uint64_t version) const {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    openSnapshots.erase(openSnapshots.find(version));
+    oldestSnapshot.store(openSnapshots.empty() ? UINT64_MAX : *openSnapshots.begin());
+    openSnapshotCount.fetch_sub(1);
 }
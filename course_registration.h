@@ -0,0 +1,1150 @@
+/**
+ * @file course_registration.h
+ * @brief Header file containing the CourseRegistration class definition
+ * @author tjkreddy
+ * @date Feb 5, 2025
+ *
+ * This file declares the course registration engine: the registration
+ * status codes and the CourseRegistration class that owns the course
+ * catalog and enrollment rosters. The checks run by registerStudent are
+ * defined in registration_checks.h.
+ */
+
+#ifndef COURSE_REGISTRATION_H
+#define COURSE_REGISTRATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ctime>
+#include "admission_control.h"
+#include "availability_board.h"
+#include "change_feed.h"
+#include "demand_tracker.h"
+#include "lottery_allocation.h"
+#include "registration_clock.h"
+#include "registration_executor.h"
+#include "registration_journal.h"
+#include "registration_metrics.h"
+#include "registration_windows.h"
+#include "roster_archive.h"
+#include "student.h"
+#include "timer_wheel.h"
+
+class TraceRecorder;
+class RosterSnapshot;
+
+/**
+ * @brief Represents the registration status for a course
+ *
+ * Used to track various states a course registration can be in,
+ * from initial registration attempt to final confirmation.
+ */
+enum class RegistrationStatus {
+    SUCCESS,            /**< Registration completed successfully */
+    COURSE_FULL,       /**< Course has reached maximum capacity */
+    PREREQ_NOT_MET,    /**< Prerequisites not satisfied */
+    TIME_CONFLICT,     /**< Schedule conflicts with another course */
+    ALREADY_ENROLLED,  /**< Student already enrolled in course */
+    REGISTRATION_CLOSED, /**< Registration period has ended */
+    UNKNOWN_COURSE,    /**< Course code is not in the catalog */
+    NOT_ENROLLED,      /**< Student is not enrolled in the course to drop */
+    RATE_LIMITED,      /**< Student exceeded the admission rate limit; retry later */
+    REGISTRATION_NOT_OPEN /**< Student's registration window has not opened yet */
+};
+
+/**
+ * @brief Value-or-status result returned by the non-throwing query API
+ *
+ * Holds a value when status is SUCCESS; otherwise status explains why
+ * no value was produced (e.g. UNKNOWN_COURSE) and value is default-initialized.
+ *
+ * @tparam T Type of the query result
+ */
+template <typename T>
+struct CourseQueryResult {
+    RegistrationStatus status; /**< SUCCESS or the reason for failure */
+    T value;                   /**< Query result, valid only on SUCCESS */
+
+    /** @brief Returns true if the query produced a value */
+    bool ok() const { return status == RegistrationStatus::SUCCESS; }
+};
+
+/**
+ * @brief Outcome of an all-or-nothing cart registration
+ *
+ * statuses[i] is the check result for the i-th requested course. When
+ * committed is false no course was registered, even those whose entry is
+ * SUCCESS.
+ */
+struct CartRegistrationResult {
+    bool committed;                          /**< True if the cart was non-empty and every course was registered */
+    std::vector<RegistrationStatus> statuses; /**< Per-course result, in request order */
+};
+
+/**
+ * @brief Class managing course registration operations
+ *
+ * CourseRegistration handles all aspects of course enrollment including:
+ * - Validating registration requirements
+ * - Managing course capacities
+ * - Handling registration periods
+ * - Tracking enrolled students
+ *
+ * All public methods are thread-safe. The catalog is guarded by a
+ * reader-writer lock that only addCourse takes exclusively, and each
+ * course's roster has its own mutex, so registrations for different
+ * courses do not contend. Operations spanning several courses lock their
+ * rosters in address order, so they cannot deadlock with each other.
+ * A given Student object must not be registered from two threads at once.
+ */
+class CourseRegistration {
+private:
+    friend class RosterSnapshot;
+
+    /** @brief One roster change kept for readers of older snapshots */
+    struct RosterChange {
+        uint64_t version;      /**< Commit version of the change */
+        std::string studentId; /**< Student added or removed */
+        bool added;            /**< True for an enrollment, false for a removal */
+    };
+
+    struct CourseInfo;
+
+    /** @brief A seat held for one student until its timer fires */
+    struct SeatHold {
+        TimerId timer;    /**< Expiry timer in holdTimers */
+        time_t expiresAt; /**< Time the hold lapses */
+    };
+
+    /** @brief What a hold expiry timer carries back: the seat to release */
+    struct HoldTimer {
+        CourseInfo* course = nullptr; /**< Course the seat is held in */
+        std::string studentId;        /**< Student holding the seat */
+    };
+
+    /**
+     * @brief Sections of one course and their seat counts
+     *
+     * Enrollment and hold counts of all sections sit in contiguous arrays,
+     * so picking the least-loaded section reads a few cache lines without
+     * taking any lock. Each count is stored by the section's roster writer
+     * (publishSeats); the section list itself only grows under the
+     * exclusive catalog lock.
+     *
+     * The member map is read on every registration, hold and cart item
+     * for a section, but written only when a student joins or leaves one,
+     * so each shard is guarded by a shared_mutex that readers hold shared.
+     * The same shards record which section a student holds a seat in, so a
+     * hold and a later registration through the parent code meet in one
+     * section.
+     */
+    struct SectionGroup {
+        static const size_t kMaxSections = 64;  /**< Sections per course */
+        static const size_t kMemberShards = 16; /**< Shards of the member map */
+
+        /** @brief Students of the sections mapped to one shard */
+        struct alignas(64) MemberShard {
+            mutable std::shared_mutex mutex;                       /**< Guards both maps; readers hold it shared */
+            std::unordered_map<std::string, uint32_t> sectionOf; /**< Section index by student ID */
+            std::unordered_map<std::string, uint32_t> heldIn;    /**< Section of each student's held seat */
+        };
+
+        const std::string* parentCode = nullptr; /**< Code of the course the sections belong to */
+        std::vector<CourseInfo*> sections;  /**< Section courses, by index */
+        std::vector<std::string> codes;     /**< Code of each section */
+        std::vector<int> capacities;        /**< Capacity of each section */
+        std::vector<std::string> departments; /**< Department a section is reserved for, or empty */
+        std::unique_ptr<std::atomic<int>[]> enrolled{new std::atomic<int>[kMaxSections]()}; /**< Enrollment of each section */
+        std::unique_ptr<std::atomic<int>[]> held{new std::atomic<int>[kMaxSections]()}; /**< Seats held in each section */
+        std::unique_ptr<MemberShard[]> members{new MemberShard[kMemberShards]}; /**< Which section each student is in */
+        std::atomic<uint32_t> heldCount{0}; /**< Entries across every shard's heldIn */
+
+        /** @brief Returns the member shard of @p studentId */
+        MemberShard& shardOf(const std::string& studentId) const;
+
+        /** @brief Returns the section @p studentId is enrolled in, or nullptr */
+        CourseInfo* sectionOf(const std::string& studentId) const;
+
+        /** @brief Returns the section @p studentId holds a seat in, or nullptr */
+        CourseInfo* heldSectionOf(const std::string& studentId) const;
+
+        /**
+         * @brief Records that a student's hold on a section began or ended
+         *
+         * Must be called with that section's roster locked. Ending a hold
+         * leaves a hold recorded on another section alone.
+         */
+        void noteHold(const std::string& studentId, uint32_t section, bool held);
+
+        /**
+         * @brief Returns the least-loaded section open to @p department
+         *
+         * Load is enrolled plus held seats over capacity; ties go to the
+         * first section at or after @p start, so concurrent students
+         * spread out.
+         *
+         * @param skipped Bit i set to ignore section i
+         * @return Section with a free seat, or nullptr if there is none
+         */
+        CourseInfo* leastLoaded(const std::string& department, size_t start, uint64_t skipped) const;
+
+        /**
+         * @brief Returns the section a student gets through the parent code
+         *
+         * The section the student holds a seat in, unless skipped; else
+         * leastLoaded. Skips the held-seat lookup while no section of the
+         * group has a hold.
+         */
+        CourseInfo* choose(const std::string& studentId, const std::string& department, size_t start,
+                           uint64_t skipped) const;
+    };
+
+    /** @brief Structure to hold course information */
+    struct CourseInfo {
+        const std::string* code = nullptr; /**< Key of this entry in courses */
+        std::string courseName;        /**< Name of the course */
+        int maxCapacity;              /**< Maximum number of students allowed */
+        std::set<std::string> prerequisites; /**< List of prerequisite courses */
+        std::set<std::string> enrolledStudents; /**< Currently enrolled students */
+        time_t registrationDeadline;  /**< Deadline for course registration */
+        std::atomic<bool> registrationClosed{false}; /**< Set by the deadline index once the deadline passes */
+        mutable std::mutex rosterMutex; /**< Guards enrolledStudents and history */
+        uint64_t createdVersion = 0;  /**< Commit version of addCourse */
+        CourseHandle handle = 0;      /**< Index of the course on the availability board */
+        std::deque<RosterChange> history; /**< Changes newer than the oldest open snapshot */
+        std::unique_ptr<SectionGroup> sections; /**< Sections, if this is a sectioned course */
+        SectionGroup* group = nullptr;  /**< Parent's sections, if this is a section */
+        uint32_t sectionIndex = 0;      /**< Index within group */
+        std::unordered_map<std::string, SeatHold> seatHolds; /**< Held seats by student ID; guarded by rosterMutex */
+    };
+
+    std::map<std::string, CourseInfo> courses; /**< Database of all courses */
+    mutable std::shared_mutex catalogMutex;   /**< Guards the courses map */
+    const RegistrationClock* clock = &CoarseClock::shared(); /**< Time source for deadlines */
+    DeadlineIndex deadlines;                  /**< Closes courses as their deadlines pass */
+    TraceRecorder* traceRecorder = nullptr;   /**< Optional call recorder */
+    mutable RegistrationMetrics metrics;      /**< Status counters and latency histograms */
+    AvailabilityBoard board;                  /**< Lock-free published seat counts */
+    DemandTracker demand;                     /**< Attempt counts by course and status */
+    AdmissionController admission;            /**< Rate limits and replays retried registrations */
+    RegistrationWindows windows;              /**< Opening time of each student cohort */
+    std::unique_ptr<ChangeFeed> changeFeed;   /**< Enrollment event stream, once enabled */
+
+    std::mutex holdMutex;                     /**< Guards holdTimers; taken after roster locks */
+    TimerWheel<HoldTimer> holdTimers;         /**< Expiry of every seat hold */
+    std::atomic<time_t> nextHoldExpiry{std::numeric_limits<time_t>::max()}; /**< No hold lapses before this */
+
+    std::atomic<uint64_t> commitVersion{0};   /**< Version of the latest roster or catalog change */
+    mutable std::mutex snapshotMutex;         /**< Guards openSnapshots */
+    mutable std::multiset<uint64_t> openSnapshots; /**< Versions of open snapshots */
+    mutable std::atomic<int> openSnapshotCount{0}; /**< Size of openSnapshots */
+    mutable std::atomic<uint64_t> oldestSnapshot{UINT64_MAX}; /**< Lower bound of open snapshot versions */
+
+    std::unique_ptr<RegistrationJournal> journal; /**< Durable log of roster changes, once enabled */
+
+    // Declared last so its workers finish before the catalog is destroyed; the
+    // destructor settles it with the journal before either is destroyed
+    std::unique_ptr<RegistrationExecutor> executor; /**< Runs async calls, once enabled */
+
+    /**
+     * @brief Assigns the commit version of a roster change
+     *
+     * Called with the rosters of every course the change touches locked,
+     * so a snapshot at or after this version sees the whole change.
+     */
+    uint64_t nextCommitVersion() { return commitVersion.fetch_add(1) + 1; }
+
+    /**
+     * @brief Publishes a course's enrolled and held seat counts
+     *
+     * Updates the availability board and, for a section, its group's
+     * counts. Must be called with the course's roster locked.
+     */
+    void publishSeats(CourseInfo& course);
+
+    /**
+     * @brief Publishes a roster change to the board, change feed, journal and snapshots
+     *
+     * Must be called with the course's roster locked, after the roster has
+     * been updated. An enrollment ends the student's hold on the course, if
+     * any. The change is kept for open snapshots, if there are any, and
+     * history no open snapshot can still need is dropped.
+     */
+    void publishRosterChange(CourseInfo& course, uint64_t version,
+                            const std::string& studentId, bool added);
+
+    /**
+     * @brief Returns whether a student is in another section of @p course's parent
+     *
+     * A student takes at most one section of a course, whichever code they
+     * register with; false if @p course is not a section.
+     */
+    static bool inOtherSection(const CourseInfo& course, const std::string& studentId) {
+        if (!course.group) {
+            return false;
+        }
+        const CourseInfo* section = course.group->sectionOf(studentId);
+        return section && section != &course;
+    }
+
+    /** @brief Returns the code a Student records an enrollment in @p course under */
+    static const std::string& recordedCode(const CourseInfo& course) {
+        return course.group ? *course.group->parentCode : *course.code;
+    }
+
+    /**
+     * @brief Drops the replayable outcomes a change to the student's roster makes stale
+     *
+     * A retry may name a section or its parent course, so both are dropped.
+     */
+    void forgetAdmission(const std::string& studentId, const CourseInfo& course) {
+        admission.forget(studentId, *course.code);
+        if (course.group) {
+            admission.forget(studentId, *course.group->parentCode);
+        }
+    }
+
+    /**
+     * @brief Runs @p Checks on one course and enrolls the student if they pass
+     *
+     * Takes the course's roster lock; the catalog lock must be held shared.
+     */
+    template <typename Checks>
+    RegistrationStatus enrollWith(Student& student, const std::string& studentId,
+                                  CourseInfo& course, time_t now);
+
+    /**
+     * @brief Enrolls a student in the least-loaded section that accepts them
+     *
+     * A section the student holds a seat in is tried first. Moves on to
+     * the next least-loaded section when the chosen one fills up before
+     * its roster lock is taken.
+     */
+    template <typename Checks>
+    RegistrationStatus enrollInSectionWith(Student& student, const std::string& studentId,
+                                           SectionGroup& group, time_t now);
+
+    /**
+     * @brief Returns the least-loaded section of @p group in a lottery draft
+     *
+     * @param open Bit i set if section i is open to the student
+     * @param start Ties go to the first section at or after this index
+     * @param seatsLeft Draft seat counts by course handle
+     * @return Handle of a section with a seat left, or UINT32_MAX
+     */
+    static CourseHandle leastLoadedSection(const SectionGroup& group, uint64_t open, size_t start,
+                                           const std::vector<int>& seatsLeft);
+
+    /** @brief Body of swapCourseWith; the caller counts the status it returns, and its demand */
+    template <typename Checks>
+    RegistrationStatus swapCourseChecked(Student& student, const std::string& dropCode,
+                                         const std::string& addCode);
+
+    /**
+     * @brief Releases every hold that lapsed by @p now
+     *
+     * Costs one atomic load and compare unless a hold may have lapsed.
+     * Must be called without the catalog lock held.
+     */
+    void advanceHolds(time_t now) {
+        if (now >= nextHoldExpiry.load(std::memory_order_acquire)) {
+            releaseExpiredHolds(now);
+        }
+    }
+
+    /** @brief Fires the hold timers due by @p now and frees their seats */
+    void releaseExpiredHolds(time_t now);
+
+    /**
+     * @brief Holds or renews a seat in one course that has no sections
+     *
+     * Takes the course's roster lock; the catalog lock must be held shared.
+     */
+    CourseQueryResult<time_t> holdIn(const Student& student, const std::string& studentId,
+                                     CourseInfo& course, time_t now, time_t expiresAt);
+
+    /**
+     * @brief Returns the course a hold named by @p course is kept in
+     *
+     * A sectioned course resolves to the section the student holds a seat
+     * in, or nullptr; any other course is itself.
+     */
+    template <typename Course>
+    static Course* holdCourse(Course& course, const std::string& studentId) {
+        return course.sections ? course.sections->heldSectionOf(studentId) : &course;
+    }
+
+    /**
+     * @brief Drops a student's hold on a course and cancels its timer
+     *
+     * Must be called with the course's roster locked.
+     *
+     * @return false if the student held no seat in the course
+     */
+    bool dropHold(CourseInfo& course, const std::string& studentId);
+
+    /** @brief Registers a new snapshot and returns its version */
+    uint64_t acquireSnapshotVersion() const;
+
+    /** @brief Unregisters a snapshot opened by acquireSnapshotVersion */
+    void releaseSnapshotVersion(uint64_t version) const;
+
+    /**
+     * @brief Validates if a student meets course prerequisites
+     *
+     * @param student Reference to the student object
+     * @param courseCode Code of the course to validate
+     * @return true if prerequisites are met
+     * @return false if any prerequisite is missing
+     */
+    bool validatePrerequisites(const Student& student, const std::string& courseCode) const;
+
+public:
+    /**
+     * @brief Destroys the engine once its async calls in flight have finished
+     *
+     * With the executor enabled, every coroutine awaiting one of the
+     * engine's calls is resumed first, including those waiting for the
+     * journal to sync their changes; a coroutine that awaits again from
+     * there is run to its next resumption too. No thread outside the
+     * executor may call into the engine once destruction starts.
+     */
+    ~CourseRegistration();
+
+    /**
+     * @brief Adds a new course to the registration system
+     *
+     * @param courseCode Unique identifier for the course
+     * @param courseName Name of the course
+     * @param capacity Maximum number of students allowed
+     * @param prerequisites List of prerequisite course codes
+     * @param deadline Registration deadline for the course
+     *
+     * @throws std::invalid_argument if course code already exists or is
+     *         longer than RegistrationJournal::kMaxFieldSize bytes
+     * @throws std::out_of_range if capacity is negative
+     *
+     * Example usage:
+     * @code
+     * CourseRegistration reg;
+     * std::set<std::string> prereqs = {"CS101", "MATH201"};
+     * reg.addCourse("CS201", "Data Structures", 60, prereqs, time(nullptr) + 86400);
+     * @endcode
+     */
+    void addCourse(const std::string& courseCode,
+                  const std::string& courseName,
+                  int capacity,
+                  const std::set<std::string>& prerequisites,
+                  time_t deadline);
+
+    /**
+     * @brief Adds a section to an existing course
+     *
+     * The section is a course of its own, with its own code, roster and
+     * capacity, and shares the parent's name, prerequisites and deadline.
+     * Once a course has sections, registerStudent on the parent code puts
+     * the student in the least-loaded section open to their department,
+     * and the parent's own capacity drops to zero.
+     *
+     * @param parentCode Code of the course the section belongs to
+     * @param sectionCode Unique code of the section, e.g. "CS101-03"
+     * @param capacity Seats in the section
+     * @param department Department the section is reserved for; empty for
+     *        a section open to every student
+     *
+     * @throws std::invalid_argument if the parent doesn't exist, is itself a
+     *         section or has students enrolled directly, or if sectionCode
+     *         already exists or is longer than RegistrationJournal::kMaxFieldSize
+     *         bytes
+     * @throws std::out_of_range if capacity is negative
+     * @throws std::length_error if the parent already has
+     *         SectionGroup::kMaxSections sections
+     *
+     * Example usage:
+     * @code
+     * reg.addCourse("CS101", "Intro to Programming", 0, {}, deadline);
+     * for (int s = 1; s <= 20; ++s) {
+     *     reg.addSection("CS101", "CS101-" + std::to_string(s), 40);
+     * }
+     * reg.registerStudent(student, "CS101");  // picks the emptiest section
+     * @endcode
+     */
+    void addSection(const std::string& parentCode, const std::string& sectionCode,
+                    int capacity, const std::string& department = "");
+
+    /**
+     * @brief Returns the section of a sectioned course a student is in
+     *
+     * @param studentId ID of the student
+     * @param courseCode Code of the parent course
+     * @return Section code; NOT_ENROLLED if the student is in no section,
+     *         UNKNOWN_COURSE if the course doesn't exist or has no sections
+     */
+    CourseQueryResult<std::string> getSection(const std::string& studentId,
+                                              const std::string& courseCode) const;
+
+    /**
+     * @brief Registers a student for a course
+     *
+     * @param student Student attempting to register
+     * @param courseCode Code of the course to register for
+     * @return RegistrationStatus indicating the result of registration attempt
+     * @throws std::invalid_argument if course doesn't exist
+     *
+     * @note This method runs DefaultRegistrationChecks, in order:
+     * - Confirms registration deadline
+     * - Checks the student is not already enrolled
+     * - Checks course capacity
+     * - Validates prerequisites
+     *
+     * @warning Registration after the deadline will be automatically rejected.
+     * Deadlines are evaluated against the engine clock (see setClock), which
+     * by default lags the system time by at most 50 ms.
+     *
+     * For a course with sections (see addSection), the student is placed in
+     * the least-loaded section they may take and recorded in the Student
+     * under the parent code; COURSE_FULL means no such section has a seat.
+     * A section code may also be registered for directly; it is recorded
+     * under the parent code too, and a student already in another section
+     * of the course gets ALREADY_ENROLLED. The same holds for carts, swaps,
+     * holds and lotteries.
+     *
+     * With an admission policy set (see setAdmissionPolicy), a retry of a
+     * recent request returns the earlier status without running the checks,
+     * and a student over the rate limit gets RATE_LIMITED.
+     *
+     * With registration windows set (see setRegistrationWindows), a student
+     * whose window has not opened gets REGISTRATION_NOT_OPEN.
+     */
+    RegistrationStatus registerStudent(Student& student, const std::string& courseCode);
+
+    /**
+     * @brief Registers a student for a course using a custom check pipeline
+     *
+     * Runs the checks of @p Checks (a CheckPipeline from registration_checks.h)
+     * in order and enrolls the student if all of them pass. The pipeline is
+     * resolved at compile time, so each rule set inlines into a single
+     * function without virtual dispatch.
+     *
+     * @tparam Checks CheckPipeline listing the check policies to apply
+     * @param student Student attempting to register
+     * @param courseCode Code of the course to register for
+     * @return RegistrationStatus of the first failing check, or SUCCESS
+     * @throws std::invalid_argument if course doesn't exist
+     *
+     * @note Defined in registration_checks.h, which must be included to
+     * instantiate a pipeline other than the default.
+     *
+     * Example usage:
+     * @code
+     * using SummerTermChecks = CheckPipeline<DeadlineCheck, CapacityCheck>;
+     * reg.registerStudentWith<SummerTermChecks>(student, "CS201");
+     * @endcode
+     */
+    template <typename Checks>
+    RegistrationStatus registerStudentWith(Student& student, const std::string& courseCode);
+
+    /**
+     * @brief Registers a student for a course without throwing
+     *
+     * Same checks and effects as registerStudent, but an unknown course
+     * code is reported as RegistrationStatus::UNKNOWN_COURSE instead of an
+     * exception. Prefer this overload on paths exposed to untrusted input,
+     * where invalid codes are common and exception unwinding is costly.
+     *
+     * @param student Student attempting to register
+     * @param courseCode Code of the course to register for
+     * @return RegistrationStatus indicating the result of registration attempt
+     */
+    RegistrationStatus tryRegisterStudent(Student& student, const std::string& courseCode);
+
+    /**
+     * @brief Non-throwing form of registerStudentWith
+     *
+     * @tparam Checks CheckPipeline listing the check policies to apply
+     * @param student Student attempting to register
+     * @param courseCode Code of the course to register for
+     * @return RegistrationStatus of the first failing check, UNKNOWN_COURSE,
+     *         or SUCCESS
+     *
+     * @note Defined in registration_checks.h.
+     */
+    template <typename Checks>
+    RegistrationStatus tryRegisterStudentWith(Student& student, const std::string& courseCode);
+
+    /**
+     * @brief Registers a student for several courses atomically
+     *
+     * Locks every requested course, runs DefaultRegistrationChecks on each
+     * and either registers the student for all of them or for none. No
+     * other registration can take a seat between the checks and the
+     * commit, so a failed cart never holds seats it does not keep.
+     * Duplicate codes in the cart are reported as ALREADY_ENROLLED and
+     * unknown codes as UNKNOWN_COURSE; either aborts the cart. Before the
+     * student's registration window opens, every course is reported as
+     * REGISTRATION_NOT_OPEN. An empty cart is not committed.
+     *
+     * @param student Student attempting to register
+     * @param courseCodes Codes of the courses in the cart
+     * @return CartRegistrationResult with the per-course check results
+     *
+     * @note Prerequisites are evaluated against the student's courses
+     * before the cart, so a cart course cannot satisfy another's
+     * prerequisite. Cart calls are not written to an attached trace.
+     *
+     * Example usage:
+     * @code
+     * CartRegistrationResult r = reg.registerCart(student, {"CS201", "MATH201", "PHY101"});
+     * if (!r.committed) { ... inspect r.statuses ... }
+     * @endcode
+     */
+    CartRegistrationResult registerCart(Student& student, const std::vector<std::string>& courseCodes);
+
+    /**
+     * @brief Atomic cart registration using a custom check pipeline
+     *
+     * @tparam Checks CheckPipeline listing the check policies to apply
+     * @note Defined in registration_checks.h.
+     * @see registerCart
+     */
+    template <typename Checks>
+    CartRegistrationResult registerCartWith(Student& student, const std::vector<std::string>& courseCodes);
+
+    /**
+     * @brief Atomically drops one course and adds another
+     *
+     * Locks both rosters, runs DefaultRegistrationChecks on the new course
+     * and, only if they pass, moves the student from the old course to the
+     * new one. The old seat stays held until the new one is secured, so a
+     * failed swap leaves the student where they were and a successful one
+     * never exposes the freed seat before the student holds the new seat.
+     * Only the two courses involved are locked.
+     *
+     * @param student Student swapping courses
+     * @param dropCode Code of the course to leave; the code of a sectioned
+     *        course drops the student's section
+     * @param addCode Code of the course to join
+     * @return SUCCESS if the swap happened; UNKNOWN_COURSE if either code
+     *         is unknown; NOT_ENROLLED if the student is not in the old
+     *         course; ALREADY_ENROLLED if both codes name the same course;
+     *         REGISTRATION_NOT_OPEN before the student's registration
+     *         window; otherwise the failing check for the new course
+     *
+     * @note Like withdrawStudent, the dropped course stays in the Student's
+     * own course list. Swaps are not written to an attached trace.
+     */
+    RegistrationStatus swapCourse(Student& student, const std::string& dropCode,
+                                  const std::string& addCode);
+
+    /**
+     * @brief Atomic course swap using a custom check pipeline
+     *
+     * @tparam Checks CheckPipeline applied to the course being added
+     * @note Defined in registration_checks.h.
+     * @see swapCourse
+     */
+    template <typename Checks>
+    RegistrationStatus swapCourseWith(Student& student, const std::string& dropCode,
+                                      const std::string& addCode);
+
+    /**
+     * @brief Withdraws a student from a course
+     *
+     * @param studentId ID of the student to withdraw
+     * @param courseCode Code of the course to withdraw from; for a course
+     *        with sections, withdraws from the student's section
+     * @return true if withdrawal was successful
+     * @return false if student wasn't enrolled or course doesn't exist
+     */
+    bool withdrawStudent(const std::string& studentId, const std::string& courseCode);
+
+    /**
+     * @brief Gets current enrollment count for a course
+     *
+     * Reads the availability board, so no roster lock is taken. For a
+     * course with sections, sums the enrollment of every section.
+     *
+     * @param courseCode Code of the course to check
+     * @return int Number of enrolled students
+     * @throws std::out_of_range if course doesn't exist
+     */
+    int getEnrollmentCount(const std::string& courseCode) const;
+
+    /**
+     * @brief Gets current enrollment count for a course without throwing
+     *
+     * @param courseCode Code of the course to check
+     * @return Enrollment count, or status UNKNOWN_COURSE if course doesn't exist
+     */
+    CourseQueryResult<int> tryGetEnrollmentCount(const std::string& courseCode) const;
+
+    /**
+     * @brief Checks if a course is full
+     *
+     * Reads the availability board, so no roster lock is taken. A course
+     * with sections is full when every section is.
+     *
+     * @param courseCode Code of the course to check
+     * @return true if course has reached maximum capacity
+     * @return false if there are still seats available
+     * @throws std::out_of_range if course doesn't exist
+     */
+    bool isCourseFull(const std::string& courseCode) const;
+
+    /**
+     * @brief Starts or stops recording calls into a trace
+     *
+     * While a recorder is attached, every successful addCourse and
+     * addSection and every registerStudent / withdrawStudent call (including the try* forms)
+     * is recorded with its outcome. Pass nullptr to stop recording.
+     * Install the engine clock (setClock) before attaching a recorder.
+     *
+     * @param recorder Recorder to use; must outlive its attachment
+     * @warning Must not be called concurrently with other methods
+     */
+    void setTraceRecorder(TraceRecorder* recorder);
+
+    /**
+     * @brief Replaces the clock used to evaluate registration deadlines
+     *
+     * The default is CoarseClock::shared(). Install a ManualClock to drive
+     * deadlines deterministically in tests and benchmarks.
+     *
+     * @param newClock Clock to use; must outlive the engine
+     * @warning Must not be called concurrently with other methods
+     */
+    void setClock(const RegistrationClock* newClock);
+
+    /**
+     * @brief Closes every course whose deadline has passed on the engine clock
+     *
+     * Registration calls do this lazily; calling it explicitly is only
+     * needed to make the closed state visible to custom checks right after
+     * advancing a ManualClock.
+     */
+    void closeExpiredCourses();
+
+    /**
+     * @brief Holds a seat in a course for a student for a limited time
+     *
+     * Runs DefaultRegistrationChecks and, if they pass, sets a seat aside
+     * for the student until @p ttl seconds from now on the engine clock. A
+     * held seat counts as taken for everybody else: CapacityCheck, the
+     * availability board and allocateLottery all leave it out. The student
+     * claims it with any registration call for the course (registerStudent,
+     * registerCart, swapCourse), which passes the capacity check even when
+     * every other seat is gone and ends the hold. Holding again while a
+     * hold is active renews it from now.
+     *
+     * Lapsed holds are released by a timer wheel as the engine clock
+     * passes them, each at O(1) cost, on the next registration, hold or
+     * expireHolds() call; their seats go straight back to the pool without
+     * any scan of courses or holds.
+     *
+     * @param student Student the seat is for
+     * @param courseCode Code of the course, or of one section of a course
+     *        with sections. The parent code of a sectioned course renews the
+     *        student's hold on one of its sections if there is one, and
+     *        otherwise holds a seat in the least-loaded section open to the
+     *        student's department, as registerStudent would pick. A later
+     *        registration through the parent code takes the held seat
+     * @param ttl Seconds the hold lasts
+     * @return Time the hold lapses on SUCCESS; otherwise the failing check,
+     *         ALREADY_ENROLLED if the student is in a section of the course,
+     *         COURSE_FULL if no section open to them has a seat,
+     *         REGISTRATION_NOT_OPEN before the student's registration
+     *         window, or UNKNOWN_COURSE if the course doesn't exist
+     * @throws std::out_of_range if @p ttl is not positive
+     * @note Holds are not written to an attached trace, snapshots or the
+     * change feed; only enrollments are.
+     *
+     * Example usage:
+     * @code
+     * CourseQueryResult<time_t> hold = reg.holdSeat(student, "CS201", 10 * 60);
+     * if (hold.ok()) {
+     *     // ... student decides within ten minutes ...
+     *     reg.registerStudent(student, "CS201");  // takes the held seat
+     * }
+     * @endcode
+     */
+    CourseQueryResult<time_t> holdSeat(const Student& student, const std::string& courseCode, time_t ttl);
+
+    /**
+     * @brief Gives up a held seat before it lapses
+     *
+     * @param studentId ID of the student holding the seat
+     * @param courseCode Code of the course the seat is held in, or the
+     *        parent code of its section
+     * @return false if the student holds no seat in the course
+     */
+    bool releaseHold(const std::string& studentId, const std::string& courseCode);
+
+    /**
+     * @brief Returns when a student's hold on a course lapses
+     *
+     * The parent code of a sectioned course reports the hold on its
+     * section, as releaseHold does.
+     *
+     * @return Expiry time; NOT_ENROLLED if the student holds no seat (or
+     *         the hold has lapsed), UNKNOWN_COURSE if the course doesn't exist
+     */
+    CourseQueryResult<time_t> getHoldExpiry(const std::string& studentId,
+                                            const std::string& courseCode) const;
+
+    /**
+     * @brief Releases every hold that has lapsed on the engine clock
+     *
+     * Registration and hold calls do this lazily; calling it explicitly
+     * only makes released seats visible to board pollers sooner.
+     */
+    void expireHolds();
+
+    /**
+     * @brief Assigns seats from ranked preferences by lottery, in one batch
+     *
+     * Runs random serial dictatorship (see lottery_allocation.h): students
+     * are shuffled with options.seed and, in that order, each gets the
+     * best-ranked course that has a free seat and whose deadline,
+     * prerequisite and already-enrolled checks pass. With
+     * options.coursesPerStudent above 1 the order is walked once per
+     * round, reversing direction every round; only a single round is
+     * strategy-proof. A student gets at most one section of a course; a
+     * sectioned course named by its parent code is assigned the
+     * least-loaded section open to the student.
+     *
+     * Seats already taken count against capacity, so a lottery can run
+     * while registerStudent stays open. The rosters of every requested
+     * course are locked while the seats are assigned. All assignments
+     * commit together under one snapshot version.
+     *
+     * Eligibility checks and the commit run on options.threads threads;
+     * only the draft itself is sequential, over integer arrays.
+     *
+     * @param entries One entry per student; a Student may appear only once
+     *        and must not be registered concurrently
+     * @param options Lottery seed, seats per student and thread count
+     * @return Courses assigned to each entry and how often each rank was
+     *         satisfied
+     *
+     * Example usage:
+     * @code
+     * std::vector<LotteryEntry> entries = {{&alice, {"CS101", "MATH101"}},
+     *                                      {&bob, {"CS101", "PHYS101"}}};
+     * LotteryOptions options;
+     * options.seed = 2026;
+     * LotteryResult result = reg.allocateLottery(entries, options);
+     * @endcode
+     */
+    LotteryResult allocateLottery(const std::vector<LotteryEntry>& entries,
+                                  const LotteryOptions& options);
+
+    /**
+     * @brief Sets the per-student admission limits applied by registerStudent
+     *
+     * Each student gets a token bucket refilled at policy.tokensPerSecond,
+     * holding up to policy.burst tokens; a registration spends one token or
+     * fails with RATE_LIMITED. A request for the same course that returned
+     * SUCCESS or ALREADY_ENROLLED less than policy.idempotencyWindow seconds
+     * ago returns that answer again and spends no token; refusals are not
+     * replayed. Both are off by default.
+     *
+     * Only registerStudent and tryRegisterStudent (and their With forms)
+     * are admission-controlled; carts and swaps are not limited. Replayed
+     * and rate-limited requests are counted in the metrics but not traced.
+     *
+     * @param policy Limits to apply; zero fields disable that limit
+     * @warning Must not be called concurrently with other methods; clears
+     *          all per-student admission state
+     *
+     * Example usage:
+     * @code
+     * // 2 registrations/s with bursts of 10; retries within 5 s are replayed
+     * reg.setAdmissionPolicy({2, 10, 5});
+     * @endcode
+     */
+    void setAdmissionPolicy(const AdmissionPolicy& policy);
+
+    /** @brief Returns how many requests the admission layer admitted, replayed and refused */
+    AdmissionStats getAdmissionStats() const;
+
+    /**
+     * @brief Staggers when each cohort of students may start registering
+     *
+     * A cohort is a semester and an academic standing. Until the engine
+     * clock reaches its cohort's opening time, a student's registerStudent,
+     * registerCart and swapCourse calls fail with REGISTRATION_NOT_OPEN
+     * without taking any lock; the check is one table lookup. Cohorts no
+     * window covers may register at any time, and a course's own deadline
+     * still applies once a window opens. allocateLottery ignores windows.
+     *
+     * Requests refused this way are counted in the metrics but not traced.
+     *
+     * @param windows Opening times; an empty list removes all windows
+     * @throws std::invalid_argument if a window has an empty semester range
+     *         or starts after RegistrationWindows::kMaxSemester; a window
+     *         ending before semester 1 covers nobody and is ignored
+     *
+     * Example usage:
+     * @code
+     * std::vector<RegistrationWindow> windows;
+     * for (AcademicStanding standing : {AcademicStanding::EXCELLENT, AcademicStanding::GOOD,
+     *                                   AcademicStanding::SATISFACTORY, AcademicStanding::PROBATION}) {
+     *     windows.push_back({7, INT_MAX, standing, opening});  // final years first
+     *     windows.push_back({1, 6, standing, opening + 3600}); // everyone else an hour later
+     * }
+     * // Students on probation last; the later window wins
+     * windows.push_back({1, INT_MAX, AcademicStanding::PROBATION, opening + 7200});
+     * reg.setRegistrationWindows(windows);
+     * @endcode
+     */
+    void setRegistrationWindows(const std::vector<RegistrationWindow>& windows);
+
+    /**
+     * @brief Returns when registration opens for a student
+     *
+     * @param student Student to look up
+     * @return Opening time of the student's cohort, or the smallest time_t
+     *         if the cohort may register at any time
+     */
+    time_t getRegistrationOpening(const Student& student) const;
+
+    /**
+     * @brief Returns the engine's status counters and latency histograms
+     *
+     * Sums the per-thread metric shards; safe to call while other threads
+     * register. Returns an all-zero snapshot when the engine is built with
+     * COURSE_REGISTRATION_METRICS=0.
+     *
+     * Example usage:
+     * @code
+     * MetricsSnapshot m = reg.getMetrics();
+     * uint64_t full = m.count(RegistrationStatus::COURSE_FULL);
+     * uint64_t p99 = m.of(MetricOperation::REGISTER).percentile(0.99);
+     * @endcode
+     */
+    MetricsSnapshot getMetrics() const;
+
+    /**
+     * @brief Opens a consistent point-in-time view of every roster
+     *
+     * The snapshot sees exactly the registrations committed before it was
+     * opened, including whole carts and swaps, and nothing after, however
+     * long it is kept open. Registrations continue at full speed; while a
+     * snapshot is open each roster change also keeps a small undo record,
+     * which is dropped once no snapshot needs it.
+     *
+     * @return RosterSnapshot (declared in roster_snapshot.h)
+     *
+     * Example usage:
+     * @code
+     * RosterSnapshot snapshot = reg.openSnapshot();
+     * snapshot.forEachCourse([](const std::string& code, const std::set<std::string>& roster) {
+     *     report(code, roster.size());
+     * });
+     * @endcode
+     */
+    RosterSnapshot openSnapshot() const;
+
+    /**
+     * @brief Freezes every roster into a compressed archive of the term
+     *
+     * Reads all rosters at one commit version through a snapshot, so it
+     * may run while registration is still open, and encodes each as an
+     * ArchivedRoster. Students are interned in @p directory, which is meant
+     * to be shared by every archived term so each ID is stored once. The
+     * engine can be destroyed afterwards; the archive does not refer to it.
+     *
+     * @param directory Student directory the archive's handles refer to;
+     *        must outlive the returned term
+     * @return ArchivedTerm (declared in roster_archive.h)
+     *
+     * Example usage:
+     * @code
+     * StudentDirectory directory;
+     * std::vector<ArchivedTerm> history;
+     * history.push_back(fall2025.archiveTerm(directory));
+     * bool audited = history[0].wasEnrolled("S1", "CS201");
+     * @endcode
+     */
+    ArchivedTerm archiveTerm(StudentDirectory& directory) const;
+
+    /**
+     * @brief Looks up the availability board handle of a course
+     *
+     * Handles are stable for the lifetime of the engine, so pollers resolve
+     * each watched course once and then read the board directly.
+     *
+     * @param courseCode Code of the course
+     * @return Course handle, or UNKNOWN_COURSE if the course doesn't exist
+     */
+    CourseQueryResult<CourseHandle> getCourseHandle(const std::string& courseCode) const;
+
+    /**
+     * @brief Reads the seat availability of a course, sections included
+     *
+     * A course split into sections has no seats of its own on the board;
+     * its answer is the sum of its sections' entries.
+     *
+     * @param courseCode Code of the course or of one section
+     * @return Seat availability, or UNKNOWN_COURSE if the course doesn't exist
+     */
+    CourseQueryResult<SeatAvailability> tryGetSeatAvailability(const std::string& courseCode) const;
+
+    /**
+     * @brief Returns the published seat availability of every course
+     *
+     * Reading the board takes no lock and never touches the rosters.
+     *
+     * Example usage:
+     * @code
+     * CourseHandle cs201 = reg.getCourseHandle("CS201").value;
+     * int seatsLeft = reg.getAvailabilityBoard().read(cs201).seatsLeft;
+     * @endcode
+     */
+    const AvailabilityBoard& getAvailabilityBoard() const { return board; }
+
+    /**
+     * @brief Starts streaming every roster change into a ring of @p capacity events
+     *
+     * Once enabled, each enrollment and withdrawal committed by any
+     * operation, including carts, swaps, lotteries and sections, is
+     * appended to the change feed with its course's roster locked. Appends
+     * cost a few atomic operations and are skipped while nobody is
+     * subscribed. See change_feed.h for ordering and loss guarantees.
+     *
+     * @param capacity Events kept for slow consumers; rounded up to a power of two
+     * @throws std::invalid_argument if @p capacity is 0
+     * @throws std::logic_error if the feed is already enabled
+     * @warning Must not be called concurrently with other methods
+     */
+    void enableChangeFeed(size_t capacity = 65536);
+
+    /**
+     * @brief Subscribes a new consumer to the change feed
+     *
+     * The consumer receives every change committed after this call, in
+     * commit order per course, until it is destroyed. It must not outlive
+     * the engine.
+     *
+     * @return ChangeFeedConsumer (declared in change_feed.h)
+     * @throws std::logic_error if enableChangeFeed has not been called
+     *
+     * Example usage:
+     * @code
+     * reg.enableChangeFeed();
+     * ChangeFeedConsumer billing = reg.subscribeChanges();
+     * std::vector<EnrollmentEvent> events;
+     * while (running) {
+     *     events.clear();
+     *     billing.poll(events);
+     *     for (const EnrollmentEvent& e : events) { ... }
+     *     if (billing.stats().dropped) { ... resynchronize from openSnapshot() ... }
+     * }
+     * @endcode
+     */
+    ChangeFeedConsumer subscribeChanges();
+
+    /** @brief Returns change feed throughput and consumer lag; all zero until enabled */
+    ChangeFeedStats getChangeFeedStats() const;
+
+    /**
+     * @brief Starts the executor that runs the awaitables of registration_async.h
+     *
+     * The executor's workers run the engine calls of suspended coroutines,
+     * serialized per course (see registration_executor.h), and resume the
+     * coroutines when the calls return. It is stopped when the engine is
+     * destroyed, once every awaiting coroutine has been resumed.
+     *
+     * @param threads Worker threads; 0 means one per hardware thread
+     * @throws std::logic_error if the executor is already enabled
+     * @warning Must not be called concurrently with other methods
+     */
+    void enableExecutor(unsigned threads = 0);
+
+    /**
+     * @brief Returns the executor started by enableExecutor
+     *
+     * @throws std::logic_error if enableExecutor has not been called
+     */
+    RegistrationExecutor& getExecutor();
+
+    /**
+     * @brief Starts journaling every roster change to a file
+     *
+     * Once enabled, each enrollment and withdrawal committed by any
+     * operation is appended to the journal with its course's roster
+     * locked, so a course's changes are journaled in commit order. Calls
+     * still return once the change is committed in memory; a caller that
+     * must not acknowledge a change before it is on disk waits for the
+     * journal, e.g. getJournal().sync() after registerStudent, or awaits
+     * registration_async.h, whose awaitables resume only once the call's
+     * changes are durable. Only roster changes are journaled; the catalog
+     * and seat holds are not.
+     *
+     * @param path Journal file, created if missing and appended to otherwise
+     * @param options Backend selection; see registration_journal.h
+     * @throws std::logic_error if a journal is already enabled
+     * @throws std::runtime_error if the journal cannot be opened
+     * @warning Must not be called concurrently with other methods
+     */
+    void enableJournal(const std::string& path, const JournalOptions& options = JournalOptions());
+
+    /** @brief Returns whether enableJournal has been called */
+    bool hasJournal() const { return journal != nullptr; }
+
+    /**
+     * @brief Returns the journal started by enableJournal
+     *
+     * @throws std::logic_error if enableJournal has not been called
+     */
+    RegistrationJournal& getJournal();
+
+    /**
+     * @brief Returns the courses with the most registration attempts ending in a status
+     *
+     * Counts come from a fixed-size count-min sketch, so they may slightly
+     * overstate a course's attempts but never understate them. Every
+     * registerStudent, registerCart course and swapCourse add is counted.
+     *
+     * @param status Outcome to rank by
+     * @param k Number of courses to return (at most DemandTracker::kTopCapacity)
+     * @return Up to @p k courses, most attempts first
+     *
+     * Example usage:
+     * @code
+     * // Where would an extra section help most?
+     * for (const CourseDemand& d : reg.getTopDemand(RegistrationStatus::COURSE_FULL, 5)) {
+     *     std::cout << d.courseCode << ": " << d.attempts << " turned away" << std::endl;
+     * }
+     * @endcode
+     */
+    std::vector<CourseDemand> getTopDemand(RegistrationStatus status, size_t k) const;
+
+    /**
+     * @brief Returns the estimated number of attempts on a course ending in a status
+     *
+     * @return Estimate from the demand sketch; never below the true count
+     */
+    uint64_t estimateDemand(const std::string& courseCode, RegistrationStatus status) const;
+
+    /**
+     * @brief Checks if a course is full without throwing
+     *
+     * @param courseCode Code of the course to check
+     * @return Whether the course is full, or status UNKNOWN_COURSE if course
+     *         doesn't exist
+     */
+    CourseQueryResult<bool> tryIsCourseFull(const std::string& courseCode) const;
+};
+
+#endif // COURSE_REGISTRATION_H
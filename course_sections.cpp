@@ -0,0 +1,199 @@
+/**
+ * @file course_sections.cpp
+ * @brief Implementation of multi-section courses
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A section is an ordinary course entry (own roster, lock, board entry and
+ * deadline flag) linked to its parent's SectionGroup. Registering for the
+ * parent code picks a section from the group's packed enrollment counts
+ * and then takes only that section's roster lock, so 20 sections spread
+ * a popular course over 20 locks instead of one. A section the student
+ * holds a seat in is picked before any other.
+ */
+
+#include <functional>
+#include <stdexcept>
+#include "course_registration.h"
+#include "registration_trace.h"
+
+// Implementation of CourseRegistration::SectionGroup methods
+
+CourseRegistration::SectionGroup::MemberShard&
+CourseRegistration::SectionGroup::shardOf(const std::string& studentId) const {
+    return members[std::hash<std::string>()(studentId) % kMemberShards];
+}
+
+CourseRegistration::CourseInfo*
+CourseRegistration::SectionGroup::sectionOf(const std::string& studentId) const {
+    MemberShard& shard = shardOf(studentId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto memberIt = shard.sectionOf.find(studentId);
+    return memberIt == shard.sectionOf.end() ? nullptr : sections[memberIt->second];
+}
+
+CourseRegistration::CourseInfo*
+CourseRegistration::SectionGroup::heldSectionOf(const std::string& studentId) const {
+    MemberShard& shard = shardOf(studentId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto heldIt = shard.heldIn.find(studentId);
+    return heldIt == shard.heldIn.end() ? nullptr : sections[heldIt->second];
+}
+
+void CourseRegistration::SectionGroup::noteHold(const std::string& studentId, uint32_t section, bool held) {
+    MemberShard& shard = shardOf(studentId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (held) {
+        if (shard.heldIn.insert_or_assign(studentId, section).second) {
+            heldCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+    auto heldIt = shard.heldIn.find(studentId);
+    if (heldIt != shard.heldIn.end() && heldIt->second == section) {
+        shard.heldIn.erase(heldIt);
+        heldCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+CourseRegistration::CourseInfo*
+CourseRegistration::SectionGroup::leastLoaded(const std::string& department, size_t start,
+                                              uint64_t skipped) const {
+    const size_t count = sections.size();
+    size_t best = count;
+    int bestTaken = 0;
+    int bestCapacity = 1;
+    for (size_t k = 0; k < count; ++k) {
+        size_t s = (start + k) % count;
+        if ((skipped >> s) & 1) {
+            continue;
+        }
+        if (!departments[s].empty() && departments[s] != department) {
+            continue;
+        }
+        // Held seats are taken, as on the board
+        int taken = enrolled[s].load(std::memory_order_relaxed) + held[s].load(std::memory_order_relaxed);
+        if (taken >= capacities[s]) {
+            continue;
+        }
+        // taken / capacities[s] < bestTaken / bestCapacity, without division
+        if (best == count || static_cast<int64_t>(taken) * bestCapacity <
+                                 static_cast<int64_t>(bestTaken) * capacities[s]) {
+            best = s;
+            bestTaken = taken;
+            bestCapacity = capacities[s];
+        }
+    }
+    return best == count ? nullptr : sections[best];
+}
+
+CourseRegistration::CourseInfo*
+CourseRegistration::SectionGroup::choose(const std::string& studentId, const std::string& department,
+                                         size_t start, uint64_t skipped) const {
+    if (heldCount.load(std::memory_order_relaxed) != 0) {
+        CourseInfo* held = heldSectionOf(studentId);
+        if (held && !((skipped >> held->sectionIndex) & 1)) {
+            return held;
+        }
+    }
+    return leastLoaded(department, start, skipped);
+}
+
+// Implementation of CourseRegistration section methods
+
+void CourseRegistration::addSection(const std::string& parentCode, const std::string& sectionCode,
+                                    int capacity, const std::string& department) {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::ADD_COURSE);
+    if (capacity < 0) {
+        throw std::out_of_range("Capacity must be non-negative");
+    }
+    if (sectionCode.size() > RegistrationJournal::kMaxFieldSize) {
+        throw std::invalid_argument("Course code is too long");
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> catalogLock(catalogMutex);
+        auto parentIt = courses.find(parentCode);
+        if (parentIt == courses.end()) {
+            throw std::invalid_argument("Course does not exist");
+        }
+        CourseInfo& parent = parentIt->second;
+        if (parent.group) {
+            throw std::invalid_argument("Course is a section");
+        }
+        // Roster writers hold the catalog lock shared, so the roster is stable here
+        if (!parent.enrolledStudents.empty()) {
+            throw std::invalid_argument("Course has students enrolled directly");
+        }
+        if (parent.sections && parent.sections->sections.size() >= SectionGroup::kMaxSections) {
+            throw std::length_error("Course has too many sections");
+        }
+
+        auto inserted = courses.try_emplace(sectionCode);
+        if (!inserted.second) {
+            throw std::invalid_argument("Course already exists");
+        }
+        CourseInfo& section = inserted.first->second;
+        section.code = &inserted.first->first;
+        section.handle = board.size();
+        try {
+            // Reserved up front so adding a section below cannot throw
+            if (!parent.sections) {
+                std::unique_ptr<SectionGroup> group(new SectionGroup);
+                group->parentCode = parent.code;
+                group->sections.reserve(SectionGroup::kMaxSections);
+                group->codes.reserve(SectionGroup::kMaxSections);
+                group->capacities.reserve(SectionGroup::kMaxSections);
+                group->departments.reserve(SectionGroup::kMaxSections);
+                parent.sections = std::move(group);
+            }
+            board.addCourse(section.handle, capacity);
+        } catch (...) {
+            courses.erase(inserted.first);
+            throw;
+        }
+        section.courseName = parent.courseName;
+        section.maxCapacity = capacity;
+        section.prerequisites = parent.prerequisites;
+        section.registrationDeadline = parent.registrationDeadline;
+        section.createdVersion = nextCommitVersion();
+        deadlines.add(section.registrationDeadline, &section.registrationClosed);
+
+        SectionGroup& group = *parent.sections;
+        section.group = &group;
+        section.sectionIndex = static_cast<uint32_t>(group.sections.size());
+        group.sections.push_back(&section);
+        group.codes.push_back(sectionCode);
+        group.capacities.push_back(capacity);
+        group.departments.push_back(department);
+        group.enrolled[section.sectionIndex].store(0, std::memory_order_relaxed);
+        group.held[section.sectionIndex].store(0, std::memory_order_relaxed);
+        for (size_t m = 0; m < SectionGroup::kMemberShards; ++m) {
+            group.members[m].sectionOf.reserve(group.members[m].sectionOf.size() +
+                                               capacity / SectionGroup::kMemberShards + 1);
+        }
+
+        // Seats now live in the sections only
+        parent.maxCapacity = 0;
+        board.setCapacity(parent.handle, 0);
+    }
+
+    if (traceRecorder) {
+        traceRecorder->recordAddSection(parentCode, sectionCode, capacity, department);
+    }
+}
+
+CourseQueryResult<std::string> CourseRegistration::getSection(const std::string& studentId,
+                                                              const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+    auto courseIt = courses.find(courseCode);
+    if (courseIt == courses.end() || !courseIt->second.sections) {
+        return {RegistrationStatus::UNKNOWN_COURSE, ""};
+    }
+    const SectionGroup& group = *courseIt->second.sections;
+    const CourseInfo* section = group.sectionOf(studentId);
+    if (!section) {
+        return {RegistrationStatus::NOT_ENROLLED, ""};
+    }
+    return {RegistrationStatus::SUCCESS, group.codes[section->sectionIndex]};
+}
@@ -0,0 +1,128 @@
+/**
+ * @file demand_tracker.cpp
+ * @brief Implementation of the count-min demand sketch and heavy hitters
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <functional>
+#include "demand_tracker.h"
+
+// Implementation of DemandTracker methods
+
+DemandTracker::DemandTracker() : shards(new Shard[kShardCount]), tables(new TopTable[kStatusCount]) {
+    for (size_t s = 0; s < kStatusCount; ++s) {
+        tables[s].codes.resize(kTopCapacity);
+    }
+}
+
+DemandTracker::Shard& DemandTracker::localShard() {
+    static std::atomic<unsigned> nextShard{0};
+    thread_local unsigned shardIndex =
+        nextShard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+    return shards[shardIndex];
+}
+
+uint64_t DemandTracker::keyHash(const std::string& courseCode, RegistrationStatus status) {
+    // splitmix64 finalizer over the string hash and the status
+    uint64_t h = std::hash<std::string>()(courseCode) +
+                 (static_cast<uint64_t>(status) + 1) * 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h ? h : 1;
+}
+
+uint64_t DemandTracker::estimateHash(uint64_t hash) const {
+    // Row i uses h1 + i * h2 (Kirsch-Mitzenmacher double hashing)
+    uint32_t h1 = static_cast<uint32_t>(hash);
+    uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+    uint64_t result = UINT64_MAX;
+    for (int row = 0; row < kDepth; ++row) {
+        uint32_t column = (h1 + row * h2) & (kWidth - 1);
+        uint64_t count = 0;
+        for (int s = 0; s < kShardCount; ++s) {
+            count += shards[s].counters[row * kWidth + column].load(std::memory_order_relaxed);
+        }
+        result = std::min(result, count);
+    }
+    return result;
+}
+
+void DemandTracker::record(const std::string& courseCode, RegistrationStatus status) {
+    uint64_t hash = keyHash(courseCode, status);
+    uint32_t h1 = static_cast<uint32_t>(hash);
+    uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+    Shard& shard = localShard();
+    for (int row = 0; row < kDepth; ++row) {
+        uint32_t column = (h1 + row * h2) & (kWidth - 1);
+        shard.counters[row * kWidth + column].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TopTable& table = tables[static_cast<size_t>(status)];
+    for (const auto& key : table.keys) {
+        if (key.load(std::memory_order_relaxed) == hash) {
+            return;
+        }
+    }
+    // One shard's counts would miss a course whose attempts are spread over threads
+    const uint64_t estimate = estimateHash(hash);
+    if (estimate <= table.threshold.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+    size_t victim = kTopCapacity;
+    uint64_t victimEstimate = UINT64_MAX;
+    for (size_t slot = 0; slot < kTopCapacity; ++slot) {
+        uint64_t key = table.keys[slot].load(std::memory_order_relaxed);
+        if (key == hash) {
+            return;
+        }
+        uint64_t slotEstimate = key ? estimateHash(key) : 0;
+        if (slotEstimate < victimEstimate) {
+            victim = slot;
+            victimEstimate = slotEstimate;
+        }
+    }
+    if (estimate <= victimEstimate) {
+        table.threshold.store(victimEstimate, std::memory_order_relaxed);
+        return;
+    }
+    table.keys[victim].store(hash, std::memory_order_relaxed);
+    table.codes[victim] = courseCode;
+
+    // Counts only grow, so a stale threshold just sends more callers here
+    uint64_t threshold = UINT64_MAX;
+    for (const auto& key : table.keys) {
+        uint64_t member = key.load(std::memory_order_relaxed);
+        threshold = std::min(threshold, member ? estimateHash(member) : 0);
+    }
+    table.threshold.store(threshold, std::memory_order_relaxed);
+}
+
+uint64_t DemandTracker::estimate(const std::string& courseCode, RegistrationStatus status) const {
+    return estimateHash(keyHash(courseCode, status));
+}
+
+std::vector<CourseDemand> DemandTracker::topK(RegistrationStatus status, size_t k) const {
+    TopTable& table = tables[static_cast<size_t>(status)];
+    std::vector<CourseDemand> result;
+    {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        for (size_t slot = 0; slot < kTopCapacity; ++slot) {
+            uint64_t key = table.keys[slot].load(std::memory_order_relaxed);
+            if (key) {
+                result.push_back({table.codes[slot], estimateHash(key)});
+            }
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const CourseDemand& a, const CourseDemand& b) {
+        return a.attempts > b.attempts || (a.attempts == b.attempts && a.courseCode < b.courseCode);
+    });
+    if (result.size() > k) {
+        result.resize(k);
+    }
+    return result;
+}
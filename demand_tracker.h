@@ -0,0 +1,119 @@
+/**
+ * @file demand_tracker.h
+ * @brief Streaming per-course demand counts and top-K by registration status
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Registration attempts are counted in a count-min sketch keyed by
+ * (course, status): kDepth rows of kWidth 64-bit counters. The sketch is
+ * split into kShardCount copies like RegistrationMetrics, and each thread
+ * increments only its own copy, so threads recording the same hot course
+ * do not contend on the same cache lines. An estimate sums a counter over
+ * every shard, giving the counter of a single unsharded sketch, and takes
+ * the minimum over the kDepth rows. It therefore never undercounts the
+ * attempts recorded before the call, and overcounts by at most e/kWidth
+ * of all attempts with probability 1 - e^-kDepth.
+ *
+ * Alongside the sketch, every status keeps a table of its kTopCapacity
+ * heaviest courses. A course enters the table once its estimate beats
+ * the table's smallest member; attempts on courses already in the table,
+ * or on courses too light to enter it, take no lock.
+ *
+ * Memory is fixed by the constants below, whatever the catalog size:
+ * kShardCount * kDepth * kWidth * 8 bytes, 1 MiB, for the sketch.
+ */
+
+#ifndef DEMAND_TRACKER_H
+#define DEMAND_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "registration_metrics.h"
+
+/** @brief Estimated attempt count of one course */
+struct CourseDemand {
+    std::string courseCode; /**< Course the attempts were for */
+    uint64_t attempts;      /**< Estimated attempts; never below the true count */
+};
+
+/**
+ * @brief Count-min sketch plus per-status heavy hitters
+ *
+ * Example usage:
+ * @code
+ * DemandTracker demand;
+ * demand.record("CS201", RegistrationStatus::COURSE_FULL);
+ * std::vector<CourseDemand> top = demand.topK(RegistrationStatus::COURSE_FULL, 10);
+ * @endcode
+ */
+class DemandTracker {
+public:
+    static const int kDepth = 4;               /**< Sketch rows (hash functions) */
+    static const uint32_t kWidth = 4096;       /**< Counters per row; a power of two */
+    static const size_t kTopCapacity = 64;     /**< Heavy hitters kept per status */
+    static const int kShardCount = 8;          /**< Sketch copies threads are spread over */
+
+private:
+    /** @brief Sketch counters incremented by the threads mapped to one shard */
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kDepth * kWidth> counters{}; /**< Row-major counters */
+    };
+
+    /** @brief Heavy-hitter candidates of one status */
+    struct TopTable {
+        std::array<std::atomic<uint64_t>, kTopCapacity> keys{}; /**< Key hashes of members, 0 if free */
+        std::atomic<uint64_t> threshold{0};  /**< Smallest member estimate when the table is full */
+        std::mutex mutex;                    /**< Guards codes and membership changes */
+        std::vector<std::string> codes;      /**< Course code of each keys slot */
+    };
+
+    std::unique_ptr<Shard[]> shards;     /**< kShardCount sketch copies */
+    std::unique_ptr<TopTable[]> tables;  /**< One table per RegistrationStatus */
+
+    /** @brief Returns the calling thread's shard */
+    Shard& localShard();
+
+    /** @brief Hashes a (course, status) key; never returns 0 */
+    static uint64_t keyHash(const std::string& courseCode, RegistrationStatus status);
+
+    /** @brief Returns the sketch estimate of a key hash, summed over every shard */
+    uint64_t estimateHash(uint64_t hash) const;
+
+public:
+    DemandTracker();
+
+    /**
+     * @brief Counts one registration attempt
+     *
+     * Safe to call from any number of threads. Increments kDepth counters
+     * of the calling thread's shard; a course not yet in the status's
+     * heavy-hitter table is also estimated across all shards.
+     *
+     * @param courseCode Course the attempt was for
+     * @param status Outcome of the attempt
+     */
+    void record(const std::string& courseCode, RegistrationStatus status);
+
+    /**
+     * @brief Returns the estimated number of attempts on a course with a status
+     *
+     * @return Estimate; never below the number of attempts recorded before the call
+     */
+    uint64_t estimate(const std::string& courseCode, RegistrationStatus status) const;
+
+    /**
+     * @brief Returns the courses with the most attempts ending in @p status
+     *
+     * @param status Outcome to rank by, e.g. COURSE_FULL
+     * @param k Number of courses to return; at most kTopCapacity are tracked
+     * @return Up to @p k courses, heaviest first
+     */
+    std::vector<CourseDemand> topK(RegistrationStatus status, size_t k) const;
+};
+
+#endif // DEMAND_TRACKER_H
@@ -0,0 +1,565 @@
+/**
+ * @file history_store.cpp
+ * @brief Implementation of the columnar history store
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "history_store.h"
+
+/** @brief First bytes of a history store file */
+struct HistoryFileHeader {
+    char magic[8];                 /**< "CRHIST01" */
+    uint32_t termCount;            /**< Entries in the term table */
+    uint32_t blockCount;           /**< Entries in the block table */
+    uint64_t rowCount;             /**< Rows in every column */
+    uint32_t courseCount;          /**< Strings in the course table */
+    uint32_t studentCount;         /**< Strings in the student table */
+    uint64_t termsOffset;          /**< HistoryTermEntry[termCount] */
+    uint64_t blocksOffset;         /**< HistoryBlockEntry[blockCount] */
+    uint64_t studentColumnOffset;  /**< uint32_t[rowCount] */
+    uint64_t courseColumnOffset;   /**< uint32_t[rowCount] */
+    uint64_t gradeColumnOffset;    /**< float[rowCount] */
+    uint64_t cgpaColumnOffset;     /**< float[rowCount] */
+    uint64_t courseStringsOffset;  /**< uint32_t offsets[courseCount + 1], then the characters */
+    uint64_t studentStringsOffset; /**< uint32_t offsets[studentCount + 1], then the characters */
+};
+
+/** @brief One term: a contiguous range of blocks and rows */
+struct HistoryTermEntry {
+    int32_t year;        /**< Year of the term */
+    uint8_t season;      /**< TermSeason */
+    uint8_t padding[3];  /**< Zero */
+    uint32_t firstBlock; /**< First block of the term */
+    uint32_t blockCount; /**< Blocks of the term */
+    uint64_t firstRow;   /**< First row of the term */
+    uint64_t rowCount;   /**< Rows of the term */
+    float minGrade;      /**< Zone map: lowest grade in the term */
+    float maxGrade;      /**< Zone map: highest grade in the term */
+    float minCgpa;       /**< Zone map: lowest CGPA in the term */
+    float maxCgpa;       /**< Zone map: highest CGPA in the term */
+};
+
+/** @brief Up to kBlockRows rows of one term, with their value ranges */
+struct HistoryBlockEntry {
+    uint64_t firstRow;   /**< First row of the block */
+    uint32_t rowCount;   /**< Rows in the block */
+    uint32_t minCourse;  /**< Zone map: lowest course id */
+    uint32_t maxCourse;  /**< Zone map: highest course id */
+    uint32_t minStudent; /**< Zone map: lowest student handle */
+    uint32_t maxStudent; /**< Zone map: highest student handle */
+    float minGrade;      /**< Zone map: lowest grade */
+    float maxGrade;      /**< Zone map: highest grade */
+    float minCgpa;       /**< Zone map: lowest CGPA */
+    float maxCgpa;       /**< Zone map: highest CGPA */
+    uint32_t padding;    /**< Zero */
+};
+
+namespace {
+
+const char kMagic[8] = {'C', 'R', 'H', 'I', 'S', 'T', '0', '1'};
+
+/** @brief Rounds @p offset up to a multiple of @p alignment */
+uint64_t alignUp(uint64_t offset, uint64_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+/** @brief Returns true if some value in [low, high] lies in [min, max) */
+bool overlaps(float low, float high, float min, float max) {
+    return high >= min && low < max;
+}
+
+/**
+ * @brief Returns the array of @p count T at @p offset in a mapping
+ *
+ * @throws std::runtime_error if the array is misaligned or not inside the mapping
+ */
+template <typename T>
+const T* sectionAt(const unsigned char* base, size_t size, uint64_t offset, uint64_t count) {
+    if (offset % alignof(T) != 0 || offset > size || count > (size - offset) / sizeof(T)) {
+        throw std::runtime_error("Corrupt history store");
+    }
+    return reinterpret_cast<const T*>(base + offset);
+}
+
+/**
+ * @brief Returns the offset just past @p count elements of @p elementSize bytes at @p offset
+ *
+ * @throws std::runtime_error if the end does not fit in 64 bits
+ */
+uint64_t sectionEnd(uint64_t offset, uint64_t count, uint64_t elementSize) {
+    if (count > (UINT64_MAX - offset) / elementSize) {
+        throw std::runtime_error("Corrupt history store");
+    }
+    return offset + count * elementSize;
+}
+
+/** @brief Flushes a file or directory to disk; returns false on failure */
+bool syncPath(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    return ::close(fd) == 0 && synced;
+}
+
+/**
+ * @brief Checks that the @p count + 1 offsets of a string table never decrease
+ *
+ * With the last offset inside the character section, every string then is.
+ *
+ * @throws std::runtime_error if an offset is below the one before it
+ */
+void checkOffsets(const uint32_t* offsets, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            throw std::runtime_error("Corrupt history store");
+        }
+    }
+}
+
+/** @brief Writes zero bytes until the stream is at @p offset */
+void padTo(std::ofstream& out, uint64_t& written, uint64_t offset) {
+    static const char zeros[64] = {};
+    while (written < offset) {
+        uint64_t chunk = std::min<uint64_t>(sizeof(zeros), offset - written);
+        out.write(zeros, static_cast<std::streamsize>(chunk));
+        written += chunk;
+    }
+}
+
+/** @brief Writes raw bytes and advances @p written */
+void writeBytes(std::ofstream& out, uint64_t& written, const void* data, uint64_t length) {
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+    written += length;
+}
+
+/** @brief Bytes of a string table holding @p values */
+uint64_t stringTableSize(const std::vector<std::string>& values) {
+    uint64_t chars = 0;
+    for (const auto& value : values) {
+        chars += value.size();
+    }
+    return (values.size() + 1) * sizeof(uint32_t) + chars;
+}
+
+/** @brief Writes a string table: offsets, then the characters */
+void writeStrings(std::ofstream& out, uint64_t& written, const std::vector<std::string>& values) {
+    uint32_t offset = 0;
+    for (const auto& value : values) {
+        writeBytes(out, written, &offset, sizeof(offset));
+        offset += static_cast<uint32_t>(value.size());
+    }
+    writeBytes(out, written, &offset, sizeof(offset));
+    for (const auto& value : values) {
+        writeBytes(out, written, value.data(), value.size());
+    }
+}
+
+} // namespace
+
+// Implementation of HistoryStoreWriter methods
+
+uint32_t HistoryStoreWriter::intern(std::unordered_map<std::string, uint32_t>& ids,
+                                    std::vector<std::string>& values, const std::string& value) {
+    auto inserted = ids.emplace(value, static_cast<uint32_t>(values.size()));
+    if (inserted.second) {
+        values.push_back(value);
+    }
+    return inserted.first->second;
+}
+
+void HistoryStoreWriter::addTerm(int year, TermSeason season, const std::vector<HistoryRecord>& records) {
+    for (const auto& term : terms) {
+        if (term.year == year && term.season == season) {
+            throw std::invalid_argument("Term already added");
+        }
+    }
+    PendingTerm term{year, season, {}};
+    term.rows.reserve(records.size());
+    for (const auto& record : records) {
+        if (std::isnan(record.grade) || std::isnan(record.cgpa)) {
+            throw std::invalid_argument("Grade and CGPA must be numbers");
+        }
+        term.rows.push_back({intern(courseIds, courseCodes, record.courseCode),
+                             intern(studentIds, studentNames, record.studentId),
+                             record.grade, record.cgpa});
+    }
+    // Course-major order keeps each block's course range narrow
+    std::sort(term.rows.begin(), term.rows.end(), [](const EncodedRow& a, const EncodedRow& b) {
+        return a.course != b.course ? a.course < b.course : a.student < b.student;
+    });
+    terms.push_back(std::move(term));
+}
+
+void HistoryStoreWriter::write(const std::string& path) const {
+    std::vector<const PendingTerm*> order;
+    for (const auto& term : terms) {
+        order.push_back(&term);
+    }
+    std::sort(order.begin(), order.end(), [](const PendingTerm* a, const PendingTerm* b) {
+        return a->year != b->year ? a->year < b->year : a->season < b->season;
+    });
+
+    // Term and block tables with their zone maps
+    std::vector<HistoryTermEntry> termTable;
+    std::vector<HistoryBlockEntry> blockTable;
+    uint64_t rowCount = 0;
+    for (const PendingTerm* term : order) {
+        HistoryTermEntry entry = {};
+        entry.year = term->year;
+        entry.season = static_cast<uint8_t>(term->season);
+        entry.firstBlock = static_cast<uint32_t>(blockTable.size());
+        entry.firstRow = rowCount;
+        entry.rowCount = term->rows.size();
+        entry.minGrade = entry.minCgpa = INFINITY;
+        entry.maxGrade = entry.maxCgpa = -INFINITY;
+        for (size_t start = 0; start < term->rows.size(); start += HistoryStore::kBlockRows) {
+            size_t end = std::min<size_t>(term->rows.size(), start + HistoryStore::kBlockRows);
+            HistoryBlockEntry block = {};
+            block.firstRow = rowCount + start;
+            block.rowCount = static_cast<uint32_t>(end - start);
+            block.minCourse = block.minStudent = UINT32_MAX;
+            block.minGrade = block.minCgpa = INFINITY;
+            block.maxGrade = block.maxCgpa = -INFINITY;
+            for (size_t r = start; r < end; ++r) {
+                const EncodedRow& row = term->rows[r];
+                block.minCourse = std::min(block.minCourse, row.course);
+                block.maxCourse = std::max(block.maxCourse, row.course);
+                block.minStudent = std::min(block.minStudent, row.student);
+                block.maxStudent = std::max(block.maxStudent, row.student);
+                block.minGrade = std::min(block.minGrade, row.grade);
+                block.maxGrade = std::max(block.maxGrade, row.grade);
+                block.minCgpa = std::min(block.minCgpa, row.cgpa);
+                block.maxCgpa = std::max(block.maxCgpa, row.cgpa);
+            }
+            entry.minGrade = std::min(entry.minGrade, block.minGrade);
+            entry.maxGrade = std::max(entry.maxGrade, block.maxGrade);
+            entry.minCgpa = std::min(entry.minCgpa, block.minCgpa);
+            entry.maxCgpa = std::max(entry.maxCgpa, block.maxCgpa);
+            blockTable.push_back(block);
+        }
+        entry.blockCount = static_cast<uint32_t>(blockTable.size()) - entry.firstBlock;
+        termTable.push_back(entry);
+        rowCount += term->rows.size();
+    }
+
+    HistoryFileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.termCount = static_cast<uint32_t>(termTable.size());
+    header.blockCount = static_cast<uint32_t>(blockTable.size());
+    header.rowCount = rowCount;
+    header.courseCount = static_cast<uint32_t>(courseCodes.size());
+    header.studentCount = static_cast<uint32_t>(studentNames.size());
+    header.termsOffset = alignUp(sizeof(header), 64);
+    header.blocksOffset = alignUp(header.termsOffset + termTable.size() * sizeof(HistoryTermEntry), 64);
+    header.studentColumnOffset = alignUp(header.blocksOffset + blockTable.size() * sizeof(HistoryBlockEntry), 64);
+    header.courseColumnOffset = alignUp(header.studentColumnOffset + rowCount * sizeof(uint32_t), 64);
+    header.gradeColumnOffset = alignUp(header.courseColumnOffset + rowCount * sizeof(uint32_t), 64);
+    header.cgpaColumnOffset = alignUp(header.gradeColumnOffset + rowCount * sizeof(float), 64);
+    header.courseStringsOffset = alignUp(header.cgpaColumnOffset + rowCount * sizeof(float), 64);
+    header.studentStringsOffset = alignUp(header.courseStringsOffset + stringTableSize(courseCodes), 64);
+
+    // Written beside the target and renamed over it, so a reader (or a
+    // HistoryStore still mapping the old file) never sees a partial store
+    const std::string temp = path + ".tmp." + std::to_string(::getpid());
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot create history store");
+    }
+    uint64_t written = 0;
+    writeBytes(out, written, &header, sizeof(header));
+    padTo(out, written, header.termsOffset);
+    writeBytes(out, written, termTable.data(), termTable.size() * sizeof(HistoryTermEntry));
+    padTo(out, written, header.blocksOffset);
+    writeBytes(out, written, blockTable.data(), blockTable.size() * sizeof(HistoryBlockEntry));
+
+    // One pass over the rows per column, so each column lands contiguously
+    padTo(out, written, header.studentColumnOffset);
+    for (const PendingTerm* term : order) {
+        for (const auto& row : term->rows) {
+            writeBytes(out, written, &row.student, sizeof(row.student));
+        }
+    }
+    padTo(out, written, header.courseColumnOffset);
+    for (const PendingTerm* term : order) {
+        for (const auto& row : term->rows) {
+            writeBytes(out, written, &row.course, sizeof(row.course));
+        }
+    }
+    padTo(out, written, header.gradeColumnOffset);
+    for (const PendingTerm* term : order) {
+        for (const auto& row : term->rows) {
+            writeBytes(out, written, &row.grade, sizeof(row.grade));
+        }
+    }
+    padTo(out, written, header.cgpaColumnOffset);
+    for (const PendingTerm* term : order) {
+        for (const auto& row : term->rows) {
+            writeBytes(out, written, &row.cgpa, sizeof(row.cgpa));
+        }
+    }
+
+    padTo(out, written, header.courseStringsOffset);
+    writeStrings(out, written, courseCodes);
+    padTo(out, written, header.studentStringsOffset);
+    writeStrings(out, written, studentNames);
+    out.close();
+    // The data must be on disk before the rename can publish it
+    if (!out || !syncPath(temp, O_RDONLY)) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Cannot write history store");
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Cannot replace history store");
+    }
+    // and the rename itself lives in the directory
+    const size_t slash = path.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    if (!syncPath(directory, O_RDONLY | O_DIRECTORY)) {
+        throw std::runtime_error("Cannot sync history store directory");
+    }
+}
+
+// Implementation of HistoryStore methods
+
+HistoryStore::HistoryStore(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open history store");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(HistoryFileHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Not a history store");
+    }
+    size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map history store");
+    }
+    base = static_cast<const unsigned char*>(mapping);
+
+    try {
+        header = reinterpret_cast<const HistoryFileHeader*>(base);
+        if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error("Not a history store");
+        }
+        terms = sectionAt<HistoryTermEntry>(base, size, header->termsOffset, header->termCount);
+        blocks = sectionAt<HistoryBlockEntry>(base, size, header->blocksOffset, header->blockCount);
+        studentColumn = sectionAt<uint32_t>(base, size, header->studentColumnOffset, header->rowCount);
+        courseColumn = sectionAt<uint32_t>(base, size, header->courseColumnOffset, header->rowCount);
+        gradeColumn = sectionAt<float>(base, size, header->gradeColumnOffset, header->rowCount);
+        cgpaColumn = sectionAt<float>(base, size, header->cgpaColumnOffset, header->rowCount);
+        courseOffsets = sectionAt<uint32_t>(base, size, header->courseStringsOffset,
+                                            uint64_t(header->courseCount) + 1);
+        courseChars = sectionAt<char>(base, size,
+                                      sectionEnd(header->courseStringsOffset, uint64_t(header->courseCount) + 1, 4),
+                                      courseOffsets[header->courseCount]);
+        studentOffsets = sectionAt<uint32_t>(base, size, header->studentStringsOffset,
+                                             uint64_t(header->studentCount) + 1);
+        studentChars = sectionAt<char>(base, size,
+                                       sectionEnd(header->studentStringsOffset, uint64_t(header->studentCount) + 1, 4),
+                                       studentOffsets[header->studentCount]);
+        checkOffsets(courseOffsets, header->courseCount);
+        checkOffsets(studentOffsets, header->studentCount);
+
+        for (uint32_t t = 0; t < header->termCount; ++t) {
+            const HistoryTermEntry& term = terms[t];
+            if (term.season > static_cast<uint8_t>(TermSeason::WINTER) ||
+                term.firstBlock > header->blockCount || term.blockCount > header->blockCount - term.firstBlock ||
+                term.firstRow > header->rowCount || term.rowCount > header->rowCount - term.firstRow) {
+                throw std::runtime_error("Corrupt history store");
+            }
+        }
+        for (uint32_t b = 0; b < header->blockCount; ++b) {
+            const HistoryBlockEntry& block = blocks[b];
+            if (block.rowCount > kBlockRows || block.firstRow > header->rowCount ||
+                block.rowCount > header->rowCount - block.firstRow) {
+                throw std::runtime_error("Corrupt history store");
+            }
+        }
+        for (uint32_t c = 0; c < header->courseCount; ++c) {
+            courseIds.emplace(courseCode(c), c);
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+HistoryStore::HistoryStore(HistoryStore&& other) noexcept
+    : base(std::exchange(other.base, nullptr)), size(std::exchange(other.size, 0)),
+      header(other.header), terms(other.terms), blocks(other.blocks),
+      studentColumn(other.studentColumn), courseColumn(other.courseColumn),
+      gradeColumn(other.gradeColumn), cgpaColumn(other.cgpaColumn),
+      courseOffsets(other.courseOffsets), courseChars(other.courseChars),
+      studentOffsets(other.studentOffsets), studentChars(other.studentChars),
+      courseIds(std::move(other.courseIds)) {}
+
+HistoryStore& HistoryStore::operator=(HistoryStore&& other) noexcept {
+    if (this != &other) {
+        release();
+        base = std::exchange(other.base, nullptr);
+        size = std::exchange(other.size, 0);
+        header = other.header;
+        terms = other.terms;
+        blocks = other.blocks;
+        studentColumn = other.studentColumn;
+        courseColumn = other.courseColumn;
+        gradeColumn = other.gradeColumn;
+        cgpaColumn = other.cgpaColumn;
+        courseOffsets = other.courseOffsets;
+        courseChars = other.courseChars;
+        studentOffsets = other.studentOffsets;
+        studentChars = other.studentChars;
+        courseIds = std::move(other.courseIds);
+    }
+    return *this;
+}
+
+HistoryStore::~HistoryStore() {
+    release();
+}
+
+void HistoryStore::release() {
+    if (base) {
+        ::munmap(const_cast<unsigned char*>(base), size);
+        base = nullptr;
+    }
+}
+
+size_t HistoryStore::termCount() const {
+    return header->termCount;
+}
+
+uint64_t HistoryStore::rowCount() const {
+    return header->rowCount;
+}
+
+std::string HistoryStore::courseCode(uint32_t course) const {
+    if (course >= header->courseCount) {
+        throw std::runtime_error("Corrupt history store");
+    }
+    return std::string(courseChars + courseOffsets[course], courseOffsets[course + 1] - courseOffsets[course]);
+}
+
+std::string HistoryStore::studentId(uint32_t student) const {
+    if (student >= header->studentCount) {
+        throw std::runtime_error("Corrupt history store");
+    }
+    return std::string(studentChars + studentOffsets[student],
+                       studentOffsets[student + 1] - studentOffsets[student]);
+}
+
+template <typename Fn>
+bool HistoryStore::scan(const HistoryQuery& query, HistoryScanStats& stats, Fn&& onBlock) const {
+    uint32_t courseLow = 0;
+    uint32_t courseHigh = UINT32_MAX;
+    if (!query.courseCode.empty()) {
+        auto courseIt = courseIds.find(query.courseCode);
+        if (courseIt == courseIds.end()) {
+            return false;
+        }
+        courseLow = courseHigh = courseIt->second;
+    }
+
+    // Locals, since stores to keep[] could otherwise alias the query
+    const float minGrade = query.minGrade;
+    const float maxGrade = query.maxGrade;
+    const float minCgpa = query.minCgpa;
+    const float maxCgpa = query.maxCgpa;
+    uint8_t keep[kBlockRows];
+    for (uint32_t t = 0; t < header->termCount; ++t) {
+        const HistoryTermEntry& term = terms[t];
+        if (!(query.seasons & (1u << term.season)) || term.year < query.fromYear || term.year > query.toYear ||
+            !overlaps(term.minGrade, term.maxGrade, query.minGrade, query.maxGrade) ||
+            !overlaps(term.minCgpa, term.maxCgpa, query.minCgpa, query.maxCgpa)) {
+            ++stats.termsSkipped;
+            continue;
+        }
+        for (uint32_t b = term.firstBlock; b < term.firstBlock + term.blockCount; ++b) {
+            const HistoryBlockEntry& block = blocks[b];
+            if (block.maxCourse < courseLow || block.minCourse > courseHigh ||
+                !overlaps(block.minGrade, block.maxGrade, query.minGrade, query.maxGrade) ||
+                !overlaps(block.minCgpa, block.maxCgpa, query.minCgpa, query.maxCgpa)) {
+                ++stats.blocksSkipped;
+                continue;
+            }
+            const uint32_t n = block.rowCount;
+            const uint32_t* course = courseColumn + block.firstRow;
+            const float* grade = gradeColumn + block.firstRow;
+            const float* cgpa = cgpaColumn + block.firstRow;
+            // Branch-free so the compiler turns it into vector compares
+            auto filter = [&](uint32_t rows) {
+                for (uint32_t i = 0; i < rows; ++i) {
+                    keep[i] = (course[i] >= courseLow) & (course[i] <= courseHigh) &
+                              (grade[i] >= minGrade) & (grade[i] < maxGrade) &
+                              (cgpa[i] >= minCgpa) & (cgpa[i] < maxCgpa);
+                }
+            };
+            // A constant trip count for full blocks lets -O2 vectorize without an epilogue
+            if (n == kBlockRows) {
+                filter(kBlockRows);
+            } else {
+                filter(n);
+            }
+            ++stats.blocksScanned;
+            stats.rowsScanned += n;
+            stats.rowsMatched += onBlock(term, block.firstRow, keep, n);
+        }
+    }
+    return true;
+}
+
+std::vector<HistoryRow> HistoryStore::find(const HistoryQuery& query, HistoryScanStats* stats) const {
+    HistoryScanStats local;
+    std::vector<HistoryRow> rows;
+    scan(query, local, [&](const HistoryTermEntry& term, uint64_t firstRow, const uint8_t* keep, uint32_t n) {
+        uint64_t matched = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            if (keep[i]) {
+                uint64_t row = firstRow + i;
+                rows.push_back(HistoryRow{term.year, static_cast<TermSeason>(term.season),
+                                          studentId(studentColumn[row]), courseCode(courseColumn[row]),
+                                          gradeColumn[row], cgpaColumn[row]});
+                ++matched;
+            }
+        }
+        return matched;
+    });
+    if (stats) {
+        *stats = local;
+    }
+    return rows;
+}
+
+uint64_t HistoryStore::count(const HistoryQuery& query, HistoryScanStats* stats) const {
+    HistoryScanStats local;
+    scan(query, local, [](const HistoryTermEntry&, uint64_t, const uint8_t* keep, uint32_t n) {
+        uint64_t matched = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            matched += keep[i];
+        }
+        return matched;
+    });
+    if (stats) {
+        *stats = local;
+    }
+    return local.rowsMatched;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file history_store.h
+ * @brief Columnar, memory-mapped store of enrollments across terms
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Audit and analytics questions span years ("who took MATH201 in any fall
+ * term with CGPA under 6"), and answering them from CourseRegistration
+ * objects means loading every past term. A HistoryStore instead keeps
+ * every (term, student, course, grade, CGPA) enrollment in one file that
+ * is memory-mapped read-only, so opening it costs no parsing and the OS
+ * pages in only what a scan touches.
+ *
+ * Layout (native byte order, see history_store.cpp for the structs):
+ * - header with the offset of every section
+ * - term table: one partition per term, with zone maps for grade and CGPA
+ * - block table: every kBlockRows rows of a term, with zone maps for
+ *   course, student, grade and CGPA
+ * - one array per column (student handle, course id, grade, CGPA),
+ *   each 64-byte aligned; the term is implied by the partition
+ * - string tables for course codes and student IDs
+ *
+ * Within a term, rows are sorted by course and then student, so a
+ * block's course range is narrow and a course filter skips almost every
+ * block. A scan first drops terms and blocks whose zone maps cannot
+ * match, then evaluates the predicates over the surviving blocks'
+ * column arrays in a branch-free loop the compiler vectorizes.
+ */
+
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// On-disk structures, defined in history_store.cpp
+struct HistoryFileHeader;
+struct HistoryTermEntry;
+struct HistoryBlockEntry;
+
+/** @brief Part of the academic year a term belongs to */
+enum class TermSeason : uint8_t {
+    SPRING, /**< Spring term */
+    SUMMER, /**< Summer term */
+    FALL,   /**< Fall term */
+    WINTER  /**< Winter term */
+};
+
+/** @brief One enrollment to store */
+struct HistoryRecord {
+    std::string studentId;  /**< Student enrolled */
+    std::string courseCode; /**< Course taken */
+    float grade;            /**< Grade points earned in the course */
+    float cgpa;             /**< Student's CGPA during the term */
+};
+
+/** @brief One enrollment returned by a query */
+struct HistoryRow {
+    int year;               /**< Year of the term */
+    TermSeason season;      /**< Season of the term */
+    std::string studentId;  /**< Student enrolled */
+    std::string courseCode; /**< Course taken */
+    float grade;            /**< Grade points earned in the course */
+    float cgpa;             /**< Student's CGPA during the term */
+};
+
+/**
+ * @brief Filter of a history scan; every field defaults to "match all"
+ *
+ * Grade and CGPA ranges are half-open, [min, max), so "CGPA under 6" is
+ * maxCgpa = 6.
+ */
+struct HistoryQuery {
+    std::string courseCode;     /**< Course to match; empty matches every course */
+    unsigned seasons = 0xf;     /**< Seasons to include, as a mask of seasonBit() values */
+    int fromYear = INT_MIN;     /**< First year to include */
+    int toYear = INT_MAX;       /**< Last year to include */
+    float minGrade = -INFINITY; /**< Lowest grade included */
+    float maxGrade = INFINITY;  /**< Grades from here on are excluded */
+    float minCgpa = -INFINITY;  /**< Lowest CGPA included */
+    float maxCgpa = INFINITY;   /**< CGPAs from here on are excluded */
+
+    /** @brief Returns the mask bit of one season */
+    static unsigned seasonBit(TermSeason season) { return 1u << static_cast<unsigned>(season); }
+};
+
+/** @brief Work done by one scan */
+struct HistoryScanStats {
+    uint64_t termsSkipped = 0;  /**< Terms ruled out by term, year or term zone map */
+    uint64_t blocksSkipped = 0; /**< Blocks ruled out by block zone map */
+    uint64_t blocksScanned = 0; /**< Blocks whose columns were read */
+    uint64_t rowsScanned = 0;   /**< Rows evaluated */
+    uint64_t rowsMatched = 0;   /**< Rows that passed the filter */
+};
+
+/**
+ * @brief Collects terms of enrollments and writes a history store file
+ *
+ * Example usage:
+ * @code
+ * HistoryStoreWriter writer;
+ * writer.addTerm(2025, TermSeason::FALL, {{"S1", "MATH201", 7.5f, 6.8f}});
+ * writer.write("history.crh");
+ * @endcode
+ */
+class HistoryStoreWriter {
+private:
+    /** @brief One enrollment with its strings interned */
+    struct EncodedRow {
+        uint32_t course;  /**< Course id */
+        uint32_t student; /**< Student handle */
+        float grade;      /**< Grade points */
+        float cgpa;       /**< CGPA during the term */
+    };
+
+    /** @brief One term's rows, sorted when written */
+    struct PendingTerm {
+        int year;                     /**< Year of the term */
+        TermSeason season;            /**< Season of the term */
+        std::vector<EncodedRow> rows; /**< Enrollments */
+    };
+
+    std::unordered_map<std::string, uint32_t> courseIds;  /**< Id of each course code */
+    std::vector<std::string> courseCodes;                 /**< Code of each course id */
+    std::unordered_map<std::string, uint32_t> studentIds; /**< Handle of each student ID */
+    std::vector<std::string> studentNames;                /**< ID of each student handle */
+    std::vector<PendingTerm> terms;                       /**< Terms added so far */
+
+    /** @brief Returns the id of @p value in a dictionary, adding it if new */
+    static uint32_t intern(std::unordered_map<std::string, uint32_t>& ids,
+                           std::vector<std::string>& values, const std::string& value);
+
+public:
+    /**
+     * @brief Adds every enrollment of one term
+     *
+     * @param year Year of the term
+     * @param season Season of the term
+     * @param records Enrollments, in any order
+     * @throws std::invalid_argument if the term was already added or a
+     *         grade or CGPA is NaN
+     */
+    void addTerm(int year, TermSeason season, const std::vector<HistoryRecord>& records);
+
+    /**
+     * @brief Writes the store, terms in chronological order
+     *
+     * The store is written to a temporary file in the same directory and
+     * renamed over @p path, so @p path holds either the old store or the
+     * complete new one, and HistoryStore objects open on the old file
+     * keep reading it. The temporary file is fsynced before the rename
+     * and the directory after it, so the same holds after a crash.
+     *
+     * @param path File to create or replace
+     * @throws std::runtime_error if the file cannot be written, leaving
+     *         @p path as it was, or if the directory cannot be synced
+     *         after @p path was replaced
+     */
+    void write(const std::string& path) const;
+};
+
+/**
+ * @brief Read-only view of a history store file, memory-mapped
+ *
+ * Queries are const and may run concurrently from any number of threads.
+ *
+ * Example usage:
+ * @code
+ * HistoryStore history("history.crh");
+ * HistoryQuery q;
+ * q.courseCode = "MATH201";
+ * q.seasons = HistoryQuery::seasonBit(TermSeason::FALL);
+ * q.maxCgpa = 6.0f;
+ * for (const HistoryRow& row : history.find(q)) {
+ *     std::cout << row.year << " " << row.studentId << std::endl;
+ * }
+ * @endcode
+ */
+class HistoryStore {
+public:
+    static constexpr uint32_t kBlockRows = 4096; /**< Rows per zone-mapped block */
+
+private:
+    const unsigned char* base = nullptr;        /**< Start of the mapping */
+    size_t size = 0;                            /**< Length of the mapping */
+    const HistoryFileHeader* header = nullptr;  /**< File header */
+    const HistoryTermEntry* terms = nullptr;    /**< Term table */
+    const HistoryBlockEntry* blocks = nullptr;  /**< Block table */
+    const uint32_t* studentColumn = nullptr;    /**< Student handle of every row */
+    const uint32_t* courseColumn = nullptr;     /**< Course id of every row */
+    const float* gradeColumn = nullptr;         /**< Grade of every row */
+    const float* cgpaColumn = nullptr;          /**< CGPA of every row */
+    const uint32_t* courseOffsets = nullptr;    /**< Start of each course code in courseChars */
+    const char* courseChars = nullptr;          /**< Course codes, back to back */
+    const uint32_t* studentOffsets = nullptr;   /**< Start of each student ID in studentChars */
+    const char* studentChars = nullptr;         /**< Student IDs, back to back */
+    std::unordered_map<std::string, uint32_t> courseIds; /**< Id of each course code */
+
+    /** @brief Unmaps the file */
+    void release();
+
+    /** @brief Returns the course code of a course id */
+    std::string courseCode(uint32_t course) const;
+
+    /** @brief Returns the student ID of a student handle */
+    std::string studentId(uint32_t student) const;
+
+    /**
+     * @brief Evaluates @p query over every block its zone maps cannot rule out
+     *
+     * @param onBlock Called as onBlock(term, firstRow, keep, rows) for each
+     *        block scanned, where keep[i] is 1 if row firstRow + i matches;
+     *        returns the number of matches it counted
+     * @return false if the query's course is not in the store
+     */
+    template <typename Fn>
+    bool scan(const HistoryQuery& query, HistoryScanStats& stats, Fn&& onBlock) const;
+
+public:
+    /**
+     * @brief Maps a store written by HistoryStoreWriter
+     *
+     * @param path File to open
+     * @throws std::runtime_error if the file cannot be mapped or is not a
+     *         valid history store
+     */
+    explicit HistoryStore(const std::string& path);
+
+    HistoryStore(HistoryStore&& other) noexcept;
+    HistoryStore& operator=(HistoryStore&& other) noexcept;
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+    ~HistoryStore();
+
+    /** @brief Returns the number of terms stored */
+    size_t termCount() const;
+
+    /** @brief Returns the number of enrollments stored */
+    uint64_t rowCount() const;
+
+    /**
+     * @brief Returns every enrollment matching @p query
+     *
+     * Rows come in chronological term order, then by course and student.
+     *
+     * @param query Filter to apply
+     * @param[out] stats If not null, receives the work the scan did
+     */
+    std::vector<HistoryRow> find(const HistoryQuery& query, HistoryScanStats* stats = nullptr) const;
+
+    /**
+     * @brief Counts the enrollments matching @p query without building rows
+     *
+     * @param query Filter to apply
+     * @param[out] stats If not null, receives the work the scan did
+     */
+    uint64_t count(const HistoryQuery& query, HistoryScanStats* stats = nullptr) const;
+};
+
+#endif // HISTORY_STORE_H
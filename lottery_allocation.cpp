@@ -0,0 +1,311 @@
+/**
+ * @file lottery_allocation.cpp
+ * @brief Implementation of CourseRegistration::allocateLottery
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * The allocation runs in four phases:
+ * 1. (parallel over students) resolve each ranked code to a course handle,
+ *    dropping unknown, closed, repeated and prerequisite-failing choices;
+ *    a sectioned course keeps the sections open to the student
+ * 2. lock the rosters of every course that survived, in address order, and
+ *    (parallel over students) drop courses the student is already in
+ * 3. (sequential) draw the lottery order and run the draft over plain
+ *    arrays of handles and seat counts; a sectioned course takes the
+ *    least-loaded of its open sections, as registerStudent does
+ * 4. (parallel over courses, then over students) commit the assignments
+ *    under one commit version and update the Student objects
+ *
+ * Only phase 3 is sequential; it touches no strings and no locks.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <thread>
+#include "course_registration.h"
+#include "registration_checks.h"
+#include "registration_trace.h"
+
+namespace {
+
+/** @brief Splits [0, count) into one contiguous range per thread */
+template <typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn fn) {
+    if (threads <= 1 || count < 1024) {
+        fn(size_t(0), count);
+        return;
+    }
+    size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        workers.emplace_back(fn, begin, std::min(count, begin + chunk));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/** @brief One eligible choice of one student */
+struct Candidate {
+    CourseHandle handle; /**< Course chosen */
+    uint32_t rank;       /**< Position in the student's ranked list */
+    uint64_t sections;   /**< For a sectioned course, bit i set if section i is open to the student */
+};
+
+const CourseHandle kDropped = UINT32_MAX; /**< Marks a candidate removed in phase 2 */
+
+} // namespace
+
+CourseHandle CourseRegistration::leastLoadedSection(const SectionGroup& group, uint64_t open, size_t start,
+                                                    const std::vector<int>& seatsLeft) {
+    const size_t count = group.sections.size();
+    CourseHandle best = UINT32_MAX;
+    int64_t bestTaken = 0;
+    int64_t bestCapacity = 1;
+    for (size_t k = 0; k < count; ++k) {
+        size_t s = (start + k) % count;
+        const CourseInfo& section = *group.sections[s];
+        if (!((open >> s) & 1) || seatsLeft[section.handle] <= 0) {
+            continue;
+        }
+        // Same load measure as SectionGroup::leastLoaded, over the draft's seat counts
+        const int64_t taken = section.maxCapacity - seatsLeft[section.handle];
+        if (best == UINT32_MAX || taken * bestCapacity < bestTaken * section.maxCapacity) {
+            best = section.handle;
+            bestTaken = taken;
+            bestCapacity = section.maxCapacity;
+        }
+    }
+    return best;
+}
+
+LotteryResult CourseRegistration::allocateLottery(const std::vector<LotteryEntry>& entries,
+                                                  const LotteryOptions& options) {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::ALLOCATE_LOTTERY);
+    const size_t n = entries.size();
+    const unsigned threads = options.threads ? options.threads
+                                             : std::max(1u, std::thread::hardware_concurrency());
+    const size_t picksPerStudent = static_cast<size_t>(std::max(0, options.coursesPerStudent));
+    time_t now = clock->now();
+    deadlines.advance(now);
+    advanceHolds(now);
+
+    LotteryResult result;
+    result.assigned.resize(n);
+    std::vector<std::string> studentIds(n);
+    std::vector<size_t> offsets(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        offsets[i + 1] = offsets[i] + entries[i].rankedCourses.size();
+    }
+    std::vector<Candidate> candidates(offsets[n]);
+    std::vector<uint32_t> candidateCounts(n, 0);
+
+    // Student index and course handle of every seat, in pick order
+    std::vector<std::pair<uint32_t, CourseHandle>> picks;
+    std::vector<const std::string*> codeOf;
+    std::vector<const std::string*> studentCodeOf;
+    {
+        std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+        std::vector<CourseInfo*> courseOf(board.size(), nullptr);
+        codeOf.assign(board.size(), nullptr);
+        studentCodeOf.assign(board.size(), nullptr);
+        for (auto& course : courses) {
+            courseOf[course.second.handle] = &course.second;
+            codeOf[course.second.handle] = &course.first;
+            studentCodeOf[course.second.handle] = &recordedCode(course.second);
+        }
+
+        // Phase 1: eligible choices, in rank order
+        parallelFor(n, threads, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const LotteryEntry& entry = entries[i];
+                studentIds[i] = entry.student->getStudentId();
+                const std::vector<std::string> completedCourses = entry.student->getEnrolledCourses();
+                const std::string department = entry.student->getDepartment();
+                Candidate* list = &candidates[offsets[i]];
+                uint32_t count = 0;
+                for (uint32_t rank = 0; rank < entry.rankedCourses.size(); ++rank) {
+                    auto courseIt = courses.find(entry.rankedCourses[rank]);
+                    if (courseIt == courses.end()) {
+                        continue;
+                    }
+                    const CourseInfo& course = courseIt->second;
+                    bool repeated = std::any_of(list, list + count, [&](const Candidate& c) {
+                        return c.handle == course.handle;
+                    });
+                    if (repeated || course.registrationClosed.load(std::memory_order_acquire) ||
+                        !hasPrerequisites(course.prerequisites, completedCourses)) {
+                        continue;
+                    }
+                    uint64_t sections = 0;
+                    if (course.sections) {
+                        const SectionGroup& group = *course.sections;
+                        for (size_t s = 0; s < group.sections.size(); ++s) {
+                            if (group.departments[s].empty() || group.departments[s] == department) {
+                                sections |= uint64_t(1) << s;
+                            }
+                        }
+                        if (!sections) {
+                            continue;
+                        }
+                    }
+                    list[count++] = {course.handle, rank, sections};
+                }
+                candidateCounts[i] = count;
+            }
+        });
+
+        // Phase 2: lock every roster still in play; same order as registerCart
+        std::vector<char> inPlay(courseOf.size(), 0);
+        for (size_t i = 0; i < n; ++i) {
+            for (uint32_t c = 0; c < candidateCounts[i]; ++c) {
+                const Candidate& candidate = candidates[offsets[i] + c];
+                if (const SectionGroup* group = courseOf[candidate.handle]->sections.get()) {
+                    // The parent has no roster; its sections are what gets locked
+                    for (size_t s = 0; s < group->sections.size(); ++s) {
+                        if ((candidate.sections >> s) & 1) {
+                            inPlay[group->sections[s]->handle] = 1;
+                        }
+                    }
+                } else {
+                    inPlay[candidate.handle] = 1;
+                }
+            }
+        }
+        std::vector<CourseInfo*> lockOrder;
+        for (CourseHandle handle = 0; handle < inPlay.size(); ++handle) {
+            if (inPlay[handle]) {
+                lockOrder.push_back(courseOf[handle]);
+            }
+        }
+        std::sort(lockOrder.begin(), lockOrder.end(), std::less<CourseInfo*>());
+        std::vector<std::unique_lock<std::mutex>> rosterLocks;
+        rosterLocks.reserve(lockOrder.size());
+        for (CourseInfo* course : lockOrder) {
+            rosterLocks.emplace_back(course->rosterMutex);
+        }
+
+        parallelFor(n, threads, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                for (uint32_t c = 0; c < candidateCounts[i]; ++c) {
+                    Candidate& candidate = candidates[offsets[i] + c];
+                    const CourseInfo& course = *courseOf[candidate.handle];
+                    if (course.enrolledStudents.find(studentIds[i]) != course.enrolledStudents.end() ||
+                        inOtherSection(course, studentIds[i]) ||
+                        (course.sections && course.sections->sectionOf(studentIds[i]))) {
+                        candidate.handle = kDropped;
+                    }
+                }
+            }
+        });
+
+        // Phase 3: the draft
+        std::vector<int> seatsLeft(courseOf.size(), 0);
+        for (CourseInfo* course : lockOrder) {
+            seatsLeft[course->handle] =
+                std::max(0, course->maxCapacity - static_cast<int>(course->enrolledStudents.size() +
+                                                                    course->seatHolds.size()));
+        }
+        std::vector<uint32_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::mt19937_64 rng(options.seed);
+        std::shuffle(order.begin(), order.end(), rng);
+
+        std::vector<uint32_t> cursor(n, 0);
+        for (size_t round = 0; round < picksPerStudent; ++round) {
+            bool anyPicked = false;
+            for (size_t j = 0; j < n; ++j) {
+                uint32_t i = order[round % 2 == 0 ? j : n - 1 - j];
+                Candidate* list = &candidates[offsets[i]];
+                // Seats never come back, so a course skipped as full stays skipped
+                while (cursor[i] < candidateCounts[i]) {
+                    const Candidate& candidate = list[cursor[i]++];
+                    if (candidate.handle == kDropped) {
+                        continue;
+                    }
+                    CourseHandle seat = candidate.handle;
+                    if (const SectionGroup* group = courseOf[candidate.handle]->sections.get()) {
+                        seat = leastLoadedSection(*group, candidate.sections, i, seatsLeft);
+                    }
+                    if (seat != kDropped && seatsLeft[seat] > 0) {
+                        --seatsLeft[seat];
+                        picks.emplace_back(i, seat);
+                        if (result.choiceCounts.size() <= candidate.rank) {
+                            result.choiceCounts.resize(candidate.rank + 1, 0);
+                        }
+                        ++result.choiceCounts[candidate.rank];
+                        anyPicked = true;
+                        // One section per course: the student's other choices of it drop out
+                        if (const SectionGroup* group = courseOf[seat]->group) {
+                            for (uint32_t c = cursor[i]; c < candidateCounts[i]; ++c) {
+                                if (list[c].handle != kDropped && (courseOf[list[c].handle]->group == group ||
+                                                                   courseOf[list[c].handle]->sections.get() == group)) {
+                                    list[c].handle = kDropped;
+                                }
+                            }
+                        }
+                        break;
+                    }
+                }
+            }
+            if (!anyPicked) {
+                break;
+            }
+        }
+
+        // Phase 4: commit per course, all under one version
+        std::vector<size_t> courseStart(courseOf.size() + 1, 0);
+        for (const auto& pick : picks) {
+            ++courseStart[pick.second + 1];
+        }
+        std::partial_sum(courseStart.begin(), courseStart.end(), courseStart.begin());
+        std::vector<uint32_t> byCourse(picks.size());
+        std::vector<size_t> fill(courseStart.begin(), courseStart.end() - 1);
+        for (const auto& pick : picks) {
+            byCourse[fill[pick.second]++] = pick.first;
+        }
+
+        uint64_t version = nextCommitVersion();
+        parallelFor(lockOrder.size(), threads, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                CourseInfo& course = *lockOrder[c];
+                for (size_t p = courseStart[course.handle]; p < courseStart[course.handle + 1]; ++p) {
+                    const std::string& studentId = studentIds[byCourse[p]];
+                    course.enrolledStudents.insert(studentId);
+                    publishRosterChange(course, version, studentId, true);
+                }
+            }
+        });
+    }
+
+    if (traceRecorder) {
+        for (const auto& pick : picks) {
+            traceRecorder->recordRegister(*entries[pick.first].student, *codeOf[pick.second],
+                                          RegistrationStatus::SUCCESS);
+        }
+    }
+    // Students record a section under its parent's code
+    std::vector<std::vector<const std::string*>> enrolledCodes(n);
+    for (const auto& pick : picks) {
+        result.assigned[pick.first].push_back(*codeOf[pick.second]);
+        enrolledCodes[pick.first].push_back(studentCodeOf[pick.second]);
+    }
+    parallelFor(n, threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t p = 0; p < result.assigned[i].size(); ++p) {
+                admission.forget(studentIds[i], result.assigned[i][p]);
+                if (*enrolledCodes[i][p] != result.assigned[i][p]) {
+                    admission.forget(studentIds[i], *enrolledCodes[i][p]);
+                }
+                entries[i].student->enrollInCourse(*enrolledCodes[i][p]);
+            }
+        }
+    });
+
+    result.seatsAssigned = picks.size();
+    for (const auto& assigned : result.assigned) {
+        result.studentsUnassigned += assigned.empty();
+    }
+    return result;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file lottery_allocation.h
+ * @brief Input and output types of batch lottery seat allocation
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * CourseRegistration::allocateLottery assigns seats from every student's
+ * ranked course list in one pass instead of a first-come race. Students
+ * are put in a random order (the lottery) and, in that order, each takes
+ * the highest-ranked course on their list that still has a seat and that
+ * they are eligible for: random serial dictatorship. When students may
+ * get several courses, picking goes in rounds of one course each, and
+ * every other round runs the order backwards, so a bad lottery draw costs
+ * a student their first pick but not every pick.
+ *
+ * With one course per student (coursesPerStudent == 1) the result is
+ * Pareto efficient, since no two students could swap seats and both be
+ * better off. It is also strategy-proof: the outcome depends only on the
+ * order and on each student's own list, so ranking courses honestly is
+ * always a student's best strategy. Multi-round picking is neither. A
+ * student may do better by ranking a contested course first, because
+ * they would be too late for it in a later round, and students may end
+ * up with seats they would gladly trade.
+ *
+ * A student gets at most one section of a course: once one is assigned,
+ * the student's other sections of that course are skipped.
+ */
+
+#ifndef LOTTERY_ALLOCATION_H
+#define LOTTERY_ALLOCATION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "student.h"
+
+/** @brief One student's ranked preferences */
+struct LotteryEntry {
+    Student* student;                       /**< Student to enroll; at most one entry per student */
+    std::vector<std::string> rankedCourses; /**< Course codes, most wanted first */
+};
+
+/** @brief Parameters of one lottery run */
+struct LotteryOptions {
+    uint64_t seed = 0;          /**< Seed of the lottery order; equal seeds give equal results */
+    int coursesPerStudent = 1;  /**< Maximum seats assigned to each student */
+    unsigned threads = 0;       /**< Worker threads; 0 uses every hardware thread */
+};
+
+/** @brief Seats assigned by one lottery run */
+struct LotteryResult {
+    std::vector<std::vector<std::string>> assigned; /**< Courses given to each entry, in pick order */
+    std::vector<uint64_t> choiceCounts;             /**< choiceCounts[r]: seats given from an (r+1)-th choice */
+    uint64_t seatsAssigned = 0;                     /**< Total seats assigned */
+    uint64_t studentsUnassigned = 0;                /**< Entries that got no seat */
+};
+
+#endif // LOTTERY_ALLOCATION_H
@@ -0,0 +1,239 @@
+/**
+ * @file registration_async.h
+ * @brief C++20 coroutine awaitables for the registration engine
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Each function returns an awaitable for one engine call. Awaiting a
+ * registration or withdrawal suspends the coroutine, queues the call on
+ * its course's strand in the engine's executor (see enableExecutor and
+ * registration_executor.h) and resumes the coroutine on an executor
+ * thread once the call returns. With a journal enabled (see
+ * enableJournal), the coroutine resumes only once everything the engine
+ * had journaled when the call returned is on disk: the journal's
+ * completion path hands the resumption to the executor, so no thread
+ * blocks on the sync. Thousands of requests can be in flight while only
+ * the executor's few threads run engine code, and requests for a
+ * contended course wait in its strand instead of on its roster lock.
+ *
+ * Query awaitables complete without suspending, but the forms taking a
+ * course code resolve it under the engine's catalog lock, held shared,
+ * so they can wait briefly behind addCourse or addSection. The forms
+ * taking a CourseHandle (see CourseRegistration::getCourseHandle) read
+ * only the availability board and never block.
+ *
+ * The rest of the engine builds as C++17; only translation units that
+ * include this header need -std=c++20.
+ */
+
+#ifndef REGISTRATION_ASYNC_H
+#define REGISTRATION_ASYNC_H
+
+#if __cplusplus < 202002L
+#error "registration_async.h requires C++20 (-std=c++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "course_registration.h"
+
+/**
+ * @brief Awaitable running one engine call on a course's strand
+ *
+ * @tparam Result Value the call returns
+ * @tparam Call Callable taking the course code and returning Result
+ *
+ * The awaitable lives in the awaiting coroutine's frame while the call is
+ * queued, which is what lets the executor and the journal take it by
+ * pointer.
+ */
+template <typename Result, typename Call>
+class CourseCallAwaitable {
+private:
+    RegistrationExecutor& executor;       /**< Executor the call runs on */
+    RegistrationJournal* journal;         /**< Journal the call's changes must reach, or nullptr */
+    std::string courseCode;               /**< Course whose strand runs the call */
+    Call call;                            /**< Engine call */
+    std::coroutine_handle<> continuation; /**< Coroutine to resume with the result */
+    std::optional<Result> result;         /**< Value of the call, once run */
+    std::exception_ptr error;             /**< Exception of the call, if it threw */
+
+    /** @brief Runs the call on the strand, then queues the resumption once it is durable */
+    static void run(void* argument) {
+        CourseCallAwaitable& self = *static_cast<CourseCallAwaitable*>(argument);
+        try {
+            self.result.emplace(self.call(self.courseCode));
+        } catch (...) {
+            self.error = std::current_exception();
+        }
+        if (self.journal) {
+            self.journal->onDurable(self.journal->appendedPosition(), &CourseCallAwaitable::durable,
+                                    argument);
+            return;
+        }
+        // Resume off the strand so the coroutine's own work does not hold up the course
+        self.executor.post(&CourseCallAwaitable::resume, self.continuation.address());
+    }
+
+    /** @brief Called by the journal once the call's changes are on disk */
+    static void durable(void* argument) {
+        CourseCallAwaitable& self = *static_cast<CourseCallAwaitable*>(argument);
+        if (self.journal->failed() && !self.error) {
+            self.error = std::make_exception_ptr(
+                std::runtime_error("Journal write failed; change may not be durable"));
+        }
+        self.executor.post(&CourseCallAwaitable::resume, self.continuation.address());
+    }
+
+    /** @brief Resumes a coroutine given its frame address */
+    static void resume(void* frame) {
+        std::coroutine_handle<>::from_address(frame).resume();
+    }
+
+public:
+    CourseCallAwaitable(RegistrationExecutor& executor, RegistrationJournal* journal,
+                        std::string courseCode, Call call)
+        : executor(executor), journal(journal), courseCode(std::move(courseCode)),
+          call(std::move(call)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        continuation = awaiting;
+        executor.postToCourse(courseCode, &CourseCallAwaitable::run, this);
+    }
+
+    Result await_resume() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*result);
+    }
+};
+
+/** @brief Awaitable whose value is already known */
+template <typename Result>
+class ReadyAwaitable {
+private:
+    Result result; /**< Value of the call */
+
+public:
+    explicit ReadyAwaitable(Result result) : result(std::move(result)) {}
+
+    bool await_ready() const noexcept { return true; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    Result await_resume() { return std::move(result); }
+};
+
+/** @brief Returns the engine's journal, or nullptr if it has none */
+inline RegistrationJournal* journalOf(CourseRegistration& registration) {
+    return registration.hasJournal() ? &registration.getJournal() : nullptr;
+}
+
+/**
+ * @brief Registers a student for a course from a coroutine
+ *
+ * Same checks and effects as CourseRegistration::tryRegisterStudent; an
+ * unknown course yields RegistrationStatus::UNKNOWN_COURSE.
+ *
+ * @param registration Engine with its executor enabled; must outlive the await
+ * @param student Student to register; must outlive the await and must not
+ *        have another registration in flight
+ * @param courseCode Code of the course to register for
+ * @return Awaitable yielding the RegistrationStatus; awaiting it throws
+ *         std::runtime_error if the journal failed before the change was durable
+ * @throws std::logic_error if the engine's executor is not enabled
+ *
+ * Example usage:
+ * @code
+ * reg.enableExecutor(4);
+ * ...
+ * RegistrationStatus status = co_await registerStudentAsync(reg, student, "CS101");
+ * @endcode
+ */
+inline auto registerStudentAsync(CourseRegistration& registration, Student& student,
+                                 std::string courseCode) {
+    auto call = [&registration, &student](const std::string& code) {
+        return registration.tryRegisterStudent(student, code);
+    };
+    return CourseCallAwaitable<RegistrationStatus, decltype(call)>(
+        registration.getExecutor(), journalOf(registration), std::move(courseCode), std::move(call));
+}
+
+/**
+ * @brief Withdraws a student from a course from a coroutine
+ *
+ * @return Awaitable yielding the result of CourseRegistration::withdrawStudent
+ * @throws std::logic_error if the engine's executor is not enabled
+ */
+inline auto withdrawStudentAsync(CourseRegistration& registration, std::string studentId,
+                                 std::string courseCode) {
+    auto call = [&registration, studentId = std::move(studentId)](const std::string& code) {
+        return registration.withdrawStudent(studentId, code);
+    };
+    return CourseCallAwaitable<bool, decltype(call)>(
+        registration.getExecutor(), journalOf(registration), std::move(courseCode), std::move(call));
+}
+
+/**
+ * @brief Awaitable form of CourseRegistration::tryGetEnrollmentCount; never suspends
+ *
+ * Takes the catalog lock shared to look the course up.
+ */
+inline ReadyAwaitable<CourseQueryResult<int>> getEnrollmentCountAsync(
+    const CourseRegistration& registration, const std::string& courseCode) {
+    return ReadyAwaitable<CourseQueryResult<int>>(registration.tryGetEnrollmentCount(courseCode));
+}
+
+/**
+ * @brief Awaitable form of CourseRegistration::tryIsCourseFull; never suspends
+ *
+ * Takes the catalog lock shared to look the course up.
+ */
+inline ReadyAwaitable<CourseQueryResult<bool>> isCourseFullAsync(
+    const CourseRegistration& registration, const std::string& courseCode) {
+    return ReadyAwaitable<CourseQueryResult<bool>>(registration.tryIsCourseFull(courseCode));
+}
+
+/**
+ * @brief Reads a course's enrollment from the availability board; never blocks
+ *
+ * A handle names one board entry. The entry of a course with sections
+ * holds no seats, so ask for such a course by code, or by its sections'
+ * handles.
+ *
+ * @param handle Handle from CourseRegistration::getCourseHandle
+ * @return Enrolled students; UNKNOWN_COURSE if no course has @p handle
+ */
+inline ReadyAwaitable<CourseQueryResult<int>> getEnrollmentCountAsync(
+    const CourseRegistration& registration, CourseHandle handle) {
+    const AvailabilityBoard& board = registration.getAvailabilityBoard();
+    if (handle >= board.size()) {
+        return ReadyAwaitable<CourseQueryResult<int>>({RegistrationStatus::UNKNOWN_COURSE, 0});
+    }
+    return ReadyAwaitable<CourseQueryResult<int>>({RegistrationStatus::SUCCESS, board.read(handle).enrolled});
+}
+
+/**
+ * @brief Reads whether a course is full from the availability board; never blocks
+ *
+ * Held seats count as taken. The same caveat about sectioned courses as
+ * for the handle form of getEnrollmentCountAsync applies.
+ *
+ * @param handle Handle from CourseRegistration::getCourseHandle
+ * @return Whether no seat is left; UNKNOWN_COURSE if no course has @p handle
+ */
+inline ReadyAwaitable<CourseQueryResult<bool>> isCourseFullAsync(
+    const CourseRegistration& registration, CourseHandle handle) {
+    const AvailabilityBoard& board = registration.getAvailabilityBoard();
+    if (handle >= board.size()) {
+        return ReadyAwaitable<CourseQueryResult<bool>>({RegistrationStatus::UNKNOWN_COURSE, false});
+    }
+    return ReadyAwaitable<CourseQueryResult<bool>>({RegistrationStatus::SUCCESS, board.read(handle).seatsLeft == 0});
+}
+
+#endif // REGISTRATION_ASYNC_H
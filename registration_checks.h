@@ -0,0 +1,492 @@
+/**
+ * @file registration_checks.h
+ * @brief Compile-time composable registration check policies
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Each check policy is a stateless type exposing a static `passes()`
+ * predicate and the RegistrationStatus to report when it fails. Policies
+ * are combined into a CheckPipeline, which evaluates them in order and
+ * stops at the first failure. Because the pipeline is a template, every
+ * rule set is expanded into a single inlined sequence of comparisons;
+ * a check that is not listed costs nothing.
+ *
+ * A custom policy only needs the same two members:
+ * @code
+ * struct CourseLoadCheck {
+ *     static constexpr RegistrationStatus failure = RegistrationStatus::TIME_CONFLICT;
+ *     template <typename Context>
+ *     static bool passes(const Context& ctx) {
+ *         return ctx.student.getEnrolledCourses().size() < 6;
+ *     }
+ * };
+ * @endcode
+ */
+
+#ifndef REGISTRATION_CHECKS_H
+#define REGISTRATION_CHECKS_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "course_registration.h"
+#include "registration_trace.h"
+
+/**
+ * @brief Data a check policy may inspect for one registration attempt
+ *
+ * @tparam Course Course record type (CourseRegistration's course entry)
+ */
+template <typename Course>
+struct CheckContext {
+    const Student& student;        /**< Student attempting to register */
+    const std::string& studentId;  /**< Cached copy of student.getStudentId() */
+    const Course& course;         /**< Course being registered for */
+    time_t now;                   /**< Engine clock at the registration attempt */
+};
+
+/**
+ * @brief Checks whether a list of courses covers every listed prerequisite
+ *
+ * @param prerequisites Prerequisite course codes
+ * @param completedCourses Courses the student has taken
+ * @return true if every prerequisite appears in @p completedCourses
+ */
+inline bool hasPrerequisites(const std::set<std::string>& prerequisites,
+                             const std::vector<std::string>& completedCourses) {
+    for (const auto& prereq : prerequisites) {
+        if (std::find(completedCourses.begin(), completedCourses.end(), prereq)
+            == completedCourses.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether a student has completed every listed prerequisite
+ *
+ * @param prerequisites Prerequisite course codes
+ * @param student Student to check
+ * @return true if every prerequisite appears in the student's courses
+ */
+inline bool hasPrerequisites(const std::set<std::string>& prerequisites,
+                             const Student& student) {
+    if (prerequisites.empty()) {
+        return true;
+    }
+    return hasPrerequisites(prerequisites, student.getEnrolledCourses());
+}
+
+/**
+ * @brief Rejects registration after the course deadline
+ *
+ * Reads the course's closed flag, which the engine's DeadlineIndex sets
+ * once the engine clock passes the deadline.
+ */
+struct DeadlineCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::REGISTRATION_CLOSED;
+
+    template <typename Context>
+    static bool passes(const Context& ctx) {
+        return !ctx.course.registrationClosed.load(std::memory_order_acquire);
+    }
+};
+
+/** @brief Rejects students already on the course roster */
+struct AlreadyEnrolledCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::ALREADY_ENROLLED;
+
+    template <typename Context>
+    static bool passes(const Context& ctx) {
+        return ctx.course.enrolledStudents.find(ctx.studentId) ==
+               ctx.course.enrolledStudents.end();
+    }
+};
+
+/**
+ * @brief Rejects registration once the course is at capacity
+ *
+ * Held seats (see CourseRegistration::holdSeat) count as taken, except
+ * the one held by the student registering; that lookup only runs when the
+ * course looks full.
+ */
+struct CapacityCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::COURSE_FULL;
+
+    template <typename Context>
+    static bool passes(const Context& ctx) {
+        return ctx.course.enrolledStudents.size() + ctx.course.seatHolds.size() <
+                   static_cast<size_t>(ctx.course.maxCapacity) ||
+               ctx.course.seatHolds.count(ctx.studentId) > 0;
+    }
+};
+
+/** @brief Rejects students missing any prerequisite course */
+struct PrerequisiteCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::PREREQ_NOT_MET;
+
+    template <typename Context>
+    static bool passes(const Context& ctx) {
+        return hasPrerequisites(ctx.course.prerequisites, ctx.student);
+    }
+};
+
+/**
+ * @brief Ordered, compile-time list of check policies
+ *
+ * @tparam Checks Check policies, evaluated left to right
+ */
+template <typename... Checks>
+struct CheckPipeline {
+    /**
+     * @brief Runs the checks in order, stopping at the first failure
+     *
+     * @param ctx Registration attempt to check
+     * @return RegistrationStatus of the first failing check, or SUCCESS
+     */
+    template <typename Context>
+    static RegistrationStatus run(const Context& ctx) {
+        RegistrationStatus status = RegistrationStatus::SUCCESS;
+        // Short-circuits on the first policy whose passes() returns false
+        (void)((Checks::passes(ctx) || (status = Checks::failure, false)) && ...);
+        return status;
+    }
+};
+
+/** @brief Rule set used by CourseRegistration::registerStudent */
+using DefaultRegistrationChecks =
+    CheckPipeline<DeadlineCheck, AlreadyEnrolledCheck, CapacityCheck, PrerequisiteCheck>;
+
+template <typename Checks>
+RegistrationStatus CourseRegistration::enrollWith(Student& student, const std::string& studentId,
+                                                  CourseInfo& course, time_t now) {
+    if (inOtherSection(course, studentId)) {
+        return RegistrationStatus::ALREADY_ENROLLED;
+    }
+    std::lock_guard<std::mutex> rosterLock(course.rosterMutex);
+    CheckContext<CourseInfo> ctx{student, studentId, course, now};
+    RegistrationStatus status = Checks::run(ctx);
+    if (status == RegistrationStatus::SUCCESS) {
+        course.enrolledStudents.insert(studentId);
+        publishRosterChange(course, nextCommitVersion(), studentId, true);
+    }
+    return status;
+}
+
+template <typename Checks>
+RegistrationStatus CourseRegistration::enrollInSectionWith(Student& student, const std::string& studentId,
+                                                           SectionGroup& group, time_t now) {
+    if (group.sectionOf(studentId)) {
+        return RegistrationStatus::ALREADY_ENROLLED;
+    }
+    const std::string department = student.getDepartment();
+    const size_t start = std::hash<std::string>()(studentId);
+    uint64_t skipped = 0;
+    for (;;) {
+        CourseInfo* section = group.choose(studentId, department, start, skipped);
+        if (!section) {
+            return RegistrationStatus::COURSE_FULL;
+        }
+        // Only capacity differs between sections, so any other failure is final
+        RegistrationStatus status = enrollWith<Checks>(student, studentId, *section, now);
+        if (status != RegistrationStatus::COURSE_FULL) {
+            return status;
+        }
+        skipped |= uint64_t(1) << section->sectionIndex;
+    }
+}
+
+template <typename Checks>
+RegistrationStatus CourseRegistration::tryRegisterStudentWith(Student& student,
+                                                              const std::string& courseCode) {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::REGISTER);
+    RegistrationStatus status = RegistrationStatus::UNKNOWN_COURSE;
+    time_t now = clock->now();
+    if (windows.enabled() && now < windows.opensAt(student)) {
+        metrics.countStatus(RegistrationStatus::REGISTRATION_NOT_OPEN);
+        return RegistrationStatus::REGISTRATION_NOT_OPEN;
+    }
+    const std::string studentId = student.getStudentId();
+    if (admission.enabled()) {
+        AdmissionDecision decision = admission.admit(studentId, courseCode, now);
+        if (decision.verdict != AdmissionVerdict::ADMIT) {
+            metrics.countStatus(decision.status);
+            return decision.status;
+        }
+    }
+    deadlines.advance(now);
+    advanceHolds(now);
+    const std::string* enrolledCode = &courseCode;
+    {
+        std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+        auto courseIt = courses.find(courseCode);
+        if (courseIt != courses.end()) {
+            CourseInfo& course = courseIt->second;
+            status = course.sections ? enrollInSectionWith<Checks>(student, studentId, *course.sections, now)
+                                     : enrollWith<Checks>(student, studentId, course, now);
+            // Catalog keys are never erased, so the code outlives the lock
+            enrolledCode = &recordedCode(course);
+        }
+    }
+
+    if (admission.enabled()) {
+        admission.complete(studentId, courseCode, status, now);
+    }
+    metrics.countStatus(status);
+    demand.record(courseCode, status);
+    if (traceRecorder) {
+        traceRecorder->recordRegister(student, courseCode, status);
+    }
+    if (status == RegistrationStatus::SUCCESS) {
+        student.enrollInCourse(*enrolledCode);
+    }
+    return status;
+}
+
+template <typename Checks>
+RegistrationStatus CourseRegistration::registerStudentWith(Student& student,
+                                                           const std::string& courseCode) {
+    RegistrationStatus status = tryRegisterStudentWith<Checks>(student, courseCode);
+    if (status == RegistrationStatus::UNKNOWN_COURSE) {
+        throw std::invalid_argument("Course does not exist");
+    }
+    return status;
+}
+
+template <typename Checks>
+CartRegistrationResult CourseRegistration::registerCartWith(Student& student,
+                                                            const std::vector<std::string>& courseCodes) {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::REGISTER_CART);
+    CartRegistrationResult result{false, std::vector<RegistrationStatus>(courseCodes.size(),
+                                                                         RegistrationStatus::SUCCESS)};
+    // Nothing to commit; committed stays false so callers never act on an empty cart
+    if (courseCodes.empty()) {
+        return result;
+    }
+    time_t now = clock->now();
+    if (windows.enabled() && now < windows.opensAt(student)) {
+        result.statuses.assign(courseCodes.size(), RegistrationStatus::REGISTRATION_NOT_OPEN);
+        metrics.countStatus(RegistrationStatus::REGISTRATION_NOT_OPEN);
+        return result;
+    }
+    deadlines.advance(now);
+    advanceHolds(now);
+    const std::string studentId = student.getStudentId();
+    std::vector<const std::string*> enrolledCodes(courseCodes.size(), nullptr);
+    std::vector<const CourseInfo*> enrolledCourses(courseCodes.size(), nullptr);
+
+    {
+        std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+        const std::string department = student.getDepartment();
+        const size_t start = std::hash<std::string>()(studentId);
+        std::vector<uint64_t> skipped(courseCodes.size(), 0);
+        for (;;) {
+            // Resolve the cart; unknown and repeated courses (or two sections of
+            // one course) fail without a lookup. A sectioned course resolves to
+            // its least-loaded section, as in registerStudent
+            result.statuses.assign(courseCodes.size(), RegistrationStatus::SUCCESS);
+            std::vector<CourseInfo*> cart(courseCodes.size(), nullptr);
+            std::vector<char> picked(courseCodes.size(), 0);
+            std::vector<CourseInfo*> lockOrder;
+            for (size_t i = 0; i < courseCodes.size(); ++i) {
+                auto courseIt = courses.find(courseCodes[i]);
+                if (courseIt == courses.end()) {
+                    result.statuses[i] = RegistrationStatus::UNKNOWN_COURSE;
+                    continue;
+                }
+                CourseInfo* course = &courseIt->second;
+                if (course->sections) {
+                    if (course->sections->sectionOf(studentId)) {
+                        result.statuses[i] = RegistrationStatus::ALREADY_ENROLLED;
+                        continue;
+                    }
+                    course = course->sections->choose(studentId, department, start, skipped[i]);
+                    if (!course) {
+                        result.statuses[i] = RegistrationStatus::COURSE_FULL;
+                        continue;
+                    }
+                    picked[i] = 1;
+                }
+                if (std::any_of(lockOrder.begin(), lockOrder.end(), [&](const CourseInfo* c) {
+                        return c == course || (c->group && c->group == course->group);
+                    })) {
+                    result.statuses[i] = RegistrationStatus::ALREADY_ENROLLED;
+                } else {
+                    cart[i] = course;
+                    lockOrder.push_back(course);
+                }
+            }
+
+            // Lock rosters in address order so concurrent carts cannot deadlock
+            std::sort(lockOrder.begin(), lockOrder.end(), std::less<CourseInfo*>());
+            std::vector<std::unique_lock<std::mutex>> rosterLocks;
+            rosterLocks.reserve(lockOrder.size());
+            for (CourseInfo* course : lockOrder) {
+                rosterLocks.emplace_back(course->rosterMutex);
+            }
+
+            bool allPassed = true;
+            bool retry = true;
+            for (size_t i = 0; i < cart.size(); ++i) {
+                if (cart[i] && inOtherSection(*cart[i], studentId)) {
+                    result.statuses[i] = RegistrationStatus::ALREADY_ENROLLED;
+                } else if (cart[i]) {
+                    CheckContext<CourseInfo> ctx{student, studentId, *cart[i], now};
+                    result.statuses[i] = Checks::run(ctx);
+                }
+                if (result.statuses[i] != RegistrationStatus::SUCCESS) {
+                    allPassed = false;
+                    // A picked section that filled first is worth another section
+                    retry = retry && picked[i] && result.statuses[i] == RegistrationStatus::COURSE_FULL;
+                }
+            }
+
+            if (allPassed) {
+                uint64_t version = nextCommitVersion();
+                for (size_t i = 0; i < cart.size(); ++i) {
+                    cart[i]->enrolledStudents.insert(studentId);
+                    publishRosterChange(*cart[i], version, studentId, true);
+                    enrolledCodes[i] = &recordedCode(*cart[i]);
+                    enrolledCourses[i] = cart[i];
+                }
+                result.committed = true;
+                break;
+            }
+            if (!retry) {
+                break;
+            }
+            for (size_t i = 0; i < cart.size(); ++i) {
+                if (result.statuses[i] == RegistrationStatus::COURSE_FULL) {
+                    skipped[i] |= uint64_t(1) << cart[i]->sectionIndex;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < courseCodes.size(); ++i) {
+        demand.record(courseCodes[i], result.statuses[i]);
+    }
+    if (result.committed) {
+        for (size_t i = 0; i < courseCodes.size(); ++i) {
+            forgetAdmission(studentId, *enrolledCourses[i]);
+            student.enrollInCourse(*enrolledCodes[i]);
+        }
+    }
+    // One outcome per cart: SUCCESS, or the first course that failed
+    auto failed = std::find_if(result.statuses.begin(), result.statuses.end(),
+                               [](RegistrationStatus s) { return s != RegistrationStatus::SUCCESS; });
+    metrics.countStatus(failed == result.statuses.end() ? RegistrationStatus::SUCCESS : *failed);
+    return result;
+}
+
+template <typename Checks>
+RegistrationStatus CourseRegistration::swapCourseWith(Student& student, const std::string& dropCode,
+                                                      const std::string& addCode) {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::SWAP_COURSE);
+    RegistrationStatus status = swapCourseChecked<Checks>(student, dropCode, addCode);
+    metrics.countStatus(status);
+    // Like registerStudent, a swap refused before its window opens is no demand
+    if (status != RegistrationStatus::REGISTRATION_NOT_OPEN) {
+        demand.record(addCode, status);
+    }
+    return status;
+}
+
+template <typename Checks>
+RegistrationStatus CourseRegistration::swapCourseChecked(Student& student, const std::string& dropCode,
+                                                         const std::string& addCode) {
+    if (dropCode == addCode) {
+        return RegistrationStatus::ALREADY_ENROLLED;
+    }
+    time_t now = clock->now();
+    if (windows.enabled() && now < windows.opensAt(student)) {
+        return RegistrationStatus::REGISTRATION_NOT_OPEN;
+    }
+    deadlines.advance(now);
+    advanceHolds(now);
+    const std::string studentId = student.getStudentId();
+
+    RegistrationStatus status;
+    const std::string* enrolledCode = &addCode;
+    const CourseInfo* dropped = nullptr;
+    const CourseInfo* added = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+        auto dropIt = courses.find(dropCode);
+        auto addIt = courses.find(addCode);
+        if (dropIt == courses.end() || addIt == courses.end()) {
+            return RegistrationStatus::UNKNOWN_COURSE;
+        }
+        // A sectioned course is dropped from whichever section the student is in
+        CourseInfo* dropSection = &dropIt->second;
+        if (dropSection->sections) {
+            dropSection = dropSection->sections->sectionOf(studentId);
+            if (!dropSection) {
+                return RegistrationStatus::NOT_ENROLLED;
+            }
+        }
+        CourseInfo& dropCourse = *dropSection;
+        // and added to its least-loaded section, as in registerStudent
+        SectionGroup* addGroup = addIt->second.sections.get();
+        if (addGroup && dropCourse.group == addGroup) {
+            return RegistrationStatus::ALREADY_ENROLLED;
+        }
+        const std::string department = addGroup ? student.getDepartment() : std::string();
+        const size_t start = std::hash<std::string>()(studentId);
+        uint64_t skipped = 0;
+        for (;;) {
+            CourseInfo* addSection = &addIt->second;
+            if (addGroup) {
+                addSection = addGroup->choose(studentId, department, start, skipped);
+                if (!addSection) {
+                    return RegistrationStatus::COURSE_FULL;
+                }
+            }
+            CourseInfo& addCourse = *addSection;
+            if (&dropCourse == &addCourse) {
+                return RegistrationStatus::ALREADY_ENROLLED;
+            }
+
+            // Same address order as registerCart so the two cannot deadlock
+            bool dropFirst = std::less<CourseInfo*>()(&dropCourse, &addCourse);
+            std::unique_lock<std::mutex> firstLock((dropFirst ? dropCourse : addCourse).rosterMutex);
+            std::unique_lock<std::mutex> secondLock((dropFirst ? addCourse : dropCourse).rosterMutex);
+
+            if (dropCourse.enrolledStudents.find(studentId) == dropCourse.enrolledStudents.end()) {
+                return RegistrationStatus::NOT_ENROLLED;
+            }
+            // Moving between two sections of one course is allowed; joining a second is not
+            const CourseInfo* section = addCourse.group ? addCourse.group->sectionOf(studentId) : nullptr;
+            if (section && section != &addCourse && section != &dropCourse) {
+                return RegistrationStatus::ALREADY_ENROLLED;
+            }
+            CheckContext<CourseInfo> ctx{student, studentId, addCourse, now};
+            status = Checks::run(ctx);
+            enrolledCode = &recordedCode(addCourse);
+            if (status == RegistrationStatus::SUCCESS) {
+                uint64_t version = nextCommitVersion();
+                addCourse.enrolledStudents.insert(studentId);
+                dropCourse.enrolledStudents.erase(studentId);
+                publishRosterChange(addCourse, version, studentId, true);
+                publishRosterChange(dropCourse, version, studentId, false);
+                dropped = &dropCourse;
+                added = &addCourse;
+            }
+            // Only capacity differs between sections, so any other outcome is final
+            if (!addGroup || status != RegistrationStatus::COURSE_FULL) {
+                break;
+            }
+            skipped |= uint64_t(1) << addCourse.sectionIndex;
+        }
+    }
+
+    if (status == RegistrationStatus::SUCCESS) {
+        forgetAdmission(studentId, *dropped);
+        forgetAdmission(studentId, *added);
+        student.enrollInCourse(*enrolledCode);
+    }
+    return status;
+}
+
+#endif // REGISTRATION_CHECKS_H
@@ -0,0 +1,58 @@
+/**
+ * @file registration_clock.cpp
+ * @brief Implementation of the coarse clock and deadline index
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ */
+
+#include "registration_clock.h"
+
+// Implementation of CoarseClock methods
+
+CoarseClock::CoarseClock(std::function<time_t()> source, std::chrono::milliseconds period)
+    : source(std::move(source)), period(period), cached(this->source()) {
+    refresher = std::thread([this] {
+        std::unique_lock<std::mutex> lock(stopMutex);
+        while (!stopSignal.wait_for(lock, this->period, [this] { return stopping; })) {
+            refresh();
+        }
+    });
+}
+
+CoarseClock::~CoarseClock() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopSignal.notify_one();
+    refresher.join();
+}
+
+time_t CoarseClock::refresh() {
+    time_t value = source();
+    cached.store(value, std::memory_order_relaxed);
+    return value;
+}
+
+CoarseClock& CoarseClock::shared() {
+    static CoarseClock clock;
+    return clock;
+}
+
+// Implementation of DeadlineIndex methods
+
+void DeadlineIndex::add(time_t deadline, std::atomic<bool>* closedFlag) {
+    std::lock_guard<std::mutex> lock(mutex);
+    heap.emplace(deadline, closedFlag);
+    nextDeadline.store(heap.top().first, std::memory_order_release);
+}
+
+void DeadlineIndex::closeExpired(time_t now) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!heap.empty() && heap.top().first < now) {
+        heap.top().second->store(true, std::memory_order_release);
+        heap.pop();
+    }
+    nextDeadline.store(heap.empty() ? std::numeric_limits<time_t>::max() : heap.top().first,
+                       std::memory_order_release);
+}
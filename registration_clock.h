@@ -0,0 +1,154 @@
+/**
+ * @file registration_clock.h
+ * @brief Injectable clocks and the registration deadline index
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * CourseRegistration never calls time() on the registration path.
+ * Instead it reads a RegistrationClock, by default the process-wide
+ * CoarseClock whose cached timestamp is refreshed by a background thread,
+ * and keeps every course deadline in a DeadlineIndex. The index flips a
+ * course's closed flag once the clock passes its deadline, so the
+ * deadline check itself is a single flag load.
+ *
+ * Tests and benchmarks install a ManualClock to control time exactly.
+ */
+
+#ifndef REGISTRATION_CLOCK_H
+#define REGISTRATION_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/** @brief Source of wall-clock time for registration decisions */
+class RegistrationClock {
+public:
+    virtual ~RegistrationClock() = default;
+
+    /** @brief Returns the current time in seconds since the epoch */
+    virtual time_t now() const = 0;
+};
+
+/** @brief Clock reading the system time on every call */
+class SystemClock : public RegistrationClock {
+public:
+    time_t now() const override { return time(nullptr); }
+};
+
+/**
+ * @brief Clock controlled explicitly by the caller
+ *
+ * Example usage:
+ * @code
+ * ManualClock clock(1700000000);
+ * reg.setClock(&clock);
+ * clock.advance(3600);  // one hour later
+ * @endcode
+ */
+class ManualClock : public RegistrationClock {
+private:
+    std::atomic<time_t> current; /**< Time returned by now() */
+
+public:
+    /** @param start Initial time */
+    explicit ManualClock(time_t start = 0) : current(start) {}
+
+    time_t now() const override { return current.load(std::memory_order_acquire); }
+
+    /** @brief Sets the current time */
+    void set(time_t value) { current.store(value, std::memory_order_release); }
+
+    /** @brief Moves the current time forward by @p seconds */
+    void advance(time_t seconds) { current.fetch_add(seconds, std::memory_order_acq_rel); }
+};
+
+/**
+ * @brief Clock returning a cached timestamp refreshed in the background
+ *
+ * now() is a single atomic load. A refresher thread re-reads the source
+ * clock every refresh period, so readings lag real time by at most that
+ * period; deadlines have one-second resolution, so the default 50 ms
+ * period does not change any registration outcome that matters.
+ */
+class CoarseClock : public RegistrationClock {
+private:
+    std::function<time_t()> source;       /**< Precise time source */
+    std::chrono::milliseconds period;     /**< Refresh interval */
+    std::atomic<time_t> cached;           /**< Last value read from source */
+    std::mutex stopMutex;                 /**< Guards stopping */
+    std::condition_variable stopSignal;   /**< Wakes the refresher to stop */
+    bool stopping = false;                /**< Set when the clock is destroyed */
+    std::thread refresher;                /**< Background refresh thread */
+
+public:
+    /**
+     * @brief Starts a coarse clock and its refresher thread
+     *
+     * @param source Precise time source
+     * @param period Interval between refreshes
+     */
+    explicit CoarseClock(std::function<time_t()> source = [] { return time(nullptr); },
+                         std::chrono::milliseconds period = std::chrono::milliseconds(50));
+
+    /** @brief Stops and joins the refresher thread */
+    ~CoarseClock() override;
+
+    CoarseClock(const CoarseClock&) = delete;
+    CoarseClock& operator=(const CoarseClock&) = delete;
+
+    time_t now() const override { return cached.load(std::memory_order_relaxed); }
+
+    /** @brief Re-reads the source immediately and returns the new value */
+    time_t refresh();
+
+    /** @brief Returns the process-wide coarse system clock */
+    static CoarseClock& shared();
+};
+
+/**
+ * @brief Min-heap of deadlines that sets each course's closed flag on expiry
+ *
+ * advance() costs one atomic load and compare unless a deadline has passed;
+ * each deadline is then popped exactly once, so closing N courses costs
+ * O(N log N) over the whole term regardless of request volume. Time is
+ * treated as monotonic: moving a clock backwards does not reopen courses.
+ */
+class DeadlineIndex {
+private:
+    using Entry = std::pair<time_t, std::atomic<bool>*>;
+
+    std::mutex mutex; /**< Guards heap */
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap; /**< Pending deadlines */
+    std::atomic<time_t> nextDeadline{std::numeric_limits<time_t>::max()}; /**< Earliest pending deadline */
+
+    /** @brief Pops and closes every entry whose deadline is before @p now */
+    void closeExpired(time_t now);
+
+public:
+    /**
+     * @brief Tracks a deadline
+     *
+     * @param deadline Last second at which registration is open
+     * @param closedFlag Flag set to true once @p deadline has passed;
+     *        must stay valid for the lifetime of the index
+     */
+    void add(time_t deadline, std::atomic<bool>* closedFlag);
+
+    /** @brief Closes every course whose deadline is before @p now */
+    void advance(time_t now) {
+        if (now > nextDeadline.load(std::memory_order_acquire)) {
+            closeExpired(now);
+        }
+    }
+};
+
+#endif // REGISTRATION_CLOCK_H
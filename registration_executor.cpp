@@ -0,0 +1,118 @@
+/**
+ * @file registration_executor.cpp
+ * @brief Implementation of the engine's worker pool and course strands
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <functional>
+#include "registration_executor.h"
+
+RegistrationExecutor::RegistrationExecutor(unsigned threads)
+    : strands(new Strand[kStrandCount]) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < kStrandCount; ++i) {
+        strands[i].owner = this;
+    }
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(&RegistrationExecutor::work, this);
+    }
+}
+
+RegistrationExecutor::~RegistrationExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueSignal.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void RegistrationExecutor::post(TaskFunction function, void* argument) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        outstanding.fetch_add(1, std::memory_order_relaxed);
+        queue.push_back({function, argument});
+        wake = idleWorkers > 0;
+    }
+    // Busy workers come back for the task on their own; skip the futex wake
+    if (wake) {
+        queueSignal.notify_one();
+    }
+}
+
+void RegistrationExecutor::postToCourse(const std::string& courseCode, TaskFunction function,
+                                        void* argument) {
+    Strand& strand = strands[std::hash<std::string>()(courseCode) % kStrandCount];
+    {
+        std::lock_guard<std::mutex> lock(strand.mutex);
+        strand.pending.push_back({function, argument});
+        if (strand.scheduled) {
+            return;
+        }
+        strand.scheduled = true;
+    }
+    post(&RegistrationExecutor::drainStrand, &strand);
+}
+
+void RegistrationExecutor::drainStrand(void* argument) {
+    Strand& strand = *static_cast<Strand*>(argument);
+    Task batch[kStrandBatch];
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(strand.mutex);
+        while (count < kStrandBatch && !strand.pending.empty()) {
+            batch[count++] = strand.pending.front();
+            strand.pending.pop_front();
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        batch[i].function(batch[i].argument);
+    }
+    {
+        std::lock_guard<std::mutex> lock(strand.mutex);
+        if (strand.pending.empty()) {
+            strand.scheduled = false;
+            return;
+        }
+    }
+    // Still scheduled: go to the back of the queue so other strands get a turn
+    strand.owner->post(&RegistrationExecutor::drainStrand, &strand);
+}
+
+void RegistrationExecutor::work() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            while (queue.empty() && !stopping) {
+                ++idleWorkers;
+                queueSignal.wait(lock);
+                --idleWorkers;
+            }
+            if (queue.empty()) {
+                return;
+            }
+            task = queue.front();
+            queue.pop_front();
+        }
+        task.function(task.argument);
+        // A task that posts another counts it before this one is discounted
+        if (outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            drainedSignal.notify_all();
+        }
+    }
+}
+
+void RegistrationExecutor::drain() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    drainedSignal.wait(lock, [this] { return outstanding.load(std::memory_order_acquire) == 0; });
+}
@@ -0,0 +1,126 @@
+/**
+ * @file registration_executor.h
+ * @brief Engine-owned worker pool with per-course strands
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * The executor runs the engine calls made through registration_async.h.
+ * A small fixed pool of threads takes tasks from one FIFO queue. Tasks
+ * that touch a course are posted to that course's strand instead: a
+ * strand runs its tasks one at a time, in posting order, on whichever
+ * worker picks it up. Requests piling up on a hot course therefore wait
+ * in its strand as queued tasks rather than as workers parked on its
+ * roster lock, and the other workers keep serving the rest of the
+ * catalog. Course codes are hashed onto kStrandCount strands, so two
+ * quiet courses may share one.
+ *
+ * Tasks are a function pointer and an argument, so posting allocates
+ * nothing beyond the queue's own storage; the coroutine awaitables pass
+ * themselves as the argument.
+ */
+
+#ifndef REGISTRATION_EXECUTOR_H
+#define REGISTRATION_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed thread pool running engine calls, serialized per course
+ *
+ * Example usage:
+ * @code
+ * RegistrationExecutor executor(4);
+ * executor.postToCourse("CS101", [](void* arg) { ... }, &request);
+ * @endcode
+ */
+class RegistrationExecutor {
+public:
+    using TaskFunction = void (*)(void*); /**< Task body; must not throw */
+
+    static constexpr size_t kStrandCount = 1024; /**< Strands course codes are hashed onto */
+    static constexpr size_t kStrandBatch = 64;   /**< Tasks a strand runs before yielding its worker */
+
+private:
+    /** @brief One queued task */
+    struct Task {
+        TaskFunction function; /**< Body */
+        void* argument;        /**< Passed to the body */
+    };
+
+    /** @brief Tasks of the courses hashed to one strand */
+    struct alignas(64) Strand {
+        std::mutex mutex;            /**< Guards pending and scheduled */
+        std::deque<Task> pending;    /**< Tasks not yet run, in posting order */
+        bool scheduled = false;      /**< Whether a drain task is queued or running */
+        RegistrationExecutor* owner = nullptr; /**< Executor the drain task is posted to */
+    };
+
+    std::mutex queueMutex;                  /**< Guards queue, stopping and idleWorkers */
+    std::condition_variable queueSignal;    /**< Wakes idle workers */
+    std::condition_variable drainedSignal;  /**< Wakes drain once nothing is outstanding */
+    std::deque<Task> queue;                 /**< Tasks ready to run */
+    bool stopping = false;                  /**< Set by the destructor */
+    size_t idleWorkers = 0;                 /**< Workers waiting on queueSignal */
+    std::atomic<size_t> outstanding{0};     /**< Tasks posted to queue and not yet finished */
+    std::unique_ptr<Strand[]> strands;      /**< Per-course serialization */
+    std::vector<std::thread> workers;       /**< Pool threads */
+
+    /** @brief Takes and runs tasks until the executor stops and the queue is empty */
+    void work();
+
+    /** @brief Runs up to kStrandBatch tasks of a strand, then requeues it if more remain */
+    static void drainStrand(void* strand);
+
+public:
+    /**
+     * @brief Starts @p threads workers
+     *
+     * @param threads Pool size; 0 means one per hardware thread
+     */
+    explicit RegistrationExecutor(unsigned threads);
+
+    /**
+     * @brief Runs every task already posted, then joins the workers
+     *
+     * @warning No task may be posted from outside the pool once destruction starts
+     */
+    ~RegistrationExecutor();
+
+    RegistrationExecutor(const RegistrationExecutor&) = delete;
+    RegistrationExecutor& operator=(const RegistrationExecutor&) = delete;
+
+    /** @brief Queues a task to run on any worker */
+    void post(TaskFunction function, void* argument);
+
+    /**
+     * @brief Queues a task behind the earlier tasks of a course
+     *
+     * Tasks posted for the same course code never run concurrently and
+     * run in posting order.
+     */
+    void postToCourse(const std::string& courseCode, TaskFunction function, void* argument);
+
+    /**
+     * @brief Blocks until no task is queued or running
+     *
+     * Tasks posted by running tasks are waited for too; tasks posted from
+     * outside the pool after it returns are not.
+     */
+    void drain();
+
+    /** @brief Returns whether no task is queued or running */
+    bool idle() const { return outstanding.load(std::memory_order_acquire) == 0; }
+
+    /** @brief Returns the number of worker threads */
+    size_t threadCount() const { return workers.size(); }
+};
+
+#endif // REGISTRATION_EXECUTOR_H
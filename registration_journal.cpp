@@ -0,0 +1,855 @@
+/**
+ * @file registration_journal.cpp
+ * @brief Implementation of the roster change journal and its backends
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "registration_journal.h"
+
+// Build with -DCOURSE_REGISTRATION_IO_URING=0 to compile only the portable backends
+#ifndef COURSE_REGISTRATION_IO_URING
+#define COURSE_REGISTRATION_IO_URING 1
+#endif
+
+#if COURSE_REGISTRATION_IO_URING && defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define REGISTRATION_JOURNAL_URING 1
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+const char kJournalMagic[8] = {'C', 'R', 'J', 'R', 'N', 'L', '0', '1'};
+const size_t kRecordHeaderSize = 8;            /**< Body length and checksum */
+const size_t kRecordFixedBody = 8 + 8 + 1 + 2 + 2; /**< Body without its two strings */
+const size_t kMaxRecordBody = kRecordFixedBody + 2 * RegistrationJournal::kMaxFieldSize;
+
+/** @brief Returns the CRC-32C (Castagnoli) lookup table */
+const uint32_t* crc32cTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78u : crc >> 1;
+            }
+            entries[i] = crc;
+        }
+        return entries;
+    }();
+    return table.data();
+}
+
+/** @brief Returns the CRC-32C of @p size bytes */
+uint32_t crc32c(const char* data, size_t size) {
+    const uint32_t* table = crc32cTable();
+    uint32_t crc = ~0u;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/** @brief Appends a little-endian integer of @p bytes bytes */
+void putLittleEndian(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+/** @brief Reads a little-endian integer of @p bytes bytes */
+uint64_t getLittleEndian(const char* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+/** @brief Appends one encoded record to @p out */
+void encodeRecord(std::string& out, uint64_t position, uint64_t version, EnrollmentEventKind kind,
+                  const std::string& courseCode, const std::string& studentId) {
+    const size_t start = out.size();
+    const size_t bodySize = kRecordFixedBody + courseCode.size() + studentId.size();
+    putLittleEndian(out, bodySize, 4);
+    putLittleEndian(out, 0, 4);
+    putLittleEndian(out, position, 8);
+    putLittleEndian(out, version, 8);
+    out.push_back(static_cast<char>(kind));
+    putLittleEndian(out, courseCode.size(), 2);
+    out += courseCode;
+    putLittleEndian(out, studentId.size(), 2);
+    out += studentId;
+    const uint32_t crc = crc32c(out.data() + start + kRecordHeaderSize, bodySize);
+    for (int i = 0; i < 4; ++i) {
+        out[start + 4 + i] = static_cast<char>((crc >> (8 * i)) & 0xff);
+    }
+}
+
+/**
+ * @brief Decodes the record at the start of @p data
+ *
+ * @return Bytes the record takes, or 0 if it is torn or corrupt
+ */
+size_t decodeRecord(const char* data, size_t size, JournalRecord& record) {
+    if (size < kRecordHeaderSize) {
+        return 0;
+    }
+    const size_t bodySize = getLittleEndian(data, 4);
+    if (bodySize < kRecordFixedBody || bodySize > kMaxRecordBody ||
+        size - kRecordHeaderSize < bodySize) {
+        return 0;
+    }
+    const char* body = data + kRecordHeaderSize;
+    if (crc32c(body, bodySize) != getLittleEndian(data + 4, 4)) {
+        return 0;
+    }
+    const uint8_t kind = static_cast<uint8_t>(body[16]);
+    const size_t codeSize = getLittleEndian(body + 17, 2);
+    if (kind > static_cast<uint8_t>(EnrollmentEventKind::WITHDRAWN) ||
+        kRecordFixedBody + codeSize > bodySize) {
+        return 0;
+    }
+    const size_t idSize = getLittleEndian(body + 19 + codeSize, 2);
+    if (kRecordFixedBody + codeSize + idSize != bodySize) {
+        return 0;
+    }
+    record.position = getLittleEndian(body, 8);
+    record.version = getLittleEndian(body + 8, 8);
+    record.kind = static_cast<EnrollmentEventKind>(kind);
+    record.courseCode.assign(body + 19, codeSize);
+    record.studentId.assign(body + 21 + codeSize, idSize);
+    return kRecordHeaderSize + bodySize;
+}
+
+/**
+ * @brief Walks the records of a journal image
+ *
+ * @param records If not null, receives every intact record
+ * @param lastPosition Receives the position of the last intact record, or 0
+ * @return Offset just past the last intact record
+ */
+size_t scanRecords(const std::string& image, std::vector<JournalRecord>* records,
+                   uint64_t& lastPosition) {
+    size_t offset = sizeof(kJournalMagic);
+    lastPosition = 0;
+    JournalRecord record;
+    while (size_t used = decodeRecord(image.data() + offset, image.size() - offset, record)) {
+        offset += used;
+        lastPosition = record.position;
+        if (records) {
+            records->push_back(record);
+        }
+    }
+    return offset;
+}
+
+/** @brief Reads a whole file; returns false with errno set on failure */
+bool readAll(int fd, std::string& image) {
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        return false;
+    }
+    image.resize(static_cast<size_t>(info.st_size));
+    size_t done = 0;
+    while (done < image.size()) {
+        ssize_t got = ::pread(fd, &image[done], image.size() - done, static_cast<off_t>(done));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            image.resize(done);
+            return got == 0;
+        }
+        done += static_cast<size_t>(got);
+    }
+    return true;
+}
+
+/** @brief Writes and syncs @p data at @p offset; returns an error message or "" */
+std::string writeAndSync(int fd, const std::string& data, uint64_t offset) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t written = ::pwrite(fd, data.data() + done, data.size() - done,
+                                   static_cast<off_t>(offset + done));
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0) {
+            return std::string("pwrite: ") + std::strerror(errno);
+        }
+        done += static_cast<size_t>(written);
+    }
+    if (::fdatasync(fd) != 0) {
+        return std::string("fdatasync: ") + std::strerror(errno);
+    }
+    return std::string();
+}
+
+} // namespace
+
+#ifdef REGISTRATION_JOURNAL_URING
+
+/** @brief Raw io_uring submission and completion rings */
+struct RegistrationJournal::Uring {
+    int ringFd = -1;                     /**< io_uring instance */
+    void* sqRing = MAP_FAILED;           /**< Submission ring mapping */
+    size_t sqRingSize = 0;               /**< Its size */
+    void* cqRing = MAP_FAILED;           /**< Completion ring mapping; may equal sqRing */
+    size_t cqRingSize = 0;               /**< Its size */
+    io_uring_sqe* sqes = nullptr;        /**< Submission queue entries */
+    size_t sqesSize = 0;                 /**< Bytes mapped for sqes */
+    unsigned* sqTail = nullptr;          /**< Shared submission tail */
+    unsigned sqMask = 0;                 /**< Submission ring mask */
+    unsigned* sqArray = nullptr;         /**< Submission index array */
+    unsigned* cqHead = nullptr;          /**< Shared completion head */
+    unsigned* cqTail = nullptr;          /**< Shared completion tail */
+    unsigned cqMask = 0;                 /**< Completion ring mask */
+    io_uring_cqe* cqes = nullptr;        /**< Completion queue entries */
+    unsigned localTail = 0;              /**< Submission tail including unpublished entries */
+    unsigned unsubmitted = 0;            /**< Entries not yet passed to io_uring_enter */
+    uint64_t wakeValue = 0;              /**< Target of the writer's eventfd read */
+
+    ~Uring() {
+        if (sqes) {
+            ::munmap(sqes, sqesSize);
+        }
+        if (cqRing != MAP_FAILED && cqRing != sqRing) {
+            ::munmap(cqRing, cqRingSize);
+        }
+        if (sqRing != MAP_FAILED) {
+            ::munmap(sqRing, sqRingSize);
+        }
+        if (ringFd >= 0) {
+            ::close(ringFd);
+        }
+    }
+
+    /**
+     * @brief Creates the rings; returns false with errno set if io_uring is unavailable
+     *
+     * A kernel whose io_uring lacks an opcode the writer submits counts as
+     * unavailable, so the journal falls back to the writer thread instead of
+     * failing its first batch with EINVAL.
+     */
+    bool open(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd < 0) {
+            return false;
+        }
+        if (!supports({IORING_OP_WRITE, IORING_OP_FSYNC, IORING_OP_READ})) {
+            return false;
+        }
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMapping = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMapping) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+        sqRing = ::mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) {
+            return false;
+        }
+        cqRing = singleMapping ? sqRing
+                               : ::mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            return false;
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* entriesMapping = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (entriesMapping == MAP_FAILED) {
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(entriesMapping);
+
+        char* sq = static_cast<char*>(sqRing);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        char* cq = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        localTail = *sqTail;
+        return true;
+    }
+
+    /** @brief Asks the kernel whether it implements every opcode in @p opcodes; errno set if not */
+    bool supports(std::initializer_list<uint8_t> opcodes) const {
+        const unsigned kProbeOps = 256;
+        // io_uring_probe ends in a flexible array, so back it with aligned storage
+        std::vector<uint64_t> storage(
+            (sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op) + 7) / 8, 0);
+        io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (::syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) {
+            // Kernels before 5.6 have no probe, and no IORING_OP_WRITE either
+            return false;
+        }
+        for (uint8_t opcode : opcodes) {
+            if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+                errno = EOPNOTSUPP;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Returns a zeroed entry to fill; published by the next submit */
+    io_uring_sqe& next(uint64_t userData) {
+        const unsigned index = localTail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.user_data = userData;
+        sqArray[index] = index;
+        ++localTail;
+        ++unsubmitted;
+        return sqe;
+    }
+
+    /**
+     * @brief Submits the filled entries and waits for @p waitFor completions
+     *
+     * @return false with errno set if io_uring_enter failed
+     */
+    bool submit(unsigned waitFor) {
+        __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+        for (;;) {
+            long done = ::syscall(__NR_io_uring_enter, ringFd, unsubmitted, waitFor,
+                                  waitFor ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (done < 0 && errno == EINTR) {
+                continue;
+            }
+            if (done < 0) {
+                return false;
+            }
+            unsubmitted -= std::min<unsigned>(unsubmitted, static_cast<unsigned>(done));
+            return true;
+        }
+    }
+
+    /** @brief Calls handle(userData, result) for every completion and consumes them */
+    template <typename Handler>
+    void reap(Handler&& handle) {
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = cqes[head & cqMask];
+            handle(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+};
+
+#else
+
+/** @brief Placeholder where io_uring is unavailable */
+struct RegistrationJournal::Uring {};
+
+#endif
+
+// Implementation of RegistrationJournal methods
+
+RegistrationJournal::RegistrationJournal(const std::string& path, const JournalOptions& options)
+    : path(path), chosen(options.backend), maxInFlight(options.maxInFlight) {
+    if (maxInFlight == 0 || maxInFlight > kMaxInFlight) {
+        throw std::invalid_argument("Journal maxInFlight must be between 1 and 16");
+    }
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open journal " + path + ": " + std::strerror(errno));
+    }
+    try {
+        recover();
+        if (chosen == JournalBackend::AUTO || chosen == JournalBackend::IO_URING) {
+#ifdef REGISTRATION_JOURNAL_URING
+            std::unique_ptr<Uring> rings(new Uring());
+            if (rings->open(4 * kMaxInFlight)) {
+                wakeFd = ::eventfd(0, EFD_CLOEXEC);
+                if (wakeFd >= 0) {
+                    uring = std::move(rings);
+                }
+            }
+#endif
+            if (!uring && chosen == JournalBackend::IO_URING) {
+                throw std::runtime_error("io_uring is not available");
+            }
+            chosen = uring ? JournalBackend::IO_URING : JournalBackend::WRITER_THREAD;
+        }
+        if (chosen == JournalBackend::IO_URING) {
+            writer = std::thread(&RegistrationJournal::runUringWriter, this);
+        } else if (chosen == JournalBackend::WRITER_THREAD) {
+            writer = std::thread(&RegistrationJournal::runWriterThread, this);
+        }
+    } catch (...) {
+        if (wakeFd >= 0) {
+            ::close(wakeFd);
+        }
+        ::close(fd);
+        throw;
+    }
+}
+
+RegistrationJournal::~RegistrationJournal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    dataReady.notify_all();
+#ifdef REGISTRATION_JOURNAL_URING
+    if (wakeFd >= 0) {
+        // The writer finishes its batches and in-flight syncs before it exits
+        ssize_t written = ::eventfd_write(wakeFd, 1);
+        (void)written;
+    }
+#endif
+    if (writer.joinable()) {
+        writer.join();
+    }
+    uring.reset();
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+    }
+    ::close(fd);
+}
+
+void RegistrationJournal::recover() {
+    std::string image;
+    if (!readAll(fd, image)) {
+        throw std::runtime_error("Cannot read journal " + path + ": " + std::strerror(errno));
+    }
+    if (image.empty()) {
+        std::string magic(kJournalMagic, sizeof(kJournalMagic));
+        std::string error = writeAndSync(fd, magic, 0);
+        if (!error.empty()) {
+            throw std::runtime_error("Cannot initialize journal " + path + ": " + error);
+        }
+        fileEnd = sizeof(kJournalMagic);
+        return;
+    }
+    if (image.size() < sizeof(kJournalMagic) ||
+        std::memcmp(image.data(), kJournalMagic, sizeof(kJournalMagic)) != 0) {
+        throw std::runtime_error("Not a registration journal: " + path);
+    }
+    uint64_t lastPosition;
+    fileEnd = scanRecords(image, nullptr, lastPosition);
+    if (fileEnd < image.size()) {
+        // Cut off a record torn by a crash so new records follow intact ones
+        if (::ftruncate(fd, static_cast<off_t>(fileEnd)) != 0 || ::fdatasync(fd) != 0) {
+            throw std::runtime_error("Cannot truncate journal " + path + ": " + std::strerror(errno));
+        }
+    }
+    appended = durable = lastPosition;
+}
+
+uint64_t RegistrationJournal::append(uint64_t version, EnrollmentEventKind kind,
+                                     const std::string& courseCode, const std::string& studentId) {
+#ifdef REGISTRATION_JOURNAL_URING
+    bool wake = false;
+#endif
+    bool notify = false;
+    uint64_t position;
+    std::vector<DurableWaiter> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        position = ++appended;
+        ++counters.records;
+        if (!failure.empty()) {
+            // A failed journal writes nothing more, so it keeps nothing either;
+            // the io_uring writer may already have exited
+        } else if (courseCode.size() > kMaxFieldSize || studentId.size() > kMaxFieldSize) {
+            // The caller has already applied the change, so it cannot be refused;
+            // the journal stops here as it does on an I/O error
+            released = fail("Journal record does not fit: course code or student ID over 65535 bytes");
+        } else if (chosen == JournalBackend::SYNCHRONOUS) {
+            pending.clear();
+            encodeRecord(pending, position, version, kind, courseCode, studentId);
+            std::string error = writeAndSync(fd, pending, fileEnd);
+            if (error.empty()) {
+                fileEnd += pending.size();
+                ++counters.batches;
+                ++counters.syncs;
+                counters.bytes += pending.size();
+                durable = position;
+            } else {
+                // Only callbacks for positions not yet appended can be waiting
+                released = fail(error);
+            }
+            pending.clear();
+        } else {
+            notify = pending.empty();
+            encodeRecord(pending, position, version, kind, courseCode, studentId);
+#ifdef REGISTRATION_JOURNAL_URING
+            if (wakeArmed) {
+                wakeArmed = false;
+                wake = true;
+            }
+#endif
+        }
+    }
+    runCallbacks(released);
+#ifdef REGISTRATION_JOURNAL_URING
+    if (wake) {
+        ssize_t written = ::eventfd_write(wakeFd, 1);
+        (void)written;
+        return position;
+    }
+#endif
+    if (notify && chosen == JournalBackend::WRITER_THREAD) {
+        dataReady.notify_one();
+    }
+    return position;
+}
+
+uint64_t RegistrationJournal::appendedPosition() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return appended;
+}
+
+uint64_t RegistrationJournal::durablePosition() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return durable;
+}
+
+bool RegistrationJournal::failed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !failure.empty();
+}
+
+JournalStats RegistrationJournal::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    JournalStats result = counters;
+    result.durablePosition = durable;
+    return result;
+}
+
+void RegistrationJournal::waitDurable(uint64_t position) {
+    std::unique_lock<std::mutex> lock(mutex);
+    durableReady.wait(lock, [&] { return durable >= position || !failure.empty(); });
+    if (durable < position) {
+        throw std::runtime_error("Journal write failed: " + failure);
+    }
+}
+
+void RegistrationJournal::onDurable(uint64_t position, DurableCallback callback, void* argument) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (durable < position && failure.empty()) {
+            waiters.push_back({position, callback, argument});
+            std::push_heap(waiters.begin(), waiters.end(),
+                           [](const DurableWaiter& a, const DurableWaiter& b) {
+                               return a.position > b.position;
+                           });
+            return;
+        }
+    }
+    callback(argument);
+}
+
+void RegistrationJournal::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    durableReady.wait(lock, [&] {
+        return (durable >= appended || !failure.empty()) && callbacksRunning == 0;
+    });
+}
+
+std::vector<RegistrationJournal::DurableWaiter> RegistrationJournal::advanceDurable(uint64_t position) {
+    auto later = [](const DurableWaiter& a, const DurableWaiter& b) { return a.position > b.position; };
+    durable = std::max(durable, position);
+    std::vector<DurableWaiter> ready;
+    while (!waiters.empty() && waiters.front().position <= durable) {
+        std::pop_heap(waiters.begin(), waiters.end(), later);
+        ready.push_back(waiters.back());
+        waiters.pop_back();
+    }
+    callbacksRunning += ready.size();
+    durableReady.notify_all();
+    return ready;
+}
+
+std::vector<RegistrationJournal::DurableWaiter> RegistrationJournal::fail(const std::string& message) {
+    if (failure.empty()) {
+        failure = message;
+    }
+    std::vector<DurableWaiter> ready;
+    ready.swap(waiters);
+    callbacksRunning += ready.size();
+    durableReady.notify_all();
+    return ready;
+}
+
+void RegistrationJournal::runCallbacks(const std::vector<DurableWaiter>& ready) {
+    if (ready.empty()) {
+        return;
+    }
+    for (const DurableWaiter& waiter : ready) {
+        waiter.callback(waiter.argument);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        callbacksRunning -= ready.size();
+    }
+    durableReady.notify_all();
+}
+
+void RegistrationJournal::runWriterThread() {
+    std::string batch;
+    for (;;) {
+        uint64_t lastPosition;
+        uint64_t offset;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            dataReady.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return;
+            }
+            batch.clear();
+            batch.swap(pending);
+            if (!failure.empty()) {
+                continue;
+            }
+            lastPosition = appended;
+            offset = fileEnd;
+            fileEnd += batch.size();
+            ++counters.batches;
+            counters.bytes += batch.size();
+        }
+        std::string error = writeAndSync(fd, batch, offset);
+        std::vector<DurableWaiter> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error.empty()) {
+                ++counters.syncs;
+                ready = advanceDurable(lastPosition);
+            } else {
+                ready = fail(error);
+            }
+        }
+        runCallbacks(ready);
+    }
+}
+
+#ifdef REGISTRATION_JOURNAL_URING
+
+void RegistrationJournal::runUringWriter() {
+    enum : uint64_t { kWake = 0, kWrite = 1, kSync = 2 }; // low bits of user_data
+    batches.resize(maxInFlight);
+    std::vector<size_t> freeSlots;
+    for (size_t i = maxInFlight; i-- > 0;) {
+        freeSlots.push_back(i);
+    }
+    std::deque<size_t> inFlight; // batch slots in submission order
+    bool wakeReadPending = false;
+
+    // The write of a batch's unwritten bytes and its fdatasync form a chain:
+    // the sync starts once the write is done
+    auto queueWrite = [&](size_t slot) {
+        const Batch& batch = batches[slot];
+        io_uring_sqe& write = uring->next((slot << 2) | kWrite);
+        write.opcode = IORING_OP_WRITE;
+        write.fd = fd;
+        write.addr = reinterpret_cast<uint64_t>(batch.data.data() + batch.written);
+        write.len = static_cast<uint32_t>(batch.data.size() - batch.written);
+        write.off = batch.offset + batch.written;
+        write.flags = IOSQE_IO_LINK;
+        io_uring_sqe& sync = uring->next((slot << 2) | kSync);
+        sync.opcode = IORING_OP_FSYNC;
+        sync.fd = fd;
+        sync.fsync_flags = IORING_FSYNC_DATASYNC;
+    };
+
+    for (;;) {
+        size_t slot = 0;
+        bool submitBatch = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failure.empty()) {
+                pending.clear();
+            }
+            if (!pending.empty() && !freeSlots.empty()) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                Batch& batch = batches[slot];
+                batch.data.clear();
+                batch.data.swap(pending);
+                batch.offset = fileEnd;
+                batch.lastPosition = appended;
+                batch.written = 0;
+                batch.shortWrite = false;
+                batch.completed = false;
+                batch.synced = false;
+                fileEnd += batch.data.size();
+                ++counters.batches;
+                counters.bytes += batch.data.size();
+                submitBatch = true;
+            } else if (stopping && pending.empty() && inFlight.empty()) {
+                break;
+            } else if (pending.empty()) {
+                wakeArmed = true;
+            }
+        }
+        if (submitBatch) {
+            queueWrite(slot);
+            inFlight.push_back(slot);
+        } else if (!wakeReadPending) {
+            io_uring_sqe& read = uring->next(kWake);
+            read.opcode = IORING_OP_READ;
+            read.fd = wakeFd;
+            // Read into the rings rather than this frame: if io_uring_enter
+            // fails the read stays pending until the destructor closes them
+            read.addr = reinterpret_cast<uint64_t>(&uring->wakeValue);
+            read.len = sizeof(uring->wakeValue);
+            read.off = static_cast<uint64_t>(-1);
+            wakeReadPending = true;
+        }
+
+        // A new batch goes to the kernel at once so its sync starts early;
+        // otherwise sleep until a completion or an append arrives
+        if (!uring->submit(submitBatch ? 0 : 1) && errno != EAGAIN && errno != EBUSY) {
+            std::vector<DurableWaiter> released;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                released = fail(std::string("io_uring_enter: ") + std::strerror(errno));
+                pending.clear();
+            }
+            runCallbacks(released);
+            // The ring is unusable, so nothing in flight will complete; appends
+            // are dropped from now on, and closing the ring cancels the wake read
+            return;
+        }
+        std::string error;
+        std::vector<size_t> rewrites;
+        uring->reap([&](uint64_t userData, int32_t result) {
+            Batch& batch = batches[userData >> 2];
+            switch (userData & 3) {
+            case kWake:
+                wakeReadPending = false;
+                break;
+            case kWrite:
+                if (result < 0) {
+                    error = std::string("journal write: ") + std::strerror(-result);
+                } else if (result == 0) {
+                    error = "journal write: no progress";
+                } else {
+                    batch.written += static_cast<size_t>(result);
+                    batch.shortWrite = batch.written < batch.data.size();
+                }
+                break;
+            case kSync:
+                if (batch.shortWrite && (result == 0 || result == -ECANCELED)) {
+                    // Like writeAndSync, write the rest at the next offset and sync again
+                    batch.shortWrite = false;
+                    rewrites.push_back(userData >> 2);
+                    break;
+                }
+                // A failed write cancels its sync, which still completes the batch
+                batch.completed = true;
+                if (result == 0) {
+                    batch.synced = true;
+                } else if (result != -ECANCELED) {
+                    error = std::string("journal fdatasync: ") + std::strerror(-result);
+                }
+                break;
+            }
+        });
+        for (size_t slot : rewrites) {
+            // Queued now, submitted by the next pass; failed batches are completed instead
+            if (error.empty()) {
+                queueWrite(slot);
+            } else {
+                batches[slot].completed = true;
+            }
+        }
+
+        std::vector<DurableWaiter> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error.empty()) {
+                ready = fail(error);
+            }
+            // Batches may sync out of order; durability only advances over a synced prefix
+            while (!inFlight.empty() && batches[inFlight.front()].completed) {
+                const Batch& batch = batches[inFlight.front()];
+                if (batch.synced && failure.empty()) {
+                    ++counters.syncs;
+                    std::vector<DurableWaiter> satisfied = advanceDurable(batch.lastPosition);
+                    ready.insert(ready.end(), satisfied.begin(), satisfied.end());
+                }
+                freeSlots.push_back(inFlight.front());
+                inFlight.pop_front();
+            }
+        }
+        runCallbacks(ready);
+    }
+
+    // Let the outstanding eventfd read finish so it never lands in a dead frame
+    while (wakeReadPending) {
+        ssize_t written = ::eventfd_write(wakeFd, 1);
+        (void)written;
+        if (!uring->submit(1)) {
+            return;
+        }
+        uring->reap([&](uint64_t userData, int32_t) {
+            if ((userData & 3) == kWake) {
+                wakeReadPending = false;
+            }
+        });
+    }
+}
+
+#else
+
+void RegistrationJournal::runUringWriter() {}
+
+#endif
+
+std::vector<JournalRecord> RegistrationJournal::read(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open journal " + path + ": " + std::strerror(errno));
+    }
+    std::string image;
+    bool ok = readAll(fd, image);
+    int error = errno;
+    ::close(fd);
+    if (!ok) {
+        throw std::runtime_error("Cannot read journal " + path + ": " + std::strerror(error));
+    }
+    if (image.size() < sizeof(kJournalMagic) ||
+        std::memcmp(image.data(), kJournalMagic, sizeof(kJournalMagic)) != 0) {
+        throw std::runtime_error("Not a registration journal: " + path);
+    }
+    std::vector<JournalRecord> records;
+    uint64_t lastPosition;
+    scanRecords(image, &records, lastPosition);
+    return records;
+}
+
+const char* journalBackendName(JournalBackend backend) {
+    switch (backend) {
+    case JournalBackend::AUTO: return "auto";
+    case JournalBackend::IO_URING: return "io_uring";
+    case JournalBackend::WRITER_THREAD: return "writer_thread";
+    case JournalBackend::SYNCHRONOUS: return "synchronous";
+    }
+    return "unknown";
+}
@@ -0,0 +1,263 @@
+/**
+ * @file registration_journal.h
+ * @brief Durable append-only journal of roster changes
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * With a journal enabled (CourseRegistration::enableJournal), every roster
+ * change the engine commits is appended to a file and numbered with a
+ * position. Appending only copies the record into an in-memory batch;
+ * a background writer turns batches into writes and fdatasyncs, so one
+ * sync covers every change appended while the previous one ran (group
+ * commit). A caller acknowledges a change once the journal's durable
+ * position reaches it, either by blocking in waitDurable or by
+ * registering a callback with onDurable.
+ *
+ * Backends:
+ * - IO_URING: the writer submits each batch as a write linked to an
+ *   fdatasync and keeps up to maxInFlight batches in flight, so the next
+ *   batch is written while the previous sync runs. Durability is taken
+ *   from the completion queue, and callbacks run from there.
+ * - WRITER_THREAD: portable fallback; the writer calls pwrite and
+ *   fdatasync itself, one batch at a time.
+ * - SYNCHRONOUS: append writes and syncs the record before returning,
+ *   in the committing thread with the course roster locked. This is the
+ *   blocking path the others are measured against.
+ * AUTO picks IO_URING when the build and the kernel support it, else
+ * WRITER_THREAD. The kernel must report write, fsync and read as
+ * supported opcodes in its io_uring probe; configure with -DCOURSE_REGISTRATION_IO_URING=OFF to
+ * leave it out.
+ *
+ * File layout:
+ * - 8-byte magic "CRJRNL01"
+ * - Records: u32 body length, u32 CRC-32C of the body, then the body:
+ *   u64 position, u64 commit version, u8 kind (EnrollmentEventKind),
+ *   u16 course code length, course code, u16 student ID length, student ID
+ * All integers are little-endian. Opening an existing journal keeps its
+ * records, cuts off a torn tail (a record whose length or checksum does
+ * not match) and continues numbering after the last intact record.
+ */
+
+#ifndef REGISTRATION_JOURNAL_H
+#define REGISTRATION_JOURNAL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "change_feed.h"
+
+/** @brief How a journal writes and syncs its batches */
+enum class JournalBackend {
+    AUTO,          /**< IO_URING if available, else WRITER_THREAD */
+    IO_URING,      /**< Batched writes and fdatasyncs submitted through io_uring */
+    WRITER_THREAD, /**< Batched pwrite and fdatasync on a writer thread */
+    SYNCHRONOUS    /**< write and fdatasync per record in the appending thread */
+};
+
+/** @brief Settings of a journal */
+struct JournalOptions {
+    JournalBackend backend = JournalBackend::AUTO; /**< Requested backend */
+    unsigned maxInFlight = 4; /**< Batches io_uring may have in flight, 1 to 16 */
+};
+
+/** @brief One roster change read back from a journal */
+struct JournalRecord {
+    uint64_t position;        /**< Position assigned by append, starting at 1 */
+    uint64_t version;         /**< Commit version of the change */
+    EnrollmentEventKind kind; /**< Enrollment or withdrawal */
+    std::string courseCode;   /**< Course whose roster changed */
+    std::string studentId;    /**< Student added or removed */
+};
+
+/** @brief Counters of a journal */
+struct JournalStats {
+    uint64_t records = 0;          /**< Records appended */
+    uint64_t batches = 0;          /**< Writes issued */
+    uint64_t syncs = 0;            /**< fdatasyncs completed */
+    uint64_t bytes = 0;            /**< Record bytes written */
+    uint64_t durablePosition = 0;  /**< Last position known to be on disk */
+};
+
+/**
+ * @brief Append-only roster change log with group commit
+ *
+ * append is safe to call from any number of threads; records are
+ * numbered in the order their appends take the journal's lock, which for
+ * changes to one course is their commit order.
+ *
+ * Example usage:
+ * @code
+ * RegistrationJournal journal("/var/lib/registration/journal");
+ * uint64_t position = journal.append(1, EnrollmentEventKind::ENROLLED, "CS101", "S1");
+ * journal.waitDurable(position);  // or journal.onDurable(position, ack, request)
+ * @endcode
+ */
+class RegistrationJournal {
+public:
+    using DurableCallback = void (*)(void*); /**< Completion callback; must not throw */
+
+    static constexpr unsigned kMaxInFlight = 16; /**< Upper bound of JournalOptions::maxInFlight */
+    static constexpr size_t kMaxFieldSize = 0xffff; /**< Longest course code or student ID a record holds */
+
+private:
+    struct Uring;
+
+    /** @brief A callback waiting for a position to become durable */
+    struct DurableWaiter {
+        uint64_t position;        /**< Position waited for */
+        DurableCallback callback; /**< Called once it is durable */
+        void* argument;           /**< Passed to callback */
+    };
+
+    /** @brief One batch handed to io_uring */
+    struct Batch {
+        std::string data;          /**< Encoded records */
+        uint64_t offset = 0;       /**< File offset of data */
+        uint64_t lastPosition = 0; /**< Position of the batch's last record */
+        size_t written = 0;        /**< Bytes of data the kernel has written so far */
+        bool shortWrite = false;   /**< Last write stopped early; the rest must be resubmitted */
+        bool completed = false;    /**< Whether its fdatasync (or its cancellation) completed */
+        bool synced = false;       /**< Whether its fdatasync succeeded */
+    };
+
+    int fd = -1;                    /**< Journal file */
+    std::string path;               /**< Journal file path */
+    JournalBackend chosen;          /**< Backend in use */
+    unsigned maxInFlight;           /**< Batches io_uring may have in flight */
+
+    mutable std::mutex mutex;       /**< Guards everything below */
+    std::condition_variable dataReady;    /**< Wakes the writer thread */
+    std::condition_variable durableReady; /**< Wakes waitDurable */
+    std::string pending;            /**< Records appended but not yet handed to the writer */
+    uint64_t appended = 0;          /**< Position of the last appended record */
+    uint64_t durable = 0;           /**< Position of the last durable record */
+    uint64_t fileEnd = 0;           /**< Offset the next batch is written at */
+    std::vector<DurableWaiter> waiters; /**< Min-heap of callbacks by position */
+    size_t callbacksRunning = 0;    /**< Callbacks taken off waiters that have not returned yet */
+    std::string failure;            /**< First I/O error, if any */
+    bool stopping = false;          /**< Set by the destructor */
+    bool wakeArmed = false;         /**< io_uring writer waits for appends on wakeFd */
+    JournalStats counters;          /**< Totals; durablePosition filled on read */
+
+    std::unique_ptr<Uring> uring;   /**< Submission and completion rings */
+    std::vector<Batch> batches;     /**< io_uring batch slots; kept until the rings close */
+    int wakeFd = -1;                /**< eventfd waking the io_uring writer */
+    std::thread writer;             /**< Background writer, unless SYNCHRONOUS */
+
+    /** @brief Scans an existing journal, cuts its torn tail and positions the writer */
+    void recover();
+
+    /**
+     * @brief Sets the durable position and returns the callbacks it satisfies; lock held
+     *
+     * The caller must pass them to runCallbacks.
+     */
+    std::vector<DurableWaiter> advanceDurable(uint64_t position);
+
+    /** @brief Records the first I/O error and releases every waiter to runCallbacks; lock held */
+    std::vector<DurableWaiter> fail(const std::string& message);
+
+    /** @brief Calls the callbacks taken from the waiter heap; lock not held */
+    void runCallbacks(const std::vector<DurableWaiter>& ready);
+
+    /** @brief Body of the WRITER_THREAD writer */
+    void runWriterThread();
+
+    /** @brief Body of the IO_URING writer */
+    void runUringWriter();
+
+public:
+    /**
+     * @brief Opens or creates a journal
+     *
+     * @param path Journal file; created if missing
+     * @param options Backend and io_uring depth
+     * @throws std::runtime_error if the file cannot be opened, is not a
+     *         journal, or IO_URING was requested and is unavailable
+     * @throws std::invalid_argument if maxInFlight is out of range
+     */
+    explicit RegistrationJournal(const std::string& path,
+                                 const JournalOptions& options = JournalOptions());
+
+    /** @brief Writes and syncs everything appended, then closes the file */
+    ~RegistrationJournal();
+
+    RegistrationJournal(const RegistrationJournal&) = delete;
+    RegistrationJournal& operator=(const RegistrationJournal&) = delete;
+
+    /**
+     * @brief Appends one roster change
+     *
+     * Never throws. I/O errors, and a course code or student ID longer
+     * than kMaxFieldSize, fail the journal; they are reported by
+     * waitDurable and failed().
+     *
+     * @return Position of the record
+     */
+    uint64_t append(uint64_t version, EnrollmentEventKind kind, const std::string& courseCode,
+                    const std::string& studentId);
+
+    /** @brief Returns the position of the last appended record */
+    uint64_t appendedPosition() const;
+
+    /** @brief Returns the position of the last record known to be on disk */
+    uint64_t durablePosition() const;
+
+    /**
+     * @brief Blocks until @p position is on disk
+     *
+     * @throws std::runtime_error if the journal failed before reaching it
+     */
+    void waitDurable(uint64_t position);
+
+    /** @brief Blocks until everything appended so far is on disk */
+    void sync() { waitDurable(appendedPosition()); }
+
+    /**
+     * @brief Blocks until the journal has nothing left to do for its callers
+     *
+     * Returns once everything appended is on disk (or the journal has
+     * failed) and every onDurable callback that released has returned.
+     * Unlike sync, it does not return while the writer is still calling
+     * callbacks, so it is safe to destroy what they use afterwards, as
+     * long as nothing appends or registers a callback meanwhile.
+     */
+    void waitIdle();
+
+    /**
+     * @brief Calls @p callback once @p position is on disk
+     *
+     * Calls it before returning if the position is already durable;
+     * otherwise it runs on the writer, straight from the completion that
+     * made the position durable, so it should only hand work off. It is
+     * also called if the journal fails; check failed() in it.
+     */
+    void onDurable(uint64_t position, DurableCallback callback, void* argument);
+
+    /** @brief Returns whether an I/O error stopped the journal */
+    bool failed() const;
+
+    /** @brief Returns the backend in use */
+    JournalBackend backend() const { return chosen; }
+
+    /** @brief Returns the journal's counters */
+    JournalStats stats() const;
+
+    /**
+     * @brief Reads every intact record of a journal file
+     *
+     * Stops at the first torn or corrupt record.
+     *
+     * @throws std::runtime_error if the file cannot be read or is not a journal
+     */
+    static std::vector<JournalRecord> read(const std::string& path);
+};
+
+/** @brief Returns the name of a journal backend, e.g. "io_uring" */
+const char* journalBackendName(JournalBackend backend);
+
+#endif // REGISTRATION_JOURNAL_H
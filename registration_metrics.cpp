@@ -0,0 +1,60 @@
+/**
+ * @file registration_metrics.cpp
+ * @brief Implementation of the registration metrics shards and histograms
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ */
+
+#include "registration_metrics.h"
+#include "course_registration.h"
+
+static_assert(static_cast<size_t>(RegistrationStatus::REGISTRATION_NOT_OPEN) + 1 == kStatusCount,
+              "kStatusCount must cover every RegistrationStatus");
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(q * (count - 1)) + 1;
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            return bucketUpperBound(bucket);
+        }
+    }
+    return bucketUpperBound(kBucketCount - 1);
+}
+
+#if COURSE_REGISTRATION_METRICS
+
+RegistrationMetrics::RegistrationMetrics() : shards(new Shard[kShardCount]) {}
+
+RegistrationMetrics::Shard& RegistrationMetrics::localShard() {
+    static std::atomic<unsigned> nextShard{0};
+    thread_local unsigned shardIndex =
+        nextShard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+    return shards[shardIndex];
+}
+
+MetricsSnapshot RegistrationMetrics::snapshot() const {
+    MetricsSnapshot result;
+    for (int s = 0; s < kShardCount; ++s) {
+        const Shard& shard = shards[s];
+        for (size_t i = 0; i < kStatusCount; ++i) {
+            result.statusCounts[i] += shard.statusCounts[i].load(std::memory_order_relaxed);
+        }
+        for (size_t op = 0; op < result.latency.size(); ++op) {
+            LatencyHistogram& histogram = result.latency[op];
+            for (int b = 0; b < LatencyHistogram::kBucketCount; ++b) {
+                uint64_t samples = shard.buckets[op][b].load(std::memory_order_relaxed);
+                histogram.buckets[b] += samples;
+                histogram.count += samples;
+            }
+            histogram.totalNanos += shard.totalNanos[op].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+#endif // COURSE_REGISTRATION_METRICS
@@ -0,0 +1,95 @@
+/**
+ * @file registration_protocol.cpp
+ * @brief Encoding and decoding of registration server frames
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <stdexcept>
+#include "registration_protocol.h"
+
+namespace {
+
+/** @brief Appends a little-endian 16-bit value */
+void put16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xff));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+/** @brief Appends a little-endian 32-bit value */
+void put32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+}
+
+/** @brief Reads a little-endian 16-bit value */
+uint16_t get16(const char* data) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+/** @brief Reads a little-endian 32-bit value */
+uint32_t get32(const char* data) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) |
+           (uint32_t(bytes[3]) << 24);
+}
+
+} // namespace
+
+void encodeRequest(const WireRequest& request, std::string& out) {
+    const size_t length = kRequestHeaderSize + request.studentId.size() + request.courseCode.size();
+    if (request.studentId.size() > 255 || length > kMaxRequestSize) {
+        throw std::length_error("Request does not fit in a frame");
+    }
+    put16(out, static_cast<uint16_t>(length));
+    out.push_back(static_cast<char>(request.opcode));
+    out.push_back(static_cast<char>(request.studentId.size()));
+    put32(out, request.tag);
+    out += request.studentId;
+    out += request.courseCode;
+}
+
+DecodeResult decodeRequest(const char* data, size_t size, WireRequest& request, size_t& consumed) {
+    if (size < 2) {
+        return DecodeResult::INCOMPLETE;
+    }
+    const size_t length = get16(data);
+    if (length < kRequestHeaderSize || length > kMaxRequestSize) {
+        return DecodeResult::MALFORMED;
+    }
+    if (size < length) {
+        return DecodeResult::INCOMPLETE;
+    }
+    const size_t studentLength = static_cast<unsigned char>(data[3]);
+    if (kRequestHeaderSize + studentLength > length) {
+        return DecodeResult::MALFORMED;
+    }
+    request.opcode = static_cast<WireOpcode>(data[2]);
+    request.tag = get32(data + 4);
+    request.studentId.assign(data + kRequestHeaderSize, studentLength);
+    request.courseCode.assign(data + kRequestHeaderSize + studentLength,
+                              length - kRequestHeaderSize - studentLength);
+    consumed = length;
+    return DecodeResult::COMPLETE;
+}
+
+void encodeResponse(const WireResponse& response, std::string& out) {
+    put32(out, response.tag);
+    out.push_back(static_cast<char>(response.opcode));
+    out.push_back(static_cast<char>(response.status));
+    put16(out, 0);
+    put32(out, static_cast<uint32_t>(response.enrolled));
+    put32(out, static_cast<uint32_t>(response.seatsLeft));
+}
+
+WireResponse decodeResponse(const char* data) {
+    WireResponse response;
+    response.tag = get32(data);
+    response.opcode = static_cast<WireOpcode>(data[4]);
+    response.status = static_cast<uint8_t>(data[5]);
+    response.enrolled = static_cast<int32_t>(get32(data + 8));
+    response.seatsLeft = static_cast<int32_t>(get32(data + 12));
+    return response;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file registration_protocol.h
+ * @brief Compact binary wire format of the registration server
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Requests and responses are framed back to back on a stream socket, so a
+ * client may send many requests before reading any answer (pipelining);
+ * the server answers each connection's requests in order. All integers
+ * are little-endian.
+ *
+ * Request frame (8-byte header, then the two strings):
+ * @code
+ * offset  size  field
+ *  0      2     frame length, header included
+ *  2      1     opcode (WireOpcode)
+ *  3      1     student ID length S (0 for QUERY)
+ *  4      4     tag, echoed in the response
+ *  8      S     student ID
+ *  8+S    rest  course code
+ * @endcode
+ *
+ * Response frame (always kResponseSize bytes):
+ * @code
+ * offset  size  field
+ *  0      4     tag of the request
+ *  4      1     opcode of the request
+ *  5      1     status: a RegistrationStatus, or kStatusUnknownStudent /
+ *               kStatusBadOpcode
+ *  6      2     zero
+ *  8      4     enrolled students (QUERY only)
+ * 12      4     seats left (QUERY only)
+ * @endcode
+ */
+
+#ifndef REGISTRATION_PROTOCOL_H
+#define REGISTRATION_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** @brief Operation requested by a frame */
+enum class WireOpcode : uint8_t {
+    REGISTER = 1, /**< tryRegisterStudent(student, course) */
+    WITHDRAW = 2, /**< withdrawStudent(student, course) */
+    QUERY = 3     /**< tryGetSeatAvailability(course) */
+};
+
+/** @brief Size of the fixed request header */
+constexpr size_t kRequestHeaderSize = 8;
+
+/** @brief Largest request frame a server accepts */
+constexpr size_t kMaxRequestSize = 1024;
+
+/** @brief Size of every response frame */
+constexpr size_t kResponseSize = 16;
+
+/** @brief Response status: the student ID is not in the server's directory */
+constexpr uint8_t kStatusUnknownStudent = 0xFE;
+
+/** @brief Response status: the opcode is not a WireOpcode */
+constexpr uint8_t kStatusBadOpcode = 0xFF;
+
+/** @brief One decoded request */
+struct WireRequest {
+    WireOpcode opcode;      /**< Requested operation; may be out of range */
+    uint32_t tag;           /**< Client-chosen tag, echoed in the response */
+    std::string studentId;  /**< Student the request is for; empty for QUERY */
+    std::string courseCode; /**< Course the request is for */
+};
+
+/** @brief One decoded response */
+struct WireResponse {
+    uint32_t tag;       /**< Tag of the request answered */
+    WireOpcode opcode;  /**< Opcode of the request answered */
+    uint8_t status;     /**< RegistrationStatus value or a kStatus* code */
+    int32_t enrolled;   /**< Enrolled students, for QUERY */
+    int32_t seatsLeft;  /**< Seats left, for QUERY */
+};
+
+/** @brief Result of trying to decode one frame from a buffer */
+enum class DecodeResult {
+    COMPLETE,   /**< A frame was decoded */
+    INCOMPLETE, /**< The buffer ends before the frame does; read more */
+    MALFORMED   /**< The bytes are not a valid frame; drop the connection */
+};
+
+/**
+ * @brief Appends a request frame to @p out
+ *
+ * @throws std::length_error if the IDs do not fit in kMaxRequestSize
+ */
+void encodeRequest(const WireRequest& request, std::string& out);
+
+/**
+ * @brief Decodes the request frame at the start of a buffer
+ *
+ * @param data Buffered bytes
+ * @param size Number of buffered bytes
+ * @param[out] request Decoded request, on COMPLETE
+ * @param[out] consumed Frame length, on COMPLETE
+ */
+DecodeResult decodeRequest(const char* data, size_t size, WireRequest& request, size_t& consumed);
+
+/** @brief Appends a response frame to @p out */
+void encodeResponse(const WireResponse& response, std::string& out);
+
+/**
+ * @brief Decodes one response frame
+ *
+ * @param data At least kResponseSize bytes
+ */
+WireResponse decodeResponse(const char* data);
+
+#endif // REGISTRATION_PROTOCOL_H
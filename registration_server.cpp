@@ -0,0 +1,435 @@
+/**
+ * @file registration_server.cpp
+ * @brief Implementation of the epoll registration server
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "registration_server.h"
+
+namespace {
+
+/** @brief Throws std::runtime_error naming the failed call and errno */
+[[noreturn]] void throwSystemError(const char* what) {
+    throw std::runtime_error(std::string(what) + ": " + std::strerror(errno));
+}
+
+/** @brief Binds and listens on a prepared address; closes the socket on failure */
+int bindAndListen(int family, const sockaddr* address, socklen_t length) {
+    int fd = ::socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throwSystemError("Cannot create socket");
+    }
+    int one = 1;
+    if (family == AF_INET) {
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    }
+    if (::bind(fd, address, length) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        throwSystemError("Cannot listen");
+    }
+    return fd;
+}
+
+} // namespace
+
+// Implementation of RegistrationServer methods
+
+RegistrationServer::RegistrationServer(CourseRegistration& registration, std::vector<Student>& students)
+    : registration(registration), students(students),
+      studentLocks(new std::mutex[kStudentLockStripes]) {
+    studentIndex.reserve(students.size());
+    for (size_t i = 0; i < students.size(); ++i) {
+        studentIndex.emplace(students[i].getStudentId(), i);
+    }
+}
+
+RegistrationServer::~RegistrationServer() {
+    stop();
+}
+
+uint16_t RegistrationServer::listenTcp(const std::string& address, uint16_t port) {
+    if (!loops.empty()) {
+        throw std::logic_error("Server is already running");
+    }
+    sockaddr_in socketAddress{};
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) {
+        throw std::invalid_argument("Not an IPv4 address");
+    }
+    int fd = bindAndListen(AF_INET, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress));
+    socklen_t length = sizeof(socketAddress);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&socketAddress), &length);
+    listeners.push_back(fd);
+    tcpListener.push_back(true);
+    return ntohs(socketAddress.sin_port);
+}
+
+void RegistrationServer::listenUnix(const std::string& path) {
+    if (!loops.empty()) {
+        throw std::logic_error("Server is already running");
+    }
+    sockaddr_un socketAddress{};
+    socketAddress.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(socketAddress.sun_path)) {
+        throw std::invalid_argument("Socket path is too long");
+    }
+    std::memcpy(socketAddress.sun_path, path.c_str(), path.size() + 1);
+    ::unlink(path.c_str());
+    listeners.push_back(bindAndListen(AF_UNIX, reinterpret_cast<sockaddr*>(&socketAddress),
+                                      sizeof(socketAddress)));
+    tcpListener.push_back(false);
+    unixPath = path;
+}
+
+void RegistrationServer::start(unsigned threads) {
+    if (!loops.empty()) {
+        throw std::logic_error("Server is already running");
+    }
+    if (listeners.empty()) {
+        throw std::logic_error("Server is not listening");
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    try {
+        for (unsigned t = 0; t < threads; ++t) {
+            loops.emplace_back(new EventLoop);
+            EventLoop& loop = *loops.back();
+            loop.epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+            loop.wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            loop.spareFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+            if (loop.epollFd < 0 || loop.wakeFd < 0 || loop.spareFd < 0) {
+                throwSystemError("Cannot create event loop");
+            }
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = loop.wakeFd;
+            ::epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, loop.wakeFd, &event);
+            for (int listener : listeners) {
+                // Wake one loop per connection, not all of them
+                event.events = EPOLLIN | EPOLLEXCLUSIVE;
+                event.data.fd = listener;
+                if (::epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, listener, &event) < 0) {
+                    throwSystemError("Cannot watch listener");
+                }
+            }
+        }
+    } catch (...) {
+        // Listeners stay open, so start() may be retried
+        for (auto& loop : loops) {
+            if (loop->spareFd >= 0) {
+                ::close(loop->spareFd);
+            }
+            if (loop->wakeFd >= 0) {
+                ::close(loop->wakeFd);
+            }
+            if (loop->epollFd >= 0) {
+                ::close(loop->epollFd);
+            }
+        }
+        loops.clear();
+        throw;
+    }
+    for (auto& loop : loops) {
+        EventLoop* target = loop.get();
+        loop->thread = std::thread([this, target] { run(*target); });
+    }
+}
+
+void RegistrationServer::stop() {
+    for (auto& loop : loops) {
+        uint64_t one = 1;
+        // Cannot fail: a handful of writes never fills the eventfd counter
+        ssize_t written = ::write(loop->wakeFd, &one, sizeof(one));
+        (void)written;
+    }
+    for (auto& loop : loops) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+        for (auto& entry : loop->connections) {
+            ::close(entry.first);
+        }
+        if (loop->spareFd >= 0) {
+            ::close(loop->spareFd);
+        }
+        ::close(loop->wakeFd);
+        ::close(loop->epollFd);
+    }
+    loops.clear();
+    for (int listener : listeners) {
+        ::close(listener);
+    }
+    listeners.clear();
+    tcpListener.clear();
+    if (!unixPath.empty()) {
+        ::unlink(unixPath.c_str());
+        unixPath.clear();
+    }
+}
+
+ServerStats RegistrationServer::stats() const {
+    ServerStats total;
+    for (const auto& loop : loops) {
+        total.connections += loop->accepted.load(std::memory_order_relaxed);
+        total.requests += loop->requests.load(std::memory_order_relaxed);
+        total.batches += loop->batches.load(std::memory_order_relaxed);
+        total.writes += loop->writes.load(std::memory_order_relaxed);
+        total.shed += loop->shed.load(std::memory_order_relaxed);
+        total.failedLoops += loop->waitError.load(std::memory_order_relaxed) != 0;
+    }
+    return total;
+}
+
+void RegistrationServer::run(EventLoop& loop) {
+    epoll_event events[kMaxEvents];
+    for (;;) {
+        int ready = ::epoll_wait(loop.epollFd, events, kMaxEvents, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Nothing more can be served; stats() reports the stopped loop
+            loop.waitError.store(errno, std::memory_order_relaxed);
+            return;
+        }
+        for (int i = 0; i < ready; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == loop.wakeFd) {
+                return;
+            }
+            bool isListener = false;
+            for (size_t l = 0; l < listeners.size(); ++l) {
+                if (listeners[l] == fd) {
+                    acceptAll(loop, l);
+                    isListener = true;
+                    break;
+                }
+            }
+            if (isListener) {
+                continue;
+            }
+            auto connectionIt = loop.connections.find(fd);
+            if (connectionIt == loop.connections.end()) {
+                continue;
+            }
+            Connection& connection = *connectionIt->second;
+            if (events[i].events & EPOLLOUT) {
+                if (!flush(loop, connection)) {
+                    continue;
+                }
+                updateInterest(loop, connection);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                onReadable(loop, connection);
+            }
+        }
+    }
+}
+
+void RegistrationServer::acceptAll(EventLoop& loop, size_t listener) {
+    for (;;) {
+        int fd = ::accept4(listeners[listener], nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if ((errno == EMFILE || errno == ENFILE) && loop.spareFd >= 0) {
+                // The listener stays readable until the connection is taken,
+                // so take it with the spare descriptor and drop it
+                ::close(loop.spareFd);
+                int dropped = ::accept4(listeners[listener], nullptr, nullptr, SOCK_CLOEXEC);
+                if (dropped >= 0) {
+                    ::close(dropped);
+                    loop.shed.fetch_add(1, std::memory_order_relaxed);
+                }
+                loop.spareFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+            }
+            return;  // EAGAIN, or another loop took it
+        }
+        if (tcpListener[listener]) {
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        std::unique_ptr<Connection> connection(new Connection);
+        connection->fd = fd;
+        connection->interest = EPOLLIN;
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+        loop.connections.emplace(fd, std::move(connection));
+        loop.accepted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void RegistrationServer::onReadable(EventLoop& loop, Connection& connection) {
+    // Read until the kernel's buffer is empty. epoll is level-triggered, so
+    // stopping early (a short read, or output piling up) only defers the rest
+    // to the next event.
+    WireRequest request;
+    size_t executed = 0;
+    for (;;) {
+        const size_t buffered = connection.input.size();
+        connection.input.resize(buffered + kReadChunk);
+        ssize_t received = ::recv(connection.fd, &connection.input[buffered], kReadChunk, 0);
+        if (received <= 0) {
+            connection.input.resize(buffered);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received < 0 && errno == EAGAIN) {
+                break;
+            }
+            close(loop, connection.fd);
+            return;
+        }
+        connection.input.resize(buffered + static_cast<size_t>(received));
+
+        // Execute every complete request, in order, before answering any
+        size_t offset = 0;
+        for (;;) {
+            size_t consumed = 0;
+            DecodeResult result = decodeRequest(connection.input.data() + offset,
+                                                connection.input.size() - offset, request, consumed);
+            if (result == DecodeResult::INCOMPLETE) {
+                break;
+            }
+            if (result == DecodeResult::MALFORMED) {
+                close(loop, connection.fd);
+                return;
+            }
+            execute(request, connection.output);
+            offset += consumed;
+            ++executed;
+        }
+        connection.input.erase(0, offset);
+        if (static_cast<size_t>(received) < kReadChunk ||
+            connection.output.size() - connection.sent >= kMaxPendingOutput) {
+            break;
+        }
+    }
+    if (executed == 0) {
+        return;
+    }
+    loop.requests.fetch_add(executed, std::memory_order_relaxed);
+    loop.batches.fetch_add(1, std::memory_order_relaxed);
+    if (flush(loop, connection)) {
+        updateInterest(loop, connection);
+    }
+}
+
+bool RegistrationServer::flush(EventLoop& loop, Connection& connection) {
+    while (connection.sent < connection.output.size()) {
+        ssize_t written = ::send(connection.fd, connection.output.data() + connection.sent,
+                                 connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EAGAIN) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            close(loop, connection.fd);
+            return false;
+        }
+        connection.sent += static_cast<size_t>(written);
+        loop.writes.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (connection.sent == connection.output.size()) {
+        connection.output.clear();
+        connection.sent = 0;
+    }
+    return true;
+}
+
+void RegistrationServer::updateInterest(EventLoop& loop, Connection& connection) {
+    const size_t pending = connection.output.size() - connection.sent;
+    uint32_t interest = 0;
+    if (pending > 0) {
+        interest |= EPOLLOUT;
+    }
+    // Stop taking requests from a client that is not reading its answers
+    if (pending < kMaxPendingOutput) {
+        interest |= EPOLLIN;
+    }
+    if (interest != connection.interest) {
+        epoll_event event{};
+        event.events = interest;
+        event.data.fd = connection.fd;
+        ::epoll_ctl(loop.epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.interest = interest;
+    }
+}
+
+void RegistrationServer::close(EventLoop& loop, int fd) {
+    ::epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    loop.connections.erase(fd);
+}
+
+void RegistrationServer::execute(const WireRequest& request, std::string& output) {
+    WireResponse response{request.tag, request.opcode,
+                          static_cast<uint8_t>(RegistrationStatus::SUCCESS), 0, 0};
+    switch (request.opcode) {
+    case WireOpcode::REGISTER: {
+        auto studentIt = studentIndex.find(request.studentId);
+        if (studentIt == studentIndex.end()) {
+            response.status = kStatusUnknownStudent;
+            break;
+        }
+        std::lock_guard<std::mutex> studentLock(
+            studentLocks[std::hash<std::string>()(request.studentId) % kStudentLockStripes]);
+        response.status = static_cast<uint8_t>(
+            registration.tryRegisterStudent(students[studentIt->second], request.courseCode));
+        break;
+    }
+    case WireOpcode::WITHDRAW: {
+        if (studentIndex.find(request.studentId) == studentIndex.end()) {
+            response.status = kStatusUnknownStudent;
+            break;
+        }
+        std::lock_guard<std::mutex> studentLock(
+            studentLocks[std::hash<std::string>()(request.studentId) % kStudentLockStripes]);
+        RegistrationStatus status = RegistrationStatus::SUCCESS;
+        if (!registration.withdrawStudent(request.studentId, request.courseCode)) {
+            // withdrawStudent does not say why; only an unknown course has no count
+            status = registration.tryGetEnrollmentCount(request.courseCode).ok()
+                         ? RegistrationStatus::NOT_ENROLLED : RegistrationStatus::UNKNOWN_COURSE;
+        }
+        response.status = static_cast<uint8_t>(status);
+        break;
+    }
+    case WireOpcode::QUERY: {
+        CourseQueryResult<SeatAvailability> seats = registration.tryGetSeatAvailability(request.courseCode);
+        response.status = static_cast<uint8_t>(seats.status);
+        if (seats.ok()) {
+            response.enrolled = seats.value.enrolled;
+            response.seatsLeft = seats.value.seatsLeft;
+        }
+        break;
+    }
+    default:
+        response.status = kStatusBadOpcode;
+        break;
+    }
+    encodeResponse(response, output);
+}
@@ -0,0 +1,197 @@
+/**
+ * @file registration_server.h
+ * @brief epoll server exposing the registration engine over registration_protocol.h
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * The server runs one or more event loops, each with its own epoll
+ * instance and its own connections. Every listening socket is registered
+ * in every loop with EPOLLEXCLUSIVE, so an incoming connection wakes one
+ * loop, which accepts it and keeps it for its lifetime.
+ *
+ * A readable connection is drained of what the kernel has buffered, every
+ * complete request in it is executed in order, and all the answers are
+ * written back with one send, so a client that pipelines N requests costs
+ * about one read and one write system call instead of N of each. When a
+ * client stops reading, its pending output is capped at
+ * kMaxPendingOutput and the server stops reading its requests until the
+ * output drains.
+ *
+ * When the process runs out of file descriptors, a loop gives up a spare
+ * descriptor it keeps open, accepts the pending connection and closes it
+ * at once, so the listener stops reporting it instead of waking every
+ * loop until a descriptor frees up. Such connections are counted in
+ * ServerStats::shed.
+ */
+
+#ifndef REGISTRATION_SERVER_H
+#define REGISTRATION_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "course_registration.h"
+#include "registration_protocol.h"
+
+/** @brief Counters of a running server, summed over its event loops */
+struct ServerStats {
+    uint64_t connections = 0; /**< Connections accepted */
+    uint64_t requests = 0;    /**< Requests executed */
+    uint64_t batches = 0;     /**< Readable events that produced at least one response */
+    uint64_t writes = 0;      /**< send() calls that wrote responses */
+    uint64_t shed = 0;        /**< Connections closed on accept for lack of file descriptors */
+    uint64_t failedLoops = 0; /**< Event loops stopped early because epoll_wait failed */
+};
+
+/**
+ * @brief Serves register, withdraw and availability queries over stream sockets
+ *
+ * The engine and the student directory are borrowed and must outlive the
+ * server. Two requests for the same student are never executed at once,
+ * even from different connections, as CourseRegistration requires.
+ *
+ * Example usage:
+ * @code
+ * RegistrationServer server(reg, students);
+ * server.listenUnix("/run/registration.sock");
+ * uint16_t port = server.listenTcp("127.0.0.1", 0);  // any free port
+ * server.start(4);
+ * ...
+ * server.stop();
+ * @endcode
+ */
+class RegistrationServer {
+public:
+    static constexpr size_t kReadChunk = 64 * 1024;          /**< Bytes requested per read() */
+    static constexpr size_t kMaxPendingOutput = 1u << 20;    /**< Unsent bytes before reading pauses */
+    static constexpr size_t kStudentLockStripes = 256;       /**< Mutexes serializing each student */
+    static constexpr int kMaxEvents = 256;                   /**< Events taken per epoll_wait */
+
+private:
+    /** @brief One client connection, owned by one event loop */
+    struct Connection {
+        int fd;                 /**< Socket */
+        std::string input;      /**< Received bytes not yet decoded */
+        std::string output;     /**< Encoded responses not yet sent */
+        size_t sent = 0;        /**< Bytes of output already sent */
+        uint32_t interest = 0;  /**< epoll events currently registered */
+    };
+
+    /** @brief One event loop thread and its connections */
+    struct EventLoop {
+        int epollFd = -1;  /**< epoll instance */
+        int wakeFd = -1;   /**< eventfd written by stop() */
+        int spareFd = -1;  /**< Reserve descriptor given up to shed a connection */
+        std::thread thread; /**< Thread running run() */
+        std::unordered_map<int, std::unique_ptr<Connection>> connections; /**< Open connections by fd */
+        std::atomic<uint64_t> accepted{0}; /**< Connections accepted */
+        std::atomic<uint64_t> requests{0}; /**< Requests executed */
+        std::atomic<uint64_t> batches{0};  /**< Readable events that produced responses */
+        std::atomic<uint64_t> writes{0};   /**< send() calls */
+        std::atomic<uint64_t> shed{0};     /**< Connections shed for lack of descriptors */
+        std::atomic<int> waitError{0};     /**< errno that stopped the loop, or 0 */
+    };
+
+    CourseRegistration& registration;                    /**< Engine requests run against */
+    std::vector<Student>& students;                      /**< Student directory */
+    std::unordered_map<std::string, size_t> studentIndex; /**< Position of each student ID */
+    std::unique_ptr<std::mutex[]> studentLocks;          /**< Stripes serializing students */
+    std::vector<int> listeners;                          /**< Listening sockets */
+    std::vector<bool> tcpListener;                       /**< Whether listeners[i] is TCP */
+    std::string unixPath;                                /**< Socket file to remove on stop */
+    std::vector<std::unique_ptr<EventLoop>> loops;       /**< Running event loops */
+
+    /** @brief Runs one event loop until stop() */
+    void run(EventLoop& loop);
+
+    /**
+     * @brief Accepts every pending connection on a listener
+     *
+     * Out of descriptors, sheds one pending connection with the loop's
+     * spare descriptor and stops.
+     */
+    void acceptAll(EventLoop& loop, size_t listener);
+
+    /** @brief Reads, executes and answers the buffered requests of a connection */
+    void onReadable(EventLoop& loop, Connection& connection);
+
+    /**
+     * @brief Sends as much pending output as the socket takes
+     *
+     * @return false if the connection failed and was closed
+     */
+    bool flush(EventLoop& loop, Connection& connection);
+
+    /** @brief Registers the events the connection's buffers call for */
+    void updateInterest(EventLoop& loop, Connection& connection);
+
+    /** @brief Closes and forgets a connection */
+    void close(EventLoop& loop, int fd);
+
+    /** @brief Executes one request and appends its response */
+    void execute(const WireRequest& request, std::string& output);
+
+public:
+    /**
+     * @brief Creates a server for an engine and its students
+     *
+     * @param registration Engine the requests run against
+     * @param students Students REGISTER requests may name; the server
+     *        registers them in place
+     */
+    RegistrationServer(CourseRegistration& registration, std::vector<Student>& students);
+
+    /** @brief Stops the server if it is running */
+    ~RegistrationServer();
+
+    RegistrationServer(const RegistrationServer&) = delete;
+    RegistrationServer& operator=(const RegistrationServer&) = delete;
+
+    /**
+     * @brief Listens on a TCP address
+     *
+     * @param address IPv4 address to bind, e.g. "127.0.0.1" or "0.0.0.0"
+     * @param port Port to bind; 0 picks a free port
+     * @return Bound port
+     * @throws std::invalid_argument if @p address is not an IPv4 address
+     * @throws std::runtime_error if the socket cannot be bound
+     * @throws std::logic_error if the server is already running
+     */
+    uint16_t listenTcp(const std::string& address, uint16_t port);
+
+    /**
+     * @brief Listens on a Unix domain socket, replacing a stale socket file
+     *
+     * @throws std::invalid_argument if @p path is too long for a socket address
+     * @throws std::runtime_error if the socket cannot be bound
+     * @throws std::logic_error if the server is already running
+     */
+    void listenUnix(const std::string& path);
+
+    /**
+     * @brief Starts the event loops
+     *
+     * @param threads Number of event loops; 0 means one per hardware thread
+     * @throws std::logic_error if already running or not listening
+     * @throws std::runtime_error if epoll cannot be set up
+     */
+    void start(unsigned threads = 1);
+
+    /** @brief Stops the event loops, closing every connection and listener */
+    void stop();
+
+    /**
+     * @brief Returns the server's counters; safe to call while it runs
+     *
+     * A loop counted in failedLoops has stopped serving its connections;
+     * stop() still cleans it up.
+     */
+    ServerStats stats() const;
+};
+
+#endif // REGISTRATION_SERVER_H
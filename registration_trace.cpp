@@ -0,0 +1,346 @@
+/**
+ * @file registration_trace.cpp
+ * @brief Implementation of registration trace recording and reading
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include "registration_trace.h"
+#include "varint.h"
+
+namespace {
+
+const char kTraceMagic[8] = {'C', 'R', 'T', 'R', 'A', 'C', 'E', '2'};
+const char kTraceMagicV1[8] = {'C', 'R', 'T', 'R', 'A', 'C', 'E', '1'}; /**< STUDENT without semester and CGPA */
+const size_t kFlushThreshold = 64 * 1024; /**< Buffered bytes before a write */
+
+/** @brief Sequential decoder over a trace stream */
+class TraceInput {
+private:
+    std::istream& in;
+
+public:
+    explicit TraceInput(std::istream& in) : in(in) {}
+
+    bool atEnd() { return in.peek() == std::char_traits<char>::eof(); }
+
+    uint8_t byte() {
+        int c = in.get();
+        if (c == std::char_traits<char>::eof()) {
+            throw std::runtime_error("Truncated trace");
+        }
+        return static_cast<uint8_t>(c);
+    }
+
+    uint64_t varint() { return getVarint([this] { return byte(); }); }
+
+    /**
+     * @brief Reads a string of @p length bytes
+     *
+     * The string grows with the bytes actually read, so a corrupt length
+     * fails as a truncated trace instead of allocating it up front.
+     */
+    std::string bytes(uint64_t length) {
+        std::string value;
+        char chunk[4096];
+        while (length > 0) {
+            auto count = static_cast<std::streamsize>(std::min<uint64_t>(length, sizeof(chunk)));
+            if (!in.read(chunk, count)) {
+                throw std::runtime_error("Truncated trace");
+            }
+            value.append(chunk, static_cast<size_t>(count));
+            length -= static_cast<uint64_t>(count);
+        }
+        return value;
+    }
+};
+
+} // namespace
+
+// Implementation of TraceRecorder methods
+
+TraceRecorder::TraceRecorder(std::ostream& out) : out(out), lastEvent(Clock::now()) {
+    buffer.append(kTraceMagic, sizeof(kTraceMagic));
+}
+
+TraceRecorder::~TraceRecorder() {
+    flush();
+}
+
+uint64_t TraceRecorder::intern(const std::string& value) {
+    auto it = stringIds.find(value);
+    if (it != stringIds.end()) {
+        return it->second;
+    }
+    uint64_t id = stringIds.size();
+    stringIds.emplace(value, id);
+    buffer.push_back(static_cast<char>(TraceRecordType::STRING));
+    putVarint(buffer, id);
+    putVarint(buffer, value.size());
+    buffer.append(value);
+    return id;
+}
+
+void TraceRecorder::putTimeDelta() {
+    Clock::time_point now = Clock::now();
+    putVarint(buffer, std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastEvent).count());
+    lastEvent = now;
+}
+
+void TraceRecorder::flushIfFull() {
+    if (buffer.size() >= kFlushThreshold) {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+void TraceRecorder::recordAddCourse(const std::string& courseCode,
+                                    const std::string& courseName,
+                                    int capacity,
+                                    const std::set<std::string>& prerequisites,
+                                    time_t deadline) {
+    std::lock_guard<std::mutex> guard(mutex);
+    // Intern every string before the record header so records never nest
+    uint64_t codeId = intern(courseCode);
+    uint64_t nameId = intern(courseName);
+    std::vector<uint64_t> prereqIds;
+    for (const auto& prereq : prerequisites) {
+        prereqIds.push_back(intern(prereq));
+    }
+
+    buffer.push_back(static_cast<char>(TraceRecordType::ADD_COURSE));
+    putTimeDelta();
+    putVarint(buffer, codeId);
+    putVarint(buffer, nameId);
+    putVarint(buffer, zigzagEncode(capacity));
+    putVarint(buffer, zigzagEncode(deadline));
+    putVarint(buffer, prereqIds.size());
+    for (uint64_t id : prereqIds) {
+        putVarint(buffer, id);
+    }
+    flushIfFull();
+}
+
+void TraceRecorder::recordAddSection(const std::string& parentCode, const std::string& sectionCode,
+                                     int capacity, const std::string& department) {
+    std::lock_guard<std::mutex> guard(mutex);
+    uint64_t parentId = intern(parentCode);
+    uint64_t sectionId = intern(sectionCode);
+    uint64_t departmentId = intern(department);
+
+    buffer.push_back(static_cast<char>(TraceRecordType::ADD_SECTION));
+    putTimeDelta();
+    putVarint(buffer, parentId);
+    putVarint(buffer, sectionId);
+    putVarint(buffer, zigzagEncode(capacity));
+    putVarint(buffer, departmentId);
+    flushIfFull();
+}
+
+void TraceRecorder::recordRegister(const Student& student, const std::string& courseCode,
+                                   RegistrationStatus status) {
+    std::lock_guard<std::mutex> guard(mutex);
+    uint64_t studentId = intern(student.getStudentId());
+    if (knownStudents.insert(studentId).second) {
+        std::vector<uint64_t> courseIds;
+        for (const auto& course : student.getEnrolledCourses()) {
+            courseIds.push_back(intern(course));
+        }
+        buffer.push_back(static_cast<char>(TraceRecordType::STUDENT));
+        putVarint(buffer, studentId);
+        putVarint(buffer, zigzagEncode(student.getSemester()));
+        float cgpa = student.getCGPA();
+        uint32_t cgpaBits;
+        std::memcpy(&cgpaBits, &cgpa, sizeof(cgpaBits));
+        for (int i = 0; i < 4; ++i) {
+            buffer.push_back(static_cast<char>((cgpaBits >> (8 * i)) & 0xff));
+        }
+        putVarint(buffer, courseIds.size());
+        for (uint64_t id : courseIds) {
+            putVarint(buffer, id);
+        }
+        const std::string department = student.getDepartment();
+        if (!department.empty()) {
+            uint64_t departmentId = intern(department);
+            buffer.push_back(static_cast<char>(TraceRecordType::DEPARTMENT));
+            putVarint(buffer, studentId);
+            putVarint(buffer, departmentId);
+        }
+    }
+    uint64_t courseId = intern(courseCode);
+
+    buffer.push_back(static_cast<char>(TraceRecordType::REGISTER));
+    putTimeDelta();
+    putVarint(buffer, studentId);
+    putVarint(buffer, courseId);
+    buffer.push_back(static_cast<char>(status));
+    flushIfFull();
+}
+
+void TraceRecorder::recordWithdraw(const std::string& studentId, const std::string& courseCode,
+                                   bool withdrawn) {
+    std::lock_guard<std::mutex> guard(mutex);
+    uint64_t studentRef = intern(studentId);
+    uint64_t courseRef = intern(courseCode);
+
+    buffer.push_back(static_cast<char>(TraceRecordType::WITHDRAW));
+    putTimeDelta();
+    putVarint(buffer, studentRef);
+    putVarint(buffer, courseRef);
+    buffer.push_back(static_cast<char>(withdrawn ? 1 : 0));
+    flushIfFull();
+}
+
+void TraceRecorder::recordClock(time_t now) {
+    std::lock_guard<std::mutex> guard(mutex);
+    buffer.push_back(static_cast<char>(TraceRecordType::CLOCK));
+    putVarint(buffer, zigzagEncode(now));
+    flushIfFull();
+}
+
+void TraceRecorder::flush() {
+    std::lock_guard<std::mutex> guard(mutex);
+    out.write(buffer.data(), buffer.size());
+    buffer.clear();
+    out.flush();
+}
+
+Trace readTrace(std::istream& in) {
+    char magic[sizeof(kTraceMagic)];
+    if (!in.read(magic, sizeof(magic))) {
+        throw std::runtime_error("Not a registration trace");
+    }
+    const bool hasStanding = std::equal(magic, magic + sizeof(magic), kTraceMagic);
+    if (!hasStanding && !std::equal(magic, magic + sizeof(magic), kTraceMagicV1)) {
+        throw std::runtime_error("Not a registration trace");
+    }
+
+    TraceInput input(in);
+    std::vector<std::string> strings;
+    auto string = [&](uint64_t id) -> const std::string& {
+        if (id >= strings.size()) {
+            throw std::runtime_error("Trace references an undefined string");
+        }
+        return strings[id];
+    };
+
+    Trace trace;
+    uint64_t clock = 0;
+    while (!input.atEnd()) {
+        auto type = static_cast<TraceRecordType>(input.byte());
+        switch (type) {
+        case TraceRecordType::STRING: {
+            uint64_t id = input.varint();
+            uint64_t length = input.varint();
+            if (id != strings.size()) {
+                throw std::runtime_error("Trace strings out of order");
+            }
+            strings.push_back(input.bytes(length));
+            break;
+        }
+        case TraceRecordType::STUDENT: {
+            const std::string& studentId = string(input.varint());
+            if (hasStanding) {
+                int64_t semester = zigzagDecode(input.varint());
+                if (semester < 1 || semester > std::numeric_limits<int>::max()) {
+                    throw std::runtime_error("Trace student semester out of range");
+                }
+                trace.studentSemesters[studentId] = static_cast<int>(semester);
+                uint32_t cgpaBits = 0;
+                for (int i = 0; i < 4; ++i) {
+                    cgpaBits |= static_cast<uint32_t>(input.byte()) << (8 * i);
+                }
+                float cgpa;
+                std::memcpy(&cgpa, &cgpaBits, sizeof(cgpa));
+                if (!(cgpa >= 0.0f && cgpa <= 10.0f)) {
+                    throw std::runtime_error("Trace student CGPA out of range");
+                }
+                trace.studentCgpas[studentId] = cgpa;
+            }
+            auto& courses = trace.studentCourses[studentId];
+            for (uint64_t n = input.varint(); n > 0; --n) {
+                courses.push_back(string(input.varint()));
+            }
+            break;
+        }
+        case TraceRecordType::ADD_COURSE: {
+            TraceEvent event{};
+            event.type = type;
+            event.offsetNanos = clock += input.varint();
+            event.courseCode = string(input.varint());
+            event.courseName = string(input.varint());
+            event.capacity = static_cast<int>(zigzagDecode(input.varint()));
+            event.deadline = static_cast<time_t>(zigzagDecode(input.varint()));
+            for (uint64_t n = input.varint(); n > 0; --n) {
+                event.prerequisites.insert(string(input.varint()));
+            }
+            trace.events.push_back(std::move(event));
+            break;
+        }
+        case TraceRecordType::REGISTER:
+        case TraceRecordType::WITHDRAW: {
+            TraceEvent event{};
+            event.type = type;
+            event.offsetNanos = clock += input.varint();
+            event.studentId = string(input.varint());
+            event.courseCode = string(input.varint());
+            event.result = input.byte();
+            trace.events.push_back(std::move(event));
+            break;
+        }
+        case TraceRecordType::ADD_SECTION: {
+            TraceEvent event{};
+            event.type = type;
+            event.offsetNanos = clock += input.varint();
+            event.parentCode = string(input.varint());
+            event.courseCode = string(input.varint());
+            event.capacity = static_cast<int>(zigzagDecode(input.varint()));
+            event.department = string(input.varint());
+            trace.events.push_back(std::move(event));
+            break;
+        }
+        case TraceRecordType::DEPARTMENT: {
+            const std::string& studentId = string(input.varint());
+            trace.studentDepartments[studentId] = string(input.varint());
+            break;
+        }
+        case TraceRecordType::CLOCK: {
+            time_t now = static_cast<time_t>(zigzagDecode(input.varint()));
+            if (!trace.hasStartTime) {
+                trace.hasStartTime = true;
+                trace.startTime = now;
+            }
+            break;
+        }
+        default:
+            throw std::runtime_error("Unknown trace record type");
+        }
+    }
+    return trace;
+}
+
+Student replayStudent(const Trace& trace, const std::string& studentId) {
+    auto department = trace.studentDepartments.find(studentId);
+    Student student(studentId, "", department == trace.studentDepartments.end() ? "" : department->second);
+    auto courses = trace.studentCourses.find(studentId);
+    if (courses != trace.studentCourses.end()) {
+        for (const auto& course : courses->second) {
+            student.enrollInCourse(course);
+        }
+    }
+    auto semester = trace.studentSemesters.find(studentId);
+    if (semester != trace.studentSemesters.end()) {
+        student.setSemester(semester->second);
+    }
+    auto cgpa = trace.studentCgpas.find(studentId);
+    if (cgpa != trace.studentCgpas.end()) {
+        student.updateCGPA(cgpa->second);
+    }
+    return student;
+}
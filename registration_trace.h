@@ -0,0 +1,178 @@
+/**
+ * @file registration_trace.h
+ * @brief Binary trace recording and reading for registration traffic
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * A TraceRecorder attached to a CourseRegistration captures every
+ * addCourse, addSection, registerStudent and withdrawStudent call with its
+ * outcome and arrival time. The trace is compact: strings (course codes,
+ * student IDs) are written once and then referenced by number, and all
+ * integers are LEB128 varints, so a typical event takes under ten bytes.
+ *
+ * Trace layout:
+ * - 8-byte magic "CRTRACE2"
+ * - A sequence of records, each starting with a one-byte TraceRecordType
+ *
+ * | Record      | Payload (varints unless noted)                                   |
+ * |-------------|------------------------------------------------------------------|
+ * | STRING      | id, length, raw bytes                                            |
+ * | STUDENT     | student id, semester, CGPA (4-byte float), course count, course ids |
+ * | ADD_COURSE  | time delta, code id, name id, capacity, deadline (zigzag), prereq count, prereq ids |
+ * | REGISTER    | time delta, student id, course id, status (1 byte)               |
+ * | WITHDRAW    | time delta, student id, course id, result (1 byte)               |
+ * | CLOCK       | engine clock in seconds (zigzag)                                 |
+ * | ADD_SECTION | time delta, parent id, section id, capacity (zigzag), department id |
+ * | DEPARTMENT  | student id, department id                                        |
+ *
+ * Time deltas are nanoseconds since the previous timed record. A STUDENT
+ * record is written the first time a student is seen and holds the
+ * semester, CGPA and courses they had at that point, so a replay can
+ * rebuild prerequisite state and the cohort that registration windows
+ * go by (see replayStudent). It is followed by a DEPARTMENT record if
+ * the student has a department, which decides the sections they may
+ * take. A CLOCK record is written when the recorder is attached so a
+ * replay can evaluate deadlines against the time of the recording.
+ * Traces with the older magic "CRTRACE1" have no semester or CGPA in
+ * their STUDENT records and still read back.
+ */
+
+#ifndef REGISTRATION_TRACE_H
+#define REGISTRATION_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "course_registration.h"
+
+/** @brief Kind of record stored in a registration trace */
+enum class TraceRecordType : uint8_t {
+    STRING = 1,     /**< Interned string definition */
+    STUDENT = 2,    /**< First sighting of a student */
+    ADD_COURSE = 3, /**< CourseRegistration::addCourse */
+    REGISTER = 4,   /**< CourseRegistration::registerStudent */
+    WITHDRAW = 5,   /**< CourseRegistration::withdrawStudent */
+    CLOCK = 6,      /**< Engine clock when recording started */
+    ADD_SECTION = 7, /**< CourseRegistration::addSection */
+    DEPARTMENT = 8  /**< Department of a student, after their STUDENT record */
+};
+
+/**
+ * @brief Records registration calls into a binary trace stream
+ *
+ * All record methods are thread-safe; they serialize on an internal mutex,
+ * so recording is meant for capturing traffic rather than for peak-load runs.
+ * Output is buffered and written to the stream when the buffer fills, on
+ * flush(), and on destruction.
+ */
+class TraceRecorder {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::ostream& out;                                   /**< Destination stream */
+    std::mutex mutex;                                    /**< Serializes writers */
+    std::string buffer;                                  /**< Pending encoded bytes */
+    std::unordered_map<std::string, uint64_t> stringIds; /**< Interned strings */
+    std::unordered_set<uint64_t> knownStudents;          /**< Students already described */
+    Clock::time_point lastEvent;                         /**< Time of the previous timed record */
+
+    uint64_t intern(const std::string& value);
+    void putTimeDelta();
+    void flushIfFull();
+
+public:
+    /**
+     * @brief Creates a recorder and writes the trace header
+     *
+     * @param out Stream receiving the trace; must outlive the recorder
+     */
+    explicit TraceRecorder(std::ostream& out);
+
+    /** @brief Flushes any buffered records */
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /** @brief Records a successful addCourse call */
+    void recordAddCourse(const std::string& courseCode,
+                         const std::string& courseName,
+                         int capacity,
+                         const std::set<std::string>& prerequisites,
+                         time_t deadline);
+
+    /** @brief Records a successful addSection call */
+    void recordAddSection(const std::string& parentCode, const std::string& sectionCode,
+                          int capacity, const std::string& department);
+
+    /** @brief Records a registerStudent call and its outcome */
+    void recordRegister(const Student& student, const std::string& courseCode,
+                        RegistrationStatus status);
+
+    /** @brief Records a withdrawStudent call and its outcome */
+    void recordWithdraw(const std::string& studentId, const std::string& courseCode,
+                        bool withdrawn);
+
+    /** @brief Records the engine clock reading at which recording started */
+    void recordClock(time_t now);
+
+    /** @brief Writes buffered records to the stream */
+    void flush();
+};
+
+/** @brief One decoded ADD_COURSE, ADD_SECTION, REGISTER or WITHDRAW record */
+struct TraceEvent {
+    TraceRecordType type;               /**< ADD_COURSE, ADD_SECTION, REGISTER or WITHDRAW */
+    uint64_t offsetNanos;               /**< Time since the start of the trace */
+    std::string courseCode;             /**< Course the call targeted (the section for ADD_SECTION) */
+    std::string parentCode;             /**< Parent course (ADD_SECTION) */
+    std::string department;             /**< Reserved department (ADD_SECTION) */
+    std::string studentId;              /**< Student (REGISTER / WITHDRAW) */
+    std::string courseName;             /**< Course name (ADD_COURSE) */
+    int capacity;                       /**< Course capacity (ADD_COURSE / ADD_SECTION) */
+    time_t deadline;                    /**< Registration deadline (ADD_COURSE) */
+    std::set<std::string> prerequisites; /**< Prerequisites (ADD_COURSE) */
+    uint8_t result;                     /**< Recorded RegistrationStatus or withdraw result */
+};
+
+/** @brief Fully decoded trace */
+struct Trace {
+    bool hasStartTime = false;      /**< Whether the trace holds a CLOCK record */
+    time_t startTime = 0;           /**< Engine clock when recording started, if hasStartTime */
+    std::vector<TraceEvent> events; /**< Timed events in recording order */
+    std::unordered_map<std::string, std::vector<std::string>> studentCourses; /**< Courses per student at first sighting */
+    std::unordered_map<std::string, std::string> studentDepartments; /**< Department per student, if any */
+    std::unordered_map<std::string, int> studentSemesters; /**< Semester per student at first sighting */
+    std::unordered_map<std::string, float> studentCgpas;   /**< CGPA per student at first sighting */
+};
+
+/**
+ * @brief Decodes a trace written by TraceRecorder
+ *
+ * @param in Stream positioned at the trace header
+ * @return Trace holding every event and student description
+ * @throws std::runtime_error if the stream is not a valid trace
+ */
+Trace readTrace(std::istream& in);
+
+/**
+ * @brief Rebuilds a student as the trace first saw them
+ *
+ * Restores the department, semester, CGPA and completed courses, so a
+ * replayed registration meets the same prerequisite checks and
+ * registration window as the recorded one. Fields the trace lacks keep
+ * the Student defaults.
+ *
+ * @param trace Trace holding the student's STUDENT record
+ * @param studentId Student to rebuild
+ * @return Student with the recorded state
+ */
+Student replayStudent(const Trace& trace, const std::string& studentId);
+
+#endif // REGISTRATION_TRACE_H
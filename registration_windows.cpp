@@ -0,0 +1,48 @@
+/**
+ * @file registration_windows.cpp
+ * @brief Implementation of the registration window table
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "registration_windows.h"
+
+RegistrationWindows::RegistrationWindows() {
+    for (auto& entry : opening) {
+        entry.store(std::numeric_limits<time_t>::min(), std::memory_order_relaxed);
+    }
+}
+
+void RegistrationWindows::set(const std::vector<RegistrationWindow>& windows) {
+    std::array<time_t, kMaxSemester * kStandingCount> table;
+    table.fill(std::numeric_limits<time_t>::min());
+    for (const auto& window : windows) {
+        if (window.fromSemester > window.toSemester) {
+            throw std::invalid_argument("Window semester range is empty");
+        }
+        // Semesters past kMaxSemester share its row, so a range starting there
+        // cannot be told apart from the semesters before it
+        if (window.fromSemester > kMaxSemester) {
+            throw std::invalid_argument("Window starts after the last semester tracked");
+        }
+        // No student is below semester 1
+        if (window.toSemester < 1) {
+            continue;
+        }
+        int from = std::max(window.fromSemester, 1);
+        int to = std::min(window.toSemester, kMaxSemester);
+        for (int semester = from; semester <= to; ++semester) {
+            table[indexOf(semester, window.standing)] = window.opensAt;
+        }
+    }
+
+    bool any = false;
+    for (size_t i = 0; i < table.size(); ++i) {
+        opening[i].store(table[i], std::memory_order_relaxed);
+        any = any || table[i] != std::numeric_limits<time_t>::min();
+    }
+    anySet.store(any, std::memory_order_relaxed);
+}
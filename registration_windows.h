@@ -0,0 +1,108 @@
+/**
+ * @file registration_windows.h
+ * @brief Staggered registration opening times by semester and standing
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Instead of opening registration to everyone at once, a registrar can
+ * give each cohort (a semester and an academic standing) its own opening
+ * time: seniors in the morning, juniors at noon, and so on. Requests from
+ * a student whose window has not opened yet are refused with
+ * REGISTRATION_NOT_OPEN before any catalog or roster lock is taken.
+ *
+ * Opening times live in a flat table with one entry per (semester,
+ * standing) pair, so looking up a student's opening is an index
+ * computation and one atomic load.
+ */
+
+#ifndef REGISTRATION_WINDOWS_H
+#define REGISTRATION_WINDOWS_H
+
+#include <array>
+#include <atomic>
+#include <climits>
+#include <ctime>
+#include <vector>
+#include "student.h"
+
+/** @brief Opening time of one range of cohorts */
+struct RegistrationWindow {
+    int fromSemester = 1;        /**< First semester of the range */
+    int toSemester = INT_MAX;    /**< Last semester of the range, inclusive */
+    AcademicStanding standing;   /**< Standing the window applies to */
+    time_t opensAt;              /**< Engine time registration opens for the range */
+};
+
+/**
+ * @brief Table of registration opening times by semester and standing
+ *
+ * Semesters from kMaxSemester on share one row, so a window reaching
+ * kMaxSemester covers every later semester too.
+ *
+ * Example usage:
+ * @code
+ * RegistrationWindows windows;
+ * windows.set({{7, INT_MAX, AcademicStanding::EXCELLENT, nineAm},
+ *              {1, 6, AcademicStanding::EXCELLENT, noon}});
+ * if (now < windows.opensAt(student)) {
+ *     // too early
+ * }
+ * @endcode
+ */
+class RegistrationWindows {
+public:
+    static constexpr int kMaxSemester = 16;   /**< Semesters tracked individually */
+    static constexpr int kStandingCount = 4;  /**< Values of AcademicStanding */
+
+private:
+    /** @brief Opening time per cohort; semester-major */
+    std::array<std::atomic<time_t>, kMaxSemester * kStandingCount> opening;
+    std::atomic<bool> anySet{false};       /**< True while any cohort opens later than immediately */
+
+    /** @brief Returns the table index of a cohort */
+    static size_t indexOf(int semester, AcademicStanding standing);
+
+public:
+    RegistrationWindows();
+
+    /**
+     * @brief Replaces every opening time with @p windows
+     *
+     * Cohorts no window covers may register immediately. Where windows
+     * overlap, the later one in the list wins. Safe to call while other
+     * threads register; a request sees either the old or the new opening
+     * time of its cohort.
+     *
+     * @param windows Opening times; an empty list removes all windows
+     * @throws std::invalid_argument if a window has an empty semester range
+     *         or starts after kMaxSemester; a window ending before
+     *         semester 1 covers nobody and is ignored
+     */
+    void set(const std::vector<RegistrationWindow>& windows);
+
+    /** @brief Returns true if any cohort has an opening time */
+    bool enabled() const { return anySet.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns when registration opens for a cohort
+     *
+     * @param semester Student's semester; values below 1 count as 1
+     * @param standing Student's academic standing
+     * @return Opening time, or the smallest time_t if the cohort is always open
+     */
+    time_t opensAt(int semester, AcademicStanding standing) const {
+        return opening[indexOf(semester, standing)].load(std::memory_order_relaxed);
+    }
+
+    /** @brief Returns when registration opens for @p student */
+    time_t opensAt(const Student& student) const {
+        return opensAt(student.getSemester(), student.getAcademicStanding());
+    }
+};
+
+inline size_t RegistrationWindows::indexOf(int semester, AcademicStanding standing) {
+    int row = semester < 1 ? 0 : (semester > kMaxSemester ? kMaxSemester : semester) - 1;
+    return static_cast<size_t>(row) * kStandingCount + static_cast<size_t>(standing);
+}
+
+#endif // REGISTRATION_WINDOWS_H
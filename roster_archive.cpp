@@ -0,0 +1,150 @@
+/**
+ * @file roster_archive.cpp
+ * @brief Implementation of archived rosters and CourseRegistration::archiveTerm
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include "roster_archive.h"
+#include "course_registration.h"
+#include "roster_snapshot.h"
+
+// Implementation of StudentDirectory methods
+
+StudentHandle StudentDirectory::intern(const std::string& studentId) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto handleIt = handles.find(studentId);
+        if (handleIt != handles.end()) {
+            return handleIt->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (ids.size() >= std::numeric_limits<StudentHandle>::max()) {
+        throw std::length_error("Student directory is full");
+    }
+    auto inserted = handles.emplace(studentId, static_cast<StudentHandle>(ids.size()));
+    if (inserted.second) {
+        ids.push_back(&inserted.first->first);
+    }
+    return inserted.first->second;
+}
+
+bool StudentDirectory::find(const std::string& studentId, StudentHandle& handle) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto handleIt = handles.find(studentId);
+    if (handleIt == handles.end()) {
+        return false;
+    }
+    handle = handleIt->second;
+    return true;
+}
+
+const std::string& StudentDirectory::idOf(StudentHandle handle) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return *ids[handle];
+}
+
+size_t StudentDirectory::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return ids.size();
+}
+
+// Implementation of ArchivedRoster methods
+
+ArchivedRoster ArchivedRoster::fromHandles(std::vector<StudentHandle> handles) {
+    std::sort(handles.begin(), handles.end());
+    handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+
+    ArchivedRoster roster;
+    roster.count = static_cast<uint32_t>(handles.size());
+    roster.index.reserve((handles.size() + kBlockSize - 1) / kBlockSize);
+    roster.gaps.reserve(handles.size());
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (i % kBlockSize == 0) {
+            roster.index.push_back({handles[i], static_cast<uint32_t>(roster.gaps.size())});
+            continue;
+        }
+        putVarint(roster.gaps, handles[i] - handles[i - 1] - 1);
+    }
+    roster.gaps.shrink_to_fit();
+    return roster;
+}
+
+ArchivedRoster ArchivedRoster::freeze(const std::set<std::string>& roster, StudentDirectory& directory) {
+    std::vector<StudentHandle> handles;
+    handles.reserve(roster.size());
+    for (const auto& studentId : roster) {
+        handles.push_back(directory.intern(studentId));
+    }
+    return fromHandles(std::move(handles));
+}
+
+bool ArchivedRoster::contains(StudentHandle handle) const {
+    // Last block starting at or before handle
+    auto blockIt = std::upper_bound(index.begin(), index.end(), handle,
+                                    [](StudentHandle h, const BlockStart& b) { return h < b.first; });
+    if (blockIt == index.begin()) {
+        return false;
+    }
+    --blockIt;
+    StudentHandle current = blockIt->first;
+    uint32_t block = static_cast<uint32_t>(blockIt - index.begin());
+    uint32_t offset = blockIt->offset;
+    uint32_t end = std::min(count, (block + 1) * kBlockSize);
+    for (uint32_t i = block * kBlockSize + 1; i < end && current < handle; ++i) {
+        current += readGap(offset) + 1;
+    }
+    return current == handle;
+}
+
+size_t ArchivedRoster::memoryBytes() const {
+    return sizeof(*this) + gaps.capacity() + index.capacity() * sizeof(BlockStart);
+}
+
+// Implementation of ArchivedTerm methods
+
+const ArchivedRoster* ArchivedTerm::roster(const std::string& courseCode) const {
+    auto rosterIt = std::lower_bound(rosters.begin(), rosters.end(), courseCode,
+                                     [](const std::pair<std::string, ArchivedRoster>& entry,
+                                        const std::string& code) { return entry.first < code; });
+    if (rosterIt == rosters.end() || rosterIt->first != courseCode) {
+        return nullptr;
+    }
+    return &rosterIt->second;
+}
+
+bool ArchivedTerm::wasEnrolled(const std::string& studentId, const std::string& courseCode) const {
+    const ArchivedRoster* archived = roster(courseCode);
+    StudentHandle handle;
+    return archived && directory->find(studentId, handle) && archived->contains(handle);
+}
+
+size_t ArchivedTerm::memoryBytes() const {
+    size_t bytes = sizeof(*this) + (rosters.capacity() - rosters.size()) * sizeof(rosters[0]);
+    for (const auto& entry : rosters) {
+        bytes += sizeof(entry.first) + entry.second.memoryBytes();
+        // Codes longer than the small-string buffer live on the heap
+        if (entry.first.capacity() > std::string().capacity()) {
+            bytes += entry.first.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+// Implementation of CourseRegistration::archiveTerm
+
+ArchivedTerm CourseRegistration::archiveTerm(StudentDirectory& directory) const {
+    RosterSnapshot snapshot = openSnapshot();
+    ArchivedTerm term;
+    term.directory = &directory;
+    term.version = snapshot.getVersion();
+    snapshot.forEachCourse([&](const std::string& courseCode, const std::set<std::string>& roster) {
+        term.rosters.emplace_back(courseCode, ArchivedRoster::freeze(roster, directory));
+    });
+    term.rosters.shrink_to_fit();
+    return term;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file roster_archive.h
+ * @brief Immutable compressed rosters for closed terms
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A live roster is a std::set<std::string>: one heap node and usually one
+ * string per enrolled student, close to 100 bytes each. Once a term is
+ * closed its rosters never change, so they can be frozen into a far
+ * denser form:
+ * - a StudentDirectory, shared by every archived term, stores each
+ *   student ID once and numbers it with a dense StudentHandle
+ * - an ArchivedRoster stores a course's handles sorted, as varint-encoded
+ *   gaps, in blocks of kBlockSize with a small skip index
+ *
+ * The gaps of a roster of a few hundred students take one to two bytes
+ * per student. Membership tests binary-search the skip index and decode
+ * at most one block; iteration decodes the gaps in order. Neither
+ * decompresses the roster as a whole.
+ */
+
+#ifndef ROSTER_ARCHIVE_H
+#define ROSTER_ARCHIVE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "varint.h"
+
+/** @brief Dense number of a student within a StudentDirectory */
+using StudentHandle = uint32_t;
+
+/**
+ * @brief Interned student IDs shared by archived terms
+ *
+ * Handles are assigned in first-seen order and never reused. All methods
+ * are thread-safe; lookups run concurrently with each other.
+ */
+class StudentDirectory {
+private:
+    mutable std::shared_mutex mutex;                        /**< Guards both containers */
+    std::unordered_map<std::string, StudentHandle> handles; /**< Handle of each ID */
+    std::vector<const std::string*> ids;                    /**< ID of each handle; keys of handles */
+
+public:
+    StudentDirectory() = default;
+    StudentDirectory(const StudentDirectory&) = delete;
+    StudentDirectory& operator=(const StudentDirectory&) = delete;
+
+    /**
+     * @brief Returns the handle of @p studentId, assigning one if it is new
+     *
+     * @throws std::length_error if every handle is taken
+     */
+    StudentHandle intern(const std::string& studentId);
+
+    /**
+     * @brief Looks up a student without assigning a handle
+     *
+     * @param studentId Student to look up
+     * @param[out] handle Set to the student's handle if found
+     * @return true if the student has a handle
+     */
+    bool find(const std::string& studentId, StudentHandle& handle) const;
+
+    /**
+     * @brief Returns the ID of a handle
+     *
+     * @param handle Handle returned by intern(); must be less than size()
+     * @return The ID, which stays valid as long as the directory
+     */
+    const std::string& idOf(StudentHandle handle) const;
+
+    /** @brief Returns the number of interned students */
+    size_t size() const;
+};
+
+/**
+ * @brief Immutable sorted set of student handles, delta + varint encoded
+ *
+ * Example usage:
+ * @code
+ * StudentDirectory directory;
+ * ArchivedRoster roster = ArchivedRoster::freeze(liveRoster, directory);
+ * StudentHandle s1;
+ * bool enrolled = directory.find("S1", s1) && roster.contains(s1);
+ * roster.forEach([&](StudentHandle h) { audit(directory.idOf(h)); });
+ * @endcode
+ */
+class ArchivedRoster {
+public:
+    static constexpr uint32_t kBlockSize = 64; /**< Handles per skip-index entry */
+
+private:
+    /** @brief First handle of a block and where the block's gaps start */
+    struct BlockStart {
+        StudentHandle first; /**< Handle stored in the index rather than as a gap */
+        uint32_t offset;     /**< Offset in bytes of the block's first gap */
+    };
+
+    std::vector<uint8_t> gaps;     /**< (handle - previous - 1) as LEB128 varints, blocks back to back */
+    std::vector<BlockStart> index; /**< One entry per block of kBlockSize handles */
+    uint32_t count = 0;            /**< Handles in the roster */
+
+    /** @brief Decodes one varint at @p offset and advances it */
+    uint32_t readGap(uint32_t& offset) const {
+        return static_cast<uint32_t>(getVarint([&] { return gaps[offset++]; }));
+    }
+
+public:
+    ArchivedRoster() = default;
+
+    /**
+     * @brief Encodes a set of handles
+     *
+     * @param handles Handles in any order; duplicates are ignored
+     */
+    static ArchivedRoster fromHandles(std::vector<StudentHandle> handles);
+
+    /**
+     * @brief Freezes a live roster, interning its students in @p directory
+     *
+     * @param roster Student IDs of the roster
+     * @param directory Directory shared by the archive
+     */
+    static ArchivedRoster freeze(const std::set<std::string>& roster, StudentDirectory& directory);
+
+    /** @brief Returns the number of students in the roster */
+    size_t size() const { return count; }
+
+    /** @brief Returns true if @p handle is in the roster */
+    bool contains(StudentHandle handle) const;
+
+    /**
+     * @brief Calls @p visit with every handle in ascending order
+     *
+     * @param visit Called as visit(StudentHandle)
+     */
+    template <typename Fn>
+    void forEach(Fn&& visit) const {
+        uint32_t offset = 0;
+        for (uint32_t block = 0; block < index.size(); ++block) {
+            StudentHandle handle = index[block].first;
+            visit(handle);
+            uint32_t end = std::min(count, (block + 1) * kBlockSize);
+            for (uint32_t i = block * kBlockSize + 1; i < end; ++i) {
+                handle += readGap(offset) + 1;
+                visit(handle);
+            }
+        }
+    }
+
+    /** @brief Returns the heap and object bytes used by the roster */
+    size_t memoryBytes() const;
+};
+
+/**
+ * @brief Every roster of one closed term, frozen at one commit version
+ *
+ * Built by CourseRegistration::archiveTerm. Immutable, so any number of
+ * threads may read it concurrently. It refers to its StudentDirectory,
+ * which must outlive it.
+ */
+class ArchivedTerm {
+private:
+    const StudentDirectory* directory = nullptr;                  /**< Directory the handles refer to */
+    std::vector<std::pair<std::string, ArchivedRoster>> rosters;  /**< Rosters in course-code order */
+    uint64_t version = 0;                                         /**< Commit version archived */
+
+    friend class CourseRegistration;
+
+public:
+    ArchivedTerm() = default;
+
+    /** @brief Returns the commit version the term was archived at */
+    uint64_t getVersion() const { return version; }
+
+    /** @brief Returns the number of archived courses */
+    size_t courseCount() const { return rosters.size(); }
+
+    /**
+     * @brief Finds a course's archived roster
+     *
+     * @param courseCode Code of the course
+     * @return The roster, or nullptr if the course was not in the term
+     */
+    const ArchivedRoster* roster(const std::string& courseCode) const;
+
+    /**
+     * @brief Checks whether a student was enrolled in a course
+     *
+     * @return false if either the student or the course is unknown
+     */
+    bool wasEnrolled(const std::string& studentId, const std::string& courseCode) const;
+
+    /**
+     * @brief Calls @p visit with the ID of every student of a course
+     *
+     * @param courseCode Code of the course
+     * @param visit Called as visit(const std::string& studentId), in handle order
+     * @return false if the course was not in the term
+     */
+    template <typename Fn>
+    bool forEachStudent(const std::string& courseCode, Fn&& visit) const {
+        const ArchivedRoster* archived = roster(courseCode);
+        if (!archived) {
+            return false;
+        }
+        archived->forEach([&](StudentHandle handle) { visit(directory->idOf(handle)); });
+        return true;
+    }
+
+    /** @brief Returns the bytes used by every roster, excluding the shared directory */
+    size_t memoryBytes() const;
+};
+
+#endif // ROSTER_ARCHIVE_H
@@ -0,0 +1,91 @@
+/**
+ * @file roster_snapshot.cpp
+ * @brief Implementation of point-in-time roster snapshots
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ */
+
+#include <utility>
+#include <vector>
+#include "roster_snapshot.h"
+
+// Implementation of RosterSnapshot methods
+
+RosterSnapshot::RosterSnapshot(const CourseRegistration* registry, uint64_t version)
+    : registry(registry), version(version) {}
+
+RosterSnapshot::RosterSnapshot(RosterSnapshot&& other) noexcept
+    : registry(other.registry), version(other.version) {
+    other.registry = nullptr;
+}
+
+RosterSnapshot& RosterSnapshot::operator=(RosterSnapshot&& other) noexcept {
+    if (this != &other) {
+        if (registry) {
+            registry->releaseSnapshotVersion(version);
+        }
+        registry = std::exchange(other.registry, nullptr);
+        version = other.version;
+    }
+    return *this;
+}
+
+RosterSnapshot::~RosterSnapshot() {
+    if (registry) {
+        registry->releaseSnapshotVersion(version);
+    }
+}
+
+CourseQueryResult<std::set<std::string>> RosterSnapshot::getRoster(const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> catalogLock(registry->catalogMutex);
+    auto courseIt = registry->courses.find(courseCode);
+    if (courseIt == registry->courses.end() || courseIt->second.createdVersion > version) {
+        return {RegistrationStatus::UNKNOWN_COURSE, {}};
+    }
+
+    const auto& course = courseIt->second;
+    std::lock_guard<std::mutex> rosterLock(course.rosterMutex);
+    std::set<std::string> roster = course.enrolledStudents;
+    // Undo newer changes, newest first
+    for (auto it = course.history.rbegin(); it != course.history.rend() && it->version > version; ++it) {
+        if (it->added) {
+            roster.erase(it->studentId);
+        } else {
+            roster.insert(it->studentId);
+        }
+    }
+    return {RegistrationStatus::SUCCESS, std::move(roster)};
+}
+
+CourseQueryResult<int> RosterSnapshot::getEnrollmentCount(const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> catalogLock(registry->catalogMutex);
+    auto courseIt = registry->courses.find(courseCode);
+    if (courseIt == registry->courses.end() || courseIt->second.createdVersion > version) {
+        return {RegistrationStatus::UNKNOWN_COURSE, 0};
+    }
+
+    const auto& course = courseIt->second;
+    std::lock_guard<std::mutex> rosterLock(course.rosterMutex);
+    int count = static_cast<int>(course.enrolledStudents.size());
+    for (auto it = course.history.rbegin(); it != course.history.rend() && it->version > version; ++it) {
+        count += it->added ? -1 : 1;
+    }
+    return {RegistrationStatus::SUCCESS, count};
+}
+
+void RosterSnapshot::forEachCourse(
+    const std::function<void(const std::string&, const std::set<std::string>&)>& visit) const {
+    // Collect the course codes first so addCourse is not blocked for the whole scan
+    std::vector<std::string> codes;
+    {
+        std::shared_lock<std::shared_mutex> catalogLock(registry->catalogMutex);
+        for (const auto& entry : registry->courses) {
+            if (entry.second.createdVersion <= version) {
+                codes.push_back(entry.first);
+            }
+        }
+    }
+    for (const auto& code : codes) {
+        visit(code, getRoster(code).value);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file roster_snapshot.h
+ * @brief Point-in-time read views over CourseRegistration rosters
+ * @author tjkreddy
+ * @date Oct 16, 2026
+ *
+ * Every roster change in CourseRegistration gets a commit version. A
+ * RosterSnapshot remembers the version current when it was opened and
+ * rebuilds each roster as of that version: it copies the live roster and
+ * undoes the changes the course has logged since. Changes are logged only
+ * while at least one snapshot is open, and only as far back as the oldest
+ * open snapshot.
+ */
+
+#ifndef ROSTER_SNAPSHOT_H
+#define ROSTER_SNAPSHOT_H
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include "course_registration.h"
+
+/**
+ * @brief Consistent read-only view of all rosters at one commit version
+ *
+ * A snapshot is move-only and stays registered with its engine until it
+ * is destroyed; it must not outlive the engine. Its methods are
+ * thread-safe and may run concurrently with any engine operation.
+ */
+class RosterSnapshot {
+private:
+    const CourseRegistration* registry; /**< Engine the snapshot reads */
+    uint64_t version;                   /**< Commit version of the view */
+
+    friend class CourseRegistration;
+    RosterSnapshot(const CourseRegistration* registry, uint64_t version);
+
+public:
+    RosterSnapshot(RosterSnapshot&& other) noexcept;
+    RosterSnapshot& operator=(RosterSnapshot&& other) noexcept;
+    RosterSnapshot(const RosterSnapshot&) = delete;
+    RosterSnapshot& operator=(const RosterSnapshot&) = delete;
+
+    /** @brief Releases the snapshot so its undo history can be dropped */
+    ~RosterSnapshot();
+
+    /** @brief Returns the commit version the snapshot reads at */
+    uint64_t getVersion() const { return version; }
+
+    /**
+     * @brief Gets a course's roster as of the snapshot
+     *
+     * @param courseCode Code of the course
+     * @return Enrolled student IDs, or UNKNOWN_COURSE if the course did not
+     *         exist when the snapshot was opened
+     */
+    CourseQueryResult<std::set<std::string>> getRoster(const std::string& courseCode) const;
+
+    /**
+     * @brief Gets a course's enrollment count as of the snapshot
+     *
+     * Cheaper than getRoster: the roster is not copied.
+     *
+     * @param courseCode Code of the course
+     * @return Enrollment count, or UNKNOWN_COURSE if the course did not
+     *         exist when the snapshot was opened
+     */
+    CourseQueryResult<int> getEnrollmentCount(const std::string& courseCode) const;
+
+    /**
+     * @brief Visits every course that existed when the snapshot was opened
+     *
+     * Courses are visited in course-code order. Each roster is rebuilt
+     * while its course is briefly locked and passed to @p visit after the
+     * lock is released.
+     *
+     * @param visit Called as visit(courseCode, roster)
+     */
+    void forEachCourse(const std::function<void(const std::string&, const std::set<std::string>&)>& visit) const;
+};
+
+#endif // ROSTER_SNAPSHOT_H
@@ -0,0 +1,193 @@
+/**
+ * @file seat_holds.cpp
+ * @brief Implementation of timed seat holds
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A hold is an entry in its course's seatHolds map, guarded by the roster
+ * lock like the roster itself, plus a timer in the engine's TimerWheel.
+ * Expiry runs the wheel up to the engine clock and, course by course,
+ * drops the holds whose timers fired; a hold renewed in the meantime has
+ * a new timer and is left alone. Nothing ever walks the courses or the
+ * holds looking for lapsed ones.
+ *
+ * A hold named by a sectioned course's parent code is kept in one of its
+ * sections, and the section group records which, so the parent code
+ * finds it again to register, renew, release or report it.
+ */
+
+#include <functional>
+#include <stdexcept>
+#include "course_registration.h"
+#include "registration_checks.h"
+
+// Implementation of CourseRegistration seat hold methods
+
+CourseQueryResult<time_t> CourseRegistration::holdSeat(const Student& student,
+                                                       const std::string& courseCode, time_t ttl) {
+    RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::HOLD_SEAT);
+    if (ttl <= 0) {
+        throw std::out_of_range("Hold time must be positive");
+    }
+    time_t now = clock->now();
+    if (windows.enabled() && now < windows.opensAt(student)) {
+        return {RegistrationStatus::REGISTRATION_NOT_OPEN, 0};
+    }
+    deadlines.advance(now);
+    advanceHolds(now);
+    const std::string studentId = student.getStudentId();
+    const time_t expiresAt = now + ttl;
+
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+    auto courseIt = courses.find(courseCode);
+    if (courseIt == courses.end()) {
+        return {RegistrationStatus::UNKNOWN_COURSE, 0};
+    }
+    CourseInfo& course = courseIt->second;
+    if (!course.sections) {
+        return holdIn(student, studentId, course, now, expiresAt);
+    }
+
+    // The parent code holds in the section registerStudent would pick
+    SectionGroup& group = *course.sections;
+    if (group.sectionOf(studentId)) {
+        return {RegistrationStatus::ALREADY_ENROLLED, 0};
+    }
+    const std::string department = student.getDepartment();
+    const size_t start = std::hash<std::string>()(studentId);
+    uint64_t skipped = 0;
+    for (;;) {
+        CourseInfo* section = group.choose(studentId, department, start, skipped);
+        if (!section) {
+            return {RegistrationStatus::COURSE_FULL, 0};
+        }
+        CourseQueryResult<time_t> result = holdIn(student, studentId, *section, now, expiresAt);
+        if (result.status != RegistrationStatus::COURSE_FULL) {
+            return result;
+        }
+        skipped |= uint64_t(1) << section->sectionIndex;
+    }
+}
+
+CourseQueryResult<time_t> CourseRegistration::holdIn(const Student& student, const std::string& studentId,
+                                                     CourseInfo& course, time_t now, time_t expiresAt) {
+    if (inOtherSection(course, studentId)) {
+        return {RegistrationStatus::ALREADY_ENROLLED, 0};
+    }
+    std::lock_guard<std::mutex> rosterLock(course.rosterMutex);
+    CheckContext<CourseInfo> ctx{student, studentId, course, now};
+    RegistrationStatus status = DefaultRegistrationChecks::run(ctx);
+    if (status != RegistrationStatus::SUCCESS) {
+        return {status, 0};
+    }
+
+    auto holdIt = course.seatHolds.find(studentId);
+    const bool renewed = holdIt != course.seatHolds.end();
+    {
+        std::lock_guard<std::mutex> holdLock(holdMutex);
+        if (renewed) {
+            holdTimers.cancel(holdIt->second.timer);
+        }
+        TimerId holdTimer = holdTimers.schedule(expiresAt, HoldTimer{&course, studentId});
+        if (renewed) {
+            holdIt->second = SeatHold{holdTimer, expiresAt};
+        } else {
+            course.seatHolds.emplace(studentId, SeatHold{holdTimer, expiresAt});
+        }
+        nextHoldExpiry.store(holdTimers.nextExpiryBound(), std::memory_order_release);
+    }
+    if (!renewed) {
+        if (course.group) {
+            course.group->noteHold(studentId, course.sectionIndex, true);
+        }
+        publishSeats(course);
+    }
+    return {RegistrationStatus::SUCCESS, expiresAt};
+}
+
+bool CourseRegistration::releaseHold(const std::string& studentId, const std::string& courseCode) {
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+    auto courseIt = courses.find(courseCode);
+    if (courseIt == courses.end()) {
+        return false;
+    }
+    CourseInfo* held = holdCourse(courseIt->second, studentId);
+    if (!held) {
+        return false;
+    }
+    CourseInfo& course = *held;
+    std::lock_guard<std::mutex> rosterLock(course.rosterMutex);
+    if (!dropHold(course, studentId)) {
+        return false;
+    }
+    publishSeats(course);
+    return true;
+}
+
+CourseQueryResult<time_t> CourseRegistration::getHoldExpiry(const std::string& studentId,
+                                                            const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+    auto courseIt = courses.find(courseCode);
+    if (courseIt == courses.end()) {
+        return {RegistrationStatus::UNKNOWN_COURSE, 0};
+    }
+    const CourseInfo* held = holdCourse(courseIt->second, studentId);
+    if (!held) {
+        return {RegistrationStatus::NOT_ENROLLED, 0};
+    }
+    const CourseInfo& course = *held;
+    std::lock_guard<std::mutex> rosterLock(course.rosterMutex);
+    auto holdIt = course.seatHolds.find(studentId);
+    // A lapsed hold may not have been released yet
+    if (holdIt == course.seatHolds.end() || holdIt->second.expiresAt <= clock->now()) {
+        return {RegistrationStatus::NOT_ENROLLED, 0};
+    }
+    return {RegistrationStatus::SUCCESS, holdIt->second.expiresAt};
+}
+
+void CourseRegistration::expireHolds() {
+    advanceHolds(clock->now());
+}
+
+void CourseRegistration::releaseExpiredHolds(time_t now) {
+    std::vector<std::pair<TimerId, HoldTimer>> expired;
+    {
+        std::lock_guard<std::mutex> holdLock(holdMutex);
+        holdTimers.advance(now, expired);
+        nextHoldExpiry.store(holdTimers.nextExpiryBound(), std::memory_order_release);
+    }
+    if (expired.empty()) {
+        return;
+    }
+
+    std::shared_lock<std::shared_mutex> catalogLock(catalogMutex);
+    for (const auto& fired : expired) {
+        CourseInfo& course = *fired.second.course;
+        std::lock_guard<std::mutex> rosterLock(course.rosterMutex);
+        auto holdIt = course.seatHolds.find(fired.second.studentId);
+        // Gone if the student registered or released it; a renewal has a new timer
+        if (holdIt != course.seatHolds.end() && holdIt->second.timer == fired.first) {
+            course.seatHolds.erase(holdIt);
+            if (course.group) {
+                course.group->noteHold(fired.second.studentId, course.sectionIndex, false);
+            }
+            publishSeats(course);
+        }
+    }
+}
+
+bool CourseRegistration::dropHold(CourseInfo& course, const std::string& studentId) {
+    auto holdIt = course.seatHolds.find(studentId);
+    if (holdIt == course.seatHolds.end()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> holdLock(holdMutex);
+        holdTimers.cancel(holdIt->second.timer);
+    }
+    course.seatHolds.erase(holdIt);
+    if (course.group) {
+        course.group->noteHold(studentId, course.sectionIndex, false);
+    }
+    return true;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file standing_watchlist.cpp
+ * @brief Implementation of the standing watchlist
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <mutex>
+#include <stdexcept>
+#include "standing_watchlist.h"
+
+// Implementation of StandingWatchlist methods
+
+StandingWatchlist::StandingWatchlist(size_t logCapacity) : logCapacity(logCapacity) {
+    if (logCapacity == 0) {
+        throw std::invalid_argument("Log capacity must be positive");
+    }
+}
+
+void StandingWatchlist::append(const std::string& studentId, AcademicStanding previous,
+                               AcademicStanding current, float cgpa, bool joined, bool left) {
+    if (log.size() == logCapacity) {
+        log.pop_front();
+    }
+    log.push_back({nextSequence++, studentId, previous, current, cgpa, joined, left});
+}
+
+void StandingWatchlist::place(const std::string& studentId, AcademicStanding standing, float cgpa) {
+    // find before emplace: emplace would allocate a node even for a tracked student
+    auto placementIt = placements.find(studentId);
+    if (placementIt == placements.end()) {
+        placementIt = placements.emplace(studentId, Placement{standing, 0}).first;
+        append(studentId, standing, standing, cgpa, true, false);
+    } else {
+        Placement& placement = placementIt->second;
+        if (placement.standing == standing) {
+            return;
+        }
+        // Out of the old list: swap its last member into this slot
+        std::vector<const std::string*>& old = lists[static_cast<size_t>(placement.standing)];
+        const std::string* moved = old.back();
+        old[placement.slot] = moved;
+        placements.find(*moved)->second.slot = placement.slot;
+        old.pop_back();
+        append(studentId, placement.standing, standing, cgpa, false, false);
+        placement.standing = standing;
+    }
+    std::vector<const std::string*>& list = lists[static_cast<size_t>(standing)];
+    placementIt->second.slot = static_cast<uint32_t>(list.size());
+    list.push_back(&placementIt->first);
+}
+
+bool StandingWatchlist::remove(const std::string& studentId, float cgpa) {
+    auto placementIt = placements.find(studentId);
+    if (placementIt == placements.end()) {
+        return false;
+    }
+    const Placement placement = placementIt->second;
+    std::vector<const std::string*>& list = lists[static_cast<size_t>(placement.standing)];
+    const std::string* moved = list.back();
+    list[placement.slot] = moved;
+    placements.find(*moved)->second.slot = placement.slot;
+    list.pop_back();
+    append(studentId, placement.standing, placement.standing, cgpa, false, true);
+    placements.erase(placementIt);
+    return true;
+}
+
+void StandingWatchlist::track(Student& student) {
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        place(student.getStudentId(), student.getAcademicStanding(), student.getCGPA());
+    }
+    student.addCgpaObserver(this);
+}
+
+bool StandingWatchlist::untrack(Student& student) {
+    student.removeCgpaObserver(this);
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    return remove(student.getStudentId(), student.getCGPA());
+}
+
+bool StandingWatchlist::updateCGPA(Student& student, float newCGPA) {
+    if (!student.isObservedBy(this)) {
+        track(student);
+    }
+    const AcademicStanding before = student.getAcademicStanding();
+    // Notifies onCgpaChange, which takes the lock if the standing changes
+    student.updateCGPA(newCGPA);
+    return student.getAcademicStanding() != before;
+}
+
+void StandingWatchlist::onCgpaChange(const Student& student, float previous) {
+    // Most updates stay within a standing and need no lock
+    if (Student::standingFor(previous) == student.getAcademicStanding()) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    place(student.getStudentId(), student.getAcademicStanding(), student.getCGPA());
+}
+
+void StandingWatchlist::onRecordReplaced(const Student& student, const std::string& previousId,
+                                         float previous) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (previousId != student.getStudentId()) {
+        remove(previousId, previous);
+    }
+    place(student.getStudentId(), student.getAcademicStanding(), student.getCGPA());
+}
+
+size_t StandingWatchlist::count(AcademicStanding standing) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return lists[static_cast<size_t>(standing)].size();
+}
+
+std::vector<std::string> StandingWatchlist::members(AcademicStanding standing) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const std::vector<const std::string*>& list = lists[static_cast<size_t>(standing)];
+    std::vector<std::string> ids;
+    ids.reserve(list.size());
+    for (const std::string* id : list) {
+        ids.push_back(*id);
+    }
+    return ids;
+}
+
+bool StandingWatchlist::standingOf(const std::string& studentId, AcademicStanding& standing) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto placementIt = placements.find(studentId);
+    if (placementIt == placements.end()) {
+        return false;
+    }
+    standing = placementIt->second.standing;
+    return true;
+}
+
+uint64_t StandingWatchlist::lastSequence() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return nextSequence - 1;
+}
+
+bool StandingWatchlist::changesSince(uint64_t sequence, std::vector<StandingChange>& changes) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const uint64_t oldest = log.empty() ? nextSequence : log.front().sequence;
+    if (sequence + 1 < oldest) {
+        return false;
+    }
+    for (size_t i = static_cast<size_t>(sequence + 1 - oldest); i < log.size(); ++i) {
+        changes.push_back(log[i]);
+    }
+    return true;
+}
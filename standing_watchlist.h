@@ -0,0 +1,179 @@
+/**
+ * @file standing_watchlist.h
+ * @brief Live per-standing membership with a log of standing changes
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Advisors need the current set of students on PROBATION, and computing
+ * it by rescanning every Student after grades are posted gets slower as
+ * the population grows. A StandingWatchlist keeps, for every
+ * AcademicStanding, the list of tracked students in it. Tracking a
+ * student attaches the watchlist as one of its CgpaObservers, so every
+ * Student::updateCGPA that changes the student's standing, wherever it
+ * is called from, moves the student between lists (O(1), swap with the
+ * last member) and appends a StandingChange to a bounded log.
+ *
+ * Readers either copy a standing's members, in time proportional to its
+ * size, or follow the log from the last sequence they saw. Neither ever
+ * visits students outside the lists involved.
+ */
+
+#ifndef STANDING_WATCHLIST_H
+#define STANDING_WATCHLIST_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "student.h"
+
+/** @brief One entry of the standing change log */
+struct StandingChange {
+    uint64_t sequence;          /**< Position in the log, from 1 */
+    std::string studentId;      /**< Student whose standing changed */
+    AcademicStanding previous;  /**< Standing before; equal to current when joined or left */
+    AcademicStanding current;   /**< Standing after; the last one held when left */
+    float cgpa;                 /**< CGPA that caused the change */
+    bool joined;                /**< True if the student was just tracked */
+    bool left;                  /**< True if the student is no longer tracked */
+};
+
+/**
+ * @brief Students grouped by academic standing, kept current on CGPA updates
+ *
+ * All methods are thread-safe; readers run concurrently with each other.
+ * A given Student object must not be updated from two threads at once.
+ * The watchlist must outlive the Student objects it tracks, or they must
+ * be detached with Student::removeCgpaObserver first. Copies of
+ * a tracked student are not tracked (see Student's copy constructor), so
+ * only the tracked objects themselves, or students moved from them, can
+ * reach the watchlist. Assigning another record to a tracked student
+ * drops its old ID and lists the new one.
+ *
+ * Example usage:
+ * @code
+ * StandingWatchlist watchlist;
+ * for (Student& student : students) {
+ *     watchlist.track(student);
+ * }
+ * student.updateCGPA(4.2f);  // moves the student if the standing changed
+ * std::vector<std::string> probation = watchlist.members(AcademicStanding::PROBATION);
+ *
+ * std::vector<StandingChange> changes;
+ * if (!watchlist.changesSince(lastSeen, changes)) {
+ *     probation = watchlist.members(AcademicStanding::PROBATION);  // fell behind; resync
+ * }
+ * @endcode
+ */
+class StandingWatchlist : public CgpaObserver {
+public:
+    static constexpr int kStandingCount = 4;              /**< Values of AcademicStanding */
+    static constexpr size_t kDefaultLogCapacity = 65536;  /**< Changes kept by default */
+
+private:
+    /** @brief Where a tracked student is listed */
+    struct Placement {
+        AcademicStanding standing; /**< List the student is in */
+        uint32_t slot;             /**< Position in that list */
+    };
+
+    mutable std::shared_mutex mutex;                                   /**< Guards everything below */
+    std::unordered_map<std::string, Placement> placements;             /**< Placement of each student ID */
+    std::array<std::vector<const std::string*>, kStandingCount> lists; /**< Members per standing */
+    std::deque<StandingChange> log;                                    /**< Most recent changes, oldest first */
+    uint64_t nextSequence = 1;                                         /**< Sequence of the next change */
+    size_t logCapacity;                                                /**< Changes kept in log */
+
+    /** @brief Moves or adds a student and logs the change; caller holds the unique lock */
+    void place(const std::string& studentId, AcademicStanding standing, float cgpa);
+
+    /** @brief Removes a student and logs it leaving; caller holds the unique lock */
+    bool remove(const std::string& studentId, float cgpa);
+
+    /** @brief Appends one change, dropping the oldest past logCapacity; caller holds the unique lock */
+    void append(const std::string& studentId, AcademicStanding previous, AcademicStanding current,
+                float cgpa, bool joined, bool left);
+
+public:
+    /**
+     * @brief Creates an empty watchlist
+     *
+     * @param logCapacity Changes kept for changesSince()
+     * @throws std::invalid_argument if logCapacity is 0
+     */
+    explicit StandingWatchlist(size_t logCapacity = kDefaultLogCapacity);
+
+    StandingWatchlist(const StandingWatchlist&) = delete;
+    StandingWatchlist& operator=(const StandingWatchlist&) = delete;
+
+    /**
+     * @brief Starts tracking a student, or re-reads one already tracked
+     *
+     * Attaches the watchlist as one of the student's CgpaObservers. Logs
+     * a change only if the student is new or changed standing.
+     */
+    void track(Student& student);
+
+    /**
+     * @brief Stops tracking a student
+     *
+     * Detaches the watchlist from the student and removes its ID from the
+     * lists, logging it as left.
+     *
+     * @return false if the student's ID was not listed
+     */
+    bool untrack(Student& student);
+
+    /**
+     * @brief Tracks a student if needed, then calls Student::updateCGPA
+     *
+     * A convenience for callers that also want to know whether the
+     * standing changed; the update itself keeps the lists current.
+     *
+     * @param student Student to update
+     * @param newCGPA New CGPA value
+     * @return true if the standing changed
+     * @throws std::out_of_range if @p newCGPA is not valid (from
+     *         Student::updateCGPA); the student's standing is unchanged
+     */
+    bool updateCGPA(Student& student, float newCGPA);
+
+    /** @brief Moves a tracked student if its standing changed; called by Student::updateCGPA */
+    void onCgpaChange(const Student& student, float previous) override;
+
+    /** @brief Drops a reassigned student's old ID and lists the new record; called by Student */
+    void onRecordReplaced(const Student& student, const std::string& previousId, float previous) override;
+
+    /** @brief Returns the number of tracked students in a standing */
+    size_t count(AcademicStanding standing) const;
+
+    /** @brief Returns the IDs of the tracked students in a standing, in no particular order */
+    std::vector<std::string> members(AcademicStanding standing) const;
+
+    /**
+     * @brief Looks up a tracked student's standing
+     *
+     * @param studentId Student to look up
+     * @param[out] standing Set to the student's standing if tracked
+     * @return false if the student is not tracked
+     */
+    bool standingOf(const std::string& studentId, AcademicStanding& standing) const;
+
+    /** @brief Returns the sequence of the most recent change, 0 if none */
+    uint64_t lastSequence() const;
+
+    /**
+     * @brief Appends every change after @p sequence to @p changes
+     *
+     * @param sequence Last sequence the caller has seen; 0 for all
+     * @param[out] changes Receives the changes, oldest first
+     * @return false if changes after @p sequence were already dropped from
+     *         the log; the caller should resync with members()
+     */
+    bool changesSince(uint64_t sequence, std::vector<StandingChange>& changes) const;
+};
+
+#endif // STANDING_WATCHLIST_H
@@ -0,0 +1,158 @@
+/**
+ * @file student.cpp
+ * @brief Implementation of the Student class
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "student.h"
+
+namespace {
+
+const size_t kMaxCourses = 1024;     /**< Courses a student's record can hold */
+const size_t kMaxIdLength = 0xffff;  /**< Longest student ID; journal records hold 16-bit lengths */
+const float kMinCGPA = 0.0f;         /**< Lowest valid CGPA */
+const float kMaxCGPA = 10.0f;        /**< Highest valid CGPA */
+
+} // namespace
+
+// Implementation of Student methods
+
+Student::Student() : cgpa(0.0f), semester(1) {}
+
+Student::Student(const std::string& id, const std::string& n, const std::string& dept)
+    : studentId(id), name(n), department(dept), cgpa(0.0f), semester(1) {
+    if (id.empty() || id.size() > kMaxIdLength) {
+        throw std::invalid_argument("Student ID must be 1 to 65535 bytes");
+    }
+}
+
+Student::Student(const Student& other)
+    : studentId(other.studentId), name(other.name), department(other.department), cgpa(other.cgpa),
+      semester(other.semester), enrolledCourses(other.enrolledCourses) {}
+
+Student::Student(Student&& other) noexcept
+    : studentId(std::move(other.studentId)), name(std::move(other.name)),
+      department(std::move(other.department)), cgpa(other.cgpa), semester(other.semester),
+      enrolledCourses(std::move(other.enrolledCourses)), cgpaObservers(std::move(other.cgpaObservers)) {
+    other.cgpaObservers.clear();
+}
+
+Student& Student::operator=(const Student& other) {
+    if (this != &other) {
+        const std::string previousId = studentId;
+        const float previousCgpa = cgpa;
+        studentId = other.studentId;
+        name = other.name;
+        department = other.department;
+        cgpa = other.cgpa;
+        semester = other.semester;
+        enrolledCourses = other.enrolledCourses;
+        notifyReplaced(previousId, previousCgpa);
+    }
+    return *this;
+}
+
+Student& Student::operator=(Student&& other) {
+    if (this != &other) {
+        const std::string previousId = std::move(studentId);
+        const float previousCgpa = cgpa;
+        studentId = std::move(other.studentId);
+        name = std::move(other.name);
+        department = std::move(other.department);
+        cgpa = other.cgpa;
+        semester = other.semester;
+        enrolledCourses = std::move(other.enrolledCourses);
+        std::vector<CgpaObserver*> incoming = std::move(other.cgpaObservers);
+        other.cgpaObservers.clear();
+        notifyReplaced(previousId, previousCgpa);
+        for (CgpaObserver* observer : incoming) {
+            addCgpaObserver(observer);
+        }
+    }
+    return *this;
+}
+
+void Student::notifyReplaced(const std::string& previousId, float previous) {
+    for (CgpaObserver* observer : cgpaObservers) {
+        observer->onRecordReplaced(*this, previousId, previous);
+    }
+}
+
+bool Student::enrollInCourse(const std::string& courseCode) {
+    if (std::find(enrolledCourses.begin(), enrolledCourses.end(), courseCode) != enrolledCourses.end()) {
+        return false;
+    }
+    if (enrolledCourses.size() >= kMaxCourses) {
+        throw std::runtime_error("Student has reached the maximum number of courses");
+    }
+    enrolledCourses.push_back(courseCode);
+    return true;
+}
+
+void Student::updateCGPA(float newCGPA) {
+    if (!(newCGPA >= kMinCGPA && newCGPA <= kMaxCGPA)) {
+        throw std::out_of_range("CGPA must be between 0.0 and 10.0");
+    }
+    const float previous = cgpa;
+    cgpa = newCGPA;
+    if (newCGPA != previous) {
+        for (CgpaObserver* observer : cgpaObservers) {
+            observer->onCgpaChange(*this, previous);
+        }
+    }
+}
+
+void Student::addCgpaObserver(CgpaObserver* observer) {
+    if (observer && !isObservedBy(observer)) {
+        cgpaObservers.push_back(observer);
+    }
+}
+
+void Student::removeCgpaObserver(CgpaObserver* observer) {
+    cgpaObservers.erase(std::remove(cgpaObservers.begin(), cgpaObservers.end(), observer),
+                        cgpaObservers.end());
+}
+
+bool Student::isObservedBy(const CgpaObserver* observer) const {
+    return std::find(cgpaObservers.begin(), cgpaObservers.end(), observer) != cgpaObservers.end();
+}
+
+AcademicStanding Student::getAcademicStanding() const {
+    return standingFor(cgpa);
+}
+
+AcademicStanding Student::standingFor(float cgpa) {
+    if (cgpa >= 8.0f) {
+        return AcademicStanding::EXCELLENT;
+    }
+    if (cgpa >= 7.0f) {
+        return AcademicStanding::GOOD;
+    }
+    if (cgpa >= 5.0f) {
+        return AcademicStanding::SATISFACTORY;
+    }
+    return AcademicStanding::PROBATION;
+}
+
+std::vector<std::string> Student::getEnrolledCourses() const {
+    return enrolledCourses;
+}
+
+bool Student::advanceToNextSemester() {
+    if (getAcademicStanding() == AcademicStanding::PROBATION) {
+        return false;
+    }
+    ++semester;
+    return true;
+}
+
+void Student::setSemester(int newSemester) {
+    if (newSemester < 1) {
+        throw std::out_of_range("Semester must be at least 1");
+    }
+    semester = newSemester;
+}
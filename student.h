@@ -28,6 +28,44 @@ enum class AcademicStanding {
     PROBATION    /**< CGPA < 5.0 */
 };
 
+class Student;
+
+/**
+ * @brief Receives a student's CGPA changes from Student::updateCGPA
+ * 
+ * Attached with Student::addCgpaObserver; a student may have several.
+ * StandingWatchlist and CgpaRanking are observers that keep their
+ * indexes current without the caller updating them.
+ */
+class CgpaObserver {
+public:
+    virtual ~CgpaObserver() = default;
+
+    /**
+     * @brief Called after a CGPA update changed a student's CGPA
+     * 
+     * Must not attach or detach observers of @p student.
+     * 
+     * @param student Student whose CGPA changed, already updated
+     * @param previous CGPA before the update
+     */
+    virtual void onCgpaChange(const Student& student, float previous) = 0;
+
+    /**
+     * @brief Called after an assignment replaced an observed student's record
+     * 
+     * The student stays observed under its new record, so an observer
+     * keyed by student ID drops @p previousId if it differs, then reads
+     * the new state. Must not attach or detach observers of @p student.
+     * 
+     * @param student Student holding its new record
+     * @param previousId Student ID before the assignment
+     * @param previous CGPA before the assignment
+     */
+    virtual void onRecordReplaced(const Student& student, const std::string& previousId,
+                                  float previous) = 0;
+};
+
 /**
  * @brief Class representing a student in the university
  * 
@@ -43,6 +81,10 @@ private:
     float cgpa;               /**< Current CGPA of the student */
     int semester;             /**< Current semester of the student */
     std::vector<std::string> enrolledCourses; /**< List of courses currently enrolled */
+    std::vector<CgpaObserver*> cgpaObservers; /**< Told about CGPA changes, in attach order */
+
+    /** @brief Tells every observer that an assignment replaced this student's record */
+    void notifyReplaced(const std::string& previousId, float previous);
 
 public:
     /**
@@ -59,10 +101,39 @@ public:
      * @param n Student's full name
      * @param dept Student's department
      * @pre id should be a valid student ID format
-     * @throws std::invalid_argument if id format is invalid
+     * @throws std::invalid_argument if id is empty or longer than 65535 bytes
      */
     Student(const std::string& id, const std::string& n, const std::string& dept);
 
+    /**
+     * @brief Copies a student's record, without its CGPA observers
+     * 
+     * An observer tracks one Student object; the copy starts detached, so
+     * updating it never reaches an observer that may no longer exist.
+     */
+    Student(const Student& other);
+
+    /** @brief Moves a student's record, CGPA observers included */
+    Student(Student&& other) noexcept;
+
+    /**
+     * @brief Copies a student's record into this student
+     * 
+     * This student's observers stay attached and are told through
+     * CgpaObserver::onRecordReplaced; @p other's are not copied.
+     */
+    Student& operator=(const Student& other);
+
+    /**
+     * @brief Moves a student's record into this student
+     * 
+     * This student's observers stay attached and are told through
+     * CgpaObserver::onRecordReplaced, then @p other's observers are
+     * moved over, so erasing a tracked student from a vector drops it
+     * from its observers. Not noexcept: the observers run.
+     */
+    Student& operator=(Student&& other);
+
     /**
      * @brief Enrolls the student in a new course
      * 
@@ -76,6 +147,9 @@ public:
     /**
      * @brief Updates the student's CGPA
      * 
+     * If the CGPA changes, every attached CgpaObserver is told before this
+     * returns, in the order they were attached.
+     * 
      * @param newCGPA New CGPA value
      * @pre newCGPA must be between 0.0 and 10.0
      * @post Student's CGPA is updated if value is valid
@@ -83,6 +157,26 @@ public:
      */
     void updateCGPA(float newCGPA);
 
+    /**
+     * @brief Attaches an observer told about this student's CGPA changes
+     * 
+     * Attaching an observer twice has no effect. Copies of the student
+     * start detached; a move carries the observers along and detaches the
+     * moved-from student.
+     * 
+     * @param observer Observer to notify; must outlive its attachment
+     */
+    void addCgpaObserver(CgpaObserver* observer);
+
+    /** @brief Detaches an observer; does nothing if it is not attached */
+    void removeCgpaObserver(CgpaObserver* observer);
+
+    /** @brief Returns whether @p observer is attached */
+    bool isObservedBy(const CgpaObserver* observer) const;
+
+    /** @brief Returns the academic standing a CGPA falls in */
+    static AcademicStanding standingFor(float cgpa);
+
     /**
      * @brief Gets the student's current academic standing
      * 
@@ -105,6 +199,17 @@ public:
      */
     bool advanceToNextSemester();
 
+    /**
+     * @brief Sets the student's semester directly
+     * 
+     * For restoring a recorded student; unlike advanceToNextSemester, the
+     * academic standing does not matter.
+     * 
+     * @param newSemester Semester to set
+     * @throws std::out_of_range if newSemester is below 1
+     */
+    void setSemester(int newSemester);
+
     // Getters and setters
     std::string getStudentId() const { return studentId; }
     std::string getName() const { return name; }
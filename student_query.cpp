@@ -0,0 +1,249 @@
+/**
+ * @file student_query.cpp
+ * @brief Implementation of the columnar student table and its queries
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <stdexcept>
+#include "student_query.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/** @brief A StudentQuery resolved against one table's columns */
+struct CompiledStudentQuery {
+    const int32_t* department;  /**< Department column */
+    const int32_t* semester;    /**< Semester column */
+    const float* cgpa;          /**< CGPA column */
+    const uint32_t* standing;   /**< Standing-bit column */
+    bool byDepartment;          /**< Whether the department predicate is active */
+    bool bySemester;            /**< Whether the semester predicate is active */
+    bool byCgpa;                /**< Whether the CGPA predicate is active */
+    bool byStanding;            /**< Whether the standing predicate is active */
+    int32_t departmentId;       /**< Department to match */
+    int32_t minSemester;        /**< First semester included */
+    int32_t maxSemester;        /**< Last semester included */
+    float minCgpa;              /**< Lowest CGPA included */
+    float maxCgpa;              /**< CGPAs from here on are excluded */
+    uint32_t standings;         /**< Standing bits to include */
+
+    /** @brief Evaluates the query on one row */
+    bool matches(size_t row) const {
+        return (!byDepartment || department[row] == departmentId) &&
+               (!bySemester || (semester[row] >= minSemester && semester[row] <= maxSemester)) &&
+               (!byCgpa || (cgpa[row] >= minCgpa && cgpa[row] < maxCgpa)) &&
+               (!byStanding || (standing[row] & standings));
+    }
+
+    /** @brief Evaluates the query on the 64 rows from @p first, one bit per row */
+    uint64_t matchWord(size_t first) const {
+#ifdef __SSE2__
+        const __m128i allOnes = _mm_set1_epi32(-1);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i departmentV = _mm_set1_epi32(departmentId);
+        const __m128i minSemesterV = _mm_set1_epi32(minSemester);
+        const __m128i maxSemesterV = _mm_set1_epi32(maxSemester);
+        const __m128 minCgpaV = _mm_set1_ps(minCgpa);
+        const __m128 maxCgpaV = _mm_set1_ps(maxCgpa);
+        const __m128i standingsV = _mm_set1_epi32(static_cast<int32_t>(standings));
+        uint64_t bits = 0;
+        for (size_t group = 0; group < 64; group += 4) {
+            const size_t row = first + group;
+            __m128i keep = allOnes;
+            if (byDepartment) {
+                __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(department + row));
+                keep = _mm_and_si128(keep, _mm_cmpeq_epi32(values, departmentV));
+            }
+            if (bySemester) {
+                // Outside the range if below the first or above the last semester
+                __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(semester + row));
+                __m128i outside = _mm_or_si128(_mm_cmplt_epi32(values, minSemesterV),
+                                               _mm_cmpgt_epi32(values, maxSemesterV));
+                keep = _mm_andnot_si128(outside, keep);
+            }
+            if (byCgpa) {
+                __m128 values = _mm_loadu_ps(cgpa + row);
+                __m128 inside = _mm_and_ps(_mm_cmpge_ps(values, minCgpaV), _mm_cmplt_ps(values, maxCgpaV));
+                keep = _mm_and_si128(keep, _mm_castps_si128(inside));
+            }
+            if (byStanding) {
+                __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(standing + row));
+                __m128i excluded = _mm_cmpeq_epi32(_mm_and_si128(values, standingsV), zero);
+                keep = _mm_andnot_si128(excluded, keep);
+            }
+            bits |= static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(keep))) << group;
+        }
+        return bits;
+#else
+        uint64_t bits = 0;
+        for (size_t i = 0; i < 64; ++i) {
+            bits |= static_cast<uint64_t>(matches(first + i)) << i;
+        }
+        return bits;
+#endif
+    }
+};
+
+/** @brief Bucket of @p cgpa in a CGPA histogram */
+size_t cgpaBucket(float cgpa) {
+    return cgpa > 0.0f ? static_cast<size_t>(cgpa) : 0;
+}
+
+} // namespace
+
+// Implementation of StudentSelection methods
+
+size_t StudentSelection::count() const {
+    size_t selected = 0;
+    for (uint64_t word : words) {
+        selected += __builtin_popcountll(word);
+    }
+    return selected;
+}
+
+StudentSelection& StudentSelection::operator&=(const StudentSelection& other) {
+    if (rows != other.rows) {
+        throw std::invalid_argument("Selections cover different tables");
+    }
+    for (size_t w = 0; w < words.size(); ++w) {
+        words[w] &= other.words[w];
+    }
+    return *this;
+}
+
+StudentSelection& StudentSelection::operator|=(const StudentSelection& other) {
+    if (rows != other.rows) {
+        throw std::invalid_argument("Selections cover different tables");
+    }
+    for (size_t w = 0; w < words.size(); ++w) {
+        words[w] |= other.words[w];
+    }
+    return *this;
+}
+
+// Implementation of StudentTable methods
+
+StudentTable::StudentTable(const std::vector<Student>& students) {
+    studentIds.reserve(students.size());
+    departmentColumn.reserve(students.size());
+    semesterColumn.reserve(students.size());
+    cgpaColumn.reserve(students.size());
+    standingColumn.reserve(students.size());
+    for (const auto& student : students) {
+        add(student);
+    }
+}
+
+size_t StudentTable::add(const Student& student) {
+    auto inserted = departmentIds.emplace(student.getDepartment(), static_cast<int32_t>(departments.size()));
+    if (inserted.second) {
+        departments.push_back(inserted.first->first);
+    }
+    studentIds.push_back(student.getStudentId());
+    departmentColumn.push_back(inserted.first->second);
+    semesterColumn.push_back(student.getSemester());
+    cgpaColumn.push_back(student.getCGPA());
+    standingColumn.push_back(1u << static_cast<unsigned>(student.getAcademicStanding()));
+    return studentIds.size() - 1;
+}
+
+const std::string& StudentTable::studentId(size_t row) const {
+    if (row >= studentIds.size()) {
+        throw std::out_of_range("Row not in table");
+    }
+    return studentIds[row];
+}
+
+const std::string& StudentTable::departmentName(size_t department) const {
+    if (department >= departments.size()) {
+        throw std::out_of_range("Department not in table");
+    }
+    return departments[department];
+}
+
+StudentSelection StudentTable::select(const StudentQuery& query) const {
+    StudentSelection selection;
+    selection.rows = size();
+    selection.words.assign((size() + 63) / 64, 0);
+
+    CompiledStudentQuery compiled;
+    compiled.department = departmentColumn.data();
+    compiled.semester = semesterColumn.data();
+    compiled.cgpa = cgpaColumn.data();
+    compiled.standing = standingColumn.data();
+    compiled.byDepartment = !query.department.empty();
+    compiled.bySemester = query.minSemester != INT_MIN || query.maxSemester != INT_MAX;
+    compiled.byCgpa = query.minCgpa != -INFINITY || query.maxCgpa != INFINITY;
+    compiled.standings = query.standings & 0xf;
+    compiled.byStanding = compiled.standings != 0xf;
+    compiled.departmentId = -1;
+    compiled.minSemester = query.minSemester;
+    compiled.maxSemester = query.maxSemester;
+    compiled.minCgpa = query.minCgpa;
+    compiled.maxCgpa = query.maxCgpa;
+    if (compiled.byDepartment) {
+        auto departmentIt = departmentIds.find(query.department);
+        if (departmentIt == departmentIds.end()) {
+            return selection;
+        }
+        compiled.departmentId = departmentIt->second;
+    }
+    // Predicates no row can pass
+    if (compiled.standings == 0 || query.minSemester > query.maxSemester || !(query.minCgpa < query.maxCgpa)) {
+        return selection;
+    }
+
+    const size_t fullWords = size() / 64;
+    for (size_t w = 0; w < fullWords; ++w) {
+        selection.words[w] = compiled.matchWord(w * 64);
+    }
+    for (size_t row = fullWords * 64; row < size(); ++row) {
+        selection.words[fullWords] |= static_cast<uint64_t>(compiled.matches(row)) << (row % 64);
+    }
+    return selection;
+}
+
+std::vector<std::string> StudentTable::list(const StudentSelection& selection) const {
+    if (selection.rows != size()) {
+        throw std::invalid_argument("Selection does not cover this table");
+    }
+    std::vector<std::string> ids;
+    ids.reserve(selection.count());
+    selection.forEach([&](size_t row) { ids.push_back(studentIds[row]); });
+    return ids;
+}
+
+std::vector<size_t> StudentTable::histogram(const StudentSelection& selection, StudentField field) const {
+    if (selection.rows != size()) {
+        throw std::invalid_argument("Selection does not cover this table");
+    }
+    std::vector<size_t> buckets;
+    auto bump = [&](size_t bucket) {
+        if (bucket >= buckets.size()) {
+            buckets.resize(bucket + 1, 0);
+        }
+        ++buckets[bucket];
+    };
+    switch (field) {
+    case StudentField::DEPARTMENT:
+        selection.forEach([&](size_t row) { bump(static_cast<size_t>(departmentColumn[row])); });
+        break;
+    case StudentField::SEMESTER:
+        selection.forEach([&](size_t row) {
+            if (semesterColumn[row] >= 0) {
+                bump(static_cast<size_t>(semesterColumn[row]));
+            }
+        });
+        break;
+    case StudentField::STANDING:
+        selection.forEach([&](size_t row) { bump(static_cast<size_t>(__builtin_ctz(standingColumn[row]))); });
+        break;
+    case StudentField::CGPA:
+        selection.forEach([&](size_t row) { bump(cgpaBucket(cgpaColumn[row])); });
+        break;
+    }
+    return buckets;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file student_query.h
+ * @brief Columnar snapshot of students with vectorized filter queries
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Advising lists such as "department CSE, semester 5 or later, on
+ * probation" used to be computed by walking Student objects, where every
+ * getDepartment() call copies a string. A StudentTable copies the fields
+ * those lists filter on into one array per field:
+ * - department, as an id into a dictionary of department names
+ * - semester
+ * - CGPA
+ * - academic standing, as the bit 1 << standing
+ *
+ * A StudentQuery is compiled against the table (the department name is
+ * resolved to its id once and unused predicates are dropped), then
+ * evaluated four rows at a time with SSE2 compares (one row at a time
+ * where SSE2 is unavailable). Each group of four results is packed with
+ * movemask into a StudentSelection, a bitmap with one bit per row.
+ * Counting a selection is a popcount per word; listing and histograms
+ * visit only the set bits.
+ */
+
+#ifndef STUDENT_QUERY_H
+#define STUDENT_QUERY_H
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "student.h"
+
+/** @brief Rows of a StudentTable picked by a query, one bit per row */
+class StudentSelection {
+private:
+    std::vector<uint64_t> words; /**< Bit r % 64 of word r / 64 is set if row r is selected */
+    size_t rows = 0;             /**< Rows of the table the selection covers */
+
+    friend class StudentTable;
+
+public:
+    StudentSelection() = default;
+
+    /** @brief Returns the number of selected rows */
+    size_t count() const;
+
+    /** @brief Returns true if row @p row is selected */
+    bool contains(size_t row) const { return row < rows && (words[row / 64] >> (row % 64)) & 1; }
+
+    /**
+     * @brief Keeps only rows also selected by @p other
+     *
+     * @throws std::invalid_argument if the selections cover different tables
+     */
+    StudentSelection& operator&=(const StudentSelection& other);
+
+    /**
+     * @brief Adds the rows selected by @p other
+     *
+     * @throws std::invalid_argument if the selections cover different tables
+     */
+    StudentSelection& operator|=(const StudentSelection& other);
+
+    /**
+     * @brief Calls @p visit with every selected row in ascending order
+     *
+     * @param visit Called as visit(size_t row)
+     */
+    template <typename Fn>
+    void forEach(Fn&& visit) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                visit(w * 64 + __builtin_ctzll(bits));
+            }
+        }
+    }
+};
+
+/**
+ * @brief Filter over a StudentTable; every field defaults to "match all"
+ *
+ * The CGPA range is half-open, [minCgpa, maxCgpa); the semester range is
+ * inclusive.
+ */
+struct StudentQuery {
+    std::string department;     /**< Department to match; empty matches every department */
+    int minSemester = INT_MIN;  /**< First semester included */
+    int maxSemester = INT_MAX;  /**< Last semester included */
+    float minCgpa = -INFINITY;  /**< Lowest CGPA included */
+    float maxCgpa = INFINITY;   /**< CGPAs from here on are excluded */
+    unsigned standings = 0xf;   /**< Standings to include, as a mask of standingBit() values */
+
+    /** @brief Returns the mask bit of one standing */
+    static unsigned standingBit(AcademicStanding standing) { return 1u << static_cast<unsigned>(standing); }
+};
+
+/** @brief Field a StudentTable histogram groups by */
+enum class StudentField {
+    DEPARTMENT, /**< Bucket i is departmentName(i) */
+    SEMESTER,   /**< Bucket i is semester i; semesters below 0 are not counted */
+    STANDING,   /**< Bucket i is AcademicStanding(i) */
+    CGPA        /**< Bucket i is CGPA in [i, i + 1), so 11 buckets for 0..10 */
+};
+
+/**
+ * @brief Column-per-field copy of a student population
+ *
+ * Rows are numbered in the order students were added. The table is a
+ * snapshot: later changes to a Student are not seen until it is added to
+ * a new table. Queries are const and may run concurrently.
+ *
+ * Example usage:
+ * @code
+ * StudentTable table(students);
+ * StudentQuery q;
+ * q.department = "CSE";
+ * q.minSemester = 5;
+ * q.standings = StudentQuery::standingBit(AcademicStanding::PROBATION);
+ * StudentSelection selected = table.select(q);
+ * std::cout << selected.count() << std::endl;
+ * for (const std::string& id : table.list(selected)) {
+ *     notifyAdvisor(id);
+ * }
+ * @endcode
+ */
+class StudentTable {
+private:
+    std::vector<std::string> studentIds;           /**< ID of each row */
+    std::vector<int32_t> departmentColumn;         /**< Department id of each row */
+    std::vector<int32_t> semesterColumn;           /**< Semester of each row */
+    std::vector<float> cgpaColumn;                 /**< CGPA of each row */
+    std::vector<uint32_t> standingColumn;          /**< 1 << standing of each row */
+    std::vector<std::string> departments;          /**< Name of each department id */
+    std::unordered_map<std::string, int32_t> departmentIds; /**< Id of each department name */
+
+public:
+    StudentTable() = default;
+
+    /** @brief Builds a table holding every student of @p students */
+    explicit StudentTable(const std::vector<Student>& students);
+
+    /**
+     * @brief Appends one student
+     *
+     * @return The student's row
+     */
+    size_t add(const Student& student);
+
+    /** @brief Returns the number of rows */
+    size_t size() const { return studentIds.size(); }
+
+    /**
+     * @brief Returns the student ID of a row
+     *
+     * @throws std::out_of_range if @p row is not less than size()
+     */
+    const std::string& studentId(size_t row) const;
+
+    /**
+     * @brief Returns the name of a department id, as used by DEPARTMENT histograms
+     *
+     * @throws std::out_of_range if @p department is unknown
+     */
+    const std::string& departmentName(size_t department) const;
+
+    /** @brief Returns the rows matching @p query */
+    StudentSelection select(const StudentQuery& query) const;
+
+    /** @brief Returns the number of rows matching @p query */
+    size_t count(const StudentQuery& query) const { return select(query).count(); }
+
+    /**
+     * @brief Returns the student IDs of the selected rows, in row order
+     *
+     * @throws std::invalid_argument if @p selection does not cover this table's rows
+     */
+    std::vector<std::string> list(const StudentSelection& selection) const;
+
+    /**
+     * @brief Counts the selected rows by one field
+     *
+     * @param selection Rows to count
+     * @param field Field to group by; see StudentField for the buckets
+     * @return One count per bucket, up to the highest bucket seen
+     * @throws std::invalid_argument if @p selection does not cover this table's rows
+     */
+    std::vector<size_t> histogram(const StudentSelection& selection, StudentField field) const;
+};
+
+#endif // STUDENT_QUERY_H
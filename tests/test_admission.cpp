@@ -0,0 +1,128 @@
+/**
+ * @file test_admission.cpp
+ * @brief Tests rate limiting, idempotent replay and idle eviction
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A retry inside the idempotency window must get the earlier answer
+ * without touching the catalog, until a withdrawal or swap changes the
+ * student's roster under either a section or its parent code. Buckets
+ * refill on the engine clock, and students with a full bucket and no
+ * live cached answers must not keep admission state.
+ */
+
+#include <ctime>
+#include <string>
+#include "admission_control.h"
+#include "course_registration.h"
+#include "registration_clock.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Engine on @p clock with MATH101 split into two sections, plus PHYS101 */
+void addCatalog(CourseRegistration& reg, ManualClock& clock) {
+    reg.setClock(&clock);
+    const time_t deadline = clock.now() + 86400;
+    reg.addCourse("MATH101", "Calculus", 0, {}, deadline);
+    reg.addSection("MATH101", "MATH101-1", 2);
+    reg.addSection("MATH101", "MATH101-2", 2);
+    reg.addCourse("PHYS101", "Mechanics", 10, {}, deadline);
+}
+
+void testRateLimit() {
+    ManualClock clock(1000);
+    CourseRegistration reg;
+    addCatalog(reg, clock);
+    reg.setAdmissionPolicy({1, 2, 0});
+    Student alice("S1", "Alice", "CSE");
+
+    CHECK(reg.tryRegisterStudent(alice, "PHYS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(alice, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(alice, "PHYS101") == RegistrationStatus::RATE_LIMITED);
+    clock.advance(1);
+    CHECK(reg.tryRegisterStudent(alice, "PHYS101") == RegistrationStatus::ALREADY_ENROLLED);
+    AdmissionStats stats = reg.getAdmissionStats();
+    CHECK(stats.admitted == 3 && stats.rateLimited == 1 && stats.replayed == 0);
+}
+
+void testReplayAndForget() {
+    ManualClock clock(1000);
+    CourseRegistration reg;
+    addCatalog(reg, clock);
+    reg.setAdmissionPolicy({0, 0, 60});
+    Student bob("S2", "Bob", "CSE");
+
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getAdmissionStats().replayed == 1);
+
+    // Withdrawing by section code drops the answer cached under the parent
+    const std::string section = reg.getSection("S2", "MATH101").value;
+    CHECK(reg.withdrawStudent("S2", section));
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getEnrollmentCount("MATH101") == 1);
+    CHECK(reg.getAdmissionStats().replayed == 1);
+
+    // So does swapping out of the section
+    CHECK(reg.swapCourse(bob, reg.getSection("S2", "MATH101").value, "PHYS101") ==
+          RegistrationStatus::SUCCESS);
+    CHECK(reg.getEnrollmentCount("MATH101") == 0);
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getEnrollmentCount("MATH101") == 1);
+
+    // Refusals are not replayed, and answers expire with the window
+    Student carol("S3", "Carol", "CSE");
+    CHECK(reg.tryRegisterStudent(carol, "NOPE101") == RegistrationStatus::UNKNOWN_COURSE);
+    CHECK(reg.tryRegisterStudent(carol, "NOPE101") == RegistrationStatus::UNKNOWN_COURSE);
+    CHECK(reg.getAdmissionStats().replayed == 1);
+    clock.advance(60);
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.getAdmissionStats().replayed == 1);
+}
+
+void testIdleEviction() {
+    AdmissionController admission;
+    admission.setPolicy({1, 4, 10});
+    const time_t start = 1000;
+    for (int i = 0; i < 100; ++i) {
+        const std::string id = "S" + std::to_string(i);
+        CHECK(admission.admit(id, "CS101", start).verdict == AdmissionVerdict::ADMIT);
+        admission.complete(id, "CS101", RegistrationStatus::SUCCESS, start);
+    }
+    CHECK(admission.trackedStudents() == 100);
+
+    // Still inside the window: nothing is idle yet
+    CHECK(admission.admit("S0", "CS101", start + 5).verdict == AdmissionVerdict::REPLAY);
+    CHECK(admission.trackedStudents() == 100);
+
+    // Past the window with full buckets, every quiet student is dropped
+    // as admissions cycle through its shard
+    for (int i = 0; i < 1000; ++i) {
+        admission.admit("T" + std::to_string(i), "CS101", start + 20);
+    }
+    CHECK(admission.trackedStudents() == 1000);
+    CHECK(admission.admit("S0", "CS101", start + 20).verdict == AdmissionVerdict::ADMIT);
+
+    // A student whose bucket is still refilling keeps its state
+    admission.admit("busy", "CS101", start + 40);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(admission.admit("busy", "CS101", start + 49).verdict == AdmissionVerdict::ADMIT);
+    }
+    CHECK(admission.admit("busy", "CS101", start + 49).verdict == AdmissionVerdict::REJECT);
+    for (int i = 0; i < 1000; ++i) {
+        admission.admit("U" + std::to_string(i), "CS101", start + 50);
+    }
+    CHECK(admission.trackedStudents() == 1001);
+    CHECK(admission.admit("busy", "CS101", start + 50).verdict == AdmissionVerdict::ADMIT);
+    CHECK(admission.admit("busy", "CS101", start + 50).verdict == AdmissionVerdict::REJECT);
+}
+
+} // namespace
+
+int main() {
+    testRateLimit();
+    testReplayAndForget();
+    testIdleEviction();
+    return test::finish();
+}
@@ -0,0 +1,151 @@
+/**
+ * @file test_archive.cpp
+ * @brief Tests archived rosters against the sets they were built from
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Whatever its size and gaps, an archived roster must iterate exactly
+ * its source set in ascending order and answer membership like it, on
+ * either side of every block boundary. An archived term must keep the
+ * rosters of the commit it was taken at, shared IDs must be interned
+ * once, and the archive must outlive the engine.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "course_registration.h"
+#include "roster_archive.h"
+#include "roster_snapshot.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Checks forEach() and contains() of @p roster against @p expected */
+void checkRoster(const ArchivedRoster& roster, const std::set<StudentHandle>& expected) {
+    CHECK(roster.size() == expected.size());
+    std::vector<StudentHandle> visited;
+    roster.forEach([&](StudentHandle handle) { visited.push_back(handle); });
+    CHECK(visited == std::vector<StudentHandle>(expected.begin(), expected.end()));
+    for (StudentHandle handle : expected) {
+        CHECK(roster.contains(handle));
+        if (handle > 0 && !expected.count(handle - 1)) {
+            CHECK(!roster.contains(handle - 1));
+        }
+        if (handle < UINT32_MAX && !expected.count(handle + 1)) {
+            CHECK(!roster.contains(handle + 1));
+        }
+    }
+}
+
+void testRosters() {
+    std::mt19937 rng(5);
+    checkRoster(ArchivedRoster::fromHandles({}), {});
+    CHECK(!ArchivedRoster().contains(0));
+    checkRoster(ArchivedRoster::fromHandles({0, UINT32_MAX}), {0, UINT32_MAX});
+
+    const std::vector<size_t> sizes = {1, ArchivedRoster::kBlockSize - 1, ArchivedRoster::kBlockSize,
+                                       ArchivedRoster::kBlockSize + 1, 1000, 5000};
+    // Dense rosters have one-byte gaps; sparse ones need multi-byte varints
+    const std::vector<uint32_t> spreads = {2, 300, 1u << 24};
+    for (size_t size : sizes) {
+        for (uint32_t spread : spreads) {
+            std::set<StudentHandle> expected;
+            std::vector<StudentHandle> handles;
+            while (expected.size() < size) {
+                StudentHandle handle = static_cast<StudentHandle>(rng() % (spread * size));
+                expected.insert(handle);
+                handles.push_back(handle);
+                // Duplicates are ignored
+                if (rng() % 8 == 0) {
+                    handles.push_back(handle);
+                }
+            }
+            std::shuffle(handles.begin(), handles.end(), rng);
+            checkRoster(ArchivedRoster::fromHandles(handles), expected);
+        }
+    }
+}
+
+void testDirectory() {
+    StudentDirectory directory;
+    CHECK(directory.intern("S1") == 0);
+    CHECK(directory.intern("S2") == 1);
+    CHECK(directory.intern("S1") == 0);
+    CHECK(directory.size() == 2);
+    StudentHandle handle = 99;
+    CHECK(directory.find("S2", handle) && handle == 1);
+    CHECK(!directory.find("S3", handle));
+    CHECK(directory.size() == 2);
+    CHECK(directory.idOf(1) == "S2");
+}
+
+void testArchiveTerm() {
+    StudentDirectory directory;
+    ArchivedTerm fall;
+    std::set<std::string> physics;
+    {
+        auto reg = std::make_unique<CourseRegistration>();
+        const time_t deadline = time(nullptr) + 86400;
+        reg->addCourse("CS101", "Programming", 500, {}, deadline);
+        reg->addCourse("PHYS101", "Mechanics", 500, {}, deadline);
+        reg->addCourse("EMPTY101", "Nobody", 10, {}, deadline);
+        for (int i = 0; i < 400; ++i) {
+            Student student("S" + std::to_string(i), "Student", "CSE");
+            CHECK(reg->tryRegisterStudent(student, "CS101") == RegistrationStatus::SUCCESS);
+            if (i % 3 == 0) {
+                CHECK(reg->tryRegisterStudent(student, "PHYS101") == RegistrationStatus::SUCCESS);
+                physics.insert(student.getStudentId());
+            }
+        }
+        fall = reg->archiveTerm(directory);
+        CHECK(fall.getVersion() == reg->openSnapshot().getVersion());
+
+        // Later changes do not reach the archive
+        CHECK(reg->withdrawStudent("S0", "PHYS101"));
+    }
+
+    CHECK(fall.courseCount() == 3);
+    CHECK(directory.size() == 400);
+    CHECK(fall.roster("CS101")->size() == 400);
+    CHECK(fall.roster("EMPTY101")->size() == 0);
+    CHECK(fall.roster("NOPE101") == nullptr);
+    CHECK(fall.wasEnrolled("S0", "PHYS101"));
+    CHECK(!fall.wasEnrolled("S1", "PHYS101"));
+    CHECK(!fall.wasEnrolled("S999", "CS101"));
+    CHECK(!fall.wasEnrolled("S0", "NOPE101"));
+
+    std::set<std::string> visited;
+    CHECK(fall.forEachStudent("PHYS101", [&](const std::string& id) { visited.insert(id); }));
+    CHECK(visited == physics);
+    CHECK(!fall.forEachStudent("NOPE101", [](const std::string&) {}));
+
+    // A second term shares the directory: known IDs are not stored again
+    CourseRegistration spring;
+    spring.addCourse("CS201", "Data Structures", 10, {}, time(nullptr) + 86400);
+    Student returning("S7", "Student", "CSE");
+    Student fresh("S1000", "Student", "CSE");
+    CHECK(spring.tryRegisterStudent(returning, "CS201") == RegistrationStatus::SUCCESS);
+    CHECK(spring.tryRegisterStudent(fresh, "CS201") == RegistrationStatus::SUCCESS);
+    ArchivedTerm next = spring.archiveTerm(directory);
+    CHECK(directory.size() == 401);
+    CHECK(next.wasEnrolled("S7", "CS201") && next.wasEnrolled("S1000", "CS201"));
+    CHECK(!next.wasEnrolled("S8", "CS201"));
+
+    // A few hundred dense handles take one to two bytes each
+    CHECK(fall.roster("CS101")->memoryBytes() < 400 * 4);
+}
+
+} // namespace
+
+int main() {
+    testRosters();
+    testDirectory();
+    testArchiveTerm();
+    return test::finish();
+}
@@ -0,0 +1,262 @@
+/**
+ * @file test_async.cpp
+ * @brief Tests the engine executor and its coroutine awaitables
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Tasks of one course must run one at a time in posting order, drain()
+ * must wait for tasks posted by tasks, and destruction must run every
+ * task already posted. Coroutines awaiting the engine must get the same
+ * outcomes as blocking calls under contention, and with a journal they
+ * must resume only once their changes are on disk.
+ */
+
+#include <atomic>
+#include <coroutine>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "registration_async.h"
+#include "registration_executor.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Coroutine that starts at once and frees itself when it finishes */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/** @brief Shared state of the strand ordering check */
+struct StrandLog {
+    std::atomic<int> running{0};  /**< Tasks of the course running right now */
+    std::atomic<bool> overlap{false}; /**< Set if two ever ran at once */
+    std::mutex mutex;             /**< Guards order */
+    std::vector<int> order;       /**< Task numbers in the order they ran */
+};
+
+/** @brief One task posted to a course strand */
+struct StrandTask {
+    StrandLog* log; /**< Log the task writes to */
+    int number;     /**< Posting order */
+
+    static void run(void* argument) {
+        StrandTask& task = *static_cast<StrandTask*>(argument);
+        if (task.log->running.fetch_add(1) != 0) {
+            task.log->overlap = true;
+        }
+        std::this_thread::yield();
+        {
+            std::lock_guard<std::mutex> lock(task.log->mutex);
+            task.log->order.push_back(task.number);
+        }
+        task.log->running.fetch_sub(1);
+    }
+};
+
+void testStrands() {
+    RegistrationExecutor executor(4);
+    CHECK(executor.threadCount() == 4);
+    StrandLog log;
+    std::vector<StrandTask> tasks;
+    for (int i = 0; i < 1000; ++i) {
+        tasks.push_back({&log, i});
+    }
+    // More than kStrandBatch tasks, so the strand yields its worker and resumes
+    std::atomic<int> others{0};
+    for (StrandTask& task : tasks) {
+        executor.postToCourse("CS101", &StrandTask::run, &task);
+        executor.post([](void* counter) { static_cast<std::atomic<int>*>(counter)->fetch_add(1); }, &others);
+    }
+    executor.drain();
+    CHECK(executor.idle());
+    CHECK(!log.overlap);
+    CHECK(log.order.size() == tasks.size());
+    bool ordered = true;
+    for (size_t i = 0; i < log.order.size(); ++i) {
+        ordered = ordered && log.order[i] == static_cast<int>(i);
+    }
+    CHECK(ordered);
+    CHECK(others == 1000);
+}
+
+/** @brief A task that posts @p depth more tasks behind itself */
+struct ChainTask {
+    RegistrationExecutor* executor; /**< Executor to post to */
+    std::atomic<int>* ran;          /**< Counts every task run */
+    int depth;                      /**< Tasks still to post */
+
+    static void run(void* argument) {
+        ChainTask& task = *static_cast<ChainTask*>(argument);
+        task.ran->fetch_add(1);
+        if (task.depth > 0) {
+            --task.depth;
+            task.executor->postToCourse("MATH101", &ChainTask::run, argument);
+        }
+    }
+};
+
+void testDrainAndShutdown() {
+    std::atomic<int> ran{0};
+    {
+        RegistrationExecutor executor(2);
+        ChainTask chain{&executor, &ran, 500};
+        executor.post(&ChainTask::run, &chain);
+        executor.drain();
+        CHECK(ran == 501);
+    }
+
+    // Destruction runs every task already posted
+    std::atomic<int> late{0};
+    {
+        RegistrationExecutor executor(1);
+        for (int i = 0; i < 200; ++i) {
+            executor.postToCourse("C" + std::to_string(i % 5),
+                                  [](void* counter) { static_cast<std::atomic<int>*>(counter)->fetch_add(1); },
+                                  &late);
+        }
+    }
+    CHECK(late == 200);
+}
+
+/** @brief Registers @p student for @p course and reads its count back without suspending */
+DetachedTask registerAndCount(CourseRegistration& reg, Student& student, std::string course,
+                              std::atomic<int>& succeeded, std::atomic<int>& unexpected,
+                              std::latch& finished) {
+    RegistrationStatus status = co_await registerStudentAsync(reg, student, course);
+    if (status == RegistrationStatus::SUCCESS) {
+        ++succeeded;
+        CourseQueryResult<int> count = co_await getEnrollmentCountAsync(reg, course);
+        CourseQueryResult<bool> full = co_await isCourseFullAsync(reg, course);
+        if (!count.ok() || count.value < 1 || !full.ok()) {
+            ++unexpected;
+        }
+    } else if (status != RegistrationStatus::COURSE_FULL) {
+        ++unexpected;
+    }
+    finished.count_down();
+}
+
+void testAwaitables() {
+    CourseRegistration reg;
+    bool threw = false;
+    try {
+        reg.getExecutor();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    reg.addCourse("CS101", "Programming", 50, {}, time(nullptr) + 86400);
+    reg.enableExecutor(4);
+    std::vector<std::unique_ptr<Student>> students;
+    for (int i = 0; i < 400; ++i) {
+        students.push_back(std::make_unique<Student>("S" + std::to_string(i), "Student", "CSE"));
+    }
+    std::atomic<int> succeeded{0};
+    std::atomic<int> unexpected{0};
+    std::latch finished(static_cast<std::ptrdiff_t>(students.size()));
+    for (auto& student : students) {
+        registerAndCount(reg, *student, "CS101", succeeded, unexpected, finished);
+    }
+    finished.wait();
+    // Contended seats are given out exactly once
+    CHECK(succeeded == 50);
+    CHECK(unexpected == 0);
+    CHECK(reg.getEnrollmentCount("CS101") == 50);
+
+    std::latch unknown(1);
+    std::atomic<int> results{0};
+    [](CourseRegistration& reg, Student& student, std::atomic<int>& results, std::latch& done) -> DetachedTask {
+        if (co_await registerStudentAsync(reg, student, "NOPE101") == RegistrationStatus::UNKNOWN_COURSE) {
+            ++results;
+        }
+        if (!co_await withdrawStudentAsync(reg, student.getStudentId(), "NOPE101")) {
+            ++results;
+        }
+        const bool withdrew = co_await withdrawStudentAsync(reg, student.getStudentId(), "CS101");
+        if (reg.getEnrollmentCount("CS101") == (withdrew ? 49 : 50)) {
+            ++results;
+        }
+        CourseQueryResult<int> missing = co_await getEnrollmentCountAsync(reg, "NOPE101");
+        if (missing.status == RegistrationStatus::UNKNOWN_COURSE) {
+            ++results;
+        }
+        // The handle forms read the board alone
+        const CourseHandle cs101 = reg.getCourseHandle("CS101").value;
+        CourseQueryResult<int> count = co_await getEnrollmentCountAsync(reg, cs101);
+        if (count.ok() && count.value == reg.getEnrollmentCount("CS101")) {
+            ++results;
+        }
+        CourseQueryResult<bool> full = co_await isCourseFullAsync(reg, cs101);
+        if (full.ok() && full.value == !withdrew) {
+            ++results;
+        }
+        const CourseHandle past = reg.getAvailabilityBoard().size();
+        if ((co_await getEnrollmentCountAsync(reg, past)).status == RegistrationStatus::UNKNOWN_COURSE &&
+            (co_await isCourseFullAsync(reg, past)).status == RegistrationStatus::UNKNOWN_COURSE) {
+            ++results;
+        }
+        done.count_down();
+    }(reg, *students[0], results, unknown);
+    unknown.wait();
+    CHECK(results == 7);
+}
+
+/** @brief Registers every student in turn, checking each change is durable on resumption */
+DetachedTask registerDurably(CourseRegistration& reg, std::vector<std::unique_ptr<Student>>& students,
+                             std::atomic<int>& durable, std::latch& finished) {
+    for (auto& student : students) {
+        RegistrationStatus status = co_await registerStudentAsync(reg, *student, "CS101");
+        RegistrationJournal& journal = reg.getJournal();
+        if (status == RegistrationStatus::SUCCESS && journal.durablePosition() >= journal.appendedPosition()) {
+            ++durable;
+        }
+    }
+    finished.count_down();
+}
+
+void testJournaled(const std::string& path) {
+    std::vector<std::unique_ptr<Student>> students;
+    for (int i = 0; i < 100; ++i) {
+        students.push_back(std::make_unique<Student>("S" + std::to_string(i), "Student", "CSE"));
+    }
+    {
+        CourseRegistration reg;
+        reg.addCourse("CS101", "Programming", 200, {}, time(nullptr) + 86400);
+        reg.enableJournal(path);
+        reg.enableExecutor(2);
+        std::atomic<int> durable{0};
+        std::latch finished(1);
+        registerDurably(reg, students, durable, finished);
+        finished.wait();
+        CHECK(durable == 100);
+    }
+    CHECK(RegistrationJournal::read(path).size() == 100);
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "test_async." + std::to_string(::getpid()) + ".journal";
+    testStrands();
+    testDrainAndShutdown();
+    testAwaitables();
+    testJournaled(path);
+    std::filesystem::remove(path);
+    return test::finish();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test_board.cpp
+ * @brief Tests the seqlock availability board and its delta feed
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A read racing a writer must see one whole publication, never a mix of
+ * two. Each changesSince call must report exactly the entries changed
+ * after its cursor, held seats must count as taken, and a course added
+ * while a poller scans must reach the poller.
+ */
+
+#include <atomic>
+#include <ctime>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "availability_board.h"
+#include "course_registration.h"
+#include "test_util.h"
+
+namespace {
+
+void testSeqlockReads() {
+    AvailabilityBoard board;
+    board.addCourse(0, 1000);
+    // Every publication keeps enrolled + held == 1000
+    board.publish(0, 0, 1000);
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 0; i <= 200000; ++i) {
+            board.publish(0, i % 1001, 1000 - i % 1001);
+        }
+        done.store(true);
+    });
+    uint64_t torn = 0;
+    uint64_t backwards = 0;
+    uint64_t lastVersion = 0;
+    while (!done.load()) {
+        SeatAvailability seats = board.read(0);
+        torn += seats.enrolled + seats.held != 1000 || seats.seatsLeft != 0;
+        backwards += seats.version < lastVersion;
+        lastVersion = seats.version;
+    }
+    writer.join();
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    CHECK(board.read(0).version == board.currentVersion());
+}
+
+void testCursor() {
+    AvailabilityBoard board;
+    for (CourseHandle handle = 0; handle < 3; ++handle) {
+        board.addCourse(handle, 10);
+    }
+    uint64_t cursor = 0;
+    CHECK(board.changesSince(cursor, cursor).size() == 3);
+    CHECK(cursor == board.currentVersion());
+    CHECK(board.changesSince(cursor, cursor).empty());
+
+    board.publish(2, 4);
+    board.setCapacity(0, 20);
+    uint64_t before = cursor;
+    std::vector<SeatAvailability> changes = board.changesSince(cursor, cursor);
+    CHECK(changes.size() == 2 && cursor > before);
+    CHECK(changes.size() == 2 && changes[0].handle == 0 && changes[0].capacity == 20);
+    CHECK(changes.size() == 2 && changes[1].handle == 2 && changes[1].enrolled == 4);
+    CHECK(board.changesSince(cursor, cursor).empty());
+
+    // An older cursor sees the later changes again
+    CHECK(board.changesSince(before, before).size() == 2);
+}
+
+void testHeldSeats() {
+    AvailabilityBoard board;
+    board.addCourse(0, 10);
+    board.publish(0, 6, 3);
+    SeatAvailability seats = board.read(0);
+    CHECK(seats.enrolled == 6 && seats.held == 3 && seats.seatsLeft == 1);
+    board.setCapacity(0, 8);
+    CHECK(board.read(0).seatsLeft == 0);
+
+    // Through the engine, a hold is published as held, not enrolled
+    CourseRegistration reg;
+    reg.addCourse("CS101", "Programming", 2, {}, time(nullptr) + 86400);
+    Student alice("S1", "Alice", "CSE");
+    CHECK(reg.holdSeat(alice, "CS101", 600).status == RegistrationStatus::SUCCESS);
+    CourseHandle cs101 = reg.getCourseHandle("CS101").value;
+    seats = reg.getAvailabilityBoard().read(cs101);
+    CHECK(seats.enrolled == 0 && seats.held == 1 && seats.seatsLeft == 1);
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::SUCCESS);
+    seats = reg.getAvailabilityBoard().read(cs101);
+    CHECK(seats.enrolled == 1 && seats.held == 0 && seats.seatsLeft == 1);
+}
+
+void testAddWhilePolling() {
+    const CourseHandle courses = 5000;
+    AvailabilityBoard board;
+    std::atomic<bool> done{false};
+    std::thread adder([&] {
+        for (CourseHandle handle = 0; handle < courses; ++handle) {
+            board.addCourse(handle, 1);
+        }
+        done.store(true);
+    });
+    std::set<CourseHandle> seen;
+    uint64_t cursor = 0;
+    bool finished = false;
+    while (!finished) {
+        // Read the flag first so the last poll covers every course
+        finished = done.load();
+        for (const SeatAvailability& seats : board.changesSince(cursor, cursor)) {
+            seen.insert(seats.handle);
+        }
+    }
+    adder.join();
+    CHECK(seen.size() == courses);
+}
+
+} // namespace
+
+int main() {
+    testSeqlockReads();
+    testCursor();
+    testHeldSeats();
+    testAddWhilePolling();
+    return test::finish();
+}
@@ -0,0 +1,131 @@
+/**
+ * @file test_cart_swap.cpp
+ * @brief Tests that carts and swaps commit whole or not at all
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A cart with one failing course must register none of them, an empty
+ * cart must not report a commit, a swap whose new course fails its
+ * checks must leave the student in the old one, a sectioned course may
+ * be dropped by its parent code, and every call must be counted once in
+ * the engine's status metrics.
+ */
+
+#include <ctime>
+#include <string>
+#include "course_registration.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief MATH101 in two sections, PHYS101, CS201 requiring CS101, and a one-seat CHEM101 */
+void addCatalog(CourseRegistration& reg) {
+    const time_t deadline = time(nullptr) + 86400;
+    reg.addCourse("MATH101", "Calculus", 0, {}, deadline);
+    reg.addSection("MATH101", "MATH101-1", 2);
+    reg.addSection("MATH101", "MATH101-2", 2);
+    reg.addCourse("PHYS101", "Mechanics", 10, {}, deadline);
+    reg.addCourse("CS101", "Programming", 10, {}, deadline);
+    reg.addCourse("CS201", "Data Structures", 10, {"CS101"}, deadline);
+    reg.addCourse("CHEM101", "Chemistry", 1, {}, deadline);
+}
+
+void testCartRollback() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    CHECK(reg.tryRegisterStudent(bob, "CHEM101") == RegistrationStatus::SUCCESS);
+
+    // CHEM101 is full, so neither PHYS101 nor the section is kept
+    CartRegistrationResult full = reg.registerCart(alice, {"PHYS101", "MATH101-1", "CHEM101"});
+    CHECK(!full.committed);
+    CHECK(full.statuses.size() == 3);
+    CHECK(full.statuses[0] == RegistrationStatus::SUCCESS);
+    CHECK(full.statuses[2] == RegistrationStatus::COURSE_FULL);
+    CHECK(reg.getEnrollmentCount("PHYS101") == 0);
+    CHECK(reg.getEnrollmentCount("MATH101") == 0);
+    CHECK(alice.getEnrolledCourses().empty());
+
+    // A cart course does not satisfy another's prerequisite
+    CartRegistrationResult prereq = reg.registerCart(alice, {"CS101", "CS201"});
+    CHECK(!prereq.committed && prereq.statuses[1] == RegistrationStatus::PREREQ_NOT_MET);
+    CHECK(reg.getEnrollmentCount("CS101") == 0);
+
+    CartRegistrationResult empty = reg.registerCart(alice, {});
+    CHECK(!empty.committed && empty.statuses.empty());
+
+    CartRegistrationResult good = reg.registerCart(alice, {"PHYS101", "CS101"});
+    CHECK(good.committed);
+    CHECK(reg.getEnrollmentCount("PHYS101") == 1 && reg.getEnrollmentCount("CS101") == 1);
+    CHECK(alice.getEnrolledCourses().size() == 2);
+}
+
+void testSwapRollback() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    CHECK(reg.tryRegisterStudent(alice, "PHYS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(bob, "CHEM101") == RegistrationStatus::SUCCESS);
+
+    CHECK(reg.swapCourse(alice, "PHYS101", "CS201") == RegistrationStatus::PREREQ_NOT_MET);
+    CHECK(reg.swapCourse(alice, "PHYS101", "CHEM101") == RegistrationStatus::COURSE_FULL);
+    CHECK(reg.swapCourse(alice, "CS101", "MATH101-1") == RegistrationStatus::NOT_ENROLLED);
+    CHECK(reg.swapCourse(alice, "PHYS101", "NOPE101") == RegistrationStatus::UNKNOWN_COURSE);
+    CHECK(reg.getEnrollmentCount("PHYS101") == 1);
+    CHECK(reg.getEnrollmentCount("CS201") == 0);
+    CHECK(reg.getEnrollmentCount("CHEM101") == 1);
+
+    CHECK(reg.swapCourse(alice, "PHYS101", "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getEnrollmentCount("PHYS101") == 0);
+    CHECK(reg.getEnrollmentCount("CS101") == 1);
+}
+
+void testSwapByParentCode() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student carol("S3", "Carol", "CSE");
+    CHECK(reg.swapCourse(carol, "MATH101", "PHYS101") == RegistrationStatus::NOT_ENROLLED);
+    CHECK(reg.tryRegisterStudent(carol, "MATH101-1") == RegistrationStatus::SUCCESS);
+
+    // The parent code names the student's section
+    CHECK(reg.swapCourse(carol, "MATH101", "MATH101-1") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.swapCourse(carol, "MATH101", "MATH101-2") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getSection("S3", "MATH101").value == "MATH101-2");
+    CHECK(reg.swapCourse(carol, "MATH101", "PHYS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getEnrollmentCount("MATH101") == 0);
+    CHECK(reg.getEnrollmentCount("PHYS101") == 1);
+    CHECK(reg.getSection("S3", "MATH101").status == RegistrationStatus::NOT_ENROLLED);
+}
+
+void testSwapMetrics() {
+    if (!RegistrationMetrics::enabled) {
+        return;
+    }
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student dave("S4", "Dave", "CSE");
+    CHECK(reg.tryRegisterStudent(dave, "PHYS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.swapCourse(dave, "PHYS101", "CS201") == RegistrationStatus::PREREQ_NOT_MET);
+    CHECK(reg.swapCourse(dave, "PHYS101", "PHYS101") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.swapCourse(dave, "PHYS101", "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(!reg.registerCart(dave, {"MATH101-1", "NOPE101"}).committed);
+    CHECK(reg.registerCart(dave, {"MATH101-1", "CHEM101"}).committed);
+
+    MetricsSnapshot metrics = reg.getMetrics();
+    CHECK(metrics.count(RegistrationStatus::SUCCESS) == 3);
+    CHECK(metrics.count(RegistrationStatus::PREREQ_NOT_MET) == 1);
+    CHECK(metrics.count(RegistrationStatus::ALREADY_ENROLLED) == 1);
+    CHECK(metrics.count(RegistrationStatus::UNKNOWN_COURSE) == 1);
+}
+
+} // namespace
+
+int main() {
+    testCartRollback();
+    testSwapRollback();
+    testSwapByParentCode();
+    testSwapMetrics();
+    return test::finish();
+}
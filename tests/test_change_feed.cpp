@@ -0,0 +1,90 @@
+/**
+ * @file test_change_feed.cpp
+ * @brief Tests that a lapped change-feed consumer counts what it lost
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A consumer that falls more than a ring's length behind must skip to
+ * the oldest event still held, count every skipped event as dropped and
+ * then continue without further loss; a consumer that keeps up must lose
+ * nothing.
+ */
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include "course_registration.h"
+#include "roster_snapshot.h"
+#include "test_util.h"
+
+namespace {
+
+void testOverrun() {
+    ChangeFeed feed(8);
+    ChangeFeedConsumer slow = feed.subscribe();
+    ChangeFeedConsumer fast = feed.subscribe();
+    std::vector<EnrollmentEvent> fastEvents;
+
+    const uint64_t published = 20;
+    for (uint64_t i = 0; i < published; ++i) {
+        feed.publish(0, "CS101", "S" + std::to_string(i), i + 1, EnrollmentEventKind::ENROLLED);
+        fast.poll(fastEvents);
+    }
+    CHECK(fastEvents.size() == published);
+    CHECK(fast.stats().dropped == 0);
+
+    std::vector<EnrollmentEvent> events;
+    slow.poll(events);
+    ChangeFeedConsumerStats stats = slow.stats();
+    CHECK(stats.dropped > 0);
+    CHECK(stats.delivered == events.size());
+    CHECK(stats.delivered + stats.dropped == published);
+    CHECK(stats.lag == 0);
+    CHECK(!events.empty() && events.size() <= 8);
+    for (size_t i = 1; i < events.size(); ++i) {
+        CHECK(events[i].sequence == events[i - 1].sequence + 1);
+    }
+    CHECK(events.front().sequence == stats.dropped);
+    CHECK(events.back().sequence == published - 1);
+    CHECK(events.back().studentId == "S19" && events.back().version == published);
+
+    // Caught up again: nothing more is lost
+    feed.publish(0, "CS101", "S20", published + 1, EnrollmentEventKind::WITHDRAWN);
+    events.clear();
+    CHECK(slow.poll(events) == 1);
+    CHECK(events[0].sequence == published && events[0].kind == EnrollmentEventKind::WITHDRAWN);
+    CHECK(slow.stats().dropped == stats.dropped);
+    CHECK(feed.stats().published == published + 1);
+}
+
+void testEngineOverrun() {
+    CourseRegistration reg;
+    reg.addCourse("CS101", "Programming", 100, {}, time(nullptr) + 86400);
+    reg.enableChangeFeed(8);
+    ChangeFeedConsumer consumer = reg.subscribeChanges();
+
+    std::vector<Student> students;
+    for (int i = 0; i < 30; ++i) {
+        students.emplace_back("S" + std::to_string(i), "Student", "CSE");
+    }
+    for (Student& student : students) {
+        CHECK(reg.tryRegisterStudent(student, "CS101") == RegistrationStatus::SUCCESS);
+    }
+
+    std::vector<EnrollmentEvent> events;
+    consumer.poll(events);
+    ChangeFeedConsumerStats stats = consumer.stats();
+    CHECK(stats.dropped > 0);
+    CHECK(stats.delivered + stats.dropped == students.size());
+    CHECK(!events.empty() && events.back().studentId == "S29");
+    // The documented way to resynchronize after a loss
+    CHECK(reg.openSnapshot().getEnrollmentCount("CS101").value == 30);
+}
+
+} // namespace
+
+int main() {
+    testOverrun();
+    testEngineOverrun();
+    return test::finish();
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_checks.cpp
+ * @brief Tests the compile-time registration check pipeline
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A CheckPipeline must run its policies left to right and stop at the
+ * first failure, the default rule set must report failures in its
+ * documented order, and an engine must apply whatever rule set a
+ * registerStudentWith call names.
+ */
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include "course_registration.h"
+#include "registration_checks.h"
+#include "registration_clock.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Names of the policies run so far, in order */
+std::vector<std::string> calls;
+
+/** @brief Context of the synthetic pipeline tests: which policies pass */
+struct Verdicts {
+    bool first;
+    bool second;
+    bool third;
+};
+
+struct FirstCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::REGISTRATION_CLOSED;
+    static bool passes(const Verdicts& v) {
+        calls.push_back("first");
+        return v.first;
+    }
+};
+
+struct SecondCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::COURSE_FULL;
+    static bool passes(const Verdicts& v) {
+        calls.push_back("second");
+        return v.second;
+    }
+};
+
+struct ThirdCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::PREREQ_NOT_MET;
+    static bool passes(const Verdicts& v) {
+        calls.push_back("third");
+        return v.third;
+    }
+};
+
+/** @brief Caps a student at two enrolled courses */
+struct CourseLoadCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::TIME_CONFLICT;
+    template <typename Context>
+    static bool passes(const Context& ctx) {
+        calls.push_back("load");
+        return ctx.student.getEnrolledCourses().size() < 2;
+    }
+};
+
+/** @brief Records that the pipeline got this far; always passes */
+struct ProbeCheck {
+    static constexpr RegistrationStatus failure = RegistrationStatus::TIME_CONFLICT;
+    template <typename Context>
+    static bool passes(const Context&) {
+        calls.push_back("probe");
+        return true;
+    }
+};
+
+void testOrderAndShortCircuit() {
+    using Pipeline = CheckPipeline<FirstCheck, SecondCheck, ThirdCheck>;
+
+    calls.clear();
+    CHECK(Pipeline::run(Verdicts{true, true, true}) == RegistrationStatus::SUCCESS);
+    CHECK(calls == (std::vector<std::string>{"first", "second", "third"}));
+
+    calls.clear();
+    CHECK(Pipeline::run(Verdicts{true, false, false}) == RegistrationStatus::COURSE_FULL);
+    CHECK(calls == (std::vector<std::string>{"first", "second"}));
+
+    calls.clear();
+    CHECK(Pipeline::run(Verdicts{false, false, false}) == RegistrationStatus::REGISTRATION_CLOSED);
+    CHECK(calls == (std::vector<std::string>{"first"}));
+
+    // Reordering the policies reorders the checks
+    calls.clear();
+    CHECK((CheckPipeline<ThirdCheck, FirstCheck>::run(Verdicts{false, false, true})) ==
+          RegistrationStatus::REGISTRATION_CLOSED);
+    CHECK(calls == (std::vector<std::string>{"third", "first"}));
+
+    // An empty pipeline accepts everything
+    CHECK(CheckPipeline<>::run(Verdicts{false, false, false}) == RegistrationStatus::SUCCESS);
+}
+
+void testDefaultOrder() {
+    ManualClock clock(1000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    reg.addCourse("CS101", "Programming", 1, {}, 2000);
+    reg.addCourse("CS201", "Data Structures", 1, {"CS101"}, 2000);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    Student carol("S3", "Carol", "CSE");
+
+    // Prerequisites are checked last: a full course reports COURSE_FULL
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(alice, "CS201") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(bob, "CS201") == RegistrationStatus::COURSE_FULL);
+    // Already enrolled comes before capacity
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::ALREADY_ENROLLED);
+    // The deadline comes before everything
+    clock.set(3000);
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::REGISTRATION_CLOSED);
+    CHECK(reg.tryRegisterStudent(carol, "CS201") == RegistrationStatus::REGISTRATION_CLOSED);
+}
+
+void testCustomRuleSet() {
+    CourseRegistration reg;
+    const time_t deadline = time(nullptr) + 86400;
+    reg.addCourse("CS101", "Programming", 10, {}, deadline);
+    reg.addCourse("CS201", "Data Structures", 10, {"CS101"}, deadline);
+    reg.addCourse("MATH101", "Calculus", 10, {}, deadline);
+    reg.addCourse("PHYS101", "Mechanics", 10, {}, deadline);
+    Student dave("S4", "Dave", "CSE");
+
+    // A summer term without prerequisite checks admits a student the default set refuses
+    using SummerTermChecks = CheckPipeline<DeadlineCheck, AlreadyEnrolledCheck, CapacityCheck>;
+    CHECK(reg.tryRegisterStudent(dave, "CS201") == RegistrationStatus::PREREQ_NOT_MET);
+    CHECK(reg.tryRegisterStudentWith<SummerTermChecks>(dave, "CS201") == RegistrationStatus::SUCCESS);
+
+    // An added check runs in its slot, and its failure stops the checks after it
+    using LoadCappedChecks = CheckPipeline<DeadlineCheck, AlreadyEnrolledCheck, CourseLoadCheck,
+                                           CapacityCheck, ProbeCheck>;
+    calls.clear();
+    CHECK(reg.tryRegisterStudentWith<LoadCappedChecks>(dave, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(calls == (std::vector<std::string>{"load", "probe"}));
+    calls.clear();
+    CHECK(reg.tryRegisterStudentWith<LoadCappedChecks>(dave, "PHYS101") == RegistrationStatus::TIME_CONFLICT);
+    CHECK(calls == (std::vector<std::string>{"load"}));
+    CHECK(reg.getEnrollmentCount("PHYS101") == 0);
+
+    // A check listed before it still wins: ALREADY_ENROLLED, not TIME_CONFLICT
+    calls.clear();
+    CHECK(reg.tryRegisterStudentWith<LoadCappedChecks>(dave, "MATH101") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(calls.empty());
+}
+
+} // namespace
+
+int main() {
+    testOrderAndShortCircuit();
+    testDefaultOrder();
+    testCustomRuleSet();
+    return test::finish();
+}
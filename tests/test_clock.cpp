@@ -0,0 +1,123 @@
+/**
+ * @file test_clock.cpp
+ * @brief Tests the coarse clock and the deadline index
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A coarse clock must start at its source's time, pick up changes both
+ * on refresh() and from its background thread, and stop without waiting
+ * out its period. The deadline index must close courses in deadline
+ * order, keep a course open through the last second of its deadline,
+ * and close deadlines added after time has already moved past them.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "course_registration.h"
+#include "registration_clock.h"
+#include "test_util.h"
+
+namespace {
+
+void testCoarseRefresh() {
+    std::atomic<time_t> source{1000};
+    CoarseClock clock([&source] { return source.load(); }, std::chrono::milliseconds(5));
+    CHECK(clock.now() == 1000);
+
+    source.store(2000);
+    CHECK(clock.refresh() == 2000);
+    CHECK(clock.now() == 2000);
+
+    // The refresher thread picks up the next change on its own
+    source.store(3000);
+    auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (clock.now() != 3000 && std::chrono::steady_clock::now() < giveUp) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(clock.now() == 3000);
+}
+
+void testCoarseStop() {
+    auto started = std::chrono::steady_clock::now();
+    {
+        CoarseClock clock([] { return time_t(0); }, std::chrono::hours(1));
+        CHECK(clock.now() == 0);
+    }
+    CHECK(std::chrono::steady_clock::now() - started < std::chrono::seconds(5));
+}
+
+void testDeadlineOrder() {
+    const time_t deadlines[] = {40, 10, 30, 20, 20};
+    std::unique_ptr<std::atomic<bool>[]> closed(new std::atomic<bool>[5]);
+    DeadlineIndex index;
+    for (int i = 0; i < 5; ++i) {
+        closed[i].store(false);
+        index.add(deadlines[i], &closed[i]);
+    }
+    index.advance(11);
+    CHECK(closed[1] && !closed[3] && !closed[4] && !closed[2] && !closed[0]);
+    index.advance(21);
+    CHECK(closed[3] && closed[4] && !closed[2] && !closed[0]);
+    index.advance(35);
+    CHECK(closed[2] && !closed[0]);
+    index.advance(41);
+    CHECK(closed[0]);
+}
+
+void testDeadlineEqualsNow() {
+    std::atomic<bool> closed{false};
+    DeadlineIndex index;
+    index.add(100, &closed);
+    // The deadline is the last second at which registration is open
+    index.advance(100);
+    CHECK(!closed);
+    index.advance(101);
+    CHECK(closed);
+
+    // Through the engine, on the same boundary
+    ManualClock manual(1000);
+    CourseRegistration reg;
+    reg.setClock(&manual);
+    reg.addCourse("CS101", "Programming", 10, {}, 1000);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::SUCCESS);
+    manual.advance(1);
+    CHECK(reg.tryRegisterStudent(bob, "CS101") == RegistrationStatus::REGISTRATION_CLOSED);
+}
+
+void testAddAfterAdvance() {
+    std::atomic<bool> late{false};
+    std::atomic<bool> past{false};
+    std::atomic<bool> future{false};
+    DeadlineIndex index;
+    index.add(50, &late);
+    index.advance(100);
+    CHECK(late);
+
+    // Added once time is already beyond it: closed by the next advance
+    index.add(60, &past);
+    index.add(200, &future);
+    CHECK(!past);
+    index.advance(100);
+    CHECK(past && !future);
+    index.advance(200);
+    CHECK(!future);
+    index.advance(201);
+    CHECK(future);
+}
+
+} // namespace
+
+int main() {
+    testCoarseRefresh();
+    testCoarseStop();
+    testDeadlineOrder();
+    testDeadlineEqualsNow();
+    testAddAfterAdvance();
+    return test::finish();
+}
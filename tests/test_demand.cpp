@@ -0,0 +1,158 @@
+/**
+ * @file test_demand.cpp
+ * @brief Tests demand estimates against exact counts
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Over a skewed stream of attempts, no estimate may fall below the true
+ * count, nearly all must stay within the sketch's e/kWidth error bound,
+ * and the heaviest courses of a status must come back from topK()
+ * heaviest first. Concurrent recording must lose no counts, and the
+ * engine must count register, cart and swap attempts under the status
+ * each ended with.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "course_registration.h"
+#include "demand_tracker.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Skewed attempts over 3000 courses: course i drawn with weight 1/(i+1) */
+std::vector<std::string> makeStream(size_t length) {
+    std::vector<double> weights;
+    for (int i = 0; i < 3000; ++i) {
+        weights.push_back(1.0 / (i + 1));
+    }
+    std::mt19937 rng(11);
+    std::discrete_distribution<int> pick(weights.begin(), weights.end());
+    std::vector<std::string> stream;
+    for (size_t i = 0; i < length; ++i) {
+        stream.push_back("C" + std::to_string(pick(rng)));
+    }
+    return stream;
+}
+
+void testEstimates() {
+    const std::vector<std::string> stream = makeStream(200000);
+    DemandTracker demand;
+    std::map<std::string, uint64_t> exact;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        // Every tenth attempt is turned away, so two statuses share the sketch
+        RegistrationStatus status = i % 10 == 0 ? RegistrationStatus::COURSE_FULL : RegistrationStatus::SUCCESS;
+        demand.record(stream[i], status);
+        if (status == RegistrationStatus::SUCCESS) {
+            ++exact[stream[i]];
+        }
+    }
+
+    const double bound = std::exp(1.0) / DemandTracker::kWidth * static_cast<double>(stream.size());
+    size_t over = 0;
+    for (const auto& course : exact) {
+        uint64_t estimate = demand.estimate(course.first, RegistrationStatus::SUCCESS);
+        CHECK(estimate >= course.second);
+        if (static_cast<double>(estimate - course.second) > bound) {
+            ++over;
+        }
+    }
+    // The bound holds with probability 1 - e^-kDepth per course
+    CHECK(over * 20 < exact.size());
+    CHECK(demand.estimate("NOPE101", RegistrationStatus::PREREQ_NOT_MET) == 0);
+
+    std::vector<std::pair<uint64_t, std::string>> heaviest;
+    for (const auto& course : exact) {
+        heaviest.emplace_back(course.second, course.first);
+    }
+    std::sort(heaviest.rbegin(), heaviest.rend());
+    std::vector<CourseDemand> top = demand.topK(RegistrationStatus::SUCCESS, 5);
+    CHECK(top.size() == 5);
+    for (size_t i = 0; i < top.size() && i < heaviest.size(); ++i) {
+        // The five heaviest are far apart, well beyond the sketch error
+        CHECK(top[i].courseCode == heaviest[i].second);
+        CHECK(top[i].attempts >= heaviest[i].first);
+    }
+    CHECK(demand.topK(RegistrationStatus::SUCCESS, 1000).size() <= DemandTracker::kTopCapacity);
+    CHECK(demand.topK(RegistrationStatus::UNKNOWN_COURSE, 5).empty());
+}
+
+void testConcurrentRecording() {
+    const std::vector<std::string> stream = makeStream(20000);
+    DemandTracker demand;
+    // More threads than shards, so some shards are shared
+    const int threadCount = DemandTracker::kShardCount + 4;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&demand, &stream]() {
+            for (const std::string& code : stream) {
+                demand.record(code, RegistrationStatus::COURSE_FULL);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const uint64_t first = static_cast<uint64_t>(std::count(stream.begin(), stream.end(), "C0"));
+    CHECK(demand.estimate("C0", RegistrationStatus::COURSE_FULL) >= threadCount * first);
+    std::vector<CourseDemand> top = demand.topK(RegistrationStatus::COURSE_FULL, 1);
+    CHECK(top.size() == 1 && top[0].courseCode == "C0");
+
+    // A lone key shares no counter, so the shards must sum to its exact count
+    DemandTracker lone;
+    threads.clear();
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&lone]() {
+            for (int i = 0; i < 1000; ++i) {
+                lone.record("CS101", RegistrationStatus::SUCCESS);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK(lone.estimate("CS101", RegistrationStatus::SUCCESS) == uint64_t(threadCount) * 1000);
+    top = lone.topK(RegistrationStatus::SUCCESS, 5);
+    CHECK(top.size() == 1 && top[0].attempts == uint64_t(threadCount) * 1000);
+}
+
+void testEngine() {
+    CourseRegistration reg;
+    const time_t deadline = time(nullptr) + 86400;
+    reg.addCourse("CS101", "Programming", 1, {}, deadline);
+    reg.addCourse("CS201", "Data Structures", 5, {"CS101"}, deadline);
+    reg.addCourse("MATH101", "Calculus", 5, {}, deadline);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    Student carol("S3", "Carol", "CSE");
+
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(bob, "CS101") == RegistrationStatus::COURSE_FULL);
+    CHECK(!reg.registerCart(carol, {"MATH101", "CS101"}).committed);
+    CHECK(reg.swapCourse(alice, "CS101", "CS101") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.swapCourse(bob, "MATH101", "CS201") == RegistrationStatus::PREREQ_NOT_MET);
+
+    CHECK(reg.estimateDemand("CS101", RegistrationStatus::SUCCESS) >= 1);
+    CHECK(reg.estimateDemand("CS101", RegistrationStatus::COURSE_FULL) >= 2);
+    CHECK(reg.estimateDemand("CS101", RegistrationStatus::ALREADY_ENROLLED) >= 1);
+    CHECK(reg.estimateDemand("CS201", RegistrationStatus::PREREQ_NOT_MET) >= 1);
+    std::vector<CourseDemand> full = reg.getTopDemand(RegistrationStatus::COURSE_FULL, 5);
+    CHECK(!full.empty() && full[0].courseCode == "CS101");
+}
+
+} // namespace
+
+int main() {
+    testEstimates();
+    testConcurrentRecording();
+    testEngine();
+    return test::finish();
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_history.cpp
+ * @brief Tests the history store against a scalar filter, and its rewrites
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Every query must return exactly the enrollments a plain loop over the
+ * written records selects, while the term and block zone maps skip the
+ * partitions that cannot match. Rewriting a store must replace it
+ * whole: a store already open keeps its old contents. A header whose
+ * string table lies outside the file must be refused.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+#include "history_store.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief One written enrollment with its term */
+struct Written {
+    int year;
+    TermSeason season;
+    HistoryRecord record;
+};
+
+/** @brief Returns whether a scalar evaluation of @p query selects @p row */
+bool matches(const HistoryQuery& query, const Written& row) {
+    return (query.courseCode.empty() || query.courseCode == row.record.courseCode) &&
+           (query.seasons & HistoryQuery::seasonBit(row.season)) && row.year >= query.fromYear &&
+           row.year <= query.toYear && row.record.grade >= query.minGrade &&
+           row.record.grade < query.maxGrade && row.record.cgpa >= query.minCgpa &&
+           row.record.cgpa < query.maxCgpa;
+}
+
+/** @brief Sort key of a row, to compare result sets */
+std::tuple<int, int, std::string, std::string, float, float> key(int year, TermSeason season,
+                                                                 const std::string& studentId,
+                                                                 const std::string& courseCode,
+                                                                 float grade, float cgpa) {
+    return std::make_tuple(year, static_cast<int>(season), studentId, courseCode, grade, cgpa);
+}
+
+/** @brief Checks find() and count() against the scalar filter */
+void checkQuery(const HistoryStore& store, const std::vector<Written>& written, const HistoryQuery& query) {
+    std::vector<std::tuple<int, int, std::string, std::string, float, float>> expected;
+    for (const Written& row : written) {
+        if (matches(query, row)) {
+            expected.push_back(key(row.year, row.season, row.record.studentId, row.record.courseCode,
+                                   row.record.grade, row.record.cgpa));
+        }
+    }
+    std::vector<std::tuple<int, int, std::string, std::string, float, float>> actual;
+    for (const HistoryRow& row : store.find(query)) {
+        actual.push_back(key(row.year, row.season, row.studentId, row.courseCode, row.grade, row.cgpa));
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    CHECK(actual == expected);
+    CHECK(store.count(query) == expected.size());
+}
+
+/** @brief Three terms of 40 courses with 300 students each */
+std::vector<Written> makeHistory(HistoryStoreWriter& writer) {
+    std::vector<Written> written;
+    const std::vector<std::pair<int, TermSeason>> terms = {
+        {2024, TermSeason::FALL}, {2025, TermSeason::SPRING}, {2025, TermSeason::FALL}};
+    for (size_t t = 0; t < terms.size(); ++t) {
+        std::vector<HistoryRecord> records;
+        for (int course = 0; course < 40; ++course) {
+            for (int student = 0; student < 300; ++student) {
+                int mix = (student * 7 + course * 13 + static_cast<int>(t) * 29) % 101;
+                records.push_back({"S" + std::to_string(student), "C" + std::to_string(100 + course),
+                                   mix / 10.0f, 4.0f + (student % 61) / 10.0f});
+                written.push_back({terms[t].first, terms[t].second, records.back()});
+            }
+        }
+        writer.addTerm(terms[t].first, terms[t].second, records);
+    }
+    return written;
+}
+
+void testQueries(const std::string& path) {
+    HistoryStoreWriter writer;
+    std::vector<Written> written = makeHistory(writer);
+    writer.write(path);
+    HistoryStore store(path);
+    CHECK(store.termCount() == 3);
+    CHECK(store.rowCount() == written.size());
+
+    HistoryQuery all;
+    checkQuery(store, written, all);
+
+    HistoryQuery course;
+    course.courseCode = "C117";
+    checkQuery(store, written, course);
+    HistoryScanStats stats;
+    store.count(course, &stats);
+    // Rows are sorted by course, so most blocks hold other courses only
+    CHECK(stats.blocksSkipped > 0);
+    CHECK(stats.blocksScanned <= 3 * 2);
+
+    HistoryQuery fall;
+    fall.seasons = HistoryQuery::seasonBit(TermSeason::FALL);
+    fall.fromYear = 2025;
+    fall.maxCgpa = 6.0f;
+    checkQuery(store, written, fall);
+    stats = HistoryScanStats();
+    store.count(fall, &stats);
+    CHECK(stats.termsSkipped == 2);
+
+    HistoryQuery grades;
+    grades.courseCode = "C100";
+    grades.minGrade = 5.0f;
+    grades.maxGrade = 7.5f;
+    grades.minCgpa = 5.0f;
+    checkQuery(store, written, grades);
+
+    HistoryQuery none;
+    none.courseCode = "NOPE";
+    CHECK(store.find(none).empty());
+    none = HistoryQuery();
+    none.minCgpa = 20.0f;
+    stats = HistoryScanStats();
+    CHECK(store.count(none, &stats) == 0);
+    CHECK(stats.termsSkipped == 3 && stats.rowsScanned == 0);
+}
+
+void testRewrite(const std::string& path) {
+    HistoryStore before(path);
+    const uint64_t rows = before.rowCount();
+
+    HistoryStoreWriter writer;
+    writer.addTerm(2026, TermSeason::SPRING, {{"S1", "MATH201", 7.5f, 6.8f}});
+    writer.write(path);
+
+    // The open store still maps the old file; a new one sees the new file
+    CHECK(before.rowCount() == rows);
+    HistoryQuery all;
+    CHECK(before.count(all) == rows);
+    HistoryStore after(path);
+    CHECK(after.rowCount() == 1);
+    std::vector<HistoryRow> found = after.find(all);
+    CHECK(found.size() == 1 && found[0].studentId == "S1" && found[0].year == 2026);
+
+    // No temporary file is left beside the store
+    CHECK(!std::filesystem::exists(path + ".tmp." + std::to_string(::getpid())));
+}
+
+void testCorruptStringTable(const std::string& path) {
+    // Point the course string table past the end of the address space
+    std::string image;
+    {
+        std::ifstream in(path, std::ios::binary);
+        image.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const size_t courseStringsField = 80; // offset of courseStringsOffset in the header
+    CHECK(image.size() > courseStringsField + 8);
+    const uint64_t huge = UINT64_MAX - 3;
+    std::memcpy(&image[courseStringsField], &huge, sizeof(huge));
+    const std::string corrupt = path + ".corrupt";
+    {
+        std::ofstream out(corrupt, std::ios::binary | std::ios::trunc);
+        out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    }
+    bool threw = false;
+    try {
+        HistoryStore store(corrupt);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::filesystem::remove(corrupt);
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "test_history." + std::to_string(::getpid()) + ".crh";
+    testQueries(path);
+    testRewrite(path);
+    testCorruptStringTable(path);
+    std::filesystem::remove(path);
+    return test::finish();
+}
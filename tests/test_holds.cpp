@@ -0,0 +1,252 @@
+/**
+ * @file test_holds.cpp
+ * @brief Tests the timer wheel and timed seat holds
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * The wheel must fire exactly the timers a sorted list of pending expiries
+ * says are due, across every level, and never a cancelled one. A held
+ * seat must be taken for everybody but its holder until the hold is
+ * claimed, released or lapses on the engine clock, and a renewal must
+ * outlive the timer it replaced. A held section seat is taken for the
+ * parent code as well, and a hold through the parent code lands in an
+ * open section that the parent code then registers, renews, releases and
+ * reports.
+ */
+
+#include <algorithm>
+#include <ctime>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "course_registration.h"
+#include "registration_clock.h"
+#include "test_util.h"
+#include "timer_wheel.h"
+
+namespace {
+
+void testWheel() {
+    std::mt19937_64 rng(42);
+    TimerWheel<int> wheel(1000);
+    std::map<TimerId, std::pair<time_t, int>> pending;
+    std::vector<time_t> expiries;
+    time_t now = 1000;
+    int next = 0;
+
+    for (int round = 0; round < 2000; ++round) {
+        // Mix near and far timers so every level sees traffic
+        const int kind = static_cast<int>(rng() % 10);
+        if (kind < 6) {
+            const time_t span = kind < 3 ? 64 : (kind < 5 ? 4096 : 1 << 20);
+            const time_t expiry = now + static_cast<time_t>(rng() % span);
+            pending[wheel.schedule(expiry, next)] = {expiry, next};
+            expiries.push_back(expiry);
+            ++next;
+        } else if (kind < 8 && !pending.empty()) {
+            auto it = pending.begin();
+            std::advance(it, static_cast<long>(rng() % pending.size()));
+            CHECK(wheel.cancel(it->first));
+            CHECK(!wheel.cancel(it->first));
+            pending.erase(it);
+        } else {
+            now += static_cast<time_t>(rng() % (kind == 8 ? 50 : 20000));
+            std::vector<std::pair<TimerId, int>> fired;
+            wheel.advance(now, fired);
+            std::vector<int> expected;
+            for (auto it = pending.begin(); it != pending.end();) {
+                if (it->second.first <= now) {
+                    expected.push_back(it->second.second);
+                    it = pending.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            std::vector<int> actual;
+            for (size_t i = 0; i < fired.size(); ++i) {
+                actual.push_back(fired[i].second);
+                CHECK(!wheel.cancel(fired[i].first));
+                CHECK(i == 0 || expiries[fired[i - 1].second] <= expiries[fired[i].second]);
+            }
+            std::sort(expected.begin(), expected.end());
+            std::sort(actual.begin(), actual.end());
+            CHECK(actual == expected);
+        }
+        CHECK(wheel.size() == pending.size());
+        time_t earliest = std::numeric_limits<time_t>::max();
+        for (const auto& timer : pending) {
+            earliest = std::min(earliest, timer.second.first);
+        }
+        CHECK(wheel.nextExpiryBound() <= earliest);
+    }
+}
+
+/** @brief Returns the published seats left in @p courseCode */
+int seatsLeft(const CourseRegistration& reg, const std::string& courseCode) {
+    return reg.tryGetSeatAvailability(courseCode).value.seatsLeft;
+}
+
+void testHolds() {
+    ManualClock clock(1000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    reg.addCourse("CS101", "Programming", 2, {}, 5000);
+    reg.addCourse("MATH101", "Calculus", 0, {}, 5000);
+    reg.addSection("MATH101", "MATH101-1", 1);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    Student carol("S3", "Carol", "CSE");
+
+    CHECK(reg.tryRegisterStudent(bob, "CS101") == RegistrationStatus::SUCCESS);
+    CourseQueryResult<time_t> hold = reg.holdSeat(alice, "CS101", 60);
+    CHECK(hold.ok() && hold.value == 1060);
+    CHECK(seatsLeft(reg, "CS101") == 0);
+    CHECK(reg.tryGetSeatAvailability("CS101").value.held == 1);
+
+    // The held seat is taken for everybody but its holder
+    CHECK(reg.tryRegisterStudent(carol, "CS101") == RegistrationStatus::COURSE_FULL);
+    CHECK(reg.holdSeat(carol, "CS101", 60).status == RegistrationStatus::COURSE_FULL);
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getHoldExpiry("S1", "CS101").status == RegistrationStatus::NOT_ENROLLED);
+    CHECK(reg.tryGetSeatAvailability("CS101").value.held == 0);
+    CHECK(reg.getEnrollmentCount("CS101") == 2);
+
+    // A renewal outlives the timer it replaced
+    CHECK(reg.holdSeat(carol, "MATH101-1", 60).value == 1060);
+    clock.set(1030);
+    CHECK(reg.holdSeat(carol, "MATH101-1", 60).value == 1090);
+    clock.set(1060);
+    reg.expireHolds();
+    CHECK(reg.getHoldExpiry("S3", "MATH101-1").value == 1090);
+    CHECK(reg.tryRegisterStudent(bob, "MATH101-1") == RegistrationStatus::COURSE_FULL);
+
+    // A lapsed hold reads as gone before and after it is released
+    clock.set(1090);
+    CHECK(reg.getHoldExpiry("S3", "MATH101-1").status == RegistrationStatus::NOT_ENROLLED);
+    reg.expireHolds();
+    CHECK(seatsLeft(reg, "MATH101-1") == 1);
+    CHECK(reg.tryRegisterStudent(bob, "MATH101-1") == RegistrationStatus::SUCCESS);
+
+    // Released holds free their seat at once
+    reg.addCourse("PHYS101", "Mechanics", 1, {}, 5000);
+    CHECK(reg.holdSeat(carol, "PHYS101", 600).ok());
+    CHECK(!reg.releaseHold("S1", "PHYS101"));
+    CHECK(reg.releaseHold("S3", "PHYS101"));
+    CHECK(!reg.releaseHold("S3", "PHYS101"));
+    CHECK(seatsLeft(reg, "PHYS101") == 1);
+
+    // A sectioned parent with no seat left, or an unknown course, cannot be held
+    CHECK(reg.holdSeat(carol, "MATH101", 60).status == RegistrationStatus::COURSE_FULL);
+    CHECK(reg.holdSeat(carol, "NOPE101", 60).status == RegistrationStatus::UNKNOWN_COURSE);
+    CHECK(reg.getHoldExpiry("S3", "NOPE101").status == RegistrationStatus::UNKNOWN_COURSE);
+    bool threw = false;
+    try {
+        reg.holdSeat(carol, "PHYS101", 0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+void testSectionHolds() {
+    ManualClock clock(1000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    reg.addCourse("MATH101", "Calculus", 0, {}, 5000);
+    reg.addSection("MATH101", "MATH101-1", 1);
+    reg.addSection("MATH101", "MATH101-2", 1);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    Student carol("S3", "Carol", "CSE");
+
+    // A section whose seat is held is full to the parent code too
+    CHECK(reg.holdSeat(alice, "MATH101-1", 60).ok());
+    CHECK(!reg.isCourseFull("MATH101"));
+    CHECK(reg.tryRegisterStudent(carol, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getSection("S3", "MATH101").value == "MATH101-2");
+    CHECK(reg.isCourseFull("MATH101"));
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::COURSE_FULL);
+
+    // Releasing the hold frees the section for the parent code
+    CHECK(reg.releaseHold("S1", "MATH101-1"));
+    CHECK(!reg.isCourseFull("MATH101"));
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getSection("S2", "MATH101").value == "MATH101-1");
+}
+
+/** @brief Returns the section of MATH101 in which @p studentId holds a seat, or "" */
+std::string heldSection(const CourseRegistration& reg, const std::string& studentId) {
+    for (const char* code : {"MATH101-1", "MATH101-2", "MATH101-E"}) {
+        if (reg.getHoldExpiry(studentId, code).ok()) {
+            return code;
+        }
+    }
+    return "";
+}
+
+void testParentHolds() {
+    ManualClock clock(1000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    reg.addCourse("MATH101", "Calculus", 0, {}, 5000);
+    reg.addSection("MATH101", "MATH101-1", 2);
+    reg.addSection("MATH101", "MATH101-2", 2);
+    reg.addSection("MATH101", "MATH101-E", 10, "ECE");
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    Student carol("S3", "Carol", "CSE");
+    Student dave("S4", "Dave", "CSE");
+
+    // The parent code holds a seat in a section open to the department
+    CHECK(reg.holdSeat(alice, "MATH101", 60).value == 1060);
+    const std::string held = heldSection(reg, "S1");
+    CHECK(held == "MATH101-1" || held == "MATH101-2");
+    CHECK(reg.getHoldExpiry("S1", "MATH101").value == 1060);
+
+    // Holding again renews that hold instead of taking a second seat
+    clock.set(1030);
+    CHECK(reg.holdSeat(alice, "MATH101", 60).value == 1090);
+    CHECK(reg.getHoldExpiry("S1", held).value == 1090);
+    CHECK(reg.tryGetSeatAvailability(held).value.held == 1);
+
+    // Registering through the parent code takes the held seat
+    CHECK(reg.tryRegisterStudent(alice, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getSection("S1", "MATH101").value == held);
+    CHECK(reg.tryGetSeatAvailability(held).value.held == 0);
+    CHECK(reg.getHoldExpiry("S1", "MATH101").status == RegistrationStatus::NOT_ENROLLED);
+    CHECK(reg.holdSeat(alice, "MATH101", 60).status == RegistrationStatus::ALREADY_ENROLLED);
+
+    // Released and lapsed holds are found through the parent code too
+    CHECK(reg.holdSeat(bob, "MATH101", 60).ok());
+    CHECK(reg.releaseHold("S2", "MATH101"));
+    CHECK(!reg.releaseHold("S2", "MATH101"));
+    CHECK(heldSection(reg, "S2").empty());
+    CHECK(reg.holdSeat(carol, "MATH101", 60).ok());
+    clock.set(1090);
+    reg.expireHolds();
+    CHECK(reg.getHoldExpiry("S3", "MATH101").status == RegistrationStatus::NOT_ENROLLED);
+    CHECK(!reg.releaseHold("S3", "MATH101"));
+
+    // Once the open sections are taken, the reserved one is not offered
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(carol, "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.holdSeat(dave, "MATH101", 60).ok());
+    CHECK(reg.holdSeat(Student("S5", "Erin", "CSE"), "MATH101", 60).status ==
+          RegistrationStatus::COURSE_FULL);
+    CHECK(reg.holdSeat(Student("S6", "Frank", "ECE"), "MATH101", 60).ok());
+    CHECK(heldSection(reg, "S6") == "MATH101-E");
+}
+
+} // namespace
+
+int main() {
+    testWheel();
+    testHolds();
+    testSectionHolds();
+    testParentHolds();
+    return test::finish();
+}
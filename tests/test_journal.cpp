@@ -0,0 +1,223 @@
+/**
+ * @file test_journal.cpp
+ * @brief Tests journal replay and recovery from a torn tail
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * An engine journals a few roster changes; the records read back must
+ * rebuild the same rosters in a fresh engine. A crash mid-append is then
+ * simulated by leaving half a record, or a record with a bad checksum,
+ * at the end of the file: read() must stop before it, and reopening the
+ * journal must cut it off and continue numbering after the last intact
+ * record. IDs too long for a record must be refused before they reach
+ * an engine, and fail the journal rather than throw if they reach one;
+ * a failed journal drops the records appended after it.
+ */
+
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "course_registration.h"
+#include "roster_snapshot.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Appends raw bytes to the end of a file */
+void appendBytes(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+/** @brief Reads a whole file */
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/** @brief Replaces a file's contents */
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+/** @brief Returns the file offset of the last record of a journal image */
+size_t lastRecordOffset(const std::string& image) {
+    size_t offset = 8;
+    size_t last = offset;
+    while (offset + 8 <= image.size()) {
+        const unsigned char* length = reinterpret_cast<const unsigned char*>(&image[offset]);
+        last = offset;
+        offset += 8 + (length[0] | (length[1] << 8) | (length[2] << 16) | (uint32_t(length[3]) << 24));
+    }
+    return last;
+}
+
+/** @brief Adds the courses every engine of this test uses */
+void addCatalog(CourseRegistration& reg) {
+    const time_t deadline = time(nullptr) + 86400;
+    reg.addCourse("CS101", "Programming", 10, {}, deadline);
+    reg.addCourse("MATH101", "Calculus", 10, {}, deadline);
+}
+
+/** @brief Returns a course's roster as read by a fresh snapshot */
+std::set<std::string> rosterOf(const CourseRegistration& reg, const std::string& courseCode) {
+    return reg.openSnapshot().getRoster(courseCode).value;
+}
+
+void testReplay(JournalBackend backend, const std::string& path) {
+    std::filesystem::remove(path);
+    std::vector<Student> students = {Student("S1", "Alice", "CSE"), Student("S2", "Bob", "CSE"),
+                                     Student("S3", "Carol", "CSE")};
+    std::set<std::string> cs101;
+    std::set<std::string> math101;
+    {
+        CourseRegistration reg;
+        addCatalog(reg);
+        JournalOptions options;
+        options.backend = backend;
+        reg.enableJournal(path, options);
+        for (Student& student : students) {
+            CHECK(reg.tryRegisterStudent(student, "CS101") == RegistrationStatus::SUCCESS);
+        }
+        CHECK(reg.tryRegisterStudent(students[0], "MATH101") == RegistrationStatus::SUCCESS);
+        CHECK(reg.withdrawStudent("S2", "CS101"));
+        reg.getJournal().sync();
+        CHECK(reg.getJournal().durablePosition() == 5);
+        cs101 = rosterOf(reg, "CS101");
+        math101 = rosterOf(reg, "MATH101");
+    }
+
+    std::vector<JournalRecord> records = RegistrationJournal::read(path);
+    CHECK(records.size() == 5);
+    for (size_t i = 0; i < records.size(); ++i) {
+        CHECK(records[i].position == i + 1);
+    }
+    CHECK(records.back().kind == EnrollmentEventKind::WITHDRAWN);
+    CHECK(records.back().courseCode == "CS101" && records.back().studentId == "S2");
+
+    // Replaying the records into an empty engine rebuilds the same rosters
+    CourseRegistration replica;
+    addCatalog(replica);
+    std::map<std::string, Student> directory;
+    for (const JournalRecord& record : records) {
+        if (record.kind == EnrollmentEventKind::ENROLLED) {
+            Student& student = directory.try_emplace(record.studentId, record.studentId, "", "CSE").first->second;
+            CHECK(replica.tryRegisterStudent(student, record.courseCode) == RegistrationStatus::SUCCESS);
+        } else {
+            CHECK(replica.withdrawStudent(record.studentId, record.courseCode));
+        }
+    }
+    CHECK(rosterOf(replica, "CS101") == cs101);
+    CHECK(rosterOf(replica, "MATH101") == math101);
+    CHECK(cs101 == (std::set<std::string>{"S1", "S3"}));
+}
+
+void testTornTail(const std::string& path) {
+    const std::string intact = readFile(path);
+    const std::vector<JournalRecord> before = RegistrationJournal::read(path);
+    const size_t last = lastRecordOffset(intact);
+    const std::string lastRecord = intact.substr(last);
+
+    // Half of a record, as left by a crash in the middle of a write
+    appendBytes(path, lastRecord.substr(0, lastRecord.size() / 2));
+    CHECK(RegistrationJournal::read(path).size() == before.size());
+
+    // A whole record whose checksum does not match its body
+    std::string damaged = intact;
+    damaged[damaged.size() - 1] ^= 0x5a;
+    writeFile(path, damaged);
+    CHECK(RegistrationJournal::read(path).size() == before.size() - 1);
+
+    // Reopening cuts the torn tail and numbers new records after the intact ones
+    writeFile(path, intact + lastRecord.substr(0, lastRecord.size() / 2));
+    {
+        JournalOptions options;
+        options.backend = JournalBackend::SYNCHRONOUS;
+        RegistrationJournal journal(path, options);
+        CHECK(std::filesystem::file_size(path) == intact.size());
+        CHECK(journal.durablePosition() == before.size());
+        uint64_t position = journal.append(99, EnrollmentEventKind::ENROLLED, "MATH101", "S9");
+        CHECK(position == before.size() + 1);
+        journal.sync();
+    }
+    std::vector<JournalRecord> after = RegistrationJournal::read(path);
+    CHECK(after.size() == before.size() + 1);
+    CHECK(after.back().position == before.size() + 1);
+    CHECK(after.back().version == 99 && after.back().studentId == "S9");
+}
+
+void testOversizedFields(const std::string& path) {
+    const std::string huge(RegistrationJournal::kMaxFieldSize + 1, 'X');
+    bool threw = false;
+    try {
+        Student student(huge, "Huge", "CSE");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    CourseRegistration reg;
+    threw = false;
+    try {
+        reg.addCourse(huge, "Huge", 10, {}, time(nullptr) + 86400);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(reg.tryGetEnrollmentCount(huge).status == RegistrationStatus::UNKNOWN_COURSE);
+
+    // Past those checks, append reports a record that does not fit as a failure
+    for (JournalBackend backend : {JournalBackend::SYNCHRONOUS, JournalBackend::WRITER_THREAD}) {
+        std::filesystem::remove(path);
+        JournalOptions options;
+        options.backend = backend;
+        RegistrationJournal journal(path, options);
+        const uint64_t first = journal.append(1, EnrollmentEventKind::ENROLLED, "CS101", "S1");
+        journal.waitDurable(first);
+        uint64_t position = 0;
+        threw = false;
+        try {
+            position = journal.append(2, EnrollmentEventKind::ENROLLED, "CS101", huge);
+        } catch (...) {
+            threw = true;
+        }
+        CHECK(!threw && position == first + 1);
+        CHECK(journal.failed());
+        threw = false;
+        try {
+            journal.waitDurable(position);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+        // A failed journal drops later records instead of queueing them
+        const uint64_t after = journal.append(3, EnrollmentEventKind::ENROLLED, "CS101", "S2");
+        journal.waitIdle();
+        CHECK(after == position + 1);
+        CHECK(journal.durablePosition() == first);
+        CHECK(RegistrationJournal::read(path).size() == 1);
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "test_journal." + std::to_string(::getpid()) + ".log";
+    for (JournalBackend backend : {JournalBackend::SYNCHRONOUS, JournalBackend::WRITER_THREAD,
+                                   JournalBackend::AUTO}) {
+        testReplay(backend, path);
+    }
+    testTornTail(path);
+    testOversizedFields(path);
+    std::filesystem::remove(path);
+    return test::finish();
+}
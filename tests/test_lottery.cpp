@@ -0,0 +1,160 @@
+/**
+ * @file test_lottery.cpp
+ * @brief Tests batch lottery allocation against its serial dictatorship rules
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A lottery must be reproducible from its seed, never overfill a course,
+ * and leave no student envying a course ranked above their seat that
+ * still has a free one. Ineligible courses, courses a student already
+ * has, extra sections of one course and seats on hold must all be
+ * passed over, and multi-round draws must cap each student's seats.
+ */
+
+#include <algorithm>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "course_registration.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Course codes and seat counts shared by every lottery below */
+const std::map<std::string, int> kCapacities = {
+    {"CS101", 5}, {"MATH101", 8}, {"PHYS101", 6}, {"CHEM101", 4}, {"BIO101", 3}};
+
+/** @brief A catalog of kCapacities plus CS201, which requires CS101 */
+void addCatalog(CourseRegistration& reg) {
+    const time_t deadline = time(nullptr) + 86400;
+    for (const auto& course : kCapacities) {
+        reg.addCourse(course.first, course.first, course.second, {}, deadline);
+    }
+    reg.addCourse("CS201", "Data Structures", 10, {"CS101"}, deadline);
+}
+
+/** @brief 40 students with no courses yet */
+std::vector<std::unique_ptr<Student>> makeStudents() {
+    std::vector<std::unique_ptr<Student>> students;
+    for (int i = 0; i < 40; ++i) {
+        std::string id = "S" + std::to_string(i);
+        students.push_back(std::make_unique<Student>(id, id, "CSE"));
+    }
+    return students;
+}
+
+/** @brief Ranks CS201 first, then courses drawn so that CS101 and BIO101 are contested */
+std::vector<LotteryEntry> makeEntries(const std::vector<std::unique_ptr<Student>>& students) {
+    const std::vector<std::string> codes = {"CS101", "BIO101", "MATH101", "PHYS101", "CHEM101"};
+    std::vector<LotteryEntry> entries;
+    for (size_t i = 0; i < students.size(); ++i) {
+        std::vector<std::string> ranked = {"CS201", codes[i % 2], codes[2 + i % 3], codes[(i + 1) % 2]};
+        entries.push_back({students[i].get(), ranked});
+    }
+    return entries;
+}
+
+void testSingleRound() {
+    std::vector<std::unique_ptr<Student>> firstStudents = makeStudents();
+    std::vector<std::unique_ptr<Student>> secondStudents = makeStudents();
+    CourseRegistration first;
+    CourseRegistration second;
+    addCatalog(first);
+    addCatalog(second);
+    LotteryOptions options;
+    options.seed = 2026;
+    options.threads = 3;
+    std::vector<LotteryEntry> entries = makeEntries(firstStudents);
+    LotteryResult result = first.allocateLottery(entries, options);
+    options.threads = 1;
+    LotteryResult again = second.allocateLottery(makeEntries(secondStudents), options);
+    CHECK(result.assigned == again.assigned);
+    CHECK(result.choiceCounts == again.choiceCounts);
+
+    uint64_t seats = 0;
+    uint64_t unassigned = 0;
+    std::vector<uint64_t> choices(entries[0].rankedCourses.size(), 0);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const std::vector<std::string>& ranked = entries[i].rankedCourses;
+        CHECK(result.assigned[i].size() <= 1);
+        // CS201's prerequisite is never met, so it is never assigned
+        CHECK(std::find(result.assigned[i].begin(), result.assigned[i].end(), "CS201") ==
+              result.assigned[i].end());
+        size_t rank = ranked.size();
+        if (result.assigned[i].empty()) {
+            ++unassigned;
+        } else {
+            rank = static_cast<size_t>(std::find(ranked.begin(), ranked.end(), result.assigned[i][0]) -
+                                       ranked.begin());
+            CHECK(rank < ranked.size());
+            ++choices[rank];
+            ++seats;
+            std::vector<std::string> enrolled = entries[i].student->getEnrolledCourses();
+            CHECK(std::find(enrolled.begin(), enrolled.end(), result.assigned[i][0]) != enrolled.end());
+        }
+        // No course ranked above the seat still had room at the end
+        for (size_t better = 1; better < rank && better < ranked.size(); ++better) {
+            CHECK(first.getEnrollmentCount(ranked[better]) == kCapacities.at(ranked[better]));
+        }
+    }
+    for (const auto& course : kCapacities) {
+        CHECK(first.getEnrollmentCount(course.first) <= course.second);
+    }
+    CHECK(result.seatsAssigned == seats);
+    CHECK(result.studentsUnassigned == unassigned);
+    CHECK(choices[0] == 0);
+    for (size_t rank = 0; rank < choices.size() && rank < result.choiceCounts.size(); ++rank) {
+        CHECK(result.choiceCounts[rank] == choices[rank]);
+    }
+}
+
+void testMultiRound() {
+    std::vector<std::unique_ptr<Student>> students = makeStudents();
+    CourseRegistration reg;
+    addCatalog(reg);
+    reg.addCourse("ECON101", "Economics", 0, {}, time(nullptr) + 86400);
+    reg.addSection("ECON101", "ECON101-1", 20);
+    reg.addSection("ECON101", "ECON101-2", 20);
+
+    // S0 already has CS101, and a student outside the draw holds a BIO101 seat
+    Student holder("H1", "Holder", "CSE");
+    CHECK(reg.tryRegisterStudent(*students[0], "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.holdSeat(holder, "BIO101", 600).ok());
+
+    std::vector<LotteryEntry> entries = makeEntries(students);
+    for (LotteryEntry& entry : entries) {
+        entry.rankedCourses.push_back("ECON101-1");
+        entry.rankedCourses.push_back("ECON101-2");
+    }
+    LotteryOptions options;
+    options.seed = 7;
+    options.coursesPerStudent = 3;
+    LotteryResult result = reg.allocateLottery(entries, options);
+
+    int econ = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const std::vector<std::string>& assigned = result.assigned[i];
+        CHECK(assigned.size() <= 3);
+        const bool bothSections =
+            std::count(assigned.begin(), assigned.end(), "ECON101-1") +
+                std::count(assigned.begin(), assigned.end(), "ECON101-2") > 1;
+        CHECK(!bothSections);
+        econ += static_cast<int>(std::count(assigned.begin(), assigned.end(), "ECON101-1") +
+                                 std::count(assigned.begin(), assigned.end(), "ECON101-2"));
+    }
+    CHECK(std::count(result.assigned[0].begin(), result.assigned[0].end(), "CS101") == 0);
+    CHECK(reg.getEnrollmentCount("CS101") == 5);
+    // The held seat stays out of the draw
+    CHECK(reg.getEnrollmentCount("BIO101") == 2);
+    CHECK(reg.getEnrollmentCount("ECON101") == econ);
+}
+
+} // namespace
+
+int main() {
+    testSingleRound();
+    testMultiRound();
+    return test::finish();
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_metrics.cpp
+ * @brief Tests the latency histograms and the sharded metrics sink
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Every bucket must cover a contiguous range no wider than an eighth of
+ * its lower bound, and a percentile must report the upper bound of the
+ * bucket holding its rank, including ranks that land on a bucket edge.
+ * Samples recorded by more threads than there are shards must all reach
+ * the snapshot. The same file is built a second time with
+ * COURSE_REGISTRATION_METRICS=0, where the sink must record nothing.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+#include "course_registration.h"
+#include "registration_metrics.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Returns the smallest value that falls in @p bucket */
+uint64_t bucketLowerBound(int bucket) {
+    return bucket == 0 ? 0 : LatencyHistogram::bucketUpperBound(bucket - 1) + 1;
+}
+
+void testBucketBounds() {
+    for (uint64_t nanos = 0; nanos < LatencyHistogram::kSubBuckets; ++nanos) {
+        CHECK(LatencyHistogram::bucketOf(nanos) == static_cast<int>(nanos));
+    }
+    uint64_t misplaced = 0;
+    uint64_t tooWide = 0;
+    for (int bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+        uint64_t lower = bucketLowerBound(bucket);
+        uint64_t upper = LatencyHistogram::bucketUpperBound(bucket);
+        misplaced += LatencyHistogram::bucketOf(lower) != bucket || LatencyHistogram::bucketOf(upper) != bucket;
+        tooWide += upper < lower || upper - lower > lower / LatencyHistogram::kSubBuckets;
+    }
+    CHECK(misplaced == 0);
+    CHECK(tooWide == 0);
+    // The last bucket ends at the largest latency there is
+    CHECK(LatencyHistogram::bucketUpperBound(LatencyHistogram::kBucketCount - 1) ==
+          std::numeric_limits<uint64_t>::max());
+    CHECK(LatencyHistogram::bucketOf(std::numeric_limits<uint64_t>::max()) ==
+          LatencyHistogram::kBucketCount - 1);
+}
+
+void testPercentileEdges() {
+    LatencyHistogram empty;
+    CHECK(empty.percentile(0.5) == 0);
+
+    // 90 samples on the top edge of one bucket, 10 on the bottom edge of the next
+    const int bucket = LatencyHistogram::bucketOf(1000);
+    const uint64_t top = LatencyHistogram::bucketUpperBound(bucket);
+    const uint64_t nextBottom = top + 1;
+    LatencyHistogram histogram;
+    histogram.buckets[LatencyHistogram::bucketOf(top)] += 90;
+    histogram.buckets[LatencyHistogram::bucketOf(nextBottom)] += 10;
+    histogram.count = 100;
+    histogram.totalNanos = 90 * top + 10 * nextBottom;
+    CHECK(histogram.percentile(0.0) == top);
+    CHECK(histogram.percentile(0.9) == top);
+    CHECK(histogram.percentile(0.91) == LatencyHistogram::bucketUpperBound(bucket + 1));
+    CHECK(histogram.percentile(1.0) == LatencyHistogram::bucketUpperBound(bucket + 1));
+
+    // A single sample is reported within an eighth above its true value
+    uint64_t outOfBound = 0;
+    for (uint64_t nanos = 1; nanos < (uint64_t(1) << 40); nanos = nanos * 3 + 1) {
+        LatencyHistogram one;
+        one.buckets[LatencyHistogram::bucketOf(nanos)] = 1;
+        one.count = 1;
+        uint64_t reported = one.percentile(0.5);
+        outOfBound += reported < nanos || reported - nanos > nanos / LatencyHistogram::kSubBuckets;
+    }
+    CHECK(outOfBound == 0);
+}
+
+void testShardMerge() {
+    // Twice as many threads as shards, so some threads share one
+    const int threadCount = 32;
+    const uint64_t perThread = 5000;
+    RegistrationMetrics metrics;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&metrics, t] {
+            for (uint64_t i = 0; i < perThread; ++i) {
+                metrics.recordLatency(MetricOperation::REGISTER, 100 * (t + 1));
+                metrics.countStatus(t % 2 ? RegistrationStatus::SUCCESS : RegistrationStatus::COURSE_FULL);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    MetricsSnapshot snapshot = metrics.snapshot();
+    const LatencyHistogram& registers = snapshot.of(MetricOperation::REGISTER);
+    if (!RegistrationMetrics::enabled) {
+        CHECK(registers.count == 0 && registers.totalNanos == 0);
+        CHECK(snapshot.count(RegistrationStatus::SUCCESS) == 0);
+        return;
+    }
+    CHECK(registers.count == threadCount * perThread);
+    CHECK(registers.totalNanos == 100 * perThread * threadCount * (threadCount + 1) / 2);
+    std::vector<uint64_t> expected(LatencyHistogram::kBucketCount, 0);
+    for (int t = 0; t < threadCount; ++t) {
+        expected[LatencyHistogram::bucketOf(100 * (t + 1))] += perThread;
+    }
+    uint64_t wrongBuckets = 0;
+    for (int bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+        wrongBuckets += registers.buckets[bucket] != expected[bucket];
+    }
+    CHECK(wrongBuckets == 0);
+    CHECK(snapshot.count(RegistrationStatus::SUCCESS) == threadCount / 2 * perThread);
+    CHECK(snapshot.count(RegistrationStatus::COURSE_FULL) == threadCount / 2 * perThread);
+    CHECK(snapshot.of(MetricOperation::WITHDRAW).count == 0);
+}
+
+void testCompiledOut() {
+    CHECK(RegistrationMetrics::enabled == (COURSE_REGISTRATION_METRICS != 0));
+    RegistrationMetrics metrics;
+    {
+        RegistrationMetrics::ScopedTimer timer(metrics, MetricOperation::HOLD_SEAT);
+    }
+    MetricsSnapshot snapshot = metrics.snapshot();
+    CHECK(snapshot.of(MetricOperation::HOLD_SEAT).count == (RegistrationMetrics::enabled ? 1u : 0u));
+}
+
+} // namespace
+
+int main() {
+    testBucketBounds();
+    testPercentileEdges();
+    testShardMerge();
+    testCompiledOut();
+    return test::finish();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_protocol.cpp
+ * @brief Tests the server's wire format: round-trips and malformed frames
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ */
+
+#include <stdexcept>
+#include <string>
+#include "registration_protocol.h"
+#include "test_util.h"
+
+namespace {
+
+void testRequestRoundTrip() {
+    std::string wire;
+    encodeRequest({WireOpcode::REGISTER, 0xdeadbeef, "S12345", "CS101"}, wire);
+    encodeRequest({WireOpcode::QUERY, 7, "", "MATH201-3"}, wire);
+    CHECK(wire.size() == 2 * kRequestHeaderSize + 6 + 5 + 9);
+
+    WireRequest request;
+    size_t consumed = 0;
+    CHECK(decodeRequest(wire.data(), wire.size(), request, consumed) == DecodeResult::COMPLETE);
+    CHECK(consumed == kRequestHeaderSize + 6 + 5);
+    CHECK(request.opcode == WireOpcode::REGISTER && request.tag == 0xdeadbeef);
+    CHECK(request.studentId == "S12345" && request.courseCode == "CS101");
+
+    // Pipelined: the second frame follows the first
+    size_t offset = consumed;
+    CHECK(decodeRequest(wire.data() + offset, wire.size() - offset, request, consumed) == DecodeResult::COMPLETE);
+    CHECK(request.opcode == WireOpcode::QUERY && request.tag == 7);
+    CHECK(request.studentId.empty() && request.courseCode == "MATH201-3");
+    CHECK(offset + consumed == wire.size());
+}
+
+void testResponseRoundTrip() {
+    std::string wire;
+    encodeResponse({42, WireOpcode::QUERY, 0, 118, -1}, wire);
+    encodeResponse({43, WireOpcode::REGISTER, kStatusUnknownStudent, 0, 0}, wire);
+    CHECK(wire.size() == 2 * kResponseSize);
+
+    WireResponse first = decodeResponse(wire.data());
+    CHECK(first.tag == 42 && first.opcode == WireOpcode::QUERY && first.status == 0);
+    CHECK(first.enrolled == 118 && first.seatsLeft == -1);
+    WireResponse second = decodeResponse(wire.data() + kResponseSize);
+    CHECK(second.tag == 43 && second.status == kStatusUnknownStudent);
+}
+
+void testIncomplete() {
+    std::string wire;
+    encodeRequest({WireOpcode::WITHDRAW, 1, "S1", "CS101"}, wire);
+    WireRequest request;
+    size_t consumed = 0;
+    for (size_t size = 0; size < wire.size(); ++size) {
+        CHECK(decodeRequest(wire.data(), size, request, consumed) == DecodeResult::INCOMPLETE);
+    }
+    CHECK(decodeRequest(wire.data(), wire.size(), request, consumed) == DecodeResult::COMPLETE);
+}
+
+void testMalformed() {
+    WireRequest request;
+    size_t consumed = 0;
+
+    // Frame length shorter than the header
+    std::string shortFrame(kRequestHeaderSize, '\0');
+    shortFrame[0] = 4;
+    CHECK(decodeRequest(shortFrame.data(), shortFrame.size(), request, consumed) == DecodeResult::MALFORMED);
+
+    // Frame length over kMaxRequestSize, rejected before the body arrives
+    std::string longFrame(2, '\0');
+    longFrame[0] = static_cast<char>((kMaxRequestSize + 1) & 0xff);
+    longFrame[1] = static_cast<char>((kMaxRequestSize + 1) >> 8);
+    CHECK(decodeRequest(longFrame.data(), longFrame.size(), request, consumed) == DecodeResult::MALFORMED);
+
+    // Student ID length running past the end of the frame
+    std::string wire;
+    encodeRequest({WireOpcode::REGISTER, 1, "S1", "CS101"}, wire);
+    wire[3] = static_cast<char>(wire.size());
+    CHECK(decodeRequest(wire.data(), wire.size(), request, consumed) == DecodeResult::MALFORMED);
+
+    // An unknown opcode is framed correctly; the server answers kStatusBadOpcode
+    wire.clear();
+    encodeRequest({static_cast<WireOpcode>(9), 1, "S1", "CS101"}, wire);
+    CHECK(decodeRequest(wire.data(), wire.size(), request, consumed) == DecodeResult::COMPLETE);
+    CHECK(static_cast<uint8_t>(request.opcode) == 9);
+}
+
+void testEncodeLimits() {
+    std::string wire;
+    bool threw = false;
+    try {
+        encodeRequest({WireOpcode::REGISTER, 1, std::string(256, 'S'), "CS101"}, wire);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    threw = false;
+    try {
+        encodeRequest({WireOpcode::REGISTER, 1, "S1", std::string(kMaxRequestSize, 'C')}, wire);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(wire.empty());
+}
+
+} // namespace
+
+int main() {
+    testRequestRoundTrip();
+    testResponseRoundTrip();
+    testIncomplete();
+    testMalformed();
+    testEncodeLimits();
+    return test::finish();
+}
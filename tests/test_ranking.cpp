@@ -0,0 +1,258 @@
+/**
+ * @file test_ranking.cpp
+ * @brief Tests CGPA ranking, percentiles and department top lists against sorting
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * ranked() must match a stable sort of the students by CGPA, on both the
+ * single-threaded and the parallel radix path. Ranks, percentiles and
+ * department top lists must match counts taken over the same students,
+ * before and after CGPA updates, and the Fenwick tree must match plain
+ * prefix sums. A tracked student's CGPA updates must reach the ranking
+ * and a standing watchlist alike, with no call to update(), and
+ * untracking or reassigning a student must drop its old ID while later
+ * students keep their tie order.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "cgpa_ranking.h"
+#include "standing_watchlist.h"
+#include "test_util.h"
+
+namespace {
+
+const std::vector<std::string> kDepartments = {"CSE", "ECE", "MECH"};
+
+/** @brief IDs of @p students, highest CGPA first, ties in input order */
+std::vector<std::string> sortedIds(const std::vector<Student>& students, const std::string& department = "") {
+    std::vector<const Student*> order;
+    for (const Student& student : students) {
+        if (department.empty() || student.getDepartment() == department) {
+            order.push_back(&student);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const Student* a, const Student* b) { return a->getCGPA() > b->getCGPA(); });
+    std::vector<std::string> ids;
+    for (const Student* student : order) {
+        ids.push_back(student->getStudentId());
+    }
+    return ids;
+}
+
+/** @brief @p count students; with @p grid, CGPAs on a 1/8 grid so equal buckets mean equal CGPAs */
+std::vector<Student> makeStudents(size_t count, std::mt19937& rng, bool grid) {
+    std::vector<Student> students;
+    std::uniform_real_distribution<float> anyCgpa(0.0f, 10.0f);
+    for (size_t i = 0; i < count; ++i) {
+        Student student("S" + std::to_string(i), "Student", kDepartments[rng() % kDepartments.size()]);
+        student.updateCGPA(grid ? static_cast<float>(rng() % 81) / 8.0f : anyCgpa(rng));
+        students.push_back(student);
+    }
+    return students;
+}
+
+void testFenwick() {
+    std::mt19937 rng(3);
+    FenwickTree tree(100);
+    std::vector<int64_t> counts(100, 0);
+    for (int i = 0; i < 2000; ++i) {
+        size_t bucket = rng() % 100;
+        int64_t delta = counts[bucket] > 0 && rng() % 3 == 0 ? -1 : 1;
+        tree.add(bucket, delta);
+        counts[bucket] += delta;
+        size_t end = rng() % 101;
+        int64_t sum = 0;
+        for (size_t b = 0; b < end; ++b) {
+            sum += counts[b];
+        }
+        CHECK(tree.prefix(end) == sum);
+        // upperBound: first bucket whose running sum exceeds the target
+        int64_t target = static_cast<int64_t>(rng() % 1200);
+        size_t expected = 0;
+        for (int64_t running = 0; expected < 100; ++expected) {
+            running += counts[expected];
+            if (running > target) {
+                break;
+            }
+        }
+        CHECK(tree.upperBound(target) == expected);
+    }
+}
+
+void testRanked() {
+    std::mt19937 rng(45);
+    // Below and above kParallelThreshold, with arbitrary and tied CGPAs
+    for (size_t count : {size_t(0), size_t(1), size_t(1000), CgpaRanking::kParallelThreshold + 5000}) {
+        for (bool grid : {false, true}) {
+            std::vector<Student> students = makeStudents(count, rng, grid);
+            CgpaRanking ranking(students, 4);
+            CHECK(ranking.size() == count);
+            CHECK(ranking.ranked() == sortedIds(students));
+        }
+    }
+}
+
+void checkCounts(const CgpaRanking& ranking, const std::vector<Student>& students) {
+    for (size_t i = 0; i < students.size(); i += 7) {
+        size_t lower = 0;
+        size_t higher = 0;
+        for (const Student& other : students) {
+            lower += other.getCGPA() < students[i].getCGPA();
+            higher += other.getCGPA() > students[i].getCGPA();
+        }
+        const std::string& id = students[i].getStudentId();
+        CHECK(ranking.rankOf(id) == higher + 1);
+        double expected = 100.0 * static_cast<double>(lower) / static_cast<double>(students.size());
+        CHECK(std::abs(ranking.percentile(id) - expected) < 1e-9);
+    }
+    for (const std::string& department : kDepartments) {
+        std::vector<std::string> all = sortedIds(students, department);
+        for (size_t n : {size_t(0), size_t(1), size_t(10), all.size(), all.size() + 10}) {
+            std::vector<std::string> top(all.begin(), all.begin() + std::min(n, all.size()));
+            CHECK(ranking.topInDepartment(department, n) == top);
+        }
+    }
+    CHECK(ranking.topInDepartment("LAW", 5).empty());
+}
+
+void testUpdates() {
+    std::mt19937 rng(9);
+    std::vector<Student> students = makeStudents(3000, rng, true);
+    CgpaRanking ranking(students);
+    checkCounts(ranking, students);
+
+    for (int i = 0; i < 2000; ++i) {
+        Student& student = students[rng() % students.size()];
+        student.updateCGPA(static_cast<float>(rng() % 81) / 8.0f);
+        ranking.update(student);
+    }
+    // A student added later ranks behind earlier ones with the same CGPA
+    Student late("LATE", "Student", "CSE");
+    late.updateCGPA(10.0f);
+    ranking.update(late);
+    students.push_back(late);
+    CHECK(ranking.size() == students.size());
+    checkCounts(ranking, students);
+    CHECK(ranking.ranked() == sortedIds(students));
+
+    // An untracked student is re-ranked only by update()
+    const size_t lateRank = ranking.rankOf("LATE");
+    late.updateCGPA(0.0f);
+    CHECK(ranking.rankOf("LATE") == lateRank);
+    ranking.update(late);
+    CHECK(ranking.rankOf("LATE") > lateRank);
+
+    bool threw = false;
+    try {
+        ranking.rankOf("NOPE");
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+    threw = false;
+    try {
+        ranking.percentile("NOPE");
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+void testTrackedStudents() {
+    CgpaRanking ranking;
+    StandingWatchlist watchlist;
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    alice.updateCGPA(9.0f);
+    bob.updateCGPA(6.0f);
+    for (Student* student : {&alice, &bob}) {
+        ranking.track(*student);
+        watchlist.track(*student);
+    }
+    CHECK(ranking.ranked() == (std::vector<std::string>{"S1", "S2"}));
+
+    // One update reaches both observers
+    bob.updateCGPA(9.5f);
+    CHECK(ranking.ranked() == (std::vector<std::string>{"S2", "S1"}));
+    CHECK(ranking.topInDepartment("CSE", 1) == std::vector<std::string>{"S2"});
+    CHECK(watchlist.count(AcademicStanding::EXCELLENT) == 2);
+
+    // A change within a standing still re-ranks, without a watchlist entry
+    const uint64_t sequence = watchlist.lastSequence();
+    alice.updateCGPA(9.9f);
+    CHECK(ranking.rankOf("S1") == 1);
+    CHECK(watchlist.lastSequence() == sequence);
+
+    // Detaching one observer leaves the other attached
+    alice.removeCgpaObserver(&ranking);
+    alice.updateCGPA(4.0f);
+    CHECK(ranking.rankOf("S1") == 1);
+    CHECK(watchlist.members(AcademicStanding::PROBATION) == std::vector<std::string>{"S1"});
+
+    // Moving a tracked student carries both observers
+    Student moved(std::move(bob));
+    CHECK(moved.isObservedBy(&ranking) && moved.isObservedBy(&watchlist));
+    moved.updateCGPA(2.0f);
+    CHECK(ranking.rankOf("S2") == 2);
+    CHECK(watchlist.count(AcademicStanding::PROBATION) == 2);
+}
+
+void testUntrackAndAssign() {
+    CgpaRanking ranking;
+    std::vector<Student> students;
+    for (int i = 0; i < 4; ++i) {
+        students.emplace_back("S" + std::to_string(i), "Student", i % 2 ? "ECE" : "CSE");
+        students.back().updateCGPA(8.0f);
+    }
+    for (Student& student : students) {
+        ranking.track(student);
+    }
+    CHECK(ranking.untrack(students[1]));
+    CHECK(!ranking.untrack(students[1]));
+    students[1].updateCGPA(10.0f);
+    CHECK(ranking.size() == 3);
+    CHECK(ranking.ranked() == (std::vector<std::string>{"S0", "S2", "S3"}));
+    CHECK(ranking.topInDepartment("ECE", 5) == std::vector<std::string>{"S3"});
+
+    ranking.track(students[1]);
+    CHECK(ranking.ranked() == (std::vector<std::string>{"S1", "S0", "S2", "S3"}));
+
+    // Erasing S0 from the vector reassigns its slot; the rest keep their order
+    students.erase(students.begin());
+    CHECK(ranking.ranked() == (std::vector<std::string>{"S1", "S2", "S3"}));
+    CHECK(ranking.rankOf("S2") == 2 && ranking.percentile("S3") == 0.0);
+    students[2].updateCGPA(9.0f);
+    CHECK(ranking.ranked() == (std::vector<std::string>{"S1", "S3", "S2"}));
+
+    // Copy-assigning a new record replaces the ID
+    Student fresh("NEW", "Student", "CSE");
+    fresh.updateCGPA(5.0f);
+    students[1] = fresh;
+    CHECK(ranking.ranked() == (std::vector<std::string>{"S1", "S3", "NEW"}));
+    CHECK(ranking.topInDepartment("CSE", 5) == std::vector<std::string>{"NEW"});
+    bool threw = false;
+    try {
+        ranking.rankOf("S2");
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    testFenwick();
+    testRanked();
+    testUpdates();
+    testTrackedStudents();
+    testUntrackAndAssign();
+    return test::finish();
+}
@@ -0,0 +1,185 @@
+/**
+ * @file test_sections.cpp
+ * @brief Tests that a student holds at most one section of a course
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Every registration path (registerStudent, carts, swaps, seat holds and
+ * the lottery) must refuse a second section of a course the student is
+ * already in, whether it names the parent code or a section code. The
+ * parent code alone must place the student in a section on every path.
+ */
+
+#include <algorithm>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "course_registration.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Engine with course MATH101 split into sections MATH101-1 and MATH101-2, plus PHYS101 */
+void addCatalog(CourseRegistration& reg) {
+    const time_t deadline = time(nullptr) + 86400;
+    reg.addCourse("MATH101", "Calculus", 0, {}, deadline);
+    reg.addSection("MATH101", "MATH101-1", 2);
+    reg.addSection("MATH101", "MATH101-2", 2);
+    reg.addCourse("PHYS101", "Mechanics", 10, {}, deadline);
+}
+
+/** @brief Returns whether @p student lists @p courseCode */
+bool lists(const Student& student, const std::string& courseCode) {
+    std::vector<std::string> courses = student.getEnrolledCourses();
+    return std::find(courses.begin(), courses.end(), courseCode) != courses.end();
+}
+
+void testParentThenSection() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student alice("S1", "Alice", "CSE");
+    CHECK(reg.tryRegisterStudent(alice, "MATH101") == RegistrationStatus::SUCCESS);
+    std::string section = reg.getSection("S1", "MATH101").value;
+    std::string other = section == "MATH101-1" ? "MATH101-2" : "MATH101-1";
+    CHECK(reg.tryRegisterStudent(alice, other) == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.tryRegisterStudent(alice, "MATH101") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.getEnrollmentCount("MATH101") == 1);
+    // The student records the course, not the section
+    CHECK(lists(alice, "MATH101"));
+    CHECK(!lists(alice, section));
+}
+
+void testSectionThenParent() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student bob("S2", "Bob", "CSE");
+    CHECK(reg.tryRegisterStudent(bob, "MATH101-2") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getSection("S2", "MATH101").value == "MATH101-2");
+    CHECK(reg.tryRegisterStudent(bob, "MATH101") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.tryRegisterStudent(bob, "MATH101-1") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.getEnrollmentCount("MATH101") == 1);
+    CHECK(lists(bob, "MATH101"));
+}
+
+void testCart() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student carol("S3", "Carol", "CSE");
+    CartRegistrationResult both = reg.registerCart(carol, {"MATH101-1", "MATH101-2"});
+    CHECK(!both.committed);
+    CHECK(reg.getEnrollmentCount("MATH101") == 0);
+
+    CHECK(reg.tryRegisterStudent(carol, "MATH101-1") == RegistrationStatus::SUCCESS);
+    CartRegistrationResult again = reg.registerCart(carol, {"PHYS101", "MATH101-2"});
+    CHECK(!again.committed);
+    CHECK(again.statuses.size() == 2 && again.statuses[1] == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.getEnrollmentCount("PHYS101") == 0);
+    CHECK(reg.getEnrollmentCount("MATH101") == 1);
+}
+
+void testSwap() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student dave("S4", "Dave", "CSE");
+    CHECK(reg.tryRegisterStudent(dave, "MATH101-1") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(dave, "PHYS101") == RegistrationStatus::SUCCESS);
+
+    // Joining another section from an unrelated course would hold two sections
+    CHECK(reg.swapCourse(dave, "PHYS101", "MATH101-2") == RegistrationStatus::ALREADY_ENROLLED);
+    CHECK(reg.getEnrollmentCount("PHYS101") == 1);
+
+    // Moving between sections of the course is allowed
+    CHECK(reg.swapCourse(dave, "MATH101-1", "MATH101-2") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getSection("S4", "MATH101").value == "MATH101-2");
+    CHECK(reg.getEnrollmentCount("MATH101") == 1);
+}
+
+void testHold() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student erin("S5", "Erin", "CSE");
+    CHECK(reg.tryRegisterStudent(erin, "MATH101-1") == RegistrationStatus::SUCCESS);
+    CHECK(reg.holdSeat(erin, "MATH101-2", 60).status == RegistrationStatus::ALREADY_ENROLLED);
+}
+
+void testLottery() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    Student frank("S6", "Frank", "CSE");
+    Student grace("S7", "Grace", "CSE");
+    std::vector<LotteryEntry> entries = {{&frank, {"MATH101-1", "MATH101-2", "PHYS101"}},
+                                         {&grace, {"MATH101-2", "MATH101-1"}}};
+    LotteryOptions options;
+    options.seed = 7;
+    options.coursesPerStudent = 2;
+    options.threads = 1;
+    LotteryResult result = reg.allocateLottery(entries, options);
+
+    // Frank's second pick skips the other section and goes to PHYS101
+    CHECK(result.assigned[0].size() == 2);
+    CHECK(std::count_if(result.assigned[0].begin(), result.assigned[0].end(), [](const std::string& code) {
+              return code.compare(0, 8, "MATH101-") == 0;
+          }) == 1);
+    CHECK(result.assigned[1].size() == 1);
+    CHECK(reg.getEnrollmentCount("MATH101") == 2);
+    CHECK(lists(frank, "MATH101") && lists(frank, "PHYS101"));
+}
+
+void testParentCodeCartSwapLottery() {
+    CourseRegistration reg;
+    addCatalog(reg);
+    // A cart naming the parent code takes a section
+    Student hank("S8", "Hank", "CSE");
+    CartRegistrationResult cart = reg.registerCart(hank, {"MATH101", "PHYS101"});
+    CHECK(cart.committed);
+    CHECK(reg.getSection("S8", "MATH101").status == RegistrationStatus::SUCCESS);
+    CHECK(lists(hank, "MATH101") && lists(hank, "PHYS101"));
+    CHECK(!reg.registerCart(hank, {"MATH101"}).committed);
+
+    // So does a swap into the parent code, load-balanced against Hank's section
+    Student ivy("S9", "Ivy", "CSE");
+    CHECK(reg.tryRegisterStudent(ivy, "PHYS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.swapCourse(ivy, "PHYS101", "MATH101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.getSection("S9", "MATH101").value != reg.getSection("S8", "MATH101").value);
+    CHECK(lists(ivy, "MATH101"));
+    CHECK(reg.getEnrollmentCount("PHYS101") == 1);
+    CHECK(reg.swapCourse(ivy, reg.getSection("S9", "MATH101").value, "MATH101") ==
+          RegistrationStatus::ALREADY_ENROLLED);
+
+    // And the lottery fills the remaining seat of each section from the parent code
+    Student jack("S10", "Jack", "CSE");
+    Student kate("S11", "Kate", "CSE");
+    Student liam("S12", "Liam", "CSE");
+    std::vector<LotteryEntry> entries = {{&jack, {"MATH101"}}, {&kate, {"MATH101"}}, {&liam, {"MATH101"}}};
+    LotteryOptions options;
+    options.seed = 11;
+    options.threads = 1;
+    LotteryResult result = reg.allocateLottery(entries, options);
+    CHECK(result.seatsAssigned == 2);
+    CHECK(result.studentsUnassigned == 1);
+    CHECK(reg.getEnrollmentCount("MATH101") == 4);
+    CHECK(reg.isCourseFull("MATH101"));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        CHECK(result.assigned[i].empty() || lists(*entries[i].student, "MATH101"));
+    }
+
+    // With every section full the parent code is full on each path
+    Student mia("S13", "Mia", "CSE");
+    CHECK(reg.tryRegisterStudent(mia, "PHYS101") == RegistrationStatus::SUCCESS);
+    CartRegistrationResult full = reg.registerCart(mia, {"MATH101"});
+    CHECK(!full.committed && full.statuses[0] == RegistrationStatus::COURSE_FULL);
+    CHECK(reg.swapCourse(mia, "PHYS101", "MATH101") == RegistrationStatus::COURSE_FULL);
+}
+
+} // namespace
+
+int main() {
+    testParentThenSection();
+    testSectionThenParent();
+    testCart();
+    testSwap();
+    testHold();
+    testLottery();
+    testParentCodeCartSwapLottery();
+    return test::finish();
+}
@@ -0,0 +1,181 @@
+/**
+ * @file test_server.cpp
+ * @brief Tests the registration server over a Unix domain socket
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A client pipelines more requests than fit in one read; every one must
+ * be answered, in order, with the status the engine gives. A withdrawal
+ * must tell an unknown course from a course the student is not in. Out
+ * of file descriptors, the server must shed a pending connection rather
+ * than leave it queued, and serve again once descriptors free up.
+ */
+
+#include <chrono>
+#include <ctime>
+#include <fcntl.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "registration_server.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Connects to a Unix domain socket; -1 on failure */
+int connectUnix(const std::string& path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/** @brief Sends all of @p bytes */
+bool sendAll(int fd, const std::string& bytes) {
+    size_t sent = 0;
+    while (sent < bytes.size()) {
+        ssize_t written = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/** @brief Receives @p count responses */
+std::vector<WireResponse> receive(int fd, size_t count) {
+    std::string bytes;
+    char buffer[4096];
+    while (bytes.size() < count * kResponseSize) {
+        ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        bytes.append(buffer, static_cast<size_t>(received));
+    }
+    std::vector<WireResponse> responses;
+    for (size_t offset = 0; offset + kResponseSize <= bytes.size(); offset += kResponseSize) {
+        responses.push_back(decodeResponse(bytes.data() + offset));
+    }
+    return responses;
+}
+
+void testPipelineAndWithdraw(const std::string& path) {
+    CourseRegistration reg;
+    reg.addCourse("CS101", "Programming", 10, {}, time(nullptr) + 86400);
+    std::vector<Student> students = {Student("S1", "Alice", "CSE"), Student("S2", "Bob", "CSE")};
+    RegistrationServer server(reg, students);
+    server.listenUnix(path);
+    server.start(1);
+
+    int fd = connectUnix(path);
+    CHECK(fd >= 0);
+    if (fd < 0) {
+        return;
+    }
+
+    // Well over kReadChunk bytes of requests, sent before any answer is read
+    std::string wire;
+    encodeRequest({WireOpcode::REGISTER, 0, "S1", "CS101"}, wire);
+    const size_t queries = RegistrationServer::kReadChunk / (kRequestHeaderSize + 5) + 1000;
+    for (size_t i = 1; i <= queries; ++i) {
+        encodeRequest({WireOpcode::QUERY, static_cast<uint32_t>(i), "", "CS101"}, wire);
+    }
+    const uint32_t last = static_cast<uint32_t>(queries);
+    encodeRequest({WireOpcode::WITHDRAW, last + 1, "S2", "CS101"}, wire);
+    encodeRequest({WireOpcode::WITHDRAW, last + 2, "S1", "NOPE101"}, wire);
+    encodeRequest({WireOpcode::WITHDRAW, last + 3, "S1", "CS101"}, wire);
+    CHECK(sendAll(fd, wire));
+
+    std::vector<WireResponse> responses = receive(fd, queries + 4);
+    ::close(fd);
+    CHECK(responses.size() == queries + 4);
+    if (responses.size() != queries + 4) {
+        return;
+    }
+    CHECK(responses[0].status == static_cast<uint8_t>(RegistrationStatus::SUCCESS));
+    for (size_t i = 1; i <= queries; ++i) {
+        CHECK(responses[i].tag == i && responses[i].enrolled == 1 && responses[i].seatsLeft == 9);
+    }
+    CHECK(responses[queries + 1].status == static_cast<uint8_t>(RegistrationStatus::NOT_ENROLLED));
+    CHECK(responses[queries + 2].status == static_cast<uint8_t>(RegistrationStatus::UNKNOWN_COURSE));
+    CHECK(responses[queries + 3].status == static_cast<uint8_t>(RegistrationStatus::SUCCESS));
+    CHECK(reg.getEnrollmentCount("CS101") == 0);
+
+    CHECK(server.stats().requests == queries + 4);
+    server.stop();
+}
+
+void testOutOfDescriptors(const std::string& path) {
+    CourseRegistration reg;
+    reg.addCourse("CS101", "Programming", 10, {}, time(nullptr) + 86400);
+    std::vector<Student> students = {Student("S1", "Alice", "CSE")};
+    RegistrationServer server(reg, students);
+    server.listenUnix(path);
+    server.start(1);
+
+    // Use up every descriptor but one, then spend it on a client whose
+    // connection waits in the listen backlog
+    rlimit saved{};
+    ::getrlimit(RLIMIT_NOFILE, &saved);
+    rlimit tight = saved;
+    tight.rlim_cur = 64;
+    CHECK(::setrlimit(RLIMIT_NOFILE, &tight) == 0);
+    std::vector<int> fillers;
+    for (int fd; (fd = ::open("/dev/null", O_RDONLY)) >= 0;) {
+        fillers.push_back(fd);
+    }
+    ::close(fillers.back());
+    fillers.pop_back();
+    int shedClient = connectUnix(path);
+    CHECK(shedClient >= 0);
+
+    for (int i = 0; i < 2000 && server.stats().shed == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(server.stats().shed == 1);
+    char byte;
+    CHECK(shedClient < 0 || ::recv(shedClient, &byte, 1, 0) <= 0);
+
+    for (int fd : fillers) {
+        ::close(fd);
+    }
+    ::setrlimit(RLIMIT_NOFILE, &saved);
+    if (shedClient >= 0) {
+        ::close(shedClient);
+    }
+
+    // The loop keeps serving once descriptors are back
+    int fd = connectUnix(path);
+    CHECK(fd >= 0);
+    if (fd >= 0) {
+        std::string wire;
+        encodeRequest({WireOpcode::REGISTER, 7, "S1", "CS101"}, wire);
+        CHECK(sendAll(fd, wire));
+        std::vector<WireResponse> responses = receive(fd, 1);
+        CHECK(responses.size() == 1 && responses[0].tag == 7);
+        ::close(fd);
+    }
+    CHECK(server.stats().failedLoops == 0);
+    server.stop();
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "test_server." + std::to_string(::getpid()) + ".sock";
+    testPipelineAndWithdraw(path);
+    testOutOfDescriptors(path);
+    ::unlink(path.c_str());
+    return test::finish();
+}
@@ -0,0 +1,100 @@
+/**
+ * @file test_snapshot.cpp
+ * @brief Tests that a roster snapshot never sees later changes
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A snapshot must keep answering with the rosters committed before it was
+ * opened while registrations, withdrawals, carts and swaps continue, and
+ * must see each cart or swap either whole or not at all.
+ */
+
+#include <atomic>
+#include <ctime>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "course_registration.h"
+#include "roster_snapshot.h"
+#include "test_util.h"
+
+namespace {
+
+void testPointInTime() {
+    CourseRegistration reg;
+    const time_t deadline = time(nullptr) + 86400;
+    reg.addCourse("CS101", "Programming", 10, {}, deadline);
+    reg.addCourse("MATH101", "Calculus", 10, {}, deadline);
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    Student carol("S3", "Carol", "CSE");
+    CHECK(reg.tryRegisterStudent(alice, "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(bob, "CS101") == RegistrationStatus::SUCCESS);
+
+    RosterSnapshot snapshot = reg.openSnapshot();
+
+    CHECK(reg.withdrawStudent("S1", "CS101"));
+    CHECK(reg.tryRegisterStudent(carol, "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.registerCart(alice, {"MATH101"}).committed);
+    CHECK(reg.swapCourse(bob, "CS101", "MATH101") == RegistrationStatus::SUCCESS);
+    reg.addCourse("PHYS101", "Mechanics", 10, {}, deadline);
+
+    CHECK(snapshot.getRoster("CS101").value == (std::set<std::string>{"S1", "S2"}));
+    CHECK(snapshot.getEnrollmentCount("MATH101").value == 0);
+    CHECK(snapshot.getRoster("PHYS101").status == RegistrationStatus::UNKNOWN_COURSE);
+    int courses = 0;
+    snapshot.forEachCourse([&](const std::string&, const std::set<std::string>&) { ++courses; });
+    CHECK(courses == 2);
+
+    RosterSnapshot later = reg.openSnapshot();
+    CHECK(later.getVersion() > snapshot.getVersion());
+    CHECK(later.getRoster("CS101").value == (std::set<std::string>{"S3"}));
+    CHECK(later.getRoster("MATH101").value == (std::set<std::string>{"S1", "S2"}));
+}
+
+void testSwapsAreAtomic() {
+    CourseRegistration reg;
+    const time_t deadline = time(nullptr) + 86400;
+    reg.addCourse("CS101", "Programming", 100, {}, deadline);
+    reg.addCourse("MATH101", "Calculus", 100, {}, deadline);
+    std::vector<Student> students;
+    for (int i = 0; i < 16; ++i) {
+        students.emplace_back("S" + std::to_string(i), "Student", "CSE");
+    }
+    for (Student& student : students) {
+        CHECK(reg.tryRegisterStudent(student, "CS101") == RegistrationStatus::SUCCESS);
+    }
+
+    // Every student is always in exactly one of the two courses
+    std::atomic<bool> stop{false};
+    std::thread swapper([&] {
+        for (int round = 0; !stop.load(std::memory_order_relaxed); ++round) {
+            for (Student& student : students) {
+                bool inCs = round % 2 == 0;
+                reg.swapCourse(student, inCs ? "CS101" : "MATH101", inCs ? "MATH101" : "CS101");
+            }
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        RosterSnapshot snapshot = reg.openSnapshot();
+        std::set<std::string> cs = snapshot.getRoster("CS101").value;
+        std::set<std::string> math = snapshot.getRoster("MATH101").value;
+        CHECK(cs.size() + math.size() == students.size());
+        for (const std::string& id : cs) {
+            CHECK(math.count(id) == 0);
+        }
+        // Reading again from the same snapshot gives the same answer
+        CHECK(snapshot.getRoster("CS101").value == cs);
+    }
+    stop.store(true, std::memory_order_relaxed);
+    swapper.join();
+}
+
+} // namespace
+
+int main() {
+    testPointInTime();
+    testSwapsAreAtomic();
+    return test::finish();
+}
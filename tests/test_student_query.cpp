@@ -0,0 +1,203 @@
+/**
+ * @file test_student_query.cpp
+ * @brief Tests vectorized student queries against a scalar reference
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Every query, including ones whose bounds fall exactly on stored values
+ * and tables whose size is not a multiple of the SIMD width, must select
+ * exactly the rows a plain loop over the Student objects picks. Counts,
+ * lists, histograms and combined selections must agree with the same
+ * loop.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "student_query.h"
+#include "test_util.h"
+
+namespace {
+
+const std::vector<std::string> kDepartments = {"CSE", "ECE", "MECH", "CIVIL", "MATH"};
+
+/** @brief @p count students over kDepartments, semesters 1..8 and CGPAs on a 0.5 grid */
+std::vector<Student> makeStudents(size_t count, std::mt19937& rng) {
+    std::vector<Student> students;
+    for (size_t i = 0; i < count; ++i) {
+        Student student("S" + std::to_string(i), "Student", kDepartments[rng() % kDepartments.size()]);
+        // Advance in good standing first: a student on probation cannot move on
+        student.updateCGPA(10.0f);
+        int semester = 1 + static_cast<int>(rng() % 8);
+        while (student.getSemester() < semester) {
+            student.advanceToNextSemester();
+        }
+        student.updateCGPA(static_cast<float>(rng() % 21) / 2.0f);
+        students.push_back(student);
+    }
+    return students;
+}
+
+/** @brief Returns whether a scalar evaluation of @p query selects @p student */
+bool matches(const StudentQuery& query, const Student& student) {
+    return (query.department.empty() || query.department == student.getDepartment()) &&
+           student.getSemester() >= query.minSemester && student.getSemester() <= query.maxSemester &&
+           student.getCGPA() >= query.minCgpa && student.getCGPA() < query.maxCgpa &&
+           (query.standings & StudentQuery::standingBit(student.getAcademicStanding()));
+}
+
+/** @brief A random query whose bounds often land on stored values */
+StudentQuery makeQuery(std::mt19937& rng) {
+    StudentQuery query;
+    if (rng() % 2) {
+        // Sometimes a department no student is in
+        query.department = rng() % 6 ? kDepartments[rng() % kDepartments.size()] : "LAW";
+    }
+    if (rng() % 2) {
+        query.minSemester = static_cast<int>(rng() % 9);
+    }
+    if (rng() % 2) {
+        query.maxSemester = static_cast<int>(rng() % 9);
+    }
+    if (rng() % 2) {
+        query.minCgpa = static_cast<float>(rng() % 21) / 2.0f;
+    }
+    if (rng() % 2) {
+        query.maxCgpa = static_cast<float>(rng() % 21) / 2.0f;
+    }
+    if (rng() % 2) {
+        query.standings = static_cast<unsigned>(rng() % 16);
+    }
+    return query;
+}
+
+/** @brief Bucket of @p student under @p field, or -1 if it is not counted */
+int bucketOf(const StudentTable& table, const Student& student, StudentField field) {
+    switch (field) {
+    case StudentField::DEPARTMENT:
+        for (size_t d = 0;; ++d) {
+            if (table.departmentName(d) == student.getDepartment()) {
+                return static_cast<int>(d);
+            }
+        }
+    case StudentField::SEMESTER:
+        return student.getSemester();
+    case StudentField::STANDING:
+        return static_cast<int>(student.getAcademicStanding());
+    case StudentField::CGPA:
+        return static_cast<int>(std::floor(student.getCGPA()));
+    }
+    return -1;
+}
+
+void checkQuery(const StudentTable& table, const std::vector<Student>& students, const StudentQuery& query) {
+    StudentSelection selected = table.select(query);
+    std::vector<std::string> expected;
+    for (size_t row = 0; row < students.size(); ++row) {
+        bool match = matches(query, students[row]);
+        CHECK(selected.contains(row) == match);
+        if (match) {
+            expected.push_back(students[row].getStudentId());
+        }
+    }
+    CHECK(!selected.contains(students.size()));
+    CHECK(selected.count() == expected.size());
+    CHECK(table.count(query) == expected.size());
+    CHECK(table.list(selected) == expected);
+
+    const StudentField fields[] = {StudentField::DEPARTMENT, StudentField::SEMESTER, StudentField::STANDING,
+                                   StudentField::CGPA};
+    for (StudentField field : fields) {
+        std::vector<size_t> reference;
+        selected.forEach([&](size_t row) {
+            int bucket = bucketOf(table, students[row], field);
+            if (bucket >= 0) {
+                if (reference.size() <= static_cast<size_t>(bucket)) {
+                    reference.resize(bucket + 1, 0);
+                }
+                ++reference[bucket];
+            }
+        });
+        std::vector<size_t> histogram = table.histogram(selected, field);
+        // Trailing empty buckets are allowed
+        CHECK(histogram.size() >= reference.size());
+        for (size_t i = 0; i < histogram.size(); ++i) {
+            CHECK(histogram[i] == (i < reference.size() ? reference[i] : 0));
+        }
+    }
+}
+
+void testAgainstReference() {
+    std::mt19937 rng(44);
+    // Sizes around the four-row groups and the 64-row bitmap words
+    for (size_t count : {0, 1, 3, 4, 5, 63, 64, 65, 1003}) {
+        std::vector<Student> students = makeStudents(count, rng);
+        StudentTable table(students);
+        CHECK(table.size() == count);
+        checkQuery(table, students, StudentQuery());
+        for (int q = 0; q < 200; ++q) {
+            checkQuery(table, students, makeQuery(rng));
+        }
+    }
+}
+
+void testCombine() {
+    std::mt19937 rng(7);
+    std::vector<Student> students = makeStudents(500, rng);
+    StudentTable table;
+    for (const Student& student : students) {
+        CHECK(table.add(student) == table.size() - 1);
+    }
+    CHECK(table.studentId(499) == "S499");
+
+    StudentQuery cse;
+    cse.department = "CSE";
+    StudentQuery probation;
+    probation.standings = StudentQuery::standingBit(AcademicStanding::PROBATION);
+    StudentSelection both = table.select(cse);
+    both &= table.select(probation);
+    StudentSelection either = table.select(cse);
+    either |= table.select(probation);
+    for (size_t row = 0; row < students.size(); ++row) {
+        bool inCse = matches(cse, students[row]);
+        bool onProbation = matches(probation, students[row]);
+        CHECK(both.contains(row) == (inCse && onProbation));
+        CHECK(either.contains(row) == (inCse || onProbation));
+    }
+
+    // Selections of another table are refused
+    StudentTable other(makeStudents(10, rng));
+    bool threw = false;
+    try {
+        both &= other.select(cse);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    threw = false;
+    try {
+        table.list(other.select(cse));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    threw = false;
+    try {
+        table.studentId(500);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    testAgainstReference();
+    testCombine();
+    return test::finish();
+}
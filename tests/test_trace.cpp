@@ -0,0 +1,226 @@
+/**
+ * @file test_trace.cpp
+ * @brief Tests that a recorded trace reads back and replays to the same outcomes
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Every recorded call must decode with its arguments, outcome and order
+ * intact, along with the clock and each student's semester, CGPA,
+ * completed courses and department. Replaying the trace serially into a
+ * fresh engine must give every call the outcome it had when recorded.
+ * Truncated or foreign input, and student records out of range, must be
+ * refused.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "course_registration.h"
+#include "registration_clock.h"
+#include "registration_trace.h"
+#include "test_util.h"
+#include "varint.h"
+
+namespace {
+
+/** @brief Window that keeps first-semester students on probation out until 6000 */
+const std::vector<RegistrationWindow> kWindows = {{1, 1, AcademicStanding::PROBATION, 6000}};
+
+/** @brief Records a mix of catalog changes, registrations and withdrawals */
+std::string record(std::vector<uint8_t>& outcomes) {
+    std::ostringstream out;
+    ManualClock clock(5000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    reg.setRegistrationWindows(kWindows);
+    {
+        TraceRecorder recorder(out);
+        reg.setTraceRecorder(&recorder);
+        reg.addCourse("CS101", "Programming", 300, {}, 90000);
+        reg.addCourse("CS201", "Data Structures", 5, {"CS101"}, 90000);
+        // Deadlines before 1970 round-trip too
+        reg.addCourse("HIST101", "History", 10, {}, -5);
+        reg.addCourse("MATH101", "Calculus", 0, {}, 90000);
+        reg.addSection("MATH101", "MATH101-1", 2, "ECE");
+        reg.addSection("MATH101", "MATH101-2", 200);
+
+        // The window lets these students in only for their semester or CGPA
+        Student senior("SENIOR", "Senior", "CSE");
+        senior.enrollInCourse("CS101");
+        senior.updateCGPA(9.25f);
+        for (int i = 0; i < 4; ++i) {
+            senior.advanceToNextSemester();
+        }
+        senior.updateCGPA(4.5f);
+        Student ece("ECE1", "Ece", "ECE");
+        ece.updateCGPA(7.5f);
+        outcomes.push_back(static_cast<uint8_t>(reg.tryRegisterStudent(senior, "CS201")));
+        outcomes.push_back(static_cast<uint8_t>(reg.tryRegisterStudent(ece, "MATH101")));
+        outcomes.push_back(static_cast<uint8_t>(reg.tryRegisterStudent(ece, "HIST101")));
+        outcomes.push_back(static_cast<uint8_t>(reg.tryRegisterStudent(ece, "NOPE101")));
+
+        // Enough traffic to flush the buffer more than once
+        std::vector<Student> students;
+        for (int i = 0; i < 400; ++i) {
+            students.emplace_back("S" + std::to_string(i), "Student", "CSE");
+            students.back().updateCGPA(7.5f);
+        }
+        for (int i = 0; i < 3000; ++i) {
+            Student& student = students[i % 400];
+            const char* course = i % 3 == 0 ? "CS101" : (i % 3 == 1 ? "CS201" : "MATH101");
+            if (i % 7 == 0) {
+                outcomes.push_back(reg.withdrawStudent(student.getStudentId(), course) ? 1 : 0);
+            } else {
+                outcomes.push_back(static_cast<uint8_t>(reg.tryRegisterStudent(student, course)));
+            }
+        }
+        reg.setTraceRecorder(nullptr);
+    }
+    return out.str();
+}
+
+void testRoundTrip() {
+    std::vector<uint8_t> outcomes;
+    const std::string bytes = record(outcomes);
+    std::istringstream in(bytes);
+    Trace trace = readTrace(in);
+
+    CHECK(trace.hasStartTime && trace.startTime == 5000);
+    CHECK(trace.events.size() == 6 + outcomes.size());
+    if (trace.events.size() != 6 + outcomes.size()) {
+        return;
+    }
+    const TraceEvent& cs201 = trace.events[1];
+    CHECK(cs201.type == TraceRecordType::ADD_COURSE && cs201.courseCode == "CS201" &&
+          cs201.courseName == "Data Structures" && cs201.capacity == 5 && cs201.deadline == 90000 &&
+          cs201.prerequisites == std::set<std::string>{"CS101"});
+    CHECK(trace.events[2].deadline == -5);
+    const TraceEvent& section = trace.events[4];
+    CHECK(section.type == TraceRecordType::ADD_SECTION && section.parentCode == "MATH101" &&
+          section.courseCode == "MATH101-1" && section.capacity == 2 && section.department == "ECE");
+    CHECK(trace.events[5].department.empty());
+
+    uint64_t previous = 0;
+    for (size_t i = 0; i < outcomes.size(); ++i) {
+        const TraceEvent& event = trace.events[6 + i];
+        CHECK(event.type == TraceRecordType::REGISTER || event.type == TraceRecordType::WITHDRAW);
+        CHECK(event.result == outcomes[i]);
+        CHECK(event.offsetNanos >= previous);
+        previous = event.offsetNanos;
+    }
+    CHECK(trace.events[6].studentId == "SENIOR" && trace.events[6].courseCode == "CS201");
+    CHECK(trace.studentCourses["SENIOR"] == std::vector<std::string>{"CS101"});
+    CHECK(trace.studentCourses["ECE1"].empty());
+    CHECK(trace.studentDepartments["ECE1"] == "ECE");
+    CHECK(trace.studentSemesters["SENIOR"] == 5 && trace.studentCgpas["SENIOR"] == 4.5f);
+    CHECK(trace.studentSemesters["ECE1"] == 1 && trace.studentCgpas["ECE1"] == 7.5f);
+    CHECK(outcomes[0] == static_cast<uint8_t>(RegistrationStatus::SUCCESS));
+    CHECK(trace.studentCourses.size() == 402);
+    // Strings are interned, so the whole trace stays well under 10 bytes per call
+    CHECK(bytes.size() < outcomes.size() * 10);
+}
+
+void testReplay() {
+    std::vector<uint8_t> outcomes;
+    std::istringstream in(record(outcomes));
+    Trace trace = readTrace(in);
+
+    ManualClock clock(trace.startTime);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    // Windows are not traced; the replay sets them as the recording did
+    reg.setRegistrationWindows(kWindows);
+    std::map<std::string, Student> students;
+    for (const auto& entry : trace.studentCourses) {
+        students.emplace(entry.first, replayStudent(trace, entry.first));
+    }
+    // A student on probation keeps the semester they reached
+    const Student& senior = students.at("SENIOR");
+    CHECK(senior.getSemester() == 5 && senior.getCGPA() == 4.5f);
+    size_t mismatches = 0;
+    for (const TraceEvent& event : trace.events) {
+        if (event.type == TraceRecordType::ADD_COURSE) {
+            reg.addCourse(event.courseCode, event.courseName, event.capacity, event.prerequisites, event.deadline);
+        } else if (event.type == TraceRecordType::ADD_SECTION) {
+            reg.addSection(event.parentCode, event.courseCode, event.capacity, event.department);
+        } else if (event.type == TraceRecordType::REGISTER) {
+            Student& student = students.at(event.studentId);
+            mismatches += static_cast<uint8_t>(reg.tryRegisterStudent(student, event.courseCode)) != event.result;
+        } else {
+            mismatches += (reg.withdrawStudent(event.studentId, event.courseCode) ? 1 : 0) != event.result;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+/** @brief Returns true if readTrace() refuses @p bytes */
+bool refused(const std::string& bytes) {
+    std::istringstream in(bytes);
+    try {
+        readTrace(in);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+/** @brief A trace holding one STUDENT record with @p semester and @p cgpa */
+std::string studentTrace(int64_t semester, float cgpa) {
+    std::string bytes = "CRTRACE2";
+    bytes.push_back(static_cast<char>(TraceRecordType::STRING));
+    putVarint(bytes, 0);
+    putVarint(bytes, 1);
+    bytes.push_back('S');
+    bytes.push_back(static_cast<char>(TraceRecordType::STUDENT));
+    putVarint(bytes, 0);
+    putVarint(bytes, zigzagEncode(semester));
+    uint32_t cgpaBits;
+    std::memcpy(&cgpaBits, &cgpa, sizeof(cgpaBits));
+    for (int i = 0; i < 4; ++i) {
+        bytes.push_back(static_cast<char>(cgpaBits >> (8 * i)));
+    }
+    putVarint(bytes, 0);
+    return bytes;
+}
+
+void testMalformed() {
+    std::vector<uint8_t> outcomes;
+    const std::string bytes = record(outcomes);
+    CHECK(refused(""));
+    CHECK(refused("NOTATRACE"));
+    CHECK(refused(bytes.substr(0, bytes.size() - 1)));
+    std::string unknown = bytes;
+    unknown.push_back(static_cast<char>(0x7f));
+    CHECK(refused(unknown));
+    // A header alone is an empty trace
+    CHECK(!refused(bytes.substr(0, 8)));
+
+    // A string longer than the input is truncated, not allocated
+    std::string huge = "CRTRACE2";
+    huge.push_back(static_cast<char>(TraceRecordType::STRING));
+    putVarint(huge, 0);
+    putVarint(huge, uint64_t(1) << 62);
+    huge.append("abc");
+    CHECK(refused(huge));
+
+    CHECK(!refused(studentTrace(3, 7.5f)));
+    CHECK(refused(studentTrace(0, 7.5f)));
+    CHECK(refused(studentTrace(int64_t(1) << 40, 7.5f)));
+    CHECK(refused(studentTrace(3, 11.0f)));
+    CHECK(refused(studentTrace(3, std::numeric_limits<float>::quiet_NaN())));
+}
+
+} // namespace
+
+int main() {
+    testRoundTrip();
+    testReplay();
+    testMalformed();
+    return test::finish();
+}
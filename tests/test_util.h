@@ -0,0 +1,44 @@
+/**
+ * @file test_util.h
+ * @brief Minimal check macro and result reporting for the test programs
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Each test program is a single translation unit whose main() calls its
+ * test functions in turn and returns test::finish(). A failed CHECK is
+ * reported and counted but does not stop the program, so one run lists
+ * every failure.
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdio>
+
+namespace test {
+
+/** @brief Failed checks so far */
+inline int failures = 0;
+
+/** @brief Prints the outcome and returns the exit status of the program */
+inline int finish() {
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
+
+} // namespace test
+
+/** @brief Reports and counts a failure if @p condition is false */
+#define CHECK(condition)                                                                       \
+    do {                                                                                       \
+        if (!(condition)) {                                                                    \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++test::failures;                                                                  \
+        }                                                                                      \
+    } while (0)
+
+#endif // TEST_UTIL_H
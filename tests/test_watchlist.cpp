@@ -0,0 +1,184 @@
+/**
+ * @file test_watchlist.cpp
+ * @brief Tests that standing changes reach the standing watchlist
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Once tracked, a student must move between the watchlist's lists on any
+ * Student::updateCGPA that changes the standing, whether called directly
+ * or through the watchlist, and only those updates may be logged. Copies
+ * of a tracked student must start detached, so they never call a
+ * watchlist that is gone. Assigning to a tracked student or untracking
+ * it must drop its old ID from the lists and log it as left.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "standing_watchlist.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Returns the standing the watchlist holds for @p studentId */
+AcademicStanding listed(const StandingWatchlist& watchlist, const std::string& studentId) {
+    AcademicStanding standing = AcademicStanding::PROBATION;
+    CHECK(watchlist.standingOf(studentId, standing));
+    return standing;
+}
+
+void testDirectUpdates() {
+    StandingWatchlist watchlist;
+    Student alice("S1", "Alice", "CSE");
+    alice.updateCGPA(7.5f);
+    watchlist.track(alice);
+    CHECK(alice.isObservedBy(&watchlist));
+    CHECK(listed(watchlist, "S1") == AcademicStanding::GOOD);
+    CHECK(watchlist.lastSequence() == 1);
+
+    // A change within the standing is not logged
+    alice.updateCGPA(7.9f);
+    CHECK(watchlist.lastSequence() == 1);
+
+    // A direct update that crosses a threshold moves the student
+    alice.updateCGPA(4.0f);
+    CHECK(listed(watchlist, "S1") == AcademicStanding::PROBATION);
+    CHECK(watchlist.count(AcademicStanding::GOOD) == 0);
+    CHECK(watchlist.members(AcademicStanding::PROBATION) == std::vector<std::string>{"S1"});
+
+    std::vector<StandingChange> changes;
+    CHECK(watchlist.changesSince(1, changes));
+    CHECK(changes.size() == 1);
+    CHECK(changes[0].previous == AcademicStanding::GOOD && changes[0].current == AcademicStanding::PROBATION);
+    CHECK(!changes[0].joined && changes[0].cgpa == 4.0f);
+
+    // An invalid CGPA throws and leaves both the student and the lists alone
+    bool threw = false;
+    try {
+        alice.updateCGPA(11.0f);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(listed(watchlist, "S1") == AcademicStanding::PROBATION);
+    CHECK(watchlist.lastSequence() == 2);
+}
+
+void testConvenienceWrapper() {
+    StandingWatchlist watchlist;
+    Student bob("S2", "Bob", "CSE");
+
+    // The wrapper tracks an untracked student first
+    CHECK(watchlist.updateCGPA(bob, 8.5f));
+    CHECK(bob.isObservedBy(&watchlist));
+    CHECK(listed(watchlist, "S2") == AcademicStanding::EXCELLENT);
+    CHECK(!watchlist.updateCGPA(bob, 9.0f));
+    CHECK(watchlist.count(AcademicStanding::EXCELLENT) == 1);
+
+    // A detached student no longer reports to the watchlist
+    bob.removeCgpaObserver(&watchlist);
+    bob.updateCGPA(6.0f);
+    CHECK(listed(watchlist, "S2") == AcademicStanding::EXCELLENT);
+    watchlist.track(bob);
+    CHECK(listed(watchlist, "S2") == AcademicStanding::SATISFACTORY);
+}
+
+void testCopiesAreDetached() {
+    std::vector<Student> copies;
+    const CgpaObserver* gone = nullptr;
+    {
+        StandingWatchlist watchlist;
+        gone = &watchlist;
+        Student carol("S3", "Carol", "CSE");
+        carol.updateCGPA(7.5f);
+        watchlist.track(carol);
+        // Updating a copy leaves the tracked student's listing alone
+        Student copy(carol);
+        CHECK(!copy.isObservedBy(&watchlist));
+        copy.updateCGPA(4.0f);
+        CHECK(listed(watchlist, "S3") == AcademicStanding::GOOD);
+
+        Student assigned("S4", "Dan", "CSE");
+        watchlist.track(assigned);
+        assigned = carol;
+        // Still tracked, under the record it was given
+        CHECK(assigned.isObservedBy(&watchlist));
+        AcademicStanding standing;
+        CHECK(!watchlist.standingOf("S4", standing));
+        CHECK(listed(watchlist, "S3") == AcademicStanding::GOOD);
+
+        // A move keeps the tracking and leaves the source detached
+        Student moved(std::move(carol));
+        CHECK(moved.isObservedBy(&watchlist));
+        CHECK(!carol.isObservedBy(&watchlist));
+        moved.updateCGPA(4.0f);
+        CHECK(listed(watchlist, "S3") == AcademicStanding::PROBATION);
+        moved.removeCgpaObserver(&watchlist);
+
+        copies.push_back(copy);
+        copies.push_back(moved);
+    }
+    // The watchlist is gone; the copies must not reach it
+    for (Student& student : copies) {
+        CHECK(!student.isObservedBy(gone));
+        student.updateCGPA(9.0f);
+    }
+}
+
+void testUntrackAndAssign() {
+    StandingWatchlist watchlist;
+    Student alice("S1", "Alice", "CSE");
+    Student bob("S2", "Bob", "CSE");
+    alice.updateCGPA(9.0f);
+    bob.updateCGPA(4.0f);
+    watchlist.track(alice);
+    watchlist.track(bob);
+
+    CHECK(watchlist.untrack(bob));
+    CHECK(!bob.isObservedBy(&watchlist));
+    CHECK(watchlist.count(AcademicStanding::PROBATION) == 0);
+    std::vector<StandingChange> changes;
+    CHECK(watchlist.changesSince(watchlist.lastSequence() - 1, changes));
+    CHECK(changes.size() == 1 && changes[0].studentId == "S2" && changes[0].left);
+    CHECK(changes.size() == 1 && changes[0].current == AcademicStanding::PROBATION);
+    bob.updateCGPA(9.0f);
+    CHECK(watchlist.count(AcademicStanding::EXCELLENT) == 1);
+    CHECK(!watchlist.untrack(bob));
+
+    // Copy-assigning a new record: the old ID leaves, the new one joins
+    Student carol("S3", "Carol", "ECE");
+    carol.updateCGPA(6.0f);
+    alice = carol;
+    AcademicStanding standing;
+    CHECK(!watchlist.standingOf("S1", standing));
+    CHECK(listed(watchlist, "S3") == AcademicStanding::SATISFACTORY);
+    alice.updateCGPA(7.5f);
+    CHECK(listed(watchlist, "S3") == AcademicStanding::GOOD);
+
+    // Erasing from a vector move-assigns over the erased student
+    std::vector<Student> students;
+    for (int i = 0; i < 3; ++i) {
+        students.emplace_back("V" + std::to_string(i), "Student", "CSE");
+    }
+    for (Student& student : students) {
+        watchlist.track(student);
+    }
+    students.erase(students.begin());
+    CHECK(!watchlist.standingOf("V0", standing));
+    CHECK(watchlist.count(AcademicStanding::PROBATION) == 2);
+    students[0].updateCGPA(8.0f);
+    CHECK(listed(watchlist, "V1") == AcademicStanding::EXCELLENT);
+    students[1].updateCGPA(5.0f);
+    CHECK(listed(watchlist, "V2") == AcademicStanding::SATISFACTORY);
+}
+
+} // namespace
+
+int main() {
+    testDirectUpdates();
+    testConvenienceWrapper();
+    testCopiesAreDetached();
+    testUntrackAndAssign();
+    return test::finish();
+}
@@ -0,0 +1,134 @@
+/**
+ * @file test_windows.cpp
+ * @brief Tests staggered registration windows by semester and standing
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * The window table must map every cohort to the opening time of the last
+ * window covering it, and the engine must refuse every registration path
+ * with REGISTRATION_NOT_OPEN until the student's window opens, while
+ * cohorts no window covers register at once.
+ */
+
+#include <climits>
+#include <ctime>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "course_registration.h"
+#include "registration_clock.h"
+#include "registration_windows.h"
+#include "test_util.h"
+
+namespace {
+
+/** @brief Returns a student in @p semester with @p cgpa */
+Student makeStudent(const std::string& id, int semester, float cgpa) {
+    Student student(id, id, "CSE");
+    student.updateCGPA(cgpa);
+    while (student.getSemester() < semester) {
+        student.advanceToNextSemester();
+    }
+    return student;
+}
+
+void testTable() {
+    RegistrationWindows windows;
+    CHECK(!windows.enabled());
+    CHECK(windows.opensAt(1, AcademicStanding::GOOD) == std::numeric_limits<time_t>::min());
+
+    windows.set({{7, INT_MAX, AcademicStanding::EXCELLENT, 100},
+                 {1, 6, AcademicStanding::EXCELLENT, 200},
+                 {1, INT_MAX, AcademicStanding::PROBATION, 300},
+                 {8, 8, AcademicStanding::PROBATION, 250}});
+    CHECK(windows.enabled());
+    CHECK(windows.opensAt(7, AcademicStanding::EXCELLENT) == 100);
+    CHECK(windows.opensAt(6, AcademicStanding::EXCELLENT) == 200);
+    // Semesters below 1 count as 1; those past kMaxSemester share its row
+    CHECK(windows.opensAt(0, AcademicStanding::EXCELLENT) == 200);
+    CHECK(windows.opensAt(RegistrationWindows::kMaxSemester + 5, AcademicStanding::EXCELLENT) == 100);
+    // The later of two overlapping windows wins
+    CHECK(windows.opensAt(8, AcademicStanding::PROBATION) == 250);
+    CHECK(windows.opensAt(9, AcademicStanding::PROBATION) == 300);
+    // An uncovered cohort is always open
+    CHECK(windows.opensAt(3, AcademicStanding::GOOD) == std::numeric_limits<time_t>::min());
+
+    bool threw = false;
+    try {
+        windows.set({{5, 4, AcademicStanding::GOOD, 100}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    // A range past the table is refused rather than folded onto its last row
+    threw = false;
+    try {
+        windows.set({{RegistrationWindows::kMaxSemester + 1, RegistrationWindows::kMaxSemester + 4,
+                      AcademicStanding::GOOD, 100}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(windows.opensAt(7, AcademicStanding::EXCELLENT) == 100);
+    // A range below semester 1 covers nobody
+    windows.set({{-3, 0, AcademicStanding::GOOD, 100}});
+    CHECK(!windows.enabled());
+    CHECK(windows.opensAt(1, AcademicStanding::GOOD) == std::numeric_limits<time_t>::min());
+
+    windows.set({});
+    CHECK(!windows.enabled());
+    CHECK(windows.opensAt(7, AcademicStanding::EXCELLENT) == std::numeric_limits<time_t>::min());
+}
+
+void testEngine() {
+    ManualClock clock(1000);
+    CourseRegistration reg;
+    reg.setClock(&clock);
+    reg.addCourse("CS101", "Programming", 10, {}, 5000);
+    reg.addCourse("MATH101", "Calculus", 10, {}, 5000);
+    reg.addCourse("PHYS101", "Mechanics", 10, {}, 2500);
+    reg.setRegistrationWindows({{7, INT_MAX, AcademicStanding::EXCELLENT, 1000},
+                                {1, 6, AcademicStanding::EXCELLENT, 2000}});
+
+    Student senior = makeStudent("S1", 7, 9.0f);
+    Student junior = makeStudent("S2", 2, 9.0f);
+    Student other = makeStudent("S3", 2, 7.5f);
+    CHECK(reg.getRegistrationOpening(junior) == 2000);
+
+    CHECK(reg.tryRegisterStudent(senior, "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.tryRegisterStudent(other, "CS101") == RegistrationStatus::SUCCESS);
+
+    // Every path refuses the junior until 2000
+    CHECK(reg.tryRegisterStudent(junior, "CS101") == RegistrationStatus::REGISTRATION_NOT_OPEN);
+    CartRegistrationResult cart = reg.registerCart(junior, {"CS101", "MATH101"});
+    CHECK(!cart.committed && cart.statuses[0] == RegistrationStatus::REGISTRATION_NOT_OPEN &&
+          cart.statuses[1] == RegistrationStatus::REGISTRATION_NOT_OPEN);
+    CHECK(reg.holdSeat(junior, "CS101", 60).status == RegistrationStatus::REGISTRATION_NOT_OPEN);
+    CHECK(reg.getEnrollmentCount("CS101") == 2);
+
+    clock.set(1999);
+    CHECK(reg.tryRegisterStudent(junior, "CS101") == RegistrationStatus::REGISTRATION_NOT_OPEN);
+    clock.set(2000);
+    CHECK(reg.tryRegisterStudent(junior, "CS101") == RegistrationStatus::SUCCESS);
+    CHECK(reg.swapCourse(junior, "CS101", "MATH101") == RegistrationStatus::SUCCESS);
+
+    // A course's own deadline still applies once a window opens
+    clock.set(3000);
+    CHECK(reg.tryRegisterStudent(junior, "PHYS101") == RegistrationStatus::REGISTRATION_CLOSED);
+
+    // A student whose standing drops moves to that cohort's window
+    reg.setRegistrationWindows({{1, INT_MAX, AcademicStanding::PROBATION, 4000}});
+    senior.updateCGPA(4.0f);
+    CHECK(reg.tryRegisterStudent(senior, "MATH101") == RegistrationStatus::REGISTRATION_NOT_OPEN);
+    clock.set(4000);
+    CHECK(reg.tryRegisterStudent(senior, "MATH101") == RegistrationStatus::SUCCESS);
+}
+
+} // namespace
+
+int main() {
+    testTable();
+    testEngine();
+    return test::finish();
+}
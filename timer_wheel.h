@@ -0,0 +1,264 @@
+/**
+ * @file timer_wheel.h
+ * @brief Hierarchical timer wheel with O(1) scheduling, cancellation and expiry
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * Time is split into 6-bit digits; level L holds 64 slots, each one
+ * 64^L ticks wide. A timer goes to the level of the highest digit in
+ * which its expiry differs from the wheel's current time, in the slot of
+ * that digit, so every timer at level 0 expires within the current block
+ * of 64 ticks and every timer at a higher level expires after everything
+ * below it. Advancing finds the next occupied slot of the lowest occupied
+ * level with one count-trailing-zeros on that level's occupancy bitmap:
+ * a level-0 slot fires its timers, a higher slot moves its timers down.
+ * Each timer moves down at most kLevels times, and empty stretches of
+ * time are skipped whole, so the cost of advancing does not depend on how
+ * far time moved or how many timers are pending.
+ *
+ * Timers live in one node array linked into per-slot lists, so cancelling
+ * unlinks a node in O(1) and freed nodes are reused without allocating.
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/** @brief Identifies a scheduled timer; ids of fired or cancelled timers are not handed out again */
+using TimerId = uint64_t;
+
+/**
+ * @brief Hierarchical timer wheel keyed by time_t ticks
+ *
+ * Not thread-safe; the owner serializes calls. Times must not be negative.
+ *
+ * @tparam Payload Value handed back when the timer fires; must be
+ *         default-constructible and movable
+ *
+ * Example usage:
+ * @code
+ * TimerWheel<std::string> wheel(now);
+ * TimerId id = wheel.schedule(now + 300, "S1");
+ * wheel.cancel(id);                      // O(1); false if already fired
+ * std::vector<std::pair<TimerId, std::string>> expired;
+ * wheel.advance(now + 600, expired);     // appends every timer due by now + 600
+ * @endcode
+ */
+template <typename Payload>
+class TimerWheel {
+public:
+    static constexpr int kSlotBits = 6;                   /**< Bits of time per level */
+    static constexpr uint32_t kSlots = 1u << kSlotBits;   /**< Slots per level */
+    static constexpr int kLevels = 11;                    /**< Enough levels to cover 64-bit times */
+
+private:
+    static constexpr uint32_t kNil = std::numeric_limits<uint32_t>::max(); /**< End of a slot list */
+    static constexpr uint16_t kFree = std::numeric_limits<uint16_t>::max(); /**< Bucket of a free node */
+
+    /** @brief One timer, linked into the list of its slot */
+    struct Node {
+        uint64_t expiry = 0;      /**< Tick at which the timer fires */
+        uint32_t prev = kNil;     /**< Previous node in the slot, or kNil */
+        uint32_t next = kNil;     /**< Next node in the slot, or next free node */
+        uint32_t generation = 0;  /**< Bumped on release, so stale ids do not match */
+        uint16_t bucket = kFree;  /**< level * kSlots + slot, or kFree */
+        Payload payload;          /**< Value returned on expiry */
+    };
+
+    std::vector<Node> nodes;                       /**< Timer storage, indexed by the low half of a TimerId */
+    std::array<uint32_t, kLevels * kSlots> heads;  /**< First node of every slot */
+    std::array<uint64_t, kLevels> occupied{};      /**< Bit s set if slot s of the level is not empty */
+    uint32_t freeHead = kNil;                      /**< First reusable node */
+    uint64_t current;                              /**< Time every pending timer is placed relative to */
+    size_t pending = 0;                            /**< Scheduled timers */
+
+    /** @brief Mask of the time bits a level's slots subdivide */
+    static uint64_t windowMask(int level) {
+        int bits = kSlotBits * (level + 1);
+        return bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    }
+
+    /** @brief Returns the lowest level with a timer, or kLevels */
+    int lowestOccupiedLevel() const {
+        int level = 0;
+        while (level < kLevels && !occupied[level]) {
+            ++level;
+        }
+        return level;
+    }
+
+    /** @brief Start of the next occupied slot of @p level, which must not be empty */
+    uint64_t nextSlotStart(int level, uint32_t& slot) const {
+        const int shift = kSlotBits * level;
+        const uint32_t digit = static_cast<uint32_t>(current >> shift) & (kSlots - 1);
+        // Pending timers never sit in slots behind the current digit
+        slot = static_cast<uint32_t>(__builtin_ctzll(occupied[level] >> digit << digit));
+        return (current & ~windowMask(level)) | (uint64_t(slot) << shift);
+    }
+
+    /** @brief Links a node into the slot its expiry maps to from current */
+    void link(uint32_t index) {
+        Node& node = nodes[index];
+        const uint64_t expiry = node.expiry > current ? node.expiry : current;
+        const uint64_t differing = expiry ^ current;
+        const int level = differing ? (63 - __builtin_clzll(differing)) / kSlotBits : 0;
+        const uint32_t slot = static_cast<uint32_t>(expiry >> (kSlotBits * level)) & (kSlots - 1);
+        const uint16_t bucket = static_cast<uint16_t>(level * kSlots + slot);
+        node.bucket = bucket;
+        node.prev = kNil;
+        node.next = heads[bucket];
+        if (node.next != kNil) {
+            nodes[node.next].prev = index;
+        }
+        heads[bucket] = index;
+        occupied[level] |= uint64_t(1) << slot;
+    }
+
+    /** @brief Removes a linked node from its slot */
+    void unlink(uint32_t index) {
+        Node& node = nodes[index];
+        if (node.prev != kNil) {
+            nodes[node.prev].next = node.next;
+        } else {
+            heads[node.bucket] = node.next;
+        }
+        if (node.next != kNil) {
+            nodes[node.next].prev = node.prev;
+        }
+        if (heads[node.bucket] == kNil) {
+            occupied[node.bucket / kSlots] &= ~(uint64_t(1) << (node.bucket % kSlots));
+        }
+    }
+
+    /** @brief Returns an unlinked node to the free list */
+    void release(uint32_t index) {
+        Node& node = nodes[index];
+        ++node.generation;
+        node.bucket = kFree;
+        node.payload = Payload();
+        node.next = freeHead;
+        freeHead = index;
+        --pending;
+    }
+
+    /** @brief Id of the timer currently in a node: generation above, index below */
+    TimerId idOf(uint32_t index) const {
+        return (uint64_t(nodes[index].generation) << 32) | index;
+    }
+
+public:
+    /** @brief Creates an empty wheel whose time starts at @p start */
+    explicit TimerWheel(time_t start = 0) : current(static_cast<uint64_t>(start)) {
+        heads.fill(kNil);
+    }
+
+    /**
+     * @brief Schedules a timer
+     *
+     * @param expiry Time at which the timer fires; a time already passed
+     *        fires on the next advance()
+     * @param payload Value handed back on expiry
+     * @return Id for cancel()
+     */
+    TimerId schedule(time_t expiry, Payload payload) {
+        uint32_t index;
+        if (freeHead != kNil) {
+            index = freeHead;
+            freeHead = nodes[index].next;
+        } else {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& node = nodes[index];
+        node.expiry = static_cast<uint64_t>(expiry);
+        node.payload = std::move(payload);
+        link(index);
+        ++pending;
+        return idOf(index);
+    }
+
+    /**
+     * @brief Cancels a pending timer
+     *
+     * @return false if the timer already fired or was cancelled
+     */
+    bool cancel(TimerId id) {
+        const uint32_t index = static_cast<uint32_t>(id);
+        if (index >= nodes.size() || nodes[index].bucket == kFree ||
+            nodes[index].generation != static_cast<uint32_t>(id >> 32)) {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    /**
+     * @brief Moves time forward and collects every timer due by @p now
+     *
+     * @param now New time; earlier than the wheel's time is a no-op
+     * @param[out] expired Receives (id, payload) of every fired timer,
+     *             in expiry order
+     */
+    void advance(time_t now, std::vector<std::pair<TimerId, Payload>>& expired) {
+        const uint64_t target = static_cast<uint64_t>(now);
+        while (pending && target >= current) {
+            const int level = lowestOccupiedLevel();
+            uint32_t slot;
+            const uint64_t start = nextSlotStart(level, slot);
+            if (start > target) {
+                break;
+            }
+            current = start;
+            const uint16_t bucket = static_cast<uint16_t>(level * kSlots + slot);
+            uint32_t index = heads[bucket];
+            heads[bucket] = kNil;
+            occupied[level] &= ~(uint64_t(1) << slot);
+            while (index != kNil) {
+                const uint32_t next = nodes[index].next;
+                if (nodes[index].expiry <= current) {
+                    expired.emplace_back(idOf(index), std::move(nodes[index].payload));
+                    release(index);
+                } else {
+                    link(index);  // Cascades to a lower level
+                }
+                index = next;
+            }
+        }
+        // No slot starts before the next occupied one, so every timer stays placed
+        if (target > current) {
+            current = target;
+        }
+    }
+
+    /**
+     * @brief Returns a time at or before the earliest pending expiry
+     *
+     * Exact when the earliest timer is within 64 ticks; otherwise the start
+     * of the slot that holds it. The largest time_t if nothing is pending.
+     */
+    time_t nextExpiryBound() const {
+        const int level = lowestOccupiedLevel();
+        if (level == kLevels) {
+            return std::numeric_limits<time_t>::max();
+        }
+        uint32_t slot;
+        const uint64_t start = nextSlotStart(level, slot);
+        return start > uint64_t(std::numeric_limits<time_t>::max())
+                   ? std::numeric_limits<time_t>::max() : static_cast<time_t>(start);
+    }
+
+    /** @brief Returns the number of pending timers */
+    size_t size() const { return pending; }
+
+    /** @brief Returns the wheel's current time */
+    time_t now() const { return static_cast<time_t>(current); }
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,63 @@
+/**
+ * @file varint.h
+ * @brief LEB128 varint and zigzag helpers shared by the binary formats
+ * @author tjkreddy
+ * @date Oct 17, 2026
+ *
+ * A varint stores an unsigned integer seven bits per byte, low bits
+ * first, with the high bit set on every byte but the last. Zigzag maps
+ * signed integers to unsigned ones so small magnitudes of either sign
+ * stay short. The archived rosters and the registration trace both use
+ * these encodings.
+ */
+
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * @brief Appends @p value to @p out as a varint
+ * @tparam Bytes Byte container with push_back, such as std::string or std::vector<uint8_t>
+ */
+template <typename Bytes>
+inline void putVarint(Bytes& out, uint64_t value) {
+    using Byte = typename Bytes::value_type;
+    while (value >= 0x80) {
+        out.push_back(static_cast<Byte>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<Byte>(value));
+}
+
+/**
+ * @brief Decodes one varint from a byte source
+ * @param next Callable returning the next byte; it reports running out itself
+ * @return The decoded value
+ * @throws std::runtime_error if the varint runs past 64 bits
+ */
+template <typename NextByte>
+inline uint64_t getVarint(NextByte&& next) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(next());
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Malformed varint");
+}
+
+/** @brief Maps a signed integer to an unsigned one, small magnitudes first */
+inline uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/** @brief Inverse of zigzagEncode */
+inline int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+#endif // VARINT_H